@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2016 by Cadence Design Systems, Inc.  ALL RIGHTS RESERVED.
+ * These coded instructions, statements, and computer programs are the
+ * copyrighted works and confidential proprietary information of
+ * Cadence Design Systems Inc.  They may be adapted and modified by bona fide
+ * purchasers for internal use, but neither the original nor any adapted
+ * or modified version may be disclosed or distributed to third parties
+ * in any manner, medium, or form, in whole or in part, without the prior
+ * written consent of Cadence Design Systems Inc.  This software and its
+ * derivatives are to be executed solely on products incorporating a Cadence
+ * Design Systems processor.
+ */
+
+#ifndef __TILE_GRAPH_H__
+#define __TILE_GRAPH_H__
+
+#include "tileManager.h"
+#include "tileKernels.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+// A tile graph runs a chain or DAG of kernels on one input tile and writes
+// only the last kernel's result to the output tile. Results of the other
+// kernels are kept in intermediate tiles allocated from the Tile Manager
+// memory banks (local data RAM), they never go to system memory.
+//
+// Each intermediate result is computed on the output region grown by the
+// halo still needed by the kernels that consume it, so the valid region
+// shrinks from stage to stage until it matches the output tile. The input
+// tile needs edges equal to the sum of halos along the longest path
+// (xvGetTileGraphHalo). Frame borders are padded once on the input tile,
+// as set by the frame padding type.
+
+#define XV_GRAPH_MAX_NODES   8
+#define XV_GRAPH_INPUT       (-1)  // Node input is the graph input tile
+#define XV_GRAPH_NONE        (-2)  // Unused second input of single input kernels
+
+typedef struct xvGraphNodeStruct
+{
+  int32_t kernelId;
+  int32_t input[2];    // Producer node index, XV_GRAPH_INPUT or XV_GRAPH_NONE
+  int32_t margin;      // Pixels computed around the output region
+  xvTile  *pTile;      // Intermediate tile, NULL for the last node
+} xvGraphNode;
+
+typedef struct xvTileGraphStruct
+{
+  int32_t     numNodes;
+  int32_t     inputHalo;    // Edge needed on the graph input tile
+  int32_t     inType;       // XV_TILE_* type of the graph input tile
+  int32_t     tileWidth;    // Maximum output tile width
+  int32_t     tileHeight;   // Maximum output tile height
+  int32_t     finalized;
+  xvGraphNode node[XV_GRAPH_MAX_NODES];
+} xvTileGraph;
+
+/***********************************
+*    Function  Prototypes
+***********************************/
+
+// Resets graph
+// pxvTM  - Tile Manager object
+// pGraph - Tile graph
+// Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+int32_t xvInitTileGraph(xvTileManager *pxvTM, xvTileGraph *pGraph);
+
+// Appends a kernel to the graph. Nodes have to be added in execution order,
+// inputs can only refer to nodes added earlier. The last node added produces the graph output.
+// pxvTM    - Tile Manager object
+// pGraph   - Tile graph
+// kernelId - xvKernelId_t value
+// input0   - First input, node index or XV_GRAPH_INPUT
+// input1   - Second input for kernels with two inputs, else XV_GRAPH_NONE
+// Returns index of the node. Returns XVTM_ERROR if it encounters an error
+int32_t xvAddTileGraphNode(xvTileManager *pxvTM, xvTileGraph *pGraph, int32_t kernelId, int32_t input0, int32_t input1);
+
+// Computes margins and halo of the graph and allocates intermediate tiles
+// pxvTM      - Tile Manager object
+// pGraph     - Tile graph
+// tileWidth  - Maximum width of output tile
+// tileHeight - Maximum height of output tile
+// Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+int32_t xvFinalizeTileGraph(xvTileManager *pxvTM, xvTileGraph *pGraph, int32_t tileWidth, int32_t tileHeight);
+
+// Returns edge width and height needed on the graph input tile, XVTM_ERROR if graph is not finalized
+int32_t xvGetTileGraphHalo(xvTileGraph *pGraph);
+
+// Allocates graph input tile and its buffer with edges sized for the graph halo
+// pxvTM     - Tile Manager object
+// pGraph    - Finalized tile graph
+// color     - Memory pool from which the buffer should be allocated
+// pFrame    - Frame associated with the tile
+// alignType - Alignment type of tile
+// Returns the pointer to allocated tile.
+// Returns ((xvTile *)(XVTM_ERROR)) if it encounters an error.
+xvTile *xvCreateTileGraphInTile(xvTileManager *pxvTM, xvTileGraph *pGraph, int32_t color, xvFrame *pFrame, int32_t alignType);
+
+// Runs all kernels of the graph
+// pxvTM    - Tile Manager object
+// pGraph   - Finalized tile graph
+// pInTile  - Input tile, edges >= graph halo
+// pOutTile - Output tile, not larger than the finalized tile size
+// Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+int32_t xvExecuteTileGraph(xvTileManager *pxvTM, xvTileGraph *pGraph, xvTile *pInTile, xvTile *pOutTile);
+
+// Releases intermediate tiles and their buffers
+// pxvTM  - Tile Manager object
+// pGraph - Tile graph
+// Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+int32_t xvFreeTileGraph(xvTileManager *pxvTM, xvTileGraph *pGraph);
+
+#if defined (__cplusplus)
+}
+#endif
+
+#endif
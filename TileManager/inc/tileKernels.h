@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2016 by Cadence Design Systems, Inc.  ALL RIGHTS RESERVED.
+ * These coded instructions, statements, and computer programs are the
+ * copyrighted works and confidential proprietary information of
+ * Cadence Design Systems Inc.  They may be adapted and modified by bona fide
+ * purchasers for internal use, but neither the original nor any adapted
+ * or modified version may be disclosed or distributed to third parties
+ * in any manner, medium, or form, in whole or in part, without the prior
+ * written consent of Cadence Design Systems Inc.  This software and its
+ * derivatives are to be executed solely on products incorporating a Cadence
+ * Design Systems processor.
+ */
+
+#ifndef __TILE_KERNELS_H__
+#define __TILE_KERNELS_H__
+
+#include "tileManager.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+// Kernels are vectorized with IVP intrinsics when built for a Vision core.
+// Everywhere else (host, non vision cores) plain C reference code is used.
+// The reference code produces bit exact results and is written so that
+// host compilers can auto-vectorize it. Define XV_KERNEL_REF_ONLY to force
+// the reference code on a Vision core.
+#if defined(__XTENSA__) && !defined(XV_KERNEL_REF_ONLY)
+#include <xtensa/config/core-isa.h>
+#if defined(XCHAL_HAVE_VISION) && XCHAL_HAVE_VISION
+#define XV_KERNEL_USE_IVP
+#endif
+#endif
+
+/*****************************************
+*   Kernel identifiers
+*****************************************/
+
+typedef enum
+{
+  XV_KERNEL_COPY_U8 = 0,
+  XV_KERNEL_COPY_U16,
+  XV_KERNEL_BOX_3X3_U8,
+  XV_KERNEL_BOX_5X5_U8,
+  XV_KERNEL_GAUSSIAN_3X3_U8,
+  XV_KERNEL_GAUSSIAN_5X5_U8,
+  XV_KERNEL_SOBEL_DX_3X3_U8S16,
+  XV_KERNEL_SOBEL_DY_3X3_U8S16,
+  XV_KERNEL_SOBEL_MAG_3X3_U8,
+  XV_KERNEL_MEDIAN_3X3_U8,
+  XV_KERNEL_MEDIAN_5X5_U8,
+  XV_KERNEL_ERODE_3X3_U8,
+  XV_KERNEL_ERODE_5X5_U8,
+  XV_KERNEL_DILATE_3X3_U8,
+  XV_KERNEL_DILATE_5X5_U8,
+  XV_KERNEL_ADD_U8,
+  XV_KERNEL_SUB_U8,
+  XV_KERNEL_ABSDIFF_U8,
+  XV_KERNEL_ADD_S16,
+  XV_KERNEL_SUB_S16,
+  XV_KERNEL_COUNT
+} xvKernelId_t;
+
+typedef int32_t (*xvUnaryKernelFunc)(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile);
+typedef int32_t (*xvBinaryKernelFunc)(xvTileManager *pxvTM, xvTile *pInTile0, xvTile *pInTile1, xvTile *pOutTile);
+
+// Describes a kernel. haloWidth and haloHeight are the number of pixels the
+// kernel reads on each side of an output pixel. Input tiles need at least
+// that many edge pixels (tileEdgeLeft/Right >= haloWidth and
+// tileEdgeTop/Bottom >= haloHeight).
+typedef struct xvKernelInfoStruct
+{
+  const char         *name;
+  xvUnaryKernelFunc  unaryFunc;   // Set for kernels with one input tile
+  xvBinaryKernelFunc binaryFunc;  // Set for kernels with two input tiles
+  uint8_t            numInputs;
+  uint8_t            haloWidth;
+  uint8_t            haloHeight;
+  uint16_t           inType;      // XV_TILE_* type of the input tile(s)
+  uint16_t           outType;     // XV_TILE_* type of the output tile
+} xvKernelInfo;
+
+/*****************************************
+*   Halo requirements
+*****************************************/
+
+#define XV_KERNEL_HALO_NONE  0
+#define XV_KERNEL_HALO_3X3   1
+#define XV_KERNEL_HALO_5X5   2
+
+/***********************************
+*    Function  Prototypes
+***********************************/
+
+// All kernels process the width x height region of pOutTile. Input pixels are read
+// from the same position of the input tile(s), including its edges.
+// Input tiles must be at least as large as the output tile and provide the kernel's halo.
+// Kernels return XVTM_ERROR if they encounter an error, else return XVTM_SUCCESS.
+// On error pxvTM->errFlag is set.
+
+// Returns the description of a kernel
+// kernelId - xvKernelId_t value
+// Returns NULL if kernelId is not valid
+const xvKernelInfo *xvGetKernelInfo(int32_t kernelId);
+
+// Computes the pitch and buffer size of a tile with equal edges on all sides
+// width     - Width of tile
+// height    - Height of tile
+// edge      - Edge width and height of tile
+// pelSize   - Bytes per pixel
+// alignType - Alignment type of the tile
+// pPitch    - Returns the pitch of the tile in pixels
+// Returns buffer size in bytes. Returns XVTM_ERROR if arguments are not valid
+int32_t xvGetHaloTileBuffSize(int32_t width, int32_t height, int32_t edge, int32_t pelSize, int32_t alignType, int32_t *pPitch);
+
+// Computes the pitch and buffer size needed by the input tile of a kernel
+// kernelId  - xvKernelId_t value
+// width     - Width of output region
+// height    - Height of output region
+// alignType - Alignment type of the tile
+// pPitch    - Returns the pitch of the tile in pixels
+// Returns buffer size in bytes. Returns XVTM_ERROR if arguments are not valid
+int32_t xvGetKernelTileBuffSize(int32_t kernelId, int32_t width, int32_t height, int32_t alignType, int32_t *pPitch);
+
+// Allocates input tile and its buffer with edges sized for the kernel's halo
+// pxvTM     - Tile Manager object
+// kernelId  - xvKernelId_t value
+// width     - Width of tile
+// height    - Height of tile
+// color     - Memory pool from which the buffer should be allocated
+// pFrame    - Frame associated with the tile
+// alignType - Alignment type of tile
+// Returns the pointer to allocated tile.
+// Returns ((xvTile *)(XVTM_ERROR)) if it encounters an error.
+xvTile *xvCreateKernelTile(xvTileManager *pxvTM, int32_t kernelId, int32_t width, int32_t height, int32_t color, xvFrame *pFrame, int32_t alignType);
+
+// Copy
+int32_t xvCopyU8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile);
+int32_t xvCopyU16(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile);
+
+// Box (mean) filter, result is rounded to nearest
+int32_t xvBoxFilter3x3U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile);
+int32_t xvBoxFilter5x5U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile);
+
+// Gaussian filter. Binomial coefficients [1 2 1] and [1 4 6 4 1]
+int32_t xvGaussian3x3U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile);
+int32_t xvGaussian5x5U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile);
+
+// Sobel gradients. Output tiles are XV_TILE_S16
+int32_t xvSobelDx3x3U8S16(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile);
+int32_t xvSobelDy3x3U8S16(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile);
+
+// Sobel magnitude, |dx| + |dy| saturated to 255
+int32_t xvSobelMag3x3U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile);
+
+// Median filter
+int32_t xvMedian3x3U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile);
+int32_t xvMedian5x5U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile);
+
+// Morphology with a square structuring element
+int32_t xvErode3x3U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile);
+int32_t xvErode5x5U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile);
+int32_t xvDilate3x3U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile);
+int32_t xvDilate5x5U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile);
+
+// Saturating arithmetic
+int32_t xvAddU8(xvTileManager *pxvTM, xvTile *pInTile0, xvTile *pInTile1, xvTile *pOutTile);
+int32_t xvSubU8(xvTileManager *pxvTM, xvTile *pInTile0, xvTile *pInTile1, xvTile *pOutTile);
+int32_t xvAbsDiffU8(xvTileManager *pxvTM, xvTile *pInTile0, xvTile *pInTile1, xvTile *pOutTile);
+int32_t xvAddS16(xvTileManager *pxvTM, xvTile *pInTile0, xvTile *pInTile1, xvTile *pOutTile);
+int32_t xvSubS16(xvTileManager *pxvTM, xvTile *pInTile0, xvTile *pInTile1, xvTile *pOutTile);
+
+#if defined (__cplusplus)
+}
+#endif
+
+#endif
@@ -34,6 +34,9 @@ extern "C"
 //#define IDMA_APP_USE_XTOS
 #include <xtensa/idma.h>
 #include <xtensa/tie/xt_misc.h>
+
+// One transfer of a descriptor chain
+typedef idma_2d_xfer_t xvDmaXfer;
 #endif //XV_EMULATE_DMA
 
 // MAX limits for number of tiles, frames memory banks and dma queue length
@@ -41,6 +44,7 @@ extern "C"
 #define MAX_NUM_TILES             32
 #define MAX_NUM_FRAMES            8
 #define MAX_NUM_DMA_QUEUE_LENGTH  32 // Optimization, multiple of 2
+#define MAX_NUM_CHAIN_DESCS       16 // Descriptors scheduled at once by ROI gather and masked row requests
 
 // Bank colors. XV_MEM_BANK_COLOR_ANY is an unlikely enum value
 #define XV_MEM_BANK_COLOR_0    0x0
@@ -164,6 +168,11 @@ extern "C"
 #endif
 #define idma_copy_2d_desc copy2d
 
+#ifdef idma_copy_2d_desc_list
+#undef idma_copy_2d_desc_list
+#endif
+#define idma_copy_2d_desc_list copy2dList
+
 #ifdef idma_desc_done
 #undef idma_desc_done
 #endif
@@ -218,6 +227,28 @@ int32_t dma_desc_done(int32_t index);
 #define idma_buffer_error_details     dma_buffer_error_details
 #endif
 
+// Descriptor format of the Tile Manager's iDMA buffer. With XVTM_USE_64B_DESC,
+// on cores that support 64B descriptors, all transfers use 64B descriptors and
+// 3D tiles are fetched with a single 3D descriptor. Otherwise 3D tiles are
+// fetched as a chain of 2D descriptors. The iDMA buffer passed to xvInitIdma()
+// has to be defined with XVTM_DESC_TYPE.
+//#define XVTM_USE_64B_DESC
+#if defined(XVTM_USE_64B_DESC) && !defined(XV_EMULATE_DMA) && (IDMA_USE_64B_DESC > 0)
+#define XVTM_DESC_TYPE  IDMA_64B_DESC
+#define XVTM_HAVE_3D_DESC
+
+// 64B descriptors take the address of the src/dst pointers
+static inline int32_t xvCopy2dDesc64(void *dst, void *src, size_t size, uint32_t flags,
+                                     uint32_t nrows, uint32_t srcPitch, uint32_t dstPitch)
+{
+  return(idma_copy_2d_desc64(0, (void *) &dst, (void *) &src, size, flags, nrows, srcPitch, dstPitch));
+}
+#define XVTM_COPY_2D_DESC  xvCopy2dDesc64
+#else
+#define XVTM_DESC_TYPE     IDMA_2D_DESC
+#define XVTM_COPY_2D_DESC  idma_copy_2d_desc
+#endif
+
 typedef enum
 {
   TILE_UNALIGNED,
@@ -267,6 +298,65 @@ typedef struct xvFrameStruct
 } xvFrame, *xvpFrame;
 
 
+// Tile spanning several planes of a planar frame, or co-located tiles of
+// several frames. Plane k is at k * tilePlanePitch bytes from plane 0 in the
+// tile buffer and at k * framePlanePitch bytes from plane 0 in system memory.
+// Size, position, edges, status and dmaIndex are those of plane 0.
+typedef struct xvTile3DStruct
+{
+  struct xvTileStruct *pTile;
+  int32_t             numPlanes;
+  int32_t             tilePlanePitch;
+  int32_t             framePlanePitch;
+} xvTile3D, *xvpTile3D;
+
+// Region of a frame, in pixels relative to the frame origin
+typedef struct xvRoiStruct
+{
+  int32_t x;
+  int32_t y;
+  int32_t width;
+  int32_t height;
+} xvRoi, *xvpRoi;
+
+// Tile walk step flags
+#define XVTM_WALK_STEP_OUT        (0x01 << 0)   // Tile to frame transfer, else frame to tile
+#define XVTM_WALK_STEP_16B        (0x01 << 1)   // 16b transfer, else 8b
+#define XVTM_WALK_STEP_INTERRUPT  (0x01 << 2)   // Requested with interruptOnCompletion
+
+// Tile walk states
+#define XVTM_WALK_IDLE       0
+#define XVTM_WALK_RECORDING  1
+#define XVTM_WALK_READY      2
+
+// One Fast transfer request of a recorded tile walk
+typedef struct xvTileWalkStepStruct
+{
+  struct xvTileStruct *pTile;
+  int32_t             flags;         // XVTM_WALK_STEP_* flags
+  int32_t             numDescs;      // Descriptors of the request, 0 if nothing is transferred
+  int32_t             frameOffset;   // Frame address of the first descriptor, relative to pFrameData
+  int32_t             status;        // Tile status set by the request
+  int32_t             dmaIndex;      // Index of the last descriptor when last scheduled
+} xvTileWalkStep, *xvpTileWalkStep;
+
+// Sequence of Fast transfer requests that is repeated for every frame. The
+// descriptors are written once while the walk is recorded and stay in the
+// iDMA buffer, later frames only patch the frame address of each request.
+typedef struct xvTileWalkStruct
+{
+  xvTileWalkStep *pSteps;
+  int32_t        maxSteps;
+  int32_t        numSteps;
+  int32_t        numDescs;     // Descriptors of the whole walk
+  int32_t        curStep;      // Next step to be scheduled
+  int32_t        numFrames;    // Frames replayed since the walk was recorded
+  int32_t        state;        // XVTM_WALK_* state
+  xvFrame        *pInFrame;
+  xvFrame        *pOutFrame;
+} xvTileWalk, *xvpTileWalk;
+
+
 #define XV_ARRAY_FIELDS \
   void     *pBuffer;    \
   uint32_t bufferSize;  \
@@ -328,6 +418,14 @@ typedef struct xvTileManagerStruct
   int32_t   frameCount;
   xvError_t errFlag;
   xvError_t idmaErrorFlag;
+
+  // iDMA buffer settings, needed to resize the descriptor ring for tile walks
+  idma_buffer_t    *pdmaBuf;
+  int32_t          dmaNumDescs;
+  int32_t          dmaRingDescs;   // Descriptors of the ring in use
+  idma_callback_fn dmaCbFunc;
+  void             *dmaCbData;
+  xvTileWalk       *pWalk;         // Walk being recorded, NULL if none
 } xvTileManager;
 
 extern xvTileManager *_ptr_xv_tile_manager;
@@ -692,6 +790,16 @@ extern xvTileManager *_ptr_xv_tile_manager;
     (pTile)->status = (pTile)->status & ~XV_TILE_STATUS_DMA_ONGOING;      \
   }
 
+#define WAIT_FOR_TILE_3D(pxvTM, pTile3D)                                  \
+  {                                                                       \
+    int32_t status;                                                       \
+    status = xvCheckTile3DReady((pxvTM), (pTile3D));                      \
+    while ( (status == 0) && (pxvTM->idmaErrorFlag == XV_ERROR_SUCCESS) ) \
+    {                                                                     \
+      status = xvCheckTile3DReady((pxvTM), (pTile3D));                    \
+    }                                                                     \
+  }
+
 // Assumes both top and bottom edges are equal
 #define XV_TILE_UPDATE_EDGE_HEIGHT(pTile, newEdgeHeight)                            \
   {                                                                                 \
@@ -863,6 +971,40 @@ int32_t xvAddIdmaRequest(xvTileManager *pxvTM, void *dst, void *src, size_t rowS
                          int32_t numRows, int32_t srcPitch, int32_t dsPitch, int32_t interruptOnCompletion);
 
 
+// Gathers regions of a frame into one packed buffer. Region k is stored
+// right after region k-1, with a pitch of its width. All regions are
+// scheduled as one descriptor chain.
+// pxvTM                 - Tile Manager object
+// pFrame                - source frame
+// pRoi                  - regions, may extend into the frame padding
+// numRois               - number of regions
+// pDst                  - destination buffer
+// dstSize               - size of destination buffer in bytes
+// ppRoiData             - receives the start of each region in pDst, may be NULL
+// interruptOnCompletion - if it is set, iDMA will interrupt after completing transfer
+// Returns dmaIndex of the last region, complete when all regions are.
+// It returns -1 if it encounters an error
+int32_t xvReqRoiGather(xvTileManager *pxvTM, xvFrame *pFrame, const xvRoi *pRoi, int32_t numRois,
+                       void *pDst, int32_t dstSize, void **ppRoiData, int32_t interruptOnCompletion);
+
+
+// Transfers the rows selected by a row mask. Row i is copied if bit (i % 32)
+// of pRowMask[i / 32] is set. Each run of selected rows is one descriptor,
+// all runs are scheduled as one descriptor chain.
+// pxvTM                 - Tile Manager object
+// dst                   - pointer to destination buffer
+// src                   - pointer to source buffer
+// rowSize               - number of bytes to transfer in a row
+// numRows               - number of rows covered by the mask
+// srcPitch              - source buffer's pitch in bytes
+// dstPitch              - destination buffer's pitch in bytes
+// pRowMask              - row mask, (numRows + 31) / 32 words
+// interruptOnCompletion - if it is set, iDMA will interrupt after completing transfer
+// Returns dmaIndex of the last selected row. It returns -1 if it encounters an error
+int32_t xvReqMaskedRowTransfer(xvTileManager *pxvTM, void *dst, void *src, size_t rowSize, int32_t numRows,
+                               int32_t srcPitch, int32_t dstPitch, const uint32_t *pRowMask, int32_t interruptOnCompletion);
+
+
 // Requests data transfer from frame present in system memory to local tile memory
 // pxvTM          - Tile Manager object
 // pTile          - destination tile
@@ -912,6 +1054,88 @@ int32_t xvReqTileTransferOutFast(xvTileManager *pxvTM, xvTile *pTile, int32_t in
 int32_t xvReqTileTransferOutFast16(xvTileManager *pxvTM, xvTile *pTile, int32_t interruptOnCompletion);
 
 
+// Requests 8b or 16b data transfer of all planes of a 3D tile from system memory
+// to local tile memory, with one 3D descriptor or one chain of 2D descriptors
+// pxvTM                 - Tile Manager object
+// pTile3D               - destination tile
+// interruptOnCompletion - if it is set, iDMA will interrupt after completing transfer
+// Returns XVTM_ERROR if it encounters an error, else it returns XVTM_SUCCESS
+int32_t xvReqTileTransferIn3D(xvTileManager *pxvTM, xvTile3D *pTile3D, int32_t interruptOnCompletion);
+
+
+// Requests data transfer of all planes of a 3D tile from local memory to system memory
+// pxvTM                 - Tile Manager object
+// pTile3D               - source tile
+// interruptOnCompletion - if it is set, iDMA will interrupt after completing transfer
+// Returns XVTM_ERROR if it encounters an error, else it returns XVTM_SUCCESS
+int32_t xvReqTileTransferOut3D(xvTileManager *pxvTM, xvTile3D *pTile3D, int32_t interruptOnCompletion);
+
+
+// Check if all planes of a 3D tile are ready. Pads the edges of every plane.
+// pxvTM   - Tile Manager object
+// pTile3D - input tile
+// Returns 1 if tile is ready, else returns 0
+// Returns XVTM_ERROR if an error occurs
+int32_t xvCheckTile3DReady(xvTileManager *pxvTM, xvTile3D *pTile3D);
+
+
+// Initializes a tile walk
+// pxvTM    - Tile Manager object
+// pWalk    - tile walk
+// pSteps   - storage for the steps of the walk
+// maxSteps - number of elements of pSteps
+// Returns XVTM_ERROR if it encounters an error, else it returns XVTM_SUCCESS
+int32_t xvInitTileWalk(xvTileManager *pxvTM, xvTileWalk *pWalk, xvTileWalkStep *pSteps, int32_t maxSteps);
+
+
+// Starts recording a tile walk. Waits for all transfers to complete and restarts the
+// iDMA buffer at its first descriptor. The following xvReqTileTransferInFast(),
+// xvReqTileTransferInFast16(), xvReqTileTransferOutFast() and xvReqTileTransferOutFast16()
+// calls are executed as usual and recorded as steps of the walk, other transfers must not
+// be requested until the recording ends.
+// pxvTM - Tile Manager object
+// pWalk - tile walk
+// Returns XVTM_ERROR if it encounters an error, else it returns XVTM_SUCCESS
+int32_t xvBeginTileWalkRecord(xvTileManager *pxvTM, xvTileWalk *pWalk);
+
+
+// Ends recording a tile walk. Waits for all transfers to complete and shrinks the
+// descriptor ring of the iDMA buffer to the descriptors of the walk, so that every
+// frame of the walk reuses the same descriptors.
+// pxvTM - Tile Manager object
+// pWalk - tile walk
+// Returns XVTM_ERROR if it encounters an error, else it returns XVTM_SUCCESS
+int32_t xvEndTileWalkRecord(xvTileManager *pxvTM, xvTileWalk *pWalk);
+
+
+// Starts a new frame of a recorded tile walk. Tiles are read from pInFrame
+// and written to pOutFrame, both must have the geometry of the recorded frames.
+// Until the walk is stopped, transfers can only be requested with xvReqTileWalkStep().
+// pxvTM     - Tile Manager object
+// pWalk     - tile walk
+// pInFrame  - source frame of the input steps
+// pOutFrame - destination frame of the output steps
+// Returns XVTM_ERROR if it encounters an error, else it returns XVTM_SUCCESS
+int32_t xvStartTileWalk(xvTileManager *pxvTM, xvTileWalk *pWalk, xvFrame *pInFrame, xvFrame *pOutFrame);
+
+
+// Schedules the next step of a tile walk. Patches the frame address of the step's
+// first descriptor and releases the step's descriptors to the iDMA. Status and dmaIndex
+// of the step's tile are set as by the recorded request.
+// pxvTM - Tile Manager object
+// pWalk - tile walk
+// Returns XVTM_ERROR if it encounters an error, else it returns XVTM_SUCCESS
+int32_t xvReqTileWalkStep(xvTileManager *pxvTM, xvTileWalk *pWalk);
+
+
+// Stops using a tile walk. Waits for all transfers to complete and restores
+// the descriptor ring set up by xvInitIdma().
+// pxvTM - Tile Manager object
+// pWalk - tile walk
+// Returns XVTM_ERROR if it encounters an error, else it returns XVTM_SUCCESS
+int32_t xvStopTileWalk(xvTileManager *pxvTM, xvTileWalk *pWalk);
+
+
 //Pads 8b edge of the given tile
 // pxvTM - Tile Manager object
 // pTile - tile
@@ -88,6 +88,17 @@ void *xvmem_alloc(xvmem_mgr_t *mgr, size_t size, uint32_t align, xvmem_status_t
 void xvmem_free(xvmem_mgr_t *mgr, void *p);
 #else
 int32_t copy2d(void *pDst, void *pSrc, size_t width, int32_t flags, int32_t height, int32_t srcPitchBytes, int32_t dstPitchBytes);
+// Same layout as idma_2d_xfer_t, which is not available without the iDMA library
+typedef struct xvDmaXferStruct
+{
+  void     *dst;
+  void     *src;
+  uint32_t row_sz;
+  uint32_t nrows;
+  uint32_t src_pitch;
+  uint32_t dst_pitch;
+} xvDmaXfer;
+int32_t copy2dList(const xvDmaXfer *pXfers, uint32_t count, uint32_t flags);
 int dma_sleep();
 #endif
 void copyBufferEdgeDataH(uint8_t * __restrict srcPtr, uint8_t * __restrict dstPtr, int32_t widthBytes, int32_t height, int32_t pitchBytes, uint8_t paddingType, uint8_t paddingVal);
@@ -0,0 +1,517 @@
+/*
+ * Copyright (c) 2016 by Cadence Design Systems, Inc.  ALL RIGHTS RESERVED.
+ * These coded instructions, statements, and computer programs are the
+ * copyrighted works and confidential proprietary information of
+ * Cadence Design Systems Inc.  They may be adapted and modified by bona fide
+ * purchasers for internal use, but neither the original nor any adapted
+ * or modified version may be disclosed or distributed to third parties
+ * in any manner, medium, or form, in whole or in part, without the prior
+ * written consent of Cadence Design Systems Inc.  This software and its
+ * derivatives are to be executed solely on products incorporating a Cadence
+ * Design Systems processor.
+ */
+
+/**********************************************************************************
+ * FILE:  tileGraph.c
+ *
+ * DESCRIPTION:
+ *
+ *    This file contains the tile graph executor. It runs a sequence of kernels
+ *    on a tile, keeping intermediate results in local memory tiles whose valid
+ *    region shrinks by the halo of each consuming kernel.
+ *
+ ********************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tileGraph.h"
+
+/**********************************************************************************
+ * FUNCTION: makeTileView()
+ *
+ * DESCRIPTION:
+ *     Builds a tile view that covers the output region grown by shift pixels
+ *     on each side. The view shares the buffer of the source tile, its edges
+ *     are reduced by shift.
+ *
+ * INPUTS:
+ *     xvTile        *pTile         Source tile, data pointer at output origin
+ *     int32_t       shift          Number of pixels the region is grown on each side
+ *     int32_t       width          Width of output region
+ *     int32_t       height         Height of output region
+ *
+ * OUTPUTS:
+ *     xvTile        *pView         Tile view
+ *
+ ********************************************************************************** */
+
+static void makeTileView(xvTile *pView, xvTile *pTile, int32_t shift, int32_t width, int32_t height)
+{
+  int32_t pelSize = XV_TILE_GET_ELEMENT_SIZE(pTile);
+  uint8_t *pData  = (uint8_t *) XV_TILE_GET_DATA_PTR(pTile);
+
+  *pView = *pTile;
+  XV_TILE_SET_DATA_PTR(pView, pData - (shift * XV_TILE_GET_PITCH(pTile) + shift) * pelSize);
+  XV_TILE_SET_WIDTH(pView, width + 2 * shift);
+  XV_TILE_SET_HEIGHT(pView, height + 2 * shift);
+  XV_TILE_SET_EDGE_LEFT(pView, XV_TILE_GET_EDGE_LEFT(pTile) - shift);
+  XV_TILE_SET_EDGE_TOP(pView, XV_TILE_GET_EDGE_TOP(pTile) - shift);
+  XV_TILE_SET_EDGE_RIGHT(pView, XV_TILE_GET_EDGE_RIGHT(pTile) + XV_TILE_GET_WIDTH(pTile) - width - shift);
+  XV_TILE_SET_EDGE_BOTTOM(pView, XV_TILE_GET_EDGE_BOTTOM(pTile) + XV_TILE_GET_HEIGHT(pTile) - height - shift);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvInitTileGraph()
+ *
+ * DESCRIPTION:
+ *     Resets the tile graph. Intermediate tiles of a finalized graph should be
+ *     released with xvFreeTileGraph before.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTileGraph   *pGraph        Tile graph
+ *
+ * OUTPUTS:
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvInitTileGraph(xvTileManager *pxvTM, xvTileGraph *pGraph)
+{
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  if (pGraph == NULL)
+  {
+    pxvTM->errFlag = XV_ERROR_POINTER_NULL;
+    return(XVTM_ERROR);
+  }
+
+  memset(pGraph, 0, sizeof(xvTileGraph));
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvAddTileGraphNode()
+ *
+ * DESCRIPTION:
+ *     Appends a kernel to the tile graph. Inputs can be the graph input tile or
+ *     nodes added earlier, so nodes are always in execution order.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTileGraph   *pGraph        Tile graph
+ *     int32_t       kernelId       xvKernelId_t value
+ *     int32_t       input0         First input, node index or XV_GRAPH_INPUT
+ *     int32_t       input1         Second input, node index, XV_GRAPH_INPUT or XV_GRAPH_NONE
+ *
+ * OUTPUTS:
+ *     Returns index of the node. Returns XVTM_ERROR if it encounters an error
+ *
+ ********************************************************************************** */
+
+int32_t xvAddTileGraphNode(xvTileManager *pxvTM, xvTileGraph *pGraph, int32_t kernelId, int32_t input0, int32_t input1)
+{
+  const xvKernelInfo *pInfo;
+  int32_t index;
+
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  if (pGraph == NULL)
+  {
+    pxvTM->errFlag = XV_ERROR_POINTER_NULL;
+    return(XVTM_ERROR);
+  }
+
+  pInfo = xvGetKernelInfo(kernelId);
+  index = pGraph->numNodes;
+  if ((pInfo == NULL) || (pGraph->finalized) || (index >= XV_GRAPH_MAX_NODES))
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return(XVTM_ERROR);
+  }
+
+  // Inputs must be produced by earlier nodes. Second input is used only by two input kernels.
+  if ((input0 < XV_GRAPH_INPUT) || (input0 >= index) ||
+      ((pInfo->numInputs == 2) && ((input1 < XV_GRAPH_INPUT) || (input1 >= index))) ||
+      ((pInfo->numInputs == 1) && (input1 != XV_GRAPH_NONE)))
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return(XVTM_ERROR);
+  }
+
+  pGraph->node[index].kernelId = kernelId;
+  pGraph->node[index].input[0] = input0;
+  pGraph->node[index].input[1] = input1;
+  pGraph->node[index].margin   = -1;
+  pGraph->node[index].pTile    = NULL;
+  pGraph->numNodes++;
+  return(index);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvFinalizeTileGraph()
+ *
+ * DESCRIPTION:
+ *     Checks tile types between nodes, computes the region each node has to
+ *     compute and the halo of the graph input. Allocates intermediate tiles,
+ *     alternating between memory banks 0 and 1 when available.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTileGraph   *pGraph        Tile graph
+ *     int32_t       tileWidth      Maximum width of output tile
+ *     int32_t       tileHeight     Maximum height of output tile
+ *
+ * OUTPUTS:
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvFinalizeTileGraph(xvTileManager *pxvTM, xvTileGraph *pGraph, int32_t tileWidth, int32_t tileHeight)
+{
+  const xvKernelInfo *pInfo;
+  xvGraphNode *pNode;
+  int32_t indn, indi, input, need, prodType, last;
+  int32_t buffSize, pitch, outType;
+  void *pBuff;
+  xvTile *pTile;
+
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  if (pGraph == NULL)
+  {
+    pxvTM->errFlag = XV_ERROR_POINTER_NULL;
+    return(XVTM_ERROR);
+  }
+
+  if ((pGraph->numNodes <= 0) || (pGraph->finalized) || (tileWidth <= 0) || (tileHeight <= 0))
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return(XVTM_ERROR);
+  }
+
+  // 1. Tile types of producers and consumers should match
+  pGraph->inType = 0;
+  for (indn = 0; indn < pGraph->numNodes; indn++)
+  {
+    pInfo = xvGetKernelInfo(pGraph->node[indn].kernelId);
+    for (indi = 0; indi < pInfo->numInputs; indi++)
+    {
+      input = pGraph->node[indn].input[indi];
+      if (input == XV_GRAPH_INPUT)
+      {
+        if (pGraph->inType == 0)
+        {
+          pGraph->inType = pInfo->inType;
+        }
+        prodType = pGraph->inType;
+      }
+      else
+      {
+        prodType = xvGetKernelInfo(pGraph->node[input].kernelId)->outType;
+      }
+      if (XV_TYPE_ELEMENT_SIZE(prodType) != XV_TYPE_ELEMENT_SIZE(pInfo->inType))
+      {
+        pxvTM->errFlag = XV_ERROR_BAD_ARG;
+        return(XVTM_ERROR);
+      }
+    }
+  }
+
+  // 2. Walk back from the output. Each producer computes the region its consumers
+  //    need: consumer's region grown by consumer's halo.
+  last                     = pGraph->numNodes - 1;
+  pGraph->inputHalo        = 0;
+  pGraph->node[last].margin = 0;
+  for (indn = 0; indn < last; indn++)
+  {
+    pGraph->node[indn].margin = -1;
+  }
+  for (indn = last; indn >= 0; indn--)
+  {
+    pNode = &pGraph->node[indn];
+    if (pNode->margin < 0)
+    {
+      // Result of this node is not used
+      pxvTM->errFlag = XV_ERROR_BAD_ARG;
+      return(XVTM_ERROR);
+    }
+    pInfo = xvGetKernelInfo(pNode->kernelId);
+    need  = pNode->margin + ((pInfo->haloWidth > pInfo->haloHeight) ? pInfo->haloWidth : pInfo->haloHeight);
+    for (indi = 0; indi < pInfo->numInputs; indi++)
+    {
+      input = pNode->input[indi];
+      if (input == XV_GRAPH_INPUT)
+      {
+        pGraph->inputHalo = (need > pGraph->inputHalo) ? need : pGraph->inputHalo;
+      }
+      else if (need > pGraph->node[input].margin)
+      {
+        pGraph->node[input].margin = need;
+      }
+    }
+  }
+
+  // 3. Intermediate tiles. The output of the last node goes to the caller's output tile.
+  pGraph->tileWidth  = tileWidth;
+  pGraph->tileHeight = tileHeight;
+  for (indn = 0; indn < last; indn++)
+  {
+    pNode    = &pGraph->node[indn];
+    outType  = xvGetKernelInfo(pNode->kernelId)->outType;
+    buffSize = xvGetHaloTileBuffSize(tileWidth, tileHeight, pNode->margin, XV_TYPE_ELEMENT_SIZE(outType), EDGE_ALIGNED_64, &pitch);
+
+    pBuff = xvAllocateBuffer(pxvTM, buffSize, (indn & 1) ? XV_MEM_BANK_COLOR_1 : XV_MEM_BANK_COLOR_0, 64);
+    if ((int32_t) pBuff == XVTM_ERROR)
+    {
+      pBuff = xvAllocateBuffer(pxvTM, buffSize, XV_MEM_BANK_COLOR_ANY, 64);
+    }
+    if ((int32_t) pBuff == XVTM_ERROR)
+    {
+      xvFreeTileGraph(pxvTM, pGraph);
+      pxvTM->errFlag = XV_ERROR_ALLOC_FAILED;
+      return(XVTM_ERROR);
+    }
+
+    pTile = xvAllocateTile(pxvTM);
+    if ((int32_t) pTile == XVTM_ERROR)
+    {
+      xvFreeBuffer(pxvTM, pBuff);
+      xvFreeTileGraph(pxvTM, pGraph);
+      pxvTM->errFlag = XV_ERROR_TILE_BUFFER_FULL;
+      return(XVTM_ERROR);
+    }
+    SETUP_TILE(pTile, pBuff, buffSize, NULL, tileWidth, tileHeight, pitch, outType, pNode->margin, pNode->margin, 0, 0, EDGE_ALIGNED_64);
+    pNode->pTile = pTile;
+  }
+
+  pGraph->finalized = 1;
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvGetTileGraphHalo()
+ *
+ * DESCRIPTION:
+ *     Returns the edge width and height needed on the graph input tile
+ *
+ * INPUTS:
+ *     xvTileGraph   *pGraph        Tile graph
+ *
+ * OUTPUTS:
+ *     Returns graph halo, XVTM_ERROR if graph is not finalized
+ *
+ ********************************************************************************** */
+
+int32_t xvGetTileGraphHalo(xvTileGraph *pGraph)
+{
+  if ((pGraph == NULL) || (pGraph->finalized == 0))
+  {
+    return(XVTM_ERROR);
+  }
+  return(pGraph->inputHalo);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvCreateTileGraphInTile()
+ *
+ * DESCRIPTION:
+ *     Allocates a graph input tile of the finalized tile size with edges
+ *     equal to the graph halo.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTileGraph   *pGraph        Finalized tile graph
+ *     int32_t       color          Memory pool from which the buffer should be allocated
+ *     xvFrame       *pFrame        Frame associated with the tile
+ *     int32_t       alignType      Alignment type of tile
+ *
+ * OUTPUTS:
+ *     Returns the pointer to allocated tile.
+ *     Returns ((xvTile *)(XVTM_ERROR)) if it encounters an error.
+ *
+ ********************************************************************************** */
+
+xvTile *xvCreateTileGraphInTile(xvTileManager *pxvTM, xvTileGraph *pGraph, int32_t color, xvFrame *pFrame, int32_t alignType)
+{
+  int32_t pitch, buffSize;
+
+  if (pxvTM == NULL)
+  {
+    return((xvTile *) XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  if ((pGraph == NULL) || (pGraph->finalized == 0))
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return((xvTile *) XVTM_ERROR);
+  }
+
+  buffSize = xvGetHaloTileBuffSize(pGraph->tileWidth, pGraph->tileHeight, pGraph->inputHalo,
+                                   XV_TYPE_ELEMENT_SIZE(pGraph->inType), alignType, &pitch);
+  return(xvCreateTile(pxvTM, buffSize, pGraph->tileWidth, pGraph->tileHeight, pitch, pGraph->inputHalo, pGraph->inputHalo,
+                      color, pFrame, pGraph->inType, alignType));
+}
+
+/**********************************************************************************
+ * FUNCTION: xvExecuteTileGraph()
+ *
+ * DESCRIPTION:
+ *     Runs the kernels of the graph in order. Every node computes the output
+ *     region grown by its margin. Only the last node writes to pOutTile.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTileGraph   *pGraph        Finalized tile graph
+ *     xvTile        *pInTile       Input tile, edges >= graph halo
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvExecuteTileGraph(xvTileManager *pxvTM, xvTileGraph *pGraph, xvTile *pInTile, xvTile *pOutTile)
+{
+  const xvKernelInfo *pInfo;
+  xvGraphNode *pNode;
+  xvTile inView[2], outView, *pSrc;
+  int32_t indn, indi, width, height, last, retVal;
+
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  if ((pInTile == NULL) || (pOutTile == NULL))
+  {
+    pxvTM->errFlag = XV_ERROR_TILE_NULL;
+    return(XVTM_ERROR);
+  }
+
+  if ((pGraph == NULL) || (pGraph->finalized == 0))
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return(XVTM_ERROR);
+  }
+
+  width  = XV_TILE_GET_WIDTH(pOutTile);
+  height = XV_TILE_GET_HEIGHT(pOutTile);
+  if ((width > pGraph->tileWidth) || (height > pGraph->tileHeight) ||
+      (XV_TILE_GET_WIDTH(pInTile) < width) || (XV_TILE_GET_HEIGHT(pInTile) < height))
+  {
+    pxvTM->errFlag = XV_ERROR_DIMENSION_MISMATCH;
+    return(XVTM_ERROR);
+  }
+
+  if ((XV_TILE_GET_EDGE_LEFT(pInTile) < pGraph->inputHalo) || (XV_TILE_GET_EDGE_TOP(pInTile) < pGraph->inputHalo) ||
+      ((XV_TILE_GET_EDGE_RIGHT(pInTile) + XV_TILE_GET_WIDTH(pInTile) - width) < pGraph->inputHalo) ||
+      ((XV_TILE_GET_EDGE_BOTTOM(pInTile) + XV_TILE_GET_HEIGHT(pInTile) - height) < pGraph->inputHalo))
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return(XVTM_ERROR);
+  }
+
+  last = pGraph->numNodes - 1;
+  for (indn = 0; indn <= last; indn++)
+  {
+    pNode = &pGraph->node[indn];
+    pInfo = xvGetKernelInfo(pNode->kernelId);
+
+    for (indi = 0; indi < pInfo->numInputs; indi++)
+    {
+      pSrc = (pNode->input[indi] == XV_GRAPH_INPUT) ? pInTile : pGraph->node[pNode->input[indi]].pTile;
+      makeTileView(&inView[indi], pSrc, pNode->margin, width, height);
+    }
+
+    if (indn == last)
+    {
+      outView = *pOutTile;
+    }
+    else
+    {
+      makeTileView(&outView, pNode->pTile, pNode->margin, width, height);
+    }
+
+    if (pInfo->numInputs == 1)
+    {
+      retVal = pInfo->unaryFunc(pxvTM, &inView[0], &outView);
+    }
+    else
+    {
+      retVal = pInfo->binaryFunc(pxvTM, &inView[0], &inView[1], &outView);
+    }
+    if (retVal == XVTM_ERROR)
+    {
+      return(XVTM_ERROR);
+    }
+  }
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvFreeTileGraph()
+ *
+ * DESCRIPTION:
+ *     Releases intermediate tiles of the graph and their buffers. Graph has
+ *     to be finalized again before it is executed.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTileGraph   *pGraph        Tile graph
+ *
+ * OUTPUTS:
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvFreeTileGraph(xvTileManager *pxvTM, xvTileGraph *pGraph)
+{
+  int32_t indn, retVal = XVTM_SUCCESS;
+  xvTile *pTile;
+
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+
+  if (pGraph == NULL)
+  {
+    pxvTM->errFlag = XV_ERROR_POINTER_NULL;
+    return(XVTM_ERROR);
+  }
+
+  for (indn = 0; indn < pGraph->numNodes; indn++)
+  {
+    pTile = pGraph->node[indn].pTile;
+    if (pTile != NULL)
+    {
+      if (xvFreeBuffer(pxvTM, XV_TILE_GET_BUFF_PTR(pTile)) == XVTM_ERROR)
+      {
+        retVal = XVTM_ERROR;
+      }
+      if (xvFreeTile(pxvTM, pTile) == XVTM_ERROR)
+      {
+        retVal = XVTM_ERROR;
+      }
+      pGraph->node[indn].pTile = NULL;
+    }
+  }
+  pGraph->finalized = 0;
+  return(retVal);
+}
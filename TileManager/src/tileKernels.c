@@ -0,0 +1,1463 @@
+/*
+ * Copyright (c) 2016 by Cadence Design Systems, Inc.  ALL RIGHTS RESERVED.
+ * These coded instructions, statements, and computer programs are the
+ * copyrighted works and confidential proprietary information of
+ * Cadence Design Systems Inc.  They may be adapted and modified by bona fide
+ * purchasers for internal use, but neither the original nor any adapted
+ * or modified version may be disclosed or distributed to third parties
+ * in any manner, medium, or form, in whole or in part, without the prior
+ * written consent of Cadence Design Systems Inc.  This software and its
+ * derivatives are to be executed solely on products incorporating a Cadence
+ * Design Systems processor.
+ */
+
+/**********************************************************************************
+ * FILE:  tileKernels.c
+ *
+ * DESCRIPTION:
+ *
+ *    This file contains image processing kernels operating on Tile Manager tiles.
+ *    Kernels read their neighbourhood from the tile edges, so input tiles have
+ *    to be created with edges at least as large as the kernel's halo.
+ *    Kernels are vectorized with IVP intrinsics on Vision cores, reference C
+ *    code is used elsewhere. Both produce bit exact results.
+ *
+ ********************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tileKernels.h"
+
+#ifdef XV_KERNEL_USE_IVP
+#include <xtensa/tie/xt_ivpn.h>
+#endif
+
+// Reciprocals used by box filters, result = (sum * recip + 2^16) >> 17.
+// Gives sum / area rounded to nearest for every 8 bit window sum.
+#define BOX_3X3_RECIP   14564
+#define BOX_5X5_RECIP   5243
+#define BOX_RECIP_SHIFT 17
+
+// Median of n (odd) values by forgetful selection. Only k + 2 values, where k = n / 2,
+// are kept in the working set. In every step minimum and maximum of the set are moved
+// to its ends and dropped, and next value is added. v[lo] holds the median at the end.
+#define MEDIAN_SELECT(v, n, SORT2)                       \
+  {                                                      \
+    int32_t lo = 0, hi = ((n) >> 1) + 1, next, ind;      \
+    next = hi + 1;                                       \
+    while (lo < hi)                                      \
+    {                                                    \
+      for (ind = lo + 1; ind <= hi; ind++)               \
+      {                                                  \
+        SORT2((v)[lo], (v)[ind]);                        \
+      }                                                  \
+      for (ind = lo + 1; ind < hi; ind++)                \
+      {                                                  \
+        SORT2((v)[ind], (v)[hi]);                        \
+      }                                                  \
+      lo++;                                              \
+      if (next < (n))                                    \
+      {                                                  \
+        (v)[hi] = (v)[next++];                           \
+      }                                                  \
+      else                                               \
+      {                                                  \
+        hi--;                                            \
+      }                                                  \
+    }                                                    \
+    if (lo != 0)                                         \
+    {                                                    \
+      (v)[0] = (v)[lo];                                  \
+    }                                                    \
+  }
+
+#define SORT2_S32(a, b)                   \
+  {                                       \
+    int32_t tmp = ((a) < (b)) ? (a) : (b); \
+    (b) = ((a) < (b)) ? (b) : (a);         \
+    (a) = tmp;                             \
+  }
+
+#ifdef XV_KERNEL_USE_IVP
+#define SORT2_VEC(a, b)                   \
+  {                                       \
+    xb_vecNx16 vecTmp = IVP_MINNX16(a, b); \
+    (b) = IVP_MAXNX16(a, b);               \
+    (a) = vecTmp;                          \
+  }
+#endif
+
+static const xvKernelInfo kernelInfoTable[XV_KERNEL_COUNT] =
+{
+  { "CopyU8",          xvCopyU8,          NULL,        1, XV_KERNEL_HALO_NONE, XV_KERNEL_HALO_NONE, XV_TILE_U8,  XV_TILE_U8  },
+  { "CopyU16",         xvCopyU16,         NULL,        1, XV_KERNEL_HALO_NONE, XV_KERNEL_HALO_NONE, XV_TILE_U16, XV_TILE_U16 },
+  { "BoxFilter3x3U8",  xvBoxFilter3x3U8,  NULL,        1, XV_KERNEL_HALO_3X3,  XV_KERNEL_HALO_3X3,  XV_TILE_U8,  XV_TILE_U8  },
+  { "BoxFilter5x5U8",  xvBoxFilter5x5U8,  NULL,        1, XV_KERNEL_HALO_5X5,  XV_KERNEL_HALO_5X5,  XV_TILE_U8,  XV_TILE_U8  },
+  { "Gaussian3x3U8",   xvGaussian3x3U8,   NULL,        1, XV_KERNEL_HALO_3X3,  XV_KERNEL_HALO_3X3,  XV_TILE_U8,  XV_TILE_U8  },
+  { "Gaussian5x5U8",   xvGaussian5x5U8,   NULL,        1, XV_KERNEL_HALO_5X5,  XV_KERNEL_HALO_5X5,  XV_TILE_U8,  XV_TILE_U8  },
+  { "SobelDx3x3U8S16", xvSobelDx3x3U8S16, NULL,        1, XV_KERNEL_HALO_3X3,  XV_KERNEL_HALO_3X3,  XV_TILE_U8,  XV_TILE_S16 },
+  { "SobelDy3x3U8S16", xvSobelDy3x3U8S16, NULL,        1, XV_KERNEL_HALO_3X3,  XV_KERNEL_HALO_3X3,  XV_TILE_U8,  XV_TILE_S16 },
+  { "SobelMag3x3U8",   xvSobelMag3x3U8,   NULL,        1, XV_KERNEL_HALO_3X3,  XV_KERNEL_HALO_3X3,  XV_TILE_U8,  XV_TILE_U8  },
+  { "Median3x3U8",     xvMedian3x3U8,     NULL,        1, XV_KERNEL_HALO_3X3,  XV_KERNEL_HALO_3X3,  XV_TILE_U8,  XV_TILE_U8  },
+  { "Median5x5U8",     xvMedian5x5U8,     NULL,        1, XV_KERNEL_HALO_5X5,  XV_KERNEL_HALO_5X5,  XV_TILE_U8,  XV_TILE_U8  },
+  { "Erode3x3U8",      xvErode3x3U8,      NULL,        1, XV_KERNEL_HALO_3X3,  XV_KERNEL_HALO_3X3,  XV_TILE_U8,  XV_TILE_U8  },
+  { "Erode5x5U8",      xvErode5x5U8,      NULL,        1, XV_KERNEL_HALO_5X5,  XV_KERNEL_HALO_5X5,  XV_TILE_U8,  XV_TILE_U8  },
+  { "Dilate3x3U8",     xvDilate3x3U8,     NULL,        1, XV_KERNEL_HALO_3X3,  XV_KERNEL_HALO_3X3,  XV_TILE_U8,  XV_TILE_U8  },
+  { "Dilate5x5U8",     xvDilate5x5U8,     NULL,        1, XV_KERNEL_HALO_5X5,  XV_KERNEL_HALO_5X5,  XV_TILE_U8,  XV_TILE_U8  },
+  { "AddU8",           NULL,              xvAddU8,     2, XV_KERNEL_HALO_NONE, XV_KERNEL_HALO_NONE, XV_TILE_U8,  XV_TILE_U8  },
+  { "SubU8",           NULL,              xvSubU8,     2, XV_KERNEL_HALO_NONE, XV_KERNEL_HALO_NONE, XV_TILE_U8,  XV_TILE_U8  },
+  { "AbsDiffU8",       NULL,              xvAbsDiffU8, 2, XV_KERNEL_HALO_NONE, XV_KERNEL_HALO_NONE, XV_TILE_U8,  XV_TILE_U8  },
+  { "AddS16",          NULL,              xvAddS16,    2, XV_KERNEL_HALO_NONE, XV_KERNEL_HALO_NONE, XV_TILE_S16, XV_TILE_S16 },
+  { "SubS16",          NULL,              xvSubS16,    2, XV_KERNEL_HALO_NONE, XV_KERNEL_HALO_NONE, XV_TILE_S16, XV_TILE_S16 },
+};
+
+/**********************************************************************************
+ * FUNCTION: checkKernelTiles()
+ *
+ * DESCRIPTION:
+ *     Validates input and output tiles of a kernel. Input tiles should cover
+ *     the output region and the halo around it. Input data beyond the output
+ *     width/height is counted towards the right and bottom halo.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM          Tile Manager object
+ *     xvTile        *pInTile0       First input tile
+ *     xvTile        *pInTile1       Second input tile, NULL for kernels with one input
+ *     xvTile        *pOutTile       Output tile
+ *     int32_t       halo            Halo needed in each direction
+ *     int32_t       inPelSize       Bytes per pixel of input tiles
+ *     int32_t       outPelSize      Bytes per pixel of output tile
+ *
+ * OUTPUTS:
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+static int32_t checkKernelTiles(xvTileManager *pxvTM, xvTile *pInTile0, xvTile *pInTile1, xvTile *pOutTile,
+                                int32_t halo, int32_t inPelSize, int32_t outPelSize)
+{
+  xvTile *pInTile;
+  int32_t indx;
+
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  if (pOutTile == NULL)
+  {
+    pxvTM->errFlag = XV_ERROR_TILE_NULL;
+    return(XVTM_ERROR);
+  }
+
+  if ((XV_TILE_GET_DATA_PTR(pOutTile) == NULL) || (XV_TILE_GET_ELEMENT_SIZE(pOutTile) != outPelSize))
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return(XVTM_ERROR);
+  }
+
+  for (indx = 0; indx < 2; indx++)
+  {
+    pInTile = (indx == 0) ? pInTile0 : pInTile1;
+    if (pInTile == NULL)
+    {
+      if (indx == 0)
+      {
+        pxvTM->errFlag = XV_ERROR_TILE_NULL;
+        return(XVTM_ERROR);
+      }
+      continue;
+    }
+
+    if ((XV_TILE_GET_DATA_PTR(pInTile) == NULL) || (XV_TILE_GET_ELEMENT_SIZE(pInTile) != inPelSize))
+    {
+      pxvTM->errFlag = XV_ERROR_BAD_ARG;
+      return(XVTM_ERROR);
+    }
+
+    if ((XV_TILE_GET_WIDTH(pInTile) < XV_TILE_GET_WIDTH(pOutTile)) ||
+        (XV_TILE_GET_HEIGHT(pInTile) < XV_TILE_GET_HEIGHT(pOutTile)))
+    {
+      pxvTM->errFlag = XV_ERROR_DIMENSION_MISMATCH;
+      return(XVTM_ERROR);
+    }
+
+    if ((XV_TILE_GET_EDGE_LEFT(pInTile) < halo) || (XV_TILE_GET_EDGE_TOP(pInTile) < halo) ||
+        ((XV_TILE_GET_EDGE_RIGHT(pInTile) + XV_TILE_GET_WIDTH(pInTile) - XV_TILE_GET_WIDTH(pOutTile)) < halo) ||
+        ((XV_TILE_GET_EDGE_BOTTOM(pInTile) + XV_TILE_GET_HEIGHT(pInTile) - XV_TILE_GET_HEIGHT(pOutTile)) < halo))
+    {
+      pxvTM->errFlag = XV_ERROR_BAD_ARG;
+      return(XVTM_ERROR);
+    }
+  }
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvGetKernelInfo()
+ *
+ * DESCRIPTION:
+ *     Returns the description of a kernel: function, number of inputs, halo
+ *     and tile types.
+ *
+ * INPUTS:
+ *     int32_t       kernelId       xvKernelId_t value
+ *
+ * OUTPUTS:
+ *     Returns pointer to kernel description, NULL if kernelId is not valid
+ *
+ ********************************************************************************** */
+
+const xvKernelInfo *xvGetKernelInfo(int32_t kernelId)
+{
+  if ((kernelId < 0) || (kernelId >= XV_KERNEL_COUNT))
+  {
+    return(NULL);
+  }
+  return(&kernelInfoTable[kernelId]);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvGetHaloTileBuffSize()
+ *
+ * DESCRIPTION:
+ *     Computes pitch and buffer size of a tile with equal edges on all sides.
+ *     Pitch is rounded up to a multiple of 32 pixels.
+ *
+ * INPUTS:
+ *     int32_t       width          Width of tile
+ *     int32_t       height         Height of tile
+ *     int32_t       edge           Edge width and height of tile
+ *     int32_t       pelSize        Bytes per pixel
+ *     int32_t       alignType      Alignment type of the tile
+ *
+ * OUTPUTS:
+ *     int32_t       *pPitch        Pitch of the tile in pixels
+ *     Returns buffer size in bytes. Returns XVTM_ERROR if arguments are not valid
+ *
+ ********************************************************************************** */
+
+int32_t xvGetHaloTileBuffSize(int32_t width, int32_t height, int32_t edge, int32_t pelSize, int32_t alignType, int32_t *pPitch)
+{
+  int32_t pitch, buffSize;
+
+  if ((pPitch == NULL) || (width <= 0) || (height <= 0) || (edge < 0) || (pelSize <= 0))
+  {
+    return(XVTM_ERROR);
+  }
+
+  pitch = width + 2 * edge;
+  // Keep rows vector aligned
+  pitch    = (pitch + IVP_ALIGNMENT) & ~IVP_ALIGNMENT;
+  buffSize = pitch * (height + 2 * edge) * pelSize;
+  if ((alignType == DATA_ALIGNED_32) || (alignType == DATA_ALIGNED_64))
+  {
+    // Data pointer may be moved forward by up to 63 bytes
+    buffSize += 64;
+  }
+
+  *pPitch = pitch;
+  return(buffSize);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvGetKernelTileBuffSize()
+ *
+ * DESCRIPTION:
+ *     Computes pitch and buffer size of an input tile whose edges are sized
+ *     for the halo of the given kernel.
+ *
+ * INPUTS:
+ *     int32_t       kernelId       xvKernelId_t value
+ *     int32_t       width          Width of output region
+ *     int32_t       height         Height of output region
+ *     int32_t       alignType      Alignment type of the tile
+ *
+ * OUTPUTS:
+ *     int32_t       *pPitch        Pitch of the tile in pixels
+ *     Returns buffer size in bytes. Returns XVTM_ERROR if arguments are not valid
+ *
+ ********************************************************************************** */
+
+int32_t xvGetKernelTileBuffSize(int32_t kernelId, int32_t width, int32_t height, int32_t alignType, int32_t *pPitch)
+{
+  const xvKernelInfo *pInfo = xvGetKernelInfo(kernelId);
+
+  if (pInfo == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+  return(xvGetHaloTileBuffSize(width, height, pInfo->haloWidth, XV_TYPE_ELEMENT_SIZE(pInfo->inType), alignType, pPitch));
+}
+
+/**********************************************************************************
+ * FUNCTION: xvCreateKernelTile()
+ *
+ * DESCRIPTION:
+ *     Allocates an input tile and its buffer for a kernel. Edges of the tile
+ *     are set to the halo of the kernel.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     int32_t       kernelId       xvKernelId_t value
+ *     int32_t       width          Width of tile
+ *     int32_t       height         Height of tile
+ *     int32_t       color          Memory pool from which the buffer should be allocated
+ *     xvFrame       *pFrame        Frame associated with the tile
+ *     int32_t       alignType      Alignment type of tile
+ *
+ * OUTPUTS:
+ *     Returns the pointer to allocated tile.
+ *     Returns ((xvTile *)(XVTM_ERROR)) if it encounters an error.
+ *
+ ********************************************************************************** */
+
+xvTile *xvCreateKernelTile(xvTileManager *pxvTM, int32_t kernelId, int32_t width, int32_t height, int32_t color, xvFrame *pFrame, int32_t alignType)
+{
+  const xvKernelInfo *pInfo;
+  int32_t pitch, buffSize;
+
+  if (pxvTM == NULL)
+  {
+    return((xvTile *) XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  pInfo    = xvGetKernelInfo(kernelId);
+  buffSize = xvGetKernelTileBuffSize(kernelId, width, height, alignType, &pitch);
+  if ((pInfo == NULL) || (buffSize == XVTM_ERROR))
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return((xvTile *) XVTM_ERROR);
+  }
+
+  return(xvCreateTile(pxvTM, buffSize, width, height, pitch, pInfo->haloWidth, pInfo->haloHeight,
+                      color, pFrame, pInfo->inType, alignType));
+}
+
+/**********************************************************************************
+ * FUNCTION: copyTileRows()
+ *
+ * DESCRIPTION:
+ *     Copies rows of a tile region
+ *
+ * INPUTS:
+ *     uint8_t       *pSrc          Source data
+ *     uint8_t       *pDst          Destination data
+ *     int32_t       widthBytes     Number of bytes in a row
+ *     int32_t       height         Number of rows
+ *     int32_t       srcPitchBytes  Source pitch in bytes
+ *     int32_t       dstPitchBytes  Destination pitch in bytes
+ *
+ * OUTPUTS:
+ *     None
+ *
+ ********************************************************************************** */
+
+static void copyTileRows(uint8_t * __restrict pSrc, uint8_t * __restrict pDst, int32_t widthBytes, int32_t height,
+                         int32_t srcPitchBytes, int32_t dstPitchBytes)
+{
+  int32_t indy;
+#ifdef XV_KERNEL_USE_IVP
+  int32_t wb;
+  xb_vec2Nx8U dvec1, * __restrict pdvecSrc, * __restrict pdvecDst;
+  valign vas1, val1;
+
+  for (indy = 0; indy < height; indy++)
+  {
+    pdvecSrc = (xb_vec2Nx8U *) (pSrc + indy * srcPitchBytes);
+    pdvecDst = (xb_vec2Nx8U *) (pDst + indy * dstPitchBytes);
+    val1     = IVP_LA2NX8U_PP(pdvecSrc);
+    vas1     = IVP_ZALIGN();
+    for (wb = widthBytes; wb > 0; wb -= (2 * IVP_SIMD_WIDTH))
+    {
+      IVP_LAV2NX8U_XP(dvec1, val1, pdvecSrc, wb);
+      IVP_SAV2NX8U_XP(dvec1, vas1, pdvecDst, wb);
+    }
+    IVP_SAPOS2NX8U_FP(vas1, pdvecDst);
+  }
+#else
+  for (indy = 0; indy < height; indy++)
+  {
+    memcpy(pDst + indy * dstPitchBytes, pSrc + indy * srcPitchBytes, widthBytes);
+  }
+#endif
+}
+
+/**********************************************************************************
+ * FUNCTION: xvCopyU8()
+ *
+ * DESCRIPTION:
+ *     Copies 8 bit input tile data into output tile
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       Input tile
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvCopyU8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile)
+{
+  if (checkKernelTiles(pxvTM, pInTile, NULL, pOutTile, 0, 1, 1) == XVTM_ERROR)
+  {
+    return(XVTM_ERROR);
+  }
+
+  copyTileRows((uint8_t *) XV_TILE_GET_DATA_PTR(pInTile), (uint8_t *) XV_TILE_GET_DATA_PTR(pOutTile),
+               XV_TILE_GET_WIDTH(pOutTile), XV_TILE_GET_HEIGHT(pOutTile), XV_TILE_GET_PITCH(pInTile), XV_TILE_GET_PITCH(pOutTile));
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvCopyU16()
+ *
+ * DESCRIPTION:
+ *     Copies 16 bit input tile data into output tile
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       Input tile
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvCopyU16(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile)
+{
+  if (checkKernelTiles(pxvTM, pInTile, NULL, pOutTile, 0, 2, 2) == XVTM_ERROR)
+  {
+    return(XVTM_ERROR);
+  }
+
+  copyTileRows((uint8_t *) XV_TILE_GET_DATA_PTR(pInTile), (uint8_t *) XV_TILE_GET_DATA_PTR(pOutTile),
+               XV_TILE_GET_WIDTH(pOutTile) * 2, XV_TILE_GET_HEIGHT(pOutTile), XV_TILE_GET_PITCH(pInTile) * 2, XV_TILE_GET_PITCH(pOutTile) * 2);
+  return(XVTM_SUCCESS);
+}
+
+#ifdef XV_KERNEL_USE_IVP
+// Loads N 8 bit pixels from an unaligned address and widens them to 16 bit
+static inline xb_vecNx16 loadNx8U(const uint8_t *pSrc)
+{
+  xb_vecNx8U *pvecSrc = (xb_vecNx8U *) pSrc;
+  xb_vecNx16 vecOut;
+  valign vaSrc = IVP_LANX8U_PP(pvecSrc);
+  IVP_LANX8U_IP(vecOut, vaSrc, pvecSrc);
+  return(vecOut);
+}
+
+// Loads N 16 bit pixels from an unaligned address
+static inline xb_vecNx16 loadNx16(const int16_t *pSrc)
+{
+  xb_vecNx16 *pvecSrc = (xb_vecNx16 *) pSrc;
+  xb_vecNx16 vecOut;
+  valign vaSrc = IVP_LANX16_PP(pvecSrc);
+  IVP_LANX16_IP(vecOut, vaSrc, pvecSrc);
+  return(vecOut);
+}
+
+// Loads (2 * radius + 1)^2 neighbourhood of N pixels, row by row
+static inline void loadWindowNx8U(xb_vecNx16 *pvecWin, const uint8_t *pSrc, int32_t pitch, int32_t radius)
+{
+  int32_t dx, dy, ind = 0;
+  for (dy = -radius; dy <= radius; dy++)
+  {
+    for (dx = -radius; dx <= radius; dx++)
+    {
+      pvecWin[ind++] = loadNx8U(pSrc + dy * pitch + dx);
+    }
+  }
+}
+#endif
+
+// Reference code window loader, same ordering as loadWindowNx8U
+static inline void loadWindowU8(int32_t *pWin, const uint8_t *pSrc, int32_t pitch, int32_t radius)
+{
+  int32_t dx, dy, ind = 0;
+  for (dy = -radius; dy <= radius; dy++)
+  {
+    for (dx = -radius; dx <= radius; dx++)
+    {
+      pWin[ind++] = pSrc[dy * pitch + dx];
+    }
+  }
+}
+
+/**********************************************************************************
+ * FUNCTION: boxFilterU8()
+ *
+ * DESCRIPTION:
+ *     Box filter with square window. Sum of the window is scaled with a
+ *     reciprocal of the window area and rounded.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       Input tile
+ *     int32_t       radius         Window radius, 1 or 2
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+static int32_t boxFilterU8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile, int32_t radius)
+{
+  int32_t indx, indy, dx, dy, width, height, srcPitch, dstPitch, recip;
+  uint8_t *pSrc, *pDst;
+
+  if (checkKernelTiles(pxvTM, pInTile, NULL, pOutTile, radius, 1, 1) == XVTM_ERROR)
+  {
+    return(XVTM_ERROR);
+  }
+
+  width    = XV_TILE_GET_WIDTH(pOutTile);
+  height   = XV_TILE_GET_HEIGHT(pOutTile);
+  srcPitch = XV_TILE_GET_PITCH(pInTile);
+  dstPitch = XV_TILE_GET_PITCH(pOutTile);
+  pSrc     = (uint8_t *) XV_TILE_GET_DATA_PTR(pInTile);
+  pDst     = (uint8_t *) XV_TILE_GET_DATA_PTR(pOutTile);
+  recip    = (radius == 1) ? BOX_3X3_RECIP : BOX_5X5_RECIP;
+
+#ifdef XV_KERNEL_USE_IVP
+  xb_vecNx16 vecSum, vecRecip = recip;
+  xb_vecNx48 accSum;
+  xb_vecNx8U * __restrict pvecDst;
+  valign vaDst;
+
+  for (indy = 0; indy < height; indy++)
+  {
+    pvecDst = (xb_vecNx8U *) (pDst + indy * dstPitch);
+    vaDst   = IVP_ZALIGN();
+    for (indx = 0; indx < width; indx += IVP_SIMD_WIDTH)
+    {
+      uint8_t *pIn = pSrc + indy * srcPitch + indx;
+      vecSum = 0;
+      for (dy = -radius; dy <= radius; dy++)
+      {
+        for (dx = -radius; dx <= radius; dx++)
+        {
+          vecSum = IVP_ADDNX16(vecSum, loadNx8U(pIn + dy * srcPitch + dx));
+        }
+      }
+      accSum = IVP_MULNX16(vecSum, vecRecip);
+      IVP_SAVNX8U_XP(IVP_PACKVRNX48(accSum, BOX_RECIP_SHIFT), vaDst, pvecDst, width - indx);
+    }
+    IVP_SAPOSNX8U_FP(vaDst, pvecDst);
+  }
+#else
+  for (indy = 0; indy < height; indy++)
+  {
+    for (indx = 0; indx < width; indx++)
+    {
+      uint8_t *pIn = pSrc + indy * srcPitch + indx;
+      int32_t sum  = 0;
+      for (dy = -radius; dy <= radius; dy++)
+      {
+        for (dx = -radius; dx <= radius; dx++)
+        {
+          sum += pIn[dy * srcPitch + dx];
+        }
+      }
+      pDst[indy * dstPitch + indx] = (uint8_t) ((sum * recip + (1 << (BOX_RECIP_SHIFT - 1))) >> BOX_RECIP_SHIFT);
+    }
+  }
+#endif
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvBoxFilter3x3U8()
+ *
+ * DESCRIPTION:
+ *     3x3 box filter on 8 bit tile
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       Input tile, edges >= 1
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvBoxFilter3x3U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile)
+{
+  return(boxFilterU8(pxvTM, pInTile, pOutTile, 1));
+}
+
+/**********************************************************************************
+ * FUNCTION: xvBoxFilter5x5U8()
+ *
+ * DESCRIPTION:
+ *     5x5 box filter on 8 bit tile
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       Input tile, edges >= 2
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvBoxFilter5x5U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile)
+{
+  return(boxFilterU8(pxvTM, pInTile, pOutTile, 2));
+}
+
+/**********************************************************************************
+ * FUNCTION: xvGaussian3x3U8()
+ *
+ * DESCRIPTION:
+ *     3x3 Gaussian filter on 8 bit tile. Coefficients are [1 2 1]' * [1 2 1] / 16
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       Input tile, edges >= 1
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvGaussian3x3U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile)
+{
+  int32_t indx, indy, dy, width, height, srcPitch, dstPitch;
+  uint8_t *pSrc, *pDst;
+
+  if (checkKernelTiles(pxvTM, pInTile, NULL, pOutTile, 1, 1, 1) == XVTM_ERROR)
+  {
+    return(XVTM_ERROR);
+  }
+
+  width    = XV_TILE_GET_WIDTH(pOutTile);
+  height   = XV_TILE_GET_HEIGHT(pOutTile);
+  srcPitch = XV_TILE_GET_PITCH(pInTile);
+  dstPitch = XV_TILE_GET_PITCH(pOutTile);
+  pSrc     = (uint8_t *) XV_TILE_GET_DATA_PTR(pInTile);
+  pDst     = (uint8_t *) XV_TILE_GET_DATA_PTR(pOutTile);
+
+#ifdef XV_KERNEL_USE_IVP
+  xb_vecNx16 vecRow[3], vecSum;
+  xb_vecNx8U * __restrict pvecDst;
+  valign vaDst;
+
+  for (indy = 0; indy < height; indy++)
+  {
+    pvecDst = (xb_vecNx8U *) (pDst + indy * dstPitch);
+    vaDst   = IVP_ZALIGN();
+    for (indx = 0; indx < width; indx += IVP_SIMD_WIDTH)
+    {
+      uint8_t *pIn = pSrc + indy * srcPitch + indx;
+      for (dy = 0; dy < 3; dy++)
+      {
+        uint8_t *pRow = pIn + (dy - 1) * srcPitch;
+        vecRow[dy] = IVP_ADDNX16(IVP_ADDNX16(loadNx8U(pRow - 1), loadNx8U(pRow + 1)), IVP_SLLINX16(loadNx8U(pRow), 1));
+      }
+      vecSum = IVP_ADDNX16(IVP_ADDNX16(vecRow[0], vecRow[2]), IVP_SLLINX16(vecRow[1], 1));
+      vecSum = IVP_SRAINX16(IVP_ADDNX16(vecSum, 8), 4);
+      IVP_SAVNX8U_XP(vecSum, vaDst, pvecDst, width - indx);
+    }
+    IVP_SAPOSNX8U_FP(vaDst, pvecDst);
+  }
+#else
+  for (indy = 0; indy < height; indy++)
+  {
+    for (indx = 0; indx < width; indx++)
+    {
+      uint8_t *pIn = pSrc + indy * srcPitch + indx;
+      int32_t row[3], sum;
+      for (dy = 0; dy < 3; dy++)
+      {
+        uint8_t *pRow = pIn + (dy - 1) * srcPitch;
+        row[dy] = pRow[-1] + 2 * pRow[0] + pRow[1];
+      }
+      sum = row[0] + 2 * row[1] + row[2];
+      pDst[indy * dstPitch + indx] = (uint8_t) ((sum + 8) >> 4);
+    }
+  }
+#endif
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvGaussian5x5U8()
+ *
+ * DESCRIPTION:
+ *     5x5 Gaussian filter on 8 bit tile. Coefficients are [1 4 6 4 1]' * [1 4 6 4 1] / 256
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       Input tile, edges >= 2
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvGaussian5x5U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile)
+{
+  int32_t indx, indy, dy, width, height, srcPitch, dstPitch;
+  uint8_t *pSrc, *pDst;
+
+  if (checkKernelTiles(pxvTM, pInTile, NULL, pOutTile, 2, 1, 1) == XVTM_ERROR)
+  {
+    return(XVTM_ERROR);
+  }
+
+  width    = XV_TILE_GET_WIDTH(pOutTile);
+  height   = XV_TILE_GET_HEIGHT(pOutTile);
+  srcPitch = XV_TILE_GET_PITCH(pInTile);
+  dstPitch = XV_TILE_GET_PITCH(pOutTile);
+  pSrc     = (uint8_t *) XV_TILE_GET_DATA_PTR(pInTile);
+  pDst     = (uint8_t *) XV_TILE_GET_DATA_PTR(pOutTile);
+
+#ifdef XV_KERNEL_USE_IVP
+  xb_vecNx16 vecRow[5], vecOne = 1, vecFour = 4, vecSix = 6;
+  xb_vecNx48 accSum;
+  xb_vecNx8U * __restrict pvecDst;
+  valign vaDst;
+
+  for (indy = 0; indy < height; indy++)
+  {
+    pvecDst = (xb_vecNx8U *) (pDst + indy * dstPitch);
+    vaDst   = IVP_ZALIGN();
+    for (indx = 0; indx < width; indx += IVP_SIMD_WIDTH)
+    {
+      uint8_t *pIn = pSrc + indy * srcPitch + indx;
+      // Horizontal pass fits in 16 bit, vertical pass is accumulated in 48 bit
+      for (dy = 0; dy < 5; dy++)
+      {
+        uint8_t *pRow = pIn + (dy - 2) * srcPitch;
+        xb_vecNx16 vecC = loadNx8U(pRow);
+        vecRow[dy] = IVP_ADDNX16(loadNx8U(pRow - 2), loadNx8U(pRow + 2));
+        vecRow[dy] = IVP_ADDNX16(vecRow[dy], IVP_SLLINX16(IVP_ADDNX16(loadNx8U(pRow - 1), loadNx8U(pRow + 1)), 2));
+        vecRow[dy] = IVP_ADDNX16(vecRow[dy], IVP_ADDNX16(IVP_SLLINX16(vecC, 2), IVP_SLLINX16(vecC, 1)));
+      }
+      accSum = IVP_MULNX16(IVP_ADDNX16(vecRow[0], vecRow[4]), vecOne);
+      IVP_MULANX16(accSum, IVP_ADDNX16(vecRow[1], vecRow[3]), vecFour);
+      IVP_MULANX16(accSum, vecRow[2], vecSix);
+      IVP_SAVNX8U_XP(IVP_PACKVRNX48(accSum, 8), vaDst, pvecDst, width - indx);
+    }
+    IVP_SAPOSNX8U_FP(vaDst, pvecDst);
+  }
+#else
+  for (indy = 0; indy < height; indy++)
+  {
+    for (indx = 0; indx < width; indx++)
+    {
+      uint8_t *pIn = pSrc + indy * srcPitch + indx;
+      int32_t row[5], sum;
+      for (dy = 0; dy < 5; dy++)
+      {
+        uint8_t *pRow = pIn + (dy - 2) * srcPitch;
+        row[dy] = pRow[-2] + 4 * pRow[-1] + 6 * pRow[0] + 4 * pRow[1] + pRow[2];
+      }
+      sum = row[0] + 4 * row[1] + 6 * row[2] + 4 * row[3] + row[4];
+      pDst[indy * dstPitch + indx] = (uint8_t) ((sum + 128) >> 8);
+    }
+  }
+#endif
+  return(XVTM_SUCCESS);
+}
+
+// Sobel kernel selection
+#define SOBEL_DX   0
+#define SOBEL_DY   1
+#define SOBEL_MAG  2
+
+/**********************************************************************************
+ * FUNCTION: sobel3x3U8()
+ *
+ * DESCRIPTION:
+ *     3x3 Sobel gradients. dx and dy are written as 16 bit values,
+ *     magnitude |dx| + |dy| is saturated to 8 bit.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       Input tile, edges >= 1
+ *     int32_t       mode           SOBEL_DX, SOBEL_DY or SOBEL_MAG
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+static int32_t sobel3x3U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile, int32_t mode)
+{
+  int32_t indx, indy, width, height, srcPitch, dstPitch;
+  uint8_t *pSrc, *pDst;
+
+  if (checkKernelTiles(pxvTM, pInTile, NULL, pOutTile, 1, 1, (mode == SOBEL_MAG) ? 1 : 2) == XVTM_ERROR)
+  {
+    return(XVTM_ERROR);
+  }
+
+  width    = XV_TILE_GET_WIDTH(pOutTile);
+  height   = XV_TILE_GET_HEIGHT(pOutTile);
+  srcPitch = XV_TILE_GET_PITCH(pInTile);
+  dstPitch = XV_TILE_GET_PITCH(pOutTile);
+  pSrc     = (uint8_t *) XV_TILE_GET_DATA_PTR(pInTile);
+  pDst     = (uint8_t *) XV_TILE_GET_DATA_PTR(pOutTile);
+
+#ifdef XV_KERNEL_USE_IVP
+  xb_vecNx16 vecWin[9], vecDx, vecDy, vecOut, vecMax = 255;
+  xb_vecNx16 * __restrict pvecDst16;
+  xb_vecNx8U * __restrict pvecDst8;
+  valign vaDst;
+
+  for (indy = 0; indy < height; indy++)
+  {
+    pvecDst16 = (xb_vecNx16 *) ((int16_t *) pDst + indy * dstPitch);
+    pvecDst8  = (xb_vecNx8U *) (pDst + indy * dstPitch);
+    vaDst     = IVP_ZALIGN();
+    for (indx = 0; indx < width; indx += IVP_SIMD_WIDTH)
+    {
+      loadWindowNx8U(vecWin, pSrc + indy * srcPitch + indx, srcPitch, 1);
+      vecDx = IVP_ADDNX16(IVP_SUBNX16(vecWin[2], vecWin[0]), IVP_SUBNX16(vecWin[8], vecWin[6]));
+      vecDx = IVP_ADDNX16(vecDx, IVP_SLLINX16(IVP_SUBNX16(vecWin[5], vecWin[3]), 1));
+      vecDy = IVP_ADDNX16(IVP_SUBNX16(vecWin[6], vecWin[0]), IVP_SUBNX16(vecWin[8], vecWin[2]));
+      vecDy = IVP_ADDNX16(vecDy, IVP_SLLINX16(IVP_SUBNX16(vecWin[7], vecWin[1]), 1));
+      if (mode == SOBEL_MAG)
+      {
+        vecOut = IVP_MINNX16(IVP_ADDNX16(IVP_ABSNX16(vecDx), IVP_ABSNX16(vecDy)), vecMax);
+        IVP_SAVNX8U_XP(vecOut, vaDst, pvecDst8, width - indx);
+      }
+      else
+      {
+        vecOut = (mode == SOBEL_DX) ? vecDx : vecDy;
+        IVP_SAVNX16_XP(vecOut, vaDst, pvecDst16, 2 * (width - indx));
+      }
+    }
+    if (mode == SOBEL_MAG)
+    {
+      IVP_SAPOSNX8U_FP(vaDst, pvecDst8);
+    }
+    else
+    {
+      IVP_SAPOSNX16_FP(vaDst, pvecDst16);
+    }
+  }
+#else
+  int32_t win[9], dx, dy, mag;
+  for (indy = 0; indy < height; indy++)
+  {
+    for (indx = 0; indx < width; indx++)
+    {
+      loadWindowU8(win, pSrc + indy * srcPitch + indx, srcPitch, 1);
+      dx = (win[2] - win[0]) + (win[8] - win[6]) + 2 * (win[5] - win[3]);
+      dy = (win[6] - win[0]) + (win[8] - win[2]) + 2 * (win[7] - win[1]);
+      if (mode == SOBEL_MAG)
+      {
+        mag = abs(dx) + abs(dy);
+        pDst[indy * dstPitch + indx] = (uint8_t) ((mag > 255) ? 255 : mag);
+      }
+      else
+      {
+        ((int16_t *) pDst)[indy * dstPitch + indx] = (int16_t) ((mode == SOBEL_DX) ? dx : dy);
+      }
+    }
+  }
+#endif
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvSobelDx3x3U8S16()
+ *
+ * DESCRIPTION:
+ *     3x3 Sobel horizontal gradient
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       8 bit input tile, edges >= 1
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      16 bit output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvSobelDx3x3U8S16(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile)
+{
+  return(sobel3x3U8(pxvTM, pInTile, pOutTile, SOBEL_DX));
+}
+
+/**********************************************************************************
+ * FUNCTION: xvSobelDy3x3U8S16()
+ *
+ * DESCRIPTION:
+ *     3x3 Sobel vertical gradient
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       8 bit input tile, edges >= 1
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      16 bit output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvSobelDy3x3U8S16(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile)
+{
+  return(sobel3x3U8(pxvTM, pInTile, pOutTile, SOBEL_DY));
+}
+
+/**********************************************************************************
+ * FUNCTION: xvSobelMag3x3U8()
+ *
+ * DESCRIPTION:
+ *     3x3 Sobel gradient magnitude, |dx| + |dy| saturated to 255
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       Input tile, edges >= 1
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvSobelMag3x3U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile)
+{
+  return(sobel3x3U8(pxvTM, pInTile, pOutTile, SOBEL_MAG));
+}
+
+// Window reduction selection
+#define WINDOW_MEDIAN  0
+#define WINDOW_MIN     1
+#define WINDOW_MAX     2
+
+/**********************************************************************************
+ * FUNCTION: windowFilterU8()
+ *
+ * DESCRIPTION:
+ *     Non linear square window filters: median, minimum (erosion) and
+ *     maximum (dilation)
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       Input tile
+ *     int32_t       radius         Window radius, 1 or 2
+ *     int32_t       mode           WINDOW_MEDIAN, WINDOW_MIN or WINDOW_MAX
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+static int32_t windowFilterU8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile, int32_t radius, int32_t mode)
+{
+  int32_t indx, indy, ind, numTaps, width, height, srcPitch, dstPitch;
+  uint8_t *pSrc, *pDst;
+
+  if (checkKernelTiles(pxvTM, pInTile, NULL, pOutTile, radius, 1, 1) == XVTM_ERROR)
+  {
+    return(XVTM_ERROR);
+  }
+
+  width    = XV_TILE_GET_WIDTH(pOutTile);
+  height   = XV_TILE_GET_HEIGHT(pOutTile);
+  srcPitch = XV_TILE_GET_PITCH(pInTile);
+  dstPitch = XV_TILE_GET_PITCH(pOutTile);
+  pSrc     = (uint8_t *) XV_TILE_GET_DATA_PTR(pInTile);
+  pDst     = (uint8_t *) XV_TILE_GET_DATA_PTR(pOutTile);
+  numTaps  = (2 * radius + 1) * (2 * radius + 1);
+
+#ifdef XV_KERNEL_USE_IVP
+  xb_vecNx16 vecWin[25], vecOut;
+  xb_vecNx8U * __restrict pvecDst;
+  valign vaDst;
+
+  for (indy = 0; indy < height; indy++)
+  {
+    pvecDst = (xb_vecNx8U *) (pDst + indy * dstPitch);
+    vaDst   = IVP_ZALIGN();
+    for (indx = 0; indx < width; indx += IVP_SIMD_WIDTH)
+    {
+      loadWindowNx8U(vecWin, pSrc + indy * srcPitch + indx, srcPitch, radius);
+      if (mode == WINDOW_MEDIAN)
+      {
+        MEDIAN_SELECT(vecWin, numTaps, SORT2_VEC);
+        vecOut = vecWin[0];
+      }
+      else
+      {
+        vecOut = vecWin[0];
+        for (ind = 1; ind < numTaps; ind++)
+        {
+          vecOut = (mode == WINDOW_MIN) ? IVP_MINNX16(vecOut, vecWin[ind]) : IVP_MAXNX16(vecOut, vecWin[ind]);
+        }
+      }
+      IVP_SAVNX8U_XP(vecOut, vaDst, pvecDst, width - indx);
+    }
+    IVP_SAPOSNX8U_FP(vaDst, pvecDst);
+  }
+#else
+  int32_t win[25], out;
+  for (indy = 0; indy < height; indy++)
+  {
+    for (indx = 0; indx < width; indx++)
+    {
+      loadWindowU8(win, pSrc + indy * srcPitch + indx, srcPitch, radius);
+      if (mode == WINDOW_MEDIAN)
+      {
+        MEDIAN_SELECT(win, numTaps, SORT2_S32);
+        out = win[0];
+      }
+      else
+      {
+        out = win[0];
+        for (ind = 1; ind < numTaps; ind++)
+        {
+          if (mode == WINDOW_MIN)
+          {
+            out = (win[ind] < out) ? win[ind] : out;
+          }
+          else
+          {
+            out = (win[ind] > out) ? win[ind] : out;
+          }
+        }
+      }
+      pDst[indy * dstPitch + indx] = (uint8_t) out;
+    }
+  }
+#endif
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvMedian3x3U8()
+ *
+ * DESCRIPTION:
+ *     3x3 median filter on 8 bit tile
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       Input tile, edges >= 1
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvMedian3x3U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile)
+{
+  return(windowFilterU8(pxvTM, pInTile, pOutTile, 1, WINDOW_MEDIAN));
+}
+
+/**********************************************************************************
+ * FUNCTION: xvMedian5x5U8()
+ *
+ * DESCRIPTION:
+ *     5x5 median filter on 8 bit tile
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       Input tile, edges >= 2
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvMedian5x5U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile)
+{
+  return(windowFilterU8(pxvTM, pInTile, pOutTile, 2, WINDOW_MEDIAN));
+}
+
+/**********************************************************************************
+ * FUNCTION: xvErode3x3U8()
+ *
+ * DESCRIPTION:
+ *     Erosion with 3x3 square structuring element on 8 bit tile
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       Input tile, edges >= 1
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvErode3x3U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile)
+{
+  return(windowFilterU8(pxvTM, pInTile, pOutTile, 1, WINDOW_MIN));
+}
+
+/**********************************************************************************
+ * FUNCTION: xvErode5x5U8()
+ *
+ * DESCRIPTION:
+ *     Erosion with 5x5 square structuring element on 8 bit tile
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       Input tile, edges >= 2
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvErode5x5U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile)
+{
+  return(windowFilterU8(pxvTM, pInTile, pOutTile, 2, WINDOW_MIN));
+}
+
+/**********************************************************************************
+ * FUNCTION: xvDilate3x3U8()
+ *
+ * DESCRIPTION:
+ *     Dilation with 3x3 square structuring element on 8 bit tile
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       Input tile, edges >= 1
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvDilate3x3U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile)
+{
+  return(windowFilterU8(pxvTM, pInTile, pOutTile, 1, WINDOW_MAX));
+}
+
+/**********************************************************************************
+ * FUNCTION: xvDilate5x5U8()
+ *
+ * DESCRIPTION:
+ *     Dilation with 5x5 square structuring element on 8 bit tile
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile       Input tile, edges >= 2
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvDilate5x5U8(xvTileManager *pxvTM, xvTile *pInTile, xvTile *pOutTile)
+{
+  return(windowFilterU8(pxvTM, pInTile, pOutTile, 2, WINDOW_MAX));
+}
+
+// Arithmetic operation selection
+#define ARITH_ADD      0
+#define ARITH_SUB      1
+#define ARITH_ABSDIFF  2
+
+/**********************************************************************************
+ * FUNCTION: arithU8()
+ *
+ * DESCRIPTION:
+ *     Pixel wise saturating arithmetic on 8 bit tiles
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile0      First input tile
+ *     xvTile        *pInTile1      Second input tile
+ *     int32_t       op             ARITH_ADD, ARITH_SUB or ARITH_ABSDIFF
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+static int32_t arithU8(xvTileManager *pxvTM, xvTile *pInTile0, xvTile *pInTile1, xvTile *pOutTile, int32_t op)
+{
+  int32_t indx, indy, width, height, src0Pitch, src1Pitch, dstPitch;
+  uint8_t *pSrc0, *pSrc1, *pDst;
+
+  if ((pInTile1 == NULL) && (pxvTM != NULL))
+  {
+    pxvTM->errFlag = XV_ERROR_TILE_NULL;
+    return(XVTM_ERROR);
+  }
+  if (checkKernelTiles(pxvTM, pInTile0, pInTile1, pOutTile, 0, 1, 1) == XVTM_ERROR)
+  {
+    return(XVTM_ERROR);
+  }
+
+  width     = XV_TILE_GET_WIDTH(pOutTile);
+  height    = XV_TILE_GET_HEIGHT(pOutTile);
+  src0Pitch = XV_TILE_GET_PITCH(pInTile0);
+  src1Pitch = XV_TILE_GET_PITCH(pInTile1);
+  dstPitch  = XV_TILE_GET_PITCH(pOutTile);
+  pSrc0     = (uint8_t *) XV_TILE_GET_DATA_PTR(pInTile0);
+  pSrc1     = (uint8_t *) XV_TILE_GET_DATA_PTR(pInTile1);
+  pDst      = (uint8_t *) XV_TILE_GET_DATA_PTR(pOutTile);
+
+#ifdef XV_KERNEL_USE_IVP
+  xb_vecNx16 vecA, vecB, vecOut, vecZero = 0, vecMax = 255;
+  xb_vecNx8U * __restrict pvecDst;
+  valign vaDst;
+
+  for (indy = 0; indy < height; indy++)
+  {
+    pvecDst = (xb_vecNx8U *) (pDst + indy * dstPitch);
+    vaDst   = IVP_ZALIGN();
+    for (indx = 0; indx < width; indx += IVP_SIMD_WIDTH)
+    {
+      vecA = loadNx8U(pSrc0 + indy * src0Pitch + indx);
+      vecB = loadNx8U(pSrc1 + indy * src1Pitch + indx);
+      if (op == ARITH_ADD)
+      {
+        vecOut = IVP_MINNX16(IVP_ADDNX16(vecA, vecB), vecMax);
+      }
+      else if (op == ARITH_SUB)
+      {
+        vecOut = IVP_MAXNX16(IVP_SUBNX16(vecA, vecB), vecZero);
+      }
+      else
+      {
+        vecOut = IVP_ABSNX16(IVP_SUBNX16(vecA, vecB));
+      }
+      IVP_SAVNX8U_XP(vecOut, vaDst, pvecDst, width - indx);
+    }
+    IVP_SAPOSNX8U_FP(vaDst, pvecDst);
+  }
+#else
+  for (indy = 0; indy < height; indy++)
+  {
+    uint8_t * __restrict pA   = pSrc0 + indy * src0Pitch;
+    uint8_t * __restrict pB   = pSrc1 + indy * src1Pitch;
+    uint8_t * __restrict pOut = pDst + indy * dstPitch;
+    for (indx = 0; indx < width; indx++)
+    {
+      int32_t val;
+      if (op == ARITH_ADD)
+      {
+        val = pA[indx] + pB[indx];
+        val = (val > 255) ? 255 : val;
+      }
+      else if (op == ARITH_SUB)
+      {
+        val = pA[indx] - pB[indx];
+        val = (val < 0) ? 0 : val;
+      }
+      else
+      {
+        val = abs(pA[indx] - pB[indx]);
+      }
+      pOut[indx] = (uint8_t) val;
+    }
+  }
+#endif
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: arithS16()
+ *
+ * DESCRIPTION:
+ *     Pixel wise saturating arithmetic on 16 bit tiles
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile0      First input tile
+ *     xvTile        *pInTile1      Second input tile
+ *     int32_t       op             ARITH_ADD or ARITH_SUB
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+static int32_t arithS16(xvTileManager *pxvTM, xvTile *pInTile0, xvTile *pInTile1, xvTile *pOutTile, int32_t op)
+{
+  int32_t indx, indy, width, height, src0Pitch, src1Pitch, dstPitch;
+  int16_t *pSrc0, *pSrc1, *pDst;
+
+  if ((pInTile1 == NULL) && (pxvTM != NULL))
+  {
+    pxvTM->errFlag = XV_ERROR_TILE_NULL;
+    return(XVTM_ERROR);
+  }
+  if (checkKernelTiles(pxvTM, pInTile0, pInTile1, pOutTile, 0, 2, 2) == XVTM_ERROR)
+  {
+    return(XVTM_ERROR);
+  }
+
+  width     = XV_TILE_GET_WIDTH(pOutTile);
+  height    = XV_TILE_GET_HEIGHT(pOutTile);
+  src0Pitch = XV_TILE_GET_PITCH(pInTile0);
+  src1Pitch = XV_TILE_GET_PITCH(pInTile1);
+  dstPitch  = XV_TILE_GET_PITCH(pOutTile);
+  pSrc0     = (int16_t *) XV_TILE_GET_DATA_PTR(pInTile0);
+  pSrc1     = (int16_t *) XV_TILE_GET_DATA_PTR(pInTile1);
+  pDst      = (int16_t *) XV_TILE_GET_DATA_PTR(pOutTile);
+
+#ifdef XV_KERNEL_USE_IVP
+  xb_vecNx16 vecA, vecB, vecOut;
+  xb_vecNx16 * __restrict pvecDst;
+  valign vaDst;
+
+  for (indy = 0; indy < height; indy++)
+  {
+    pvecDst = (xb_vecNx16 *) (pDst + indy * dstPitch);
+    vaDst   = IVP_ZALIGN();
+    for (indx = 0; indx < width; indx += IVP_SIMD_WIDTH)
+    {
+      vecA   = loadNx16(pSrc0 + indy * src0Pitch + indx);
+      vecB   = loadNx16(pSrc1 + indy * src1Pitch + indx);
+      vecOut = (op == ARITH_ADD) ? IVP_ADDSNX16(vecA, vecB) : IVP_SUBSNX16(vecA, vecB);
+      IVP_SAVNX16_XP(vecOut, vaDst, pvecDst, 2 * (width - indx));
+    }
+    IVP_SAPOSNX16_FP(vaDst, pvecDst);
+  }
+#else
+  for (indy = 0; indy < height; indy++)
+  {
+    int16_t * __restrict pA   = pSrc0 + indy * src0Pitch;
+    int16_t * __restrict pB   = pSrc1 + indy * src1Pitch;
+    int16_t * __restrict pOut = pDst + indy * dstPitch;
+    for (indx = 0; indx < width; indx++)
+    {
+      int32_t val = (op == ARITH_ADD) ? (pA[indx] + pB[indx]) : (pA[indx] - pB[indx]);
+      val        = (val > 32767) ? 32767 : ((val < -32768) ? -32768 : val);
+      pOut[indx] = (int16_t) val;
+    }
+  }
+#endif
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvAddU8()
+ *
+ * DESCRIPTION:
+ *     Saturating addition of 8 bit tiles
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile0      First input tile
+ *     xvTile        *pInTile1      Second input tile
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvAddU8(xvTileManager *pxvTM, xvTile *pInTile0, xvTile *pInTile1, xvTile *pOutTile)
+{
+  return(arithU8(pxvTM, pInTile0, pInTile1, pOutTile, ARITH_ADD));
+}
+
+/**********************************************************************************
+ * FUNCTION: xvSubU8()
+ *
+ * DESCRIPTION:
+ *     Saturating subtraction of 8 bit tiles, pInTile0 - pInTile1
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile0      First input tile
+ *     xvTile        *pInTile1      Second input tile
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvSubU8(xvTileManager *pxvTM, xvTile *pInTile0, xvTile *pInTile1, xvTile *pOutTile)
+{
+  return(arithU8(pxvTM, pInTile0, pInTile1, pOutTile, ARITH_SUB));
+}
+
+/**********************************************************************************
+ * FUNCTION: xvAbsDiffU8()
+ *
+ * DESCRIPTION:
+ *     Absolute difference of 8 bit tiles
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile0      First input tile
+ *     xvTile        *pInTile1      Second input tile
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvAbsDiffU8(xvTileManager *pxvTM, xvTile *pInTile0, xvTile *pInTile1, xvTile *pOutTile)
+{
+  return(arithU8(pxvTM, pInTile0, pInTile1, pOutTile, ARITH_ABSDIFF));
+}
+
+/**********************************************************************************
+ * FUNCTION: xvAddS16()
+ *
+ * DESCRIPTION:
+ *     Saturating addition of 16 bit tiles
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile0      First input tile
+ *     xvTile        *pInTile1      Second input tile
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvAddS16(xvTileManager *pxvTM, xvTile *pInTile0, xvTile *pInTile1, xvTile *pOutTile)
+{
+  return(arithS16(pxvTM, pInTile0, pInTile1, pOutTile, ARITH_ADD));
+}
+
+/**********************************************************************************
+ * FUNCTION: xvSubS16()
+ *
+ * DESCRIPTION:
+ *     Saturating subtraction of 16 bit tiles, pInTile0 - pInTile1
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM         Tile Manager object
+ *     xvTile        *pInTile0      First input tile
+ *     xvTile        *pInTile1      Second input tile
+ *
+ * OUTPUTS:
+ *     xvTile        *pOutTile      Output tile
+ *     Returns XVTM_ERROR if it encounters an error, else returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvSubS16(xvTileManager *pxvTM, xvTile *pInTile0, xvTile *pInTile1, xvTile *pOutTile)
+{
+  return(arithS16(pxvTM, pInTile0, pInTile1, pOutTile, ARITH_SUB));
+}
@@ -41,6 +41,7 @@ xvTileManager *_ptr_xv_tile_manager;
  *     Function to initialize iDMA library. Tile Manager uses iDMA library
  *     in buffer mode. DMA transfer is scheduled as soon as the descriptor
  *     is added.
+ *     The buffer holds descriptors of type XVTM_DESC_TYPE.
  *
  *
  * INPUTS:
@@ -84,7 +85,7 @@ int32_t xvInitIdma(xvTileManager *pxvTM, idma_buffer_t *buf, int32_t numDescs, i
   idma_ticks_cyc_t ticksPerCyc = TICK_CYCLES_2;
   int32_t timeoutTicks         = 0;
   int32_t initFlags            = 0;
-  idma_type_t type             = IDMA_2D_DESC;
+  idma_type_t type             = XVTM_DESC_TYPE;
   retVal = idma_init(initFlags, maxBlock, maxPifReq, ticksPerCyc, timeoutTicks, errCallbackFunc);
   if (retVal != IDMA_OK)
   {
@@ -98,6 +99,12 @@ int32_t xvInitIdma(xvTileManager *pxvTM, idma_buffer_t *buf, int32_t numDescs, i
     pxvTM->errFlag = XV_ERROR_DMA_INIT;
     return(XVTM_ERROR);
   }
+
+  pxvTM->pdmaBuf      = buf;
+  pxvTM->dmaNumDescs  = numDescs;
+  pxvTM->dmaRingDescs = numDescs;
+  pxvTM->dmaCbFunc   = cbFunc;
+  pxvTM->dmaCbData   = cbData;
 #endif
   return(XVTM_SUCCESS);
 }
@@ -141,6 +148,7 @@ int32_t xvInitTileManager(xvTileManager *pxvTM, void *pdmaObj)
   pxvTM->pdmaObj             = pdmaObj;
   pxvTM->tileDMApendingCount = 0;
   pxvTM->tileDMAstartIndex   = 0;
+  pxvTM->pWalk               = NULL;
 
   // Initialize Memory banks related elements
 #ifndef XV_EMULATE_DMA
@@ -884,7 +892,7 @@ int32_t xvAddIdmaRequest(xvTileManager *pxvTM, void *dst, void *src, size_t rowS
     return(XVTM_ERROR);
   }
 
-  if ((rowSize <= 0) || (numRows <= 0) || (srcPitch < 0) || (dstPitch < 0))
+  if ((rowSize == 0) || (numRows <= 0) || (srcPitch < 0) || (dstPitch < 0))
   {
     pxvTM->errFlag = XV_ERROR_BAD_ARG;
     return(XVTM_ERROR);
@@ -905,7 +913,7 @@ int32_t xvAddIdmaRequest(xvTileManager *pxvTM, void *dst, void *src, size_t rowS
 
   TM_LOG_PRINT("src: %p, dst, %p, rowsize: %d, numRows: %d, srcPitch: %d, dstPitch: %d, flags: 0x%x\n",
                src, dst, rowSize, numRows, srcPitch, dstPitch, intrCompletionFlag);
-  dmaIndex = idma_copy_2d_desc(dst, src, rowSize, intrCompletionFlag, numRows, srcPitch, dstPitch);
+  dmaIndex = XVTM_COPY_2D_DESC(dst, src, rowSize, intrCompletionFlag, numRows, srcPitch, dstPitch);
   TM_LOG_PRINT(" dmaIndex: %d\n", dmaIndex);
   return(dmaIndex);
 #else
@@ -939,7 +947,7 @@ static inline int32_t addIdmaRequestInline(xvTileManager *pxvTM, void *dst, void
 
   TM_LOG_PRINT("src: %p, dst, %p, rowsize: %d, numRows: %d, srcPitch: %d, dstPitch: %d, flags: 0x%x\n",
                src, dst, rowSize, numRows, srcPitchBytes, dstPitchBytes, intrCompletionFlag);
-  dmaIndex = idma_copy_2d_desc(dst, src, rowSize, intrCompletionFlag, numRows, srcPitchBytes, dstPitchBytes);
+  dmaIndex = XVTM_COPY_2D_DESC(dst, src, rowSize, intrCompletionFlag, numRows, srcPitchBytes, dstPitchBytes);
   TM_LOG_PRINT(" dmaIndex: %d\n", dmaIndex);
   return(dmaIndex);
 #else
@@ -954,6 +962,271 @@ static inline int32_t addIdmaRequestInline(xvTileManager *pxvTM, void *dst, void
 #endif
 }
 
+// Descriptors scheduled at once by a chain request, limited by the ring
+static inline int32_t chainBatchDescs(const xvTileManager *pxvTM)
+{
+#ifndef XV_EMULATE_DMA
+  return(XVTM_MIN(MAX_NUM_CHAIN_DESCS, pxvTM->dmaRingDescs));
+#else
+  return(MAX_NUM_CHAIN_DESCS);
+#endif
+}
+
+// Schedules a list of 2D transfers as one descriptor chain. Only the last
+// descriptor interrupts on completion. Waits until the descriptors still
+// outstanding leave room for the chain in the ring.
+static inline int32_t addIdmaChainInline(xvTileManager *pxvTM, const xvDmaXfer *pXfers, int32_t count,
+                                         int32_t interruptOnCompletion)
+{
+  int32_t dmaIndex;
+  uint32_t intrCompletionFlag = interruptOnCompletion ? DESC_NOTIFY_W_INT : 0;
+
+#ifndef XV_EMULATE_DMA
+  while ((((int32_t) idma_hw_num_outstanding() + count) > pxvTM->dmaRingDescs) &&
+         (pxvTM->idmaErrorFlag == XV_ERROR_SUCCESS))
+  {
+  }
+  if (pxvTM->idmaErrorFlag != XV_ERROR_SUCCESS)
+  {
+    pxvTM->errFlag = XV_ERROR_IDMA;
+    return(XVTM_ERROR);
+  }
+#endif
+
+  TM_LOG_PRINT("chain of %d descs, flags: 0x%x\n", count, intrCompletionFlag);
+  dmaIndex = idma_copy_2d_desc_list(pXfers, (uint32_t) count, intrCompletionFlag);
+  TM_LOG_PRINT(" dmaIndex: %d\n", dmaIndex);
+  if (dmaIndex < 0)
+  {
+    pxvTM->errFlag = XV_ERROR_IDMA;
+    return(XVTM_ERROR);
+  }
+  return(dmaIndex);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvReqRoiGather()
+ *
+ * DESCRIPTION:
+ *     Gathers regions of a frame into one packed buffer. Region k is stored
+ *     right after region k-1, its pitch is its width. The regions are
+ *     scheduled as one descriptor chain, in batches of at most MAX_NUM_CHAIN_DESCS,
+ *     so a single dmaIndex tells when all of them are transferred.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM                   Tile Manager object
+ *     xvFrame       *pFrame                  Source frame
+ *     const xvRoi   *pRoi                    Regions, may extend into the frame padding
+ *     int32_t       numRois                  Number of regions
+ *     void          *pDst                    Destination buffer
+ *     int32_t       dstSize                  Size of destination buffer in bytes
+ *     void          **ppRoiData              Receives the start of each region in pDst, may be NULL
+ *     int32_t       interruptOnCompletion    If it is set, iDMA will interrupt after completing transfer
+ *
+ * OUTPUTS:
+ *     Returns dmaIndex of the last region. It returns XVTM_ERROR if it encounters an error
+ *
+ ********************************************************************************** */
+
+int32_t xvReqRoiGather(xvTileManager *pxvTM, xvFrame *pFrame, const xvRoi *pRoi, int32_t numRois,
+                       void *pDst, int32_t dstSize, void **ppRoiData, int32_t interruptOnCompletion)
+{
+  xvDmaXfer xfers[MAX_NUM_CHAIN_DESCS];
+  uint8_t *pDstRoi;
+  int32_t indx, count, maxCount, dmaIndex;
+  int32_t pixWidth, framePitchBytes, rowBytes, totalBytes;
+
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  if (pFrame == NULL || pFrame->pFrameBuff == NULL || pFrame->pFrameData == NULL)
+  {
+    pxvTM->errFlag = XV_ERROR_FRAME_NULL;
+    return(XVTM_ERROR);
+  }
+
+  if ((pDst == NULL) || ((pRoi == NULL) && (numRois > 0)))
+  {
+    pxvTM->errFlag = XV_ERROR_POINTER_NULL;
+    return(XVTM_ERROR);
+  }
+
+  if (numRois < 0)
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return(XVTM_ERROR);
+  }
+
+  pixWidth        = pFrame->pixelRes * pFrame->numChannels;
+  framePitchBytes = pFrame->framePitch * pFrame->pixelRes;
+
+  // Check all regions before scheduling any of them
+  totalBytes = 0;
+  for (indx = 0; indx < numRois; indx++)
+  {
+    if ((pRoi[indx].width <= 0) || (pRoi[indx].height <= 0) ||
+        (pRoi[indx].x < -pFrame->leftEdgePadWidth) || (pRoi[indx].y < -pFrame->topEdgePadHeight) ||
+        (pRoi[indx].x + pRoi[indx].width > pFrame->frameWidth + pFrame->rightEdgePadWidth) ||
+        (pRoi[indx].y + pRoi[indx].height > pFrame->frameHeight + pFrame->bottomEdgePadHeight))
+    {
+      pxvTM->errFlag = XV_ERROR_BAD_ARG;
+      return(XVTM_ERROR);
+    }
+    totalBytes += pRoi[indx].width * pixWidth * pRoi[indx].height;
+  }
+
+  if (totalBytes > dstSize)
+  {
+    pxvTM->errFlag = XV_ERROR_BUFFER_OVERFLOW;
+    return(XVTM_ERROR);
+  }
+
+  maxCount = chainBatchDescs(pxvTM);
+  if (maxCount < 1)
+  {
+    pxvTM->errFlag = XV_ERROR_DMA_INIT;
+    return(XVTM_ERROR);
+  }
+
+  pDstRoi = (uint8_t *) pDst;
+  count   = 0;
+  for (indx = 0; indx < numRois; indx++)
+  {
+    if (count == maxCount)
+    {
+      if (addIdmaChainInline(pxvTM, xfers, count, 0) < 0)
+      {
+        return(XVTM_ERROR);
+      }
+      count = 0;
+    }
+    rowBytes                = pRoi[indx].width * pixWidth;
+    xfers[count].dst        = pDstRoi;
+    xfers[count].src        = (uint8_t *) pFrame->pFrameData + pRoi[indx].y * framePitchBytes + pRoi[indx].x * pixWidth;
+    xfers[count].row_sz     = rowBytes;
+    xfers[count].nrows      = pRoi[indx].height;
+    xfers[count].src_pitch  = framePitchBytes;
+    xfers[count].dst_pitch  = rowBytes;
+    count++;
+
+    if (ppRoiData != NULL)
+    {
+      ppRoiData[indx] = pDstRoi;
+    }
+    pDstRoi += rowBytes * pRoi[indx].height;
+  }
+
+  dmaIndex = addIdmaChainInline(pxvTM, xfers, count, interruptOnCompletion);
+  return(dmaIndex);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvReqMaskedRowTransfer()
+ *
+ * DESCRIPTION:
+ *     Transfers the rows selected by a row mask. Row i is copied if bit (i % 32)
+ *     of pRowMask[i / 32] is set. Each run of consecutive selected rows becomes
+ *     one 2D descriptor and the runs are scheduled as one descriptor chain, in
+ *     batches of at most MAX_NUM_CHAIN_DESCS, so a single dmaIndex tells when all of
+ *     them are transferred. Tile Manager's descriptor buffer holds 2D
+ *     descriptors, so the predicated 64B descriptor of the iDMA is not used.
+ *
+ * INPUTS:
+ *     xvTileManager  *pxvTM                  Tile Manager object
+ *     void           *dst                    Pointer to destination buffer
+ *     void           *src                    Pointer to source buffer
+ *     size_t         rowSize                 Number of bytes to transfer in a row
+ *     int32_t        numRows                 Number of rows covered by the mask
+ *     int32_t        srcPitch                Source buffer's pitch in bytes
+ *     int32_t        dstPitch                Destination buffer's pitch in bytes
+ *     const uint32_t *pRowMask               Row mask, (numRows + 31) / 32 words
+ *     int32_t        interruptOnCompletion   If it is set, iDMA will interrupt after completing transfer
+ *
+ * OUTPUTS:
+ *     Returns dmaIndex of the last selected row. It returns XVTM_ERROR if it encounters an error
+ *
+ ********************************************************************************** */
+
+int32_t xvReqMaskedRowTransfer(xvTileManager *pxvTM, void *dst, void *src, size_t rowSize, int32_t numRows,
+                               int32_t srcPitch, int32_t dstPitch, const uint32_t *pRowMask, int32_t interruptOnCompletion)
+{
+  xvDmaXfer xfers[MAX_NUM_CHAIN_DESCS];
+  int32_t row, firstRow, count, maxCount, dmaIndex;
+
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+  if ((dst == NULL) || (src == NULL) || (pRowMask == NULL))
+  {
+    pxvTM->errFlag = XV_ERROR_POINTER_NULL;
+    return(XVTM_ERROR);
+  }
+
+  if ((rowSize == 0) || (numRows <= 0) || (srcPitch < 0) || (dstPitch < 0))
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return(XVTM_ERROR);
+  }
+
+  maxCount = chainBatchDescs(pxvTM);
+  if (maxCount < 1)
+  {
+    pxvTM->errFlag = XV_ERROR_DMA_INIT;
+    return(XVTM_ERROR);
+  }
+
+#define ROW_SELECTED(r)  ((pRowMask[(r) >> 5] >> ((r) & 31)) & 1)
+
+  row   = 0;
+  count = 0;
+  while (row < numRows)
+  {
+    // Skip unselected rows, a word at a time where possible
+    while ((row < numRows) && !ROW_SELECTED(row))
+    {
+      row += (((row & 31) == 0) && (pRowMask[row >> 5] == 0)) ? 32 : 1;
+    }
+    if (row >= numRows)
+    {
+      break;
+    }
+
+    firstRow = row;
+    while ((row < numRows) && ROW_SELECTED(row))
+    {
+      row += (((row & 31) == 0) && (pRowMask[row >> 5] == 0xFFFFFFFF)) ? 32 : 1;
+    }
+    row = XVTM_MIN(row, numRows);
+
+    if (count == maxCount)
+    {
+      if (addIdmaChainInline(pxvTM, xfers, count, 0) < 0)
+      {
+        return(XVTM_ERROR);
+      }
+      count = 0;
+    }
+    xfers[count].dst       = (uint8_t *) dst + firstRow * dstPitch;
+    xfers[count].src       = (uint8_t *) src + firstRow * srcPitch;
+    xfers[count].row_sz    = rowSize;
+    xfers[count].nrows     = row - firstRow;
+    xfers[count].src_pitch = srcPitch;
+    xfers[count].dst_pitch = dstPitch;
+    count++;
+  }
+
+#undef ROW_SELECTED
+
+  dmaIndex = addIdmaChainInline(pxvTM, xfers, count, interruptOnCompletion);
+  return(dmaIndex);
+}
+
 // Part of tile reuse. Checks X direction boundary condition and performs DMA transfers
 uint32_t solveForX(xvTileManager *pxvTM, xvTile *pTile, uint8_t *pCurrBuff, uint8_t *pPrevBuff,
                    int32_t y1, int32_t y2, int32_t x1, int32_t x2, int32_t px1, int32_t px2, int32_t tp, int32_t ptp, int32_t interruptOnCompletion)
@@ -1279,6 +1552,39 @@ int32_t xvReqTileTransferIn(xvTileManager *pxvTM, xvTile *pTile, xvTile *pPrevTi
   return(XVTM_SUCCESS);
 }
 
+// Appends a Fast transfer request to the tile walk being recorded. frameOffset
+// is the frame address of the request's first descriptor relative to pFrameData,
+// dmaIndex the index of its last descriptor.
+static void recordTileWalkStep(xvTileManager *pxvTM, xvTile *pTile, int32_t flags,
+                               int32_t frameOffset, int32_t dmaIndex)
+{
+  xvTileWalk *pWalk = pxvTM->pWalk;
+  xvTileWalkStep *pStep;
+
+  // Overflow is reported by xvEndTileWalkRecord()
+  if (pWalk->numSteps >= pWalk->maxSteps)
+  {
+    pWalk->numSteps = pWalk->maxSteps + 1;
+    return;
+  }
+
+  pStep              = &pWalk->pSteps[pWalk->numSteps++];
+  pStep->pTile       = pTile;
+  pStep->flags       = flags;
+  pStep->numDescs    = 0;
+  pStep->frameOffset = frameOffset;
+  pStep->status      = pTile->status;
+  pStep->dmaIndex    = XVTM_DUMMY_DMA_INDEX;
+#ifndef XV_EMULATE_DMA
+  // The ring restarts at index 0 when recording begins
+  if (dmaIndex != XVTM_DUMMY_DMA_INDEX)
+  {
+    pStep->numDescs = dmaIndex - pWalk->numDescs;
+    pWalk->numDescs = dmaIndex;
+  }
+#endif
+}
+
 /**********************************************************************************
  * FUNCTION: xvReqTileTransferInFast()
  *
@@ -1393,7 +1699,7 @@ int32_t xvReqTileTransferInFast(xvTileManager *pxvTM, xvTile *pTile, int32_t int
     intrCompletionFlag = interruptOnCompletion * !((statusFlag & (XV_TILE_STATUS_TOP_EDGE_PADDING_NEEDED | XV_TILE_STATUS_BOTTOM_EDGE_PADDING_NEEDED)) && (pFrame->paddingType == FRAME_EDGE_PADDING));
     TM_LOG_PRINT("src: %p, dst, %p, rowsize: %d, numRows: %d, srcPitch: %d, dstPitch: %d, flags: 0x%x\n",
                  srcPtr, dstPtr, dmaWidthBytes, dmaHeight, framePitchBytes, tilePitchBytes, intrCompletionFlag);
-    dmaIndex = idma_copy_2d_desc(dstPtr, srcPtr, dmaWidthBytes, intrCompletionFlag, dmaHeight, framePitchBytes, tilePitchBytes);
+    dmaIndex = XVTM_COPY_2D_DESC(dstPtr, srcPtr, dmaWidthBytes, intrCompletionFlag, dmaHeight, framePitchBytes, tilePitchBytes);
     TM_LOG_PRINT(" dmaIndex: %d\n", dmaIndex);
 
     if ((statusFlag & XV_TILE_STATUS_TOP_EDGE_PADDING_NEEDED) && (pFrame->paddingType == FRAME_EDGE_PADDING))
@@ -1406,7 +1712,7 @@ int32_t xvReqTileTransferInFast(xvTileManager *pxvTM, xvTile *pTile, int32_t int
       intrCompletionFlag = interruptOnCompletion * !((statusFlag & XV_TILE_STATUS_BOTTOM_EDGE_PADDING_NEEDED) && (pFrame->paddingType == FRAME_EDGE_PADDING));
       TM_LOG_PRINT("src: %p, dst, %p, rowsize: %d, numRows: %d, srcPitch: %d, dstPitch: %d, flags: 0x%x\n",
                    srcPtr, dstPtr, copyRowBytes, extraEdgeTop, 0, tilePitchBytes, intrCompletionFlag);
-      dmaIndex = idma_copy_2d_desc(dstPtr, srcPtr, copyRowBytes, intrCompletionFlag, extraEdgeTop, 0, tilePitchBytes);
+      dmaIndex = XVTM_COPY_2D_DESC(dstPtr, srcPtr, copyRowBytes, intrCompletionFlag, extraEdgeTop, 0, tilePitchBytes);
       TM_LOG_PRINT(" dmaIndex: %d\n", dmaIndex);
       statusFlag = statusFlag & ~XV_TILE_STATUS_TOP_EDGE_PADDING_NEEDED;
     }
@@ -1418,7 +1724,7 @@ int32_t xvReqTileTransferInFast(xvTileManager *pxvTM, xvTile *pTile, int32_t int
       copyRowBytes = (tileEdgeLeft + tileWidth + tileEdgeRight);
       TM_LOG_PRINT("src: %p, dst, %p, rowsize: %d, numRows: %d, srcPitch: %d, dstPitch: %d, flags: 0x%x\n",
                    srcPtr, dstPtr, copyRowBytes, extraEdgeBottom, 0, tilePitchBytes, interruptOnCompletion);
-      dmaIndex = idma_copy_2d_desc(dstPtr, srcPtr, copyRowBytes, interruptOnCompletion, extraEdgeBottom, 0, tilePitchBytes);
+      dmaIndex = XVTM_COPY_2D_DESC(dstPtr, srcPtr, copyRowBytes, interruptOnCompletion, extraEdgeBottom, 0, tilePitchBytes);
       TM_LOG_PRINT(" dmaIndex: %d\n", dmaIndex);
       statusFlag = statusFlag & ~XV_TILE_STATUS_BOTTOM_EDGE_PADDING_NEEDED;
     }
@@ -1429,6 +1735,11 @@ int32_t xvReqTileTransferInFast(xvTileManager *pxvTM, xvTile *pTile, int32_t int
   }
   pTile->status   = statusFlag | XV_TILE_STATUS_DMA_ONGOING;
   pTile->dmaIndex = dmaIndex;
+  if (pxvTM->pWalk != NULL)
+  {
+    recordTileWalkStep(pxvTM, pTile, interruptOnCompletion ? XVTM_WALK_STEP_INTERRUPT : 0,
+                       y1 * framePitchBytes + x1, dmaIndex);
+  }
   return(XVTM_SUCCESS);
 }
 
@@ -1546,7 +1857,7 @@ int32_t xvReqTileTransferInFast16(xvTileManager *pxvTM, xvTile *pTile, int32_t i
     intrCompletionFlag = interruptOnCompletion * !((statusFlag & (XV_TILE_STATUS_TOP_EDGE_PADDING_NEEDED | XV_TILE_STATUS_BOTTOM_EDGE_PADDING_NEEDED)) && (pFrame->paddingType == FRAME_EDGE_PADDING));
     TM_LOG_PRINT("src: %p, dst, %p, rowsize: %d, numRows: %d, srcPitch: %d, dstPitch: %d, flags: 0x%x\n",
                  srcPtr, dstPtr, dmaWidthBytes, dmaHeight, framePitchBytes, tilePitchBytes, intrCompletionFlag);
-    dmaIndex = idma_copy_2d_desc(dstPtr, srcPtr, dmaWidthBytes, intrCompletionFlag, dmaHeight, framePitchBytes, tilePitchBytes);
+    dmaIndex = XVTM_COPY_2D_DESC(dstPtr, srcPtr, dmaWidthBytes, intrCompletionFlag, dmaHeight, framePitchBytes, tilePitchBytes);
     TM_LOG_PRINT(" dmaIndex: %d\n", dmaIndex);
 
     if ((statusFlag & XV_TILE_STATUS_TOP_EDGE_PADDING_NEEDED) && (pFrame->paddingType == FRAME_EDGE_PADDING))
@@ -1559,7 +1870,7 @@ int32_t xvReqTileTransferInFast16(xvTileManager *pxvTM, xvTile *pTile, int32_t i
       intrCompletionFlag = interruptOnCompletion * !((statusFlag & XV_TILE_STATUS_BOTTOM_EDGE_PADDING_NEEDED) && (pFrame->paddingType == FRAME_EDGE_PADDING));
       TM_LOG_PRINT("src: %p, dst, %p, rowsize: %d, numRows: %d, srcPitch: %d, dstPitch: %d, flags: 0x%x\n",
                    srcPtr, dstPtr, copyRowBytes, extraEdgeTop, 0, tilePitchBytes, intrCompletionFlag);
-      dmaIndex = idma_copy_2d_desc(dstPtr, srcPtr, copyRowBytes, intrCompletionFlag, extraEdgeTop, 0, tilePitchBytes);
+      dmaIndex = XVTM_COPY_2D_DESC(dstPtr, srcPtr, copyRowBytes, intrCompletionFlag, extraEdgeTop, 0, tilePitchBytes);
       TM_LOG_PRINT(" dmaIndex: %d\n", dmaIndex);
       statusFlag = statusFlag & ~XV_TILE_STATUS_TOP_EDGE_PADDING_NEEDED;
     }
@@ -1571,7 +1882,7 @@ int32_t xvReqTileTransferInFast16(xvTileManager *pxvTM, xvTile *pTile, int32_t i
       copyRowBytes = (tileEdgeLeft + tileWidth + tileEdgeRight) * 2;
       TM_LOG_PRINT("src: %p, dst, %p, rowsize: %d, numRows: %d, srcPitch: %d, dstPitch: %d, flags: 0x%x\n",
                    srcPtr, dstPtr, copyRowBytes, extraEdgeBottom, 0, tilePitchBytes, interruptOnCompletion);
-      dmaIndex = idma_copy_2d_desc(dstPtr, srcPtr, copyRowBytes, interruptOnCompletion, extraEdgeBottom, 0, tilePitchBytes);
+      dmaIndex = XVTM_COPY_2D_DESC(dstPtr, srcPtr, copyRowBytes, interruptOnCompletion, extraEdgeBottom, 0, tilePitchBytes);
       TM_LOG_PRINT(" dmaIndex: %d\n", dmaIndex);
       statusFlag = statusFlag & ~XV_TILE_STATUS_BOTTOM_EDGE_PADDING_NEEDED;
     }
@@ -1582,6 +1893,11 @@ int32_t xvReqTileTransferInFast16(xvTileManager *pxvTM, xvTile *pTile, int32_t i
   }
   pTile->status   = statusFlag | XV_TILE_STATUS_DMA_ONGOING;
   pTile->dmaIndex = dmaIndex;
+  if (pxvTM->pWalk != NULL)
+  {
+    recordTileWalkStep(pxvTM, pTile, XVTM_WALK_STEP_16B | (interruptOnCompletion ? XVTM_WALK_STEP_INTERRUPT : 0),
+                       y1 * framePitchBytes + (x1 * 2), dmaIndex);
+  }
   return(XVTM_SUCCESS);
 }
 
@@ -1691,7 +2007,7 @@ int32_t xvReqTileTransferOutFast(xvTileManager *pxvTM, xvTile *pTile, int32_t in
 {
   xvFrame *pFrame;
   uint8_t *srcPtr, *dstPtr;
-  int32_t dmaIndex;
+  int32_t dmaIndex = XVTM_DUMMY_DMA_INDEX;
   int32_t srcHeight, srcWidth, srcPitchBytes;
   int32_t dstPitchBytes, numRows, rowSize;
 
@@ -1728,10 +2044,15 @@ int32_t xvReqTileTransferOutFast(xvTileManager *pxvTM, xvTile *pTile, int32_t in
     pTile->status = pTile->status | XV_TILE_STATUS_DMA_ONGOING;
     TM_LOG_PRINT("src: %p, dst, %p, rowsize: %d, numRows: %d, srcPitch: %d, dstPitch: %d, flags: 0x%x\n",
                  srcPtr, dstPtr, rowSize, numRows, srcPitchBytes, dstPitchBytes, intrCompletionFlag);
-    dmaIndex = idma_copy_2d_desc(dstPtr, srcPtr, rowSize, intrCompletionFlag, numRows, srcPitchBytes, dstPitchBytes);
+    dmaIndex = XVTM_COPY_2D_DESC(dstPtr, srcPtr, rowSize, intrCompletionFlag, numRows, srcPitchBytes, dstPitchBytes);
     TM_LOG_PRINT(" dmaIndex: %d\n", dmaIndex);
     pTile->dmaIndex = dmaIndex;
   }
+  if (pxvTM->pWalk != NULL)
+  {
+    recordTileWalkStep(pxvTM, pTile, XVTM_WALK_STEP_OUT | (interruptOnCompletion ? XVTM_WALK_STEP_INTERRUPT : 0),
+                       (int32_t) (dstPtr - (uint8_t *) pFrame->pFrameData), dmaIndex);
+  }
   return(XVTM_SUCCESS);
 }
 
@@ -1755,7 +2076,7 @@ int32_t xvReqTileTransferOutFast16(xvTileManager *pxvTM, xvTile *pTile, int32_t
 {
   xvFrame *pFrame;
   uint8_t *srcPtr, *dstPtr;
-  int32_t dmaIndex;
+  int32_t dmaIndex = XVTM_DUMMY_DMA_INDEX;
   int32_t srcHeight, srcWidth, srcPitchBytes;
   int32_t dstPitchBytes, numRows, rowSize;
 
@@ -1793,13 +2114,902 @@ int32_t xvReqTileTransferOutFast16(xvTileManager *pxvTM, xvTile *pTile, int32_t
     pTile->status = pTile->status | XV_TILE_STATUS_DMA_ONGOING;
     TM_LOG_PRINT("src: %p, dst, %p, rowsize: %d, numRows: %d, srcPitch: %d, dstPitch: %d, flags: 0x%x\n",
                  srcPtr, dstPtr, rowSize, numRows, srcPitchBytes, dstPitchBytes, intrCompletionFlag);
-    dmaIndex = idma_copy_2d_desc(dstPtr, srcPtr, rowSize, intrCompletionFlag, numRows, srcPitchBytes, dstPitchBytes);
+    dmaIndex = XVTM_COPY_2D_DESC(dstPtr, srcPtr, rowSize, intrCompletionFlag, numRows, srcPitchBytes, dstPitchBytes);
     TM_LOG_PRINT(" dmaIndex: %d\n", dmaIndex);
     pTile->dmaIndex = dmaIndex;
   }
+  if (pxvTM->pWalk != NULL)
+  {
+    recordTileWalkStep(pxvTM, pTile, XVTM_WALK_STEP_OUT | XVTM_WALK_STEP_16B | (interruptOnCompletion ? XVTM_WALK_STEP_INTERRUPT : 0),
+                       (int32_t) (dstPtr - (uint8_t *) pFrame->pFrameData), dmaIndex);
+  }
+  return(XVTM_SUCCESS);
+}
+
+// Waits until the iDMA completed all outstanding descriptors
+static int32_t waitIdmaIdle(xvTileManager *pxvTM)
+{
+#ifndef XV_EMULATE_DMA
+  while ((idma_hw_num_outstanding() > 0) && (pxvTM->idmaErrorFlag == XV_ERROR_SUCCESS))
+  {
+  }
+  if (pxvTM->idmaErrorFlag != XV_ERROR_SUCCESS)
+  {
+    pxvTM->errFlag = XV_ERROR_IDMA;
+    return(XVTM_ERROR);
+  }
+#endif
+  return(XVTM_SUCCESS);
+}
+
+// Restarts the iDMA buffer of xvInitIdma() at its first descriptor,
+// with a ring of numDescs descriptors. The iDMA has to be idle: the
+// buffer stays bound to the channel, and idma_init_loop() only moves
+// the channel back to the first descriptor when none is outstanding.
+static int32_t resizeIdmaRing(xvTileManager *pxvTM, int32_t numDescs)
+{
+#ifndef XV_EMULATE_DMA
+  int32_t retVal;
+  if (pxvTM->pdmaBuf == NULL)
+  {
+    pxvTM->errFlag = XV_ERROR_BUFFER_NULL;
+    return(XVTM_ERROR);
+  }
+  retVal = idma_init_loop(pxvTM->pdmaBuf, XVTM_DESC_TYPE, numDescs, pxvTM->dmaCbData, pxvTM->dmaCbFunc);
+  if (retVal != IDMA_OK)
+  {
+    pxvTM->errFlag = XV_ERROR_DMA_INIT;
+    return(XVTM_ERROR);
+  }
+  pxvTM->dmaRingDescs = numDescs;
+#endif
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvInitTileWalk()
+ *
+ * DESCRIPTION:
+ *     Initializes a tile walk. A tile walk records the Fast transfer requests of
+ *     one frame and replays them for the following frames from the same iDMA
+ *     descriptors, which are only patched with the frame address.
+ *
+ * INPUTS:
+ *     xvTileManager  *pxvTM                  Tile Manager object
+ *     xvTileWalk     *pWalk                  Tile walk
+ *     xvTileWalkStep *pSteps                 Storage for the steps of the walk
+ *     int32_t        maxSteps                Number of elements of pSteps
+ *
+ * OUTPUTS:
+ *     Returns XVTM_ERROR if it encounters an error, else it returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvInitTileWalk(xvTileManager *pxvTM, xvTileWalk *pWalk, xvTileWalkStep *pSteps, int32_t maxSteps)
+{
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  if ((pWalk == NULL) || (pSteps == NULL))
+  {
+    pxvTM->errFlag = XV_ERROR_POINTER_NULL;
+    return(XVTM_ERROR);
+  }
+
+  if (maxSteps < 1)
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return(XVTM_ERROR);
+  }
+
+  pWalk->pSteps    = pSteps;
+  pWalk->maxSteps  = maxSteps;
+  pWalk->numSteps  = 0;
+  pWalk->numDescs  = 0;
+  pWalk->curStep   = 0;
+  pWalk->numFrames = 0;
+  pWalk->state     = XVTM_WALK_IDLE;
+  pWalk->pInFrame  = NULL;
+  pWalk->pOutFrame = NULL;
   return(XVTM_SUCCESS);
 }
 
+/**********************************************************************************
+ * FUNCTION: xvBeginTileWalkRecord()
+ *
+ * DESCRIPTION:
+ *     Starts recording a tile walk. Waits for all transfers to complete and
+ *     restarts the iDMA buffer at its first descriptor, so that the walk
+ *     occupies the descriptors from the start of the buffer. The following
+ *     Fast transfer requests are executed and recorded as steps of the walk.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM                   Tile Manager object
+ *     xvTileWalk    *pWalk                   Tile walk
+ *
+ * OUTPUTS:
+ *     Returns XVTM_ERROR if it encounters an error, else it returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvBeginTileWalkRecord(xvTileManager *pxvTM, xvTileWalk *pWalk)
+{
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  if (pWalk == NULL)
+  {
+    pxvTM->errFlag = XV_ERROR_POINTER_NULL;
+    return(XVTM_ERROR);
+  }
+
+  if ((pxvTM->pWalk != NULL) || (pWalk->state != XVTM_WALK_IDLE))
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return(XVTM_ERROR);
+  }
+
+  if (waitIdmaIdle(pxvTM) == XVTM_ERROR)
+  {
+    return(XVTM_ERROR);
+  }
+  if (resizeIdmaRing(pxvTM, pxvTM->dmaNumDescs) == XVTM_ERROR)
+  {
+    return(XVTM_ERROR);
+  }
+
+  pWalk->numSteps  = 0;
+  pWalk->numDescs  = 0;
+  pWalk->curStep   = 0;
+  pWalk->numFrames = 0;
+  pWalk->state     = XVTM_WALK_RECORDING;
+  pxvTM->pWalk     = pWalk;
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvEndTileWalkRecord()
+ *
+ * DESCRIPTION:
+ *     Ends recording a tile walk. Waits for all transfers to complete and
+ *     shrinks the descriptor ring to the descriptors of the walk. Every
+ *     frame of the walk then starts at the first descriptor of the buffer
+ *     and finds the descriptors of each step where they were recorded.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM                   Tile Manager object
+ *     xvTileWalk    *pWalk                   Tile walk
+ *
+ * OUTPUTS:
+ *     Returns XVTM_ERROR if it encounters an error, else it returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvEndTileWalkRecord(xvTileManager *pxvTM, xvTileWalk *pWalk)
+{
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  if (pWalk == NULL)
+  {
+    pxvTM->errFlag = XV_ERROR_POINTER_NULL;
+    return(XVTM_ERROR);
+  }
+
+  if ((pxvTM->pWalk != pWalk) || (pWalk->state != XVTM_WALK_RECORDING))
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return(XVTM_ERROR);
+  }
+  pxvTM->pWalk = NULL;
+  pWalk->state = XVTM_WALK_IDLE;
+
+  if (waitIdmaIdle(pxvTM) == XVTM_ERROR)
+  {
+    return(XVTM_ERROR);
+  }
+
+  // Descriptors of the first steps were overwritten if the walk wrapped around the ring
+  if ((pWalk->numSteps > pWalk->maxSteps) || (pWalk->numDescs > pxvTM->dmaNumDescs))
+  {
+    pxvTM->errFlag = XV_ERROR_BUFFER_OVERFLOW;
+    return(XVTM_ERROR);
+  }
+
+  if (pWalk->numDescs > 0)
+  {
+    if (resizeIdmaRing(pxvTM, pWalk->numDescs) == XVTM_ERROR)
+    {
+      return(XVTM_ERROR);
+    }
+  }
+
+  pWalk->curStep = 0;
+  pWalk->state   = XVTM_WALK_READY;
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvStartTileWalk()
+ *
+ * DESCRIPTION:
+ *     Starts a new frame of a recorded tile walk. All steps of the previous
+ *     frame have to be scheduled before.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM                   Tile Manager object
+ *     xvTileWalk    *pWalk                   Tile walk
+ *     xvFrame       *pInFrame                Source frame of the input steps
+ *     xvFrame       *pOutFrame               Destination frame of the output steps
+ *
+ * OUTPUTS:
+ *     Returns XVTM_ERROR if it encounters an error, else it returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvStartTileWalk(xvTileManager *pxvTM, xvTileWalk *pWalk, xvFrame *pInFrame, xvFrame *pOutFrame)
+{
+  int32_t index, flags;
+
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  if (pWalk == NULL)
+  {
+    pxvTM->errFlag = XV_ERROR_POINTER_NULL;
+    return(XVTM_ERROR);
+  }
+
+  if ((pWalk->state != XVTM_WALK_READY) || ((pWalk->curStep != 0) && (pWalk->curStep != pWalk->numSteps)))
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return(XVTM_ERROR);
+  }
+
+  flags = 0;
+  for (index = 0; index < pWalk->numSteps; index++)
+  {
+    flags |= (pWalk->pSteps[index].flags & XVTM_WALK_STEP_OUT) ? 2 : 1;
+  }
+  if ((((flags & 1) != 0) && ((pInFrame == NULL) || (pInFrame->pFrameData == NULL))) ||
+      (((flags & 2) != 0) && ((pOutFrame == NULL) || (pOutFrame->pFrameData == NULL))))
+  {
+    pxvTM->errFlag = XV_ERROR_FRAME_NULL;
+    return(XVTM_ERROR);
+  }
+
+  pWalk->pInFrame  = pInFrame;
+  pWalk->pOutFrame = pOutFrame;
+  pWalk->curStep   = 0;
+  pWalk->numFrames++;
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvReqTileWalkStep()
+ *
+ * DESCRIPTION:
+ *     Schedules the next step of a tile walk. Only the frame address of the
+ *     step's first descriptor is patched, the other fields and the edge
+ *     replication descriptors of the step are reused as recorded. The
+ *     descriptors are released to the iDMA with one descriptor count update.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM                   Tile Manager object
+ *     xvTileWalk    *pWalk                   Tile walk
+ *
+ * OUTPUTS:
+ *     Returns XVTM_ERROR if it encounters an error, else it returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvReqTileWalkStep(xvTileManager *pxvTM, xvTileWalk *pWalk)
+{
+  xvTileWalkStep *pStep;
+  xvTile *pTile;
+  xvFrame *pFrame;
+
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  if ((pWalk == NULL) || (pWalk->state != XVTM_WALK_READY) || (pWalk->curStep >= pWalk->numSteps))
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return(XVTM_ERROR);
+  }
+
+  pStep         = &pWalk->pSteps[pWalk->curStep++];
+  pTile         = pStep->pTile;
+  pFrame        = (pStep->flags & XVTM_WALK_STEP_OUT) ? pWalk->pOutFrame : pWalk->pInFrame;
+  pTile->pFrame = pFrame;
+
+#ifdef XV_EMULATE_DMA
+  // No descriptors to reuse, the request is repeated
+  int32_t interruptOnCompletion = (pStep->flags & XVTM_WALK_STEP_INTERRUPT) ? 1 : 0;
+  switch (pStep->flags & (XVTM_WALK_STEP_OUT | XVTM_WALK_STEP_16B))
+  {
+  case XVTM_WALK_STEP_OUT:
+    return(xvReqTileTransferOutFast(pxvTM, pTile, interruptOnCompletion));
+  case XVTM_WALK_STEP_OUT | XVTM_WALK_STEP_16B:
+    return(xvReqTileTransferOutFast16(pxvTM, pTile, interruptOnCompletion));
+  case XVTM_WALK_STEP_16B:
+    return(xvReqTileTransferInFast16(pxvTM, pTile, interruptOnCompletion));
+  default:
+    return(xvReqTileTransferInFast(pxvTM, pTile, interruptOnCompletion));
+  }
+#else
+  uint8_t *pFrameAddr;
+  int32_t dmaIndex;
+
+  if (pStep->numDescs == 0)
+  {
+    if ((pStep->flags & XVTM_WALK_STEP_OUT) == 0)
+    {
+      pTile->status   = pStep->status;
+      pTile->dmaIndex = XVTM_DUMMY_DMA_INDEX;
+    }
+    return(XVTM_SUCCESS);
+  }
+
+  // The descriptors were last used by this step in the previous frame
+  if (pStep->dmaIndex != XVTM_DUMMY_DMA_INDEX)
+  {
+    while ((idma_desc_done(pStep->dmaIndex) == 0) && (pxvTM->idmaErrorFlag == XV_ERROR_SUCCESS))
+    {
+    }
+  }
+
+  // src and dst are at the same offsets in 2D and 64B descriptors
+  pFrameAddr = (uint8_t *) pFrame->pFrameData + pStep->frameOffset;
+  if (pStep->flags & XVTM_WALK_STEP_OUT)
+  {
+    idma_update_desc_dst(pFrameAddr);
+  }
+  else
+  {
+    idma_update_desc_src(pFrameAddr);
+  }
+  dmaIndex = idma_schedule_desc(pStep->numDescs);
+  TM_LOG_PRINT("walk step: %d, frame address: %p, descriptors: %d, dmaIndex: %d\n",
+               pWalk->curStep - 1, pFrameAddr, pStep->numDescs, dmaIndex);
+
+  pStep->dmaIndex = dmaIndex;
+  if (pStep->flags & XVTM_WALK_STEP_OUT)
+  {
+    pTile->status = pTile->status | XV_TILE_STATUS_DMA_ONGOING;
+  }
+  else
+  {
+    pTile->status = pStep->status;
+  }
+  pTile->dmaIndex = dmaIndex;
+  return(XVTM_SUCCESS);
+#endif
+}
+
+/**********************************************************************************
+ * FUNCTION: xvStopTileWalk()
+ *
+ * DESCRIPTION:
+ *     Stops using a tile walk. Waits for all transfers to complete and
+ *     restores the descriptor ring set up by xvInitIdma(). The walk can
+ *     be recorded again afterwards.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM                   Tile Manager object
+ *     xvTileWalk    *pWalk                   Tile walk
+ *
+ * OUTPUTS:
+ *     Returns XVTM_ERROR if it encounters an error, else it returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvStopTileWalk(xvTileManager *pxvTM, xvTileWalk *pWalk)
+{
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  if (pWalk == NULL)
+  {
+    pxvTM->errFlag = XV_ERROR_POINTER_NULL;
+    return(XVTM_ERROR);
+  }
+
+  if (pxvTM->pWalk == pWalk)
+  {
+    pxvTM->pWalk = NULL;
+  }
+  pWalk->state   = XVTM_WALK_IDLE;
+  pWalk->curStep = 0;
+
+  if (waitIdmaIdle(pxvTM) == XVTM_ERROR)
+  {
+    return(XVTM_ERROR);
+  }
+  return(resizeIdmaRing(pxvTM, pxvTM->dmaNumDescs));
+}
+
+// One transfer of a 3D tile request, repeated for every plane
+typedef struct
+{
+  uint8_t *pDst;
+  uint8_t *pSrc;
+  int32_t rowBytes;
+  int32_t numRows;
+  int32_t srcPitch;
+  int32_t dstPitch;
+  int32_t srcPlanePitch;
+  int32_t dstPlanePitch;
+} xvDma3DRequest;
+
+// Schedules 3D transfers, as 3D descriptors if the iDMA buffer holds 64B
+// descriptors, else as one chain of 2D descriptors, one per plane.
+// Only the last descriptor interrupts on completion.
+static int32_t addIdma3DRequestsInline(xvTileManager *pxvTM, const xvDma3DRequest *pReq, int32_t count,
+                                       int32_t numPlanes, int32_t interruptOnCompletion)
+{
+  int32_t indx, dmaIndex;
+#ifdef XVTM_HAVE_3D_DESC
+  void *dst, *src;
+  uint32_t intrCompletionFlag;
+
+  dmaIndex = XVTM_DUMMY_DMA_INDEX;
+  for (indx = 0; indx < count; indx++)
+  {
+    intrCompletionFlag = (interruptOnCompletion && (indx == count - 1)) ? DESC_NOTIFY_W_INT : 0;
+    dst                = pReq[indx].pDst;
+    src                = pReq[indx].pSrc;
+    TM_LOG_PRINT("3D src: %p, dst, %p, rowsize: %d, numRows: %d, numPlanes: %d, flags: 0x%x\n",
+                 src, dst, pReq[indx].rowBytes, pReq[indx].numRows, numPlanes, intrCompletionFlag);
+    dmaIndex = idma_copy_3d_desc64(0, (void *) &dst, (void *) &src, intrCompletionFlag, pReq[indx].rowBytes,
+                                   pReq[indx].numRows, numPlanes, pReq[indx].srcPitch, pReq[indx].dstPitch,
+                                   pReq[indx].srcPlanePitch, pReq[indx].dstPlanePitch);
+    TM_LOG_PRINT(" dmaIndex: %d\n", dmaIndex);
+    if (dmaIndex < 0)
+    {
+      pxvTM->errFlag = XV_ERROR_IDMA;
+      return(XVTM_ERROR);
+    }
+  }
+  return(dmaIndex);
+#else
+  xvDmaXfer xfers[MAX_NUM_CHAIN_DESCS];
+  int32_t plane, numXfers, maxXfers;
+
+  maxXfers = chainBatchDescs(pxvTM);
+  if (maxXfers < 1)
+  {
+    pxvTM->errFlag = XV_ERROR_DMA_INIT;
+    return(XVTM_ERROR);
+  }
+
+  numXfers = 0;
+  for (indx = 0; indx < count; indx++)
+  {
+    for (plane = 0; plane < numPlanes; plane++)
+    {
+      if (numXfers == maxXfers)
+      {
+        if (addIdmaChainInline(pxvTM, xfers, numXfers, 0) < 0)
+        {
+          return(XVTM_ERROR);
+        }
+        numXfers = 0;
+      }
+      xfers[numXfers].dst       = pReq[indx].pDst + plane * pReq[indx].dstPlanePitch;
+      xfers[numXfers].src       = pReq[indx].pSrc + plane * pReq[indx].srcPlanePitch;
+      xfers[numXfers].row_sz    = pReq[indx].rowBytes;
+      xfers[numXfers].nrows     = pReq[indx].numRows;
+      xfers[numXfers].src_pitch = pReq[indx].srcPitch;
+      xfers[numXfers].dst_pitch = pReq[indx].dstPitch;
+      numXfers++;
+    }
+  }
+  dmaIndex = addIdmaChainInline(pxvTM, xfers, numXfers, interruptOnCompletion);
+  return(dmaIndex);
+#endif
+}
+
+// Checks a 3D tile and its frame. Planes have to fit in the tile buffer.
+static int32_t checkTile3D(xvTileManager *pxvTM, xvTile3D *pTile3D)
+{
+  xvTile *pTile;
+  xvFrame *pFrame;
+  int32_t pixWidth, tilePitchBytes, planeBytes;
+  uint8_t *pFirst, *pEnd;
+
+  if ((pTile3D == NULL) || (pTile3D->pTile == NULL))
+  {
+    pxvTM->errFlag = XV_ERROR_TILE_NULL;
+    return(XVTM_ERROR);
+  }
+
+  pTile = pTile3D->pTile;
+  if (XV_IS_TILE_OK(pTile) == 0)
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return(XVTM_ERROR);
+  }
+
+  pFrame = pTile->pFrame;
+  if (pFrame == NULL || pFrame->pFrameBuff == NULL || pFrame->pFrameData == NULL)
+  {
+    pxvTM->errFlag = XV_ERROR_FRAME_NULL;
+    return(XVTM_ERROR);
+  }
+
+  // Edge padding is done by xvPadEdges() and xvPadEdges16()
+  pixWidth = pFrame->pixelRes * pFrame->numChannels;
+  if ((pTile3D->numPlanes < 1) || (pTile3D->tilePlanePitch < 0) || (pTile3D->framePlanePitch < 0) ||
+      (pFrame->numChannels != 1) || ((pFrame->pixelRes != 1) && (pFrame->pixelRes != 2)))
+  {
+    pxvTM->errFlag = XV_ERROR_BAD_ARG;
+    return(XVTM_ERROR);
+  }
+
+  tilePitchBytes = pTile->pitch * pFrame->pixelRes;
+  planeBytes     = (pTile->tileEdgeTop + pTile->height + pTile->tileEdgeBottom) * tilePitchBytes;
+  pFirst         = (uint8_t *) pTile->pData - (pTile->tileEdgeTop * tilePitchBytes + pTile->tileEdgeLeft * pixWidth);
+  pEnd           = pFirst + (pTile3D->numPlanes - 1) * pTile3D->tilePlanePitch + planeBytes;
+  if (((pTile3D->numPlanes > 1) && (pTile3D->tilePlanePitch < planeBytes)) ||
+      (pEnd > (uint8_t *) pTile->pBuffer + pTile->bufferSize))
+  {
+    pxvTM->errFlag = XV_ERROR_BUFFER_OVERFLOW;
+    return(XVTM_ERROR);
+  }
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvReqTileTransferIn3D()
+ *
+ * DESCRIPTION:
+ *     Requests 8b or 16b data transfer of all planes of a 3D tile from frame
+ *     present in system memory to local tile memory. Works like
+ *     xvReqTileTransferInFast() on every plane, but all planes are fetched
+ *     with one 3D descriptor if the iDMA buffer holds 64B descriptors, else
+ *     with one chain of 2D descriptors. Top and bottom edges are replicated
+ *     the same way for FRAME_EDGE_PADDING. The remaining edges are padded
+ *     by xvCheckTile3DReady().
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM                   Tile Manager object
+ *     xvTile3D      *pTile3D                 Destination tile
+ *     int32_t       interruptOnCompletion    If it is set, iDMA will interrupt after completing transfer
+ *
+ * OUTPUTS:
+ *     Returns XVTM_ERROR if it encounters an error, else it returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvReqTileTransferIn3D(xvTileManager *pxvTM, xvTile3D *pTile3D, int32_t interruptOnCompletion)
+{
+  xvTile *pTile;
+  xvFrame *pFrame;
+  xvDma3DRequest req[3];
+  int32_t frameWidth, frameHeight, framePitchBytes, tileWidth, tileHeight, tilePitchBytes;
+  int32_t statusFlag, x1, y1, x2, y2, dmaHeight, dmaWidthBytes, dmaIndex, copyRowBytes, pixWidth, count;
+  int16_t tileEdgeLeft, tileEdgeRight, tileEdgeTop, tileEdgeBottom;
+  int16_t extraEdgeTop, extraEdgeBottom, extraEdgeLeft;
+  uint8_t *srcPtr, *edgePtr;
+
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  if (checkTile3D(pxvTM, pTile3D) != XVTM_SUCCESS)
+  {
+    return(XVTM_ERROR);
+  }
+
+  pTile  = pTile3D->pTile;
+  pFrame = pTile->pFrame;
+
+  pixWidth        = pFrame->pixelRes * pFrame->numChannels;
+  frameWidth      = pFrame->frameWidth;
+  frameHeight     = pFrame->frameHeight;
+  framePitchBytes = pFrame->framePitch * pFrame->pixelRes;
+
+  tileWidth      = pTile->width;
+  tileHeight     = pTile->height;
+  tilePitchBytes = pTile->pitch * pFrame->pixelRes;
+  tileEdgeLeft   = pTile->tileEdgeLeft;
+  tileEdgeRight  = pTile->tileEdgeRight;
+  tileEdgeTop    = pTile->tileEdgeTop;
+  tileEdgeBottom = pTile->tileEdgeBottom;
+
+  statusFlag      = pTile->status;
+  extraEdgeTop    = 0;
+  extraEdgeBottom = 0;
+  extraEdgeLeft   = 0;
+
+  // 1. CHECK IF EXTRA PADDING NEEDED
+  y1 = pTile->y - tileEdgeTop;
+  if (y1 > frameHeight)
+  {
+    y1 = frameHeight;
+  }
+  if (y1 < 0)
+  {
+    extraEdgeTop = -y1;
+    y1           = 0;
+    statusFlag  |= XV_TILE_STATUS_TOP_EDGE_PADDING_NEEDED;
+  }
+
+  y2 = pTile->y + (tileHeight - 1) + tileEdgeBottom;
+  if (y2 < 0)
+  {
+    y2 = -1;
+  }
+  if (y2 > frameHeight - 1)
+  {
+    extraEdgeBottom = y2 - frameHeight + 1;
+    y2              = frameHeight - 1;
+    statusFlag     |= XV_TILE_STATUS_BOTTOM_EDGE_PADDING_NEEDED;
+  }
+
+  x1 = pTile->x - tileEdgeLeft;
+  if (x1 > frameWidth)
+  {
+    x1 = frameWidth;
+  }
+  if (x1 < 0)
+  {
+    extraEdgeLeft = -x1;
+    x1            = 0;
+    statusFlag   |= XV_TILE_STATUS_LEFT_EDGE_PADDING_NEEDED;
+  }
+
+  x2 = pTile->x + (tileWidth - 1) + tileEdgeRight;
+  if (x2 < 0)
+  {
+    x2 = -1;
+  }
+  if (x2 > frameWidth - 1)
+  {
+    x2          = frameWidth - 1;
+    statusFlag |= XV_TILE_STATUS_RIGHT_EDGE_PADDING_NEEDED;
+  }
+
+  // 2. FILL ALL TILE and DMA RELATED DATA
+  dmaHeight     = y2 - y1 + 1;
+  dmaWidthBytes = (x2 - x1 + 1) * pixWidth;
+
+  if (dmaHeight > 0 && dmaWidthBytes > 0)
+  {
+    srcPtr  = (uint8_t *) pFrame->pFrameData + y1 * framePitchBytes + x1 * pixWidth;
+    edgePtr = (uint8_t *) pTile->pData - (tileEdgeTop * tilePitchBytes + tileEdgeLeft * pixWidth);
+
+    req[0].pSrc          = srcPtr;
+    req[0].pDst          = edgePtr + (extraEdgeTop * tilePitchBytes + extraEdgeLeft * pixWidth);
+    req[0].rowBytes      = dmaWidthBytes;
+    req[0].numRows       = dmaHeight;
+    req[0].srcPitch      = framePitchBytes;
+    req[0].dstPitch      = tilePitchBytes;
+    req[0].srcPlanePitch = pTile3D->framePlanePitch;
+    req[0].dstPlanePitch = pTile3D->tilePlanePitch;
+    count                = 1;
+
+    copyRowBytes = (tileEdgeLeft + tileWidth + tileEdgeRight) * pixWidth;
+    if ((statusFlag & XV_TILE_STATUS_TOP_EDGE_PADDING_NEEDED) && (pFrame->paddingType == FRAME_EDGE_PADDING))
+    {
+      // Replicate the first fetched row upwards
+      req[count].pSrc          = edgePtr + extraEdgeTop * tilePitchBytes;
+      req[count].pDst          = edgePtr;
+      req[count].rowBytes      = copyRowBytes;
+      req[count].numRows       = extraEdgeTop;
+      req[count].srcPitch      = 0;
+      req[count].dstPitch      = tilePitchBytes;
+      req[count].srcPlanePitch = pTile3D->tilePlanePitch;
+      req[count].dstPlanePitch = pTile3D->tilePlanePitch;
+      count++;
+      statusFlag = statusFlag & ~XV_TILE_STATUS_TOP_EDGE_PADDING_NEEDED;
+    }
+
+    if ((statusFlag & XV_TILE_STATUS_BOTTOM_EDGE_PADDING_NEEDED) && (pFrame->paddingType == FRAME_EDGE_PADDING))
+    {
+      // Replicate the last fetched row downwards
+      req[count].pSrc          = (uint8_t *) pTile->pData - tileEdgeLeft * pixWidth + (tileHeight + tileEdgeBottom - extraEdgeBottom - 1) * tilePitchBytes;
+      req[count].pDst          = req[count].pSrc + tilePitchBytes;
+      req[count].rowBytes      = copyRowBytes;
+      req[count].numRows       = extraEdgeBottom;
+      req[count].srcPitch      = 0;
+      req[count].dstPitch      = tilePitchBytes;
+      req[count].srcPlanePitch = pTile3D->tilePlanePitch;
+      req[count].dstPlanePitch = pTile3D->tilePlanePitch;
+      count++;
+      statusFlag = statusFlag & ~XV_TILE_STATUS_BOTTOM_EDGE_PADDING_NEEDED;
+    }
+
+    dmaIndex = addIdma3DRequestsInline(pxvTM, req, count, pTile3D->numPlanes, interruptOnCompletion);
+    if (dmaIndex < 0)
+    {
+      return(XVTM_ERROR);
+    }
+  }
+  else
+  {
+    dmaIndex = XVTM_DUMMY_DMA_INDEX;
+  }
+  pTile->status   = statusFlag | XV_TILE_STATUS_DMA_ONGOING;
+  pTile->dmaIndex = dmaIndex;
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvReqTileTransferOut3D()
+ *
+ * DESCRIPTION:
+ *     Requests data transfer of all planes of a 3D tile from local memory to
+ *     frame in system memory, with one 3D descriptor if the iDMA buffer holds
+ *     64B descriptors, else with one chain of 2D descriptors.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM                   Tile Manager object
+ *     xvTile3D      *pTile3D                 Source tile
+ *     int32_t       interruptOnCompletion    If it is set, iDMA will interrupt after completing transfer
+ *
+ * OUTPUTS:
+ *     Returns XVTM_ERROR if it encounters an error, else it returns XVTM_SUCCESS
+ *
+ ********************************************************************************** */
+
+int32_t xvReqTileTransferOut3D(xvTileManager *pxvTM, xvTile3D *pTile3D, int32_t interruptOnCompletion)
+{
+  xvTile *pTile;
+  xvFrame *pFrame;
+  xvDma3DRequest req;
+  int32_t pixWidth, dmaIndex, srcPitchBytes, dstPitchBytes, numRows, rowSize;
+
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  if (checkTile3D(pxvTM, pTile3D) != XVTM_SUCCESS)
+  {
+    return(XVTM_ERROR);
+  }
+
+  pTile         = pTile3D->pTile;
+  pFrame        = pTile->pFrame;
+  pixWidth      = pFrame->pixelRes * pFrame->numChannels;
+  srcPitchBytes = pTile->pitch * pFrame->pixelRes;
+  dstPitchBytes = pFrame->framePitch * pFrame->pixelRes;
+  numRows       = XVTM_MIN(pTile->height, pFrame->frameHeight - pTile->y);
+  rowSize       = XVTM_MIN(pTile->width, (pFrame->frameWidth - pTile->x));
+
+  req.pSrc = (uint8_t *) pTile->pData;
+  req.pDst = (uint8_t *) pFrame->pFrameData + (pTile->y * dstPitchBytes + pTile->x * pixWidth);
+
+  if (pTile->x < 0)
+  {
+    rowSize  += pTile->x;      // x is negative;
+    req.pSrc += (-pTile->x * pixWidth);
+    req.pDst += (-pTile->x * pixWidth);
+  }
+
+  if (pTile->y < 0)
+  {
+    numRows  += pTile->y;      // y is negative;
+    req.pSrc += (-pTile->y * srcPitchBytes);
+    req.pDst += (-pTile->y * dstPitchBytes);
+  }
+
+  if ((rowSize > 0) && (numRows > 0))
+  {
+    req.rowBytes      = rowSize * pixWidth;
+    req.numRows       = numRows;
+    req.srcPitch      = srcPitchBytes;
+    req.dstPitch      = dstPitchBytes;
+    req.srcPlanePitch = pTile3D->tilePlanePitch;
+    req.dstPlanePitch = pTile3D->framePlanePitch;
+
+    dmaIndex = addIdma3DRequestsInline(pxvTM, &req, 1, pTile3D->numPlanes, interruptOnCompletion);
+    if (dmaIndex < 0)
+    {
+      return(XVTM_ERROR);
+    }
+    pTile->status   = pTile->status | XV_TILE_STATUS_DMA_ONGOING;
+    pTile->dmaIndex = dmaIndex;
+  }
+  return(XVTM_SUCCESS);
+}
+
+/**********************************************************************************
+ * FUNCTION: xvCheckTile3DReady()
+ *
+ * DESCRIPTION:
+ *     Checks if the transfer of all planes of a 3D tile is completed. Once it
+ *     is, pads the edges of every plane wherever required.
+ *
+ * INPUTS:
+ *     xvTileManager *pxvTM                   Tile Manager object
+ *     xvTile3D      *pTile3D                 Input tile
+ *
+ * OUTPUTS:
+ *     Returns ONE if the tile is ready and ZERO if it is not
+ *     Returns XVTM_ERROR if an error occurs
+ *
+ ********************************************************************************** */
+
+int32_t xvCheckTile3DReady(xvTileManager *pxvTM, xvTile3D *pTile3D)
+{
+  xvTile *pTile, planeTile;
+  int32_t plane, retVal;
+
+  if (pxvTM == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+  pxvTM->errFlag = XV_ERROR_SUCCESS;
+
+  if ((pTile3D == NULL) || (pTile3D->pTile == NULL))
+  {
+    pxvTM->errFlag = XV_ERROR_TILE_NULL;
+    return(XVTM_ERROR);
+  }
+
+  pTile = pTile3D->pTile;
+  if (pTile->status & XV_TILE_STATUS_DMA_ONGOING)
+  {
+    if (pTile->dmaIndex != XVTM_DUMMY_DMA_INDEX)
+    {
+      retVal = xvCheckForIdmaIndex(pxvTM, pTile->dmaIndex);
+      if (retVal != 1)
+      {
+        return(retVal);
+      }
+    }
+    pTile->status = pTile->status & ~XV_TILE_STATUS_DMA_ONGOING;
+  }
+
+  if (pTile->status & XV_TILE_STATUS_EDGE_PADDING_NEEDED)
+  {
+    planeTile = *pTile;
+    for (plane = 0; plane < pTile3D->numPlanes; plane++)
+    {
+      planeTile.pData  = (uint8_t *) pTile->pData + plane * pTile3D->tilePlanePitch;
+      planeTile.status = pTile->status;
+      if (pTile->pFrame->pixelRes == 2)
+      {
+        retVal = xvPadEdges16(pxvTM, &planeTile);
+      }
+      else
+      {
+        retVal = xvPadEdges(pxvTM, &planeTile);
+      }
+      if (retVal == XVTM_ERROR)
+      {
+        return(XVTM_ERROR);
+      }
+    }
+    pTile->status = pTile->status & ~XV_TILE_STATUS_EDGE_PADDING_NEEDED;
+  }
+  return(pTile->status == 0);
+}
+
 /**********************************************************************************
  * FUNCTION: xvCheckForIdmaIndex()
  *
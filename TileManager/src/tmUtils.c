@@ -583,6 +583,18 @@ int32_t copy2d(void *pDst, void *pSrc, size_t width, int32_t flags, int32_t heig
   return(0);
 }
 
+// Emulates a list of 2D dma copies
+int32_t copy2dList(const xvDmaXfer *pXfers, uint32_t count, uint32_t flags)
+{
+  uint32_t indx;
+  for (indx = 0; indx < count; indx++)
+  {
+    copy2d(pXfers[indx].dst, pXfers[indx].src, pXfers[indx].row_sz, flags, pXfers[indx].nrows,
+           pXfers[indx].src_pitch, pXfers[indx].dst_pitch);
+  }
+  return(0);
+}
+
 int dma_sleep()
 {
 	return 1;
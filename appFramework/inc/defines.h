@@ -35,6 +35,24 @@ int IMAGE_HEIGHT;
 #define MAX_PIF                  (64)
 
 #define INTERRUPT_ON_COMPLETION  (1)
+
+// Kernel applied to every tile by processData(), one of xvKernelId_t.
+// Output is compared against the input frame only for XV_KERNEL_COPY_U8.
+#define PROCESS_KERNEL           XV_KERNEL_COPY_U8
+// Optional second kernel fused after PROCESS_KERNEL. Its input is the result
+// of PROCESS_KERNEL, which stays in local memory.
+//#define PROCESS_KERNEL_2         XV_KERNEL_SOBEL_MAG_3X3_U8
+
+// Define VIDEO_INPUT to process a raw video sequence instead of the still
+// image. VIDEO_FORMAT is one of vidFormat_t, VIDEO_WIDTH and VIDEO_HEIGHT
+// are used for headerless YUV420/NV12 files only.
+//#define VIDEO_INPUT              "data/input.y4m"
+#define VIDEO_OUTPUT             "data/output.y4m"
+#define VIDEO_FORMAT             VID_FORMAT_Y4M
+#define VIDEO_WIDTH              (1920)
+#define VIDEO_HEIGHT             (1080)
+#define VIDEO_RING_SIZE          (3)
+
 #define RET_ERROR                (-1)
 
 #endif //__DEFINES__
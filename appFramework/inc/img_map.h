@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2016 by Cadence Design Systems, Inc.  ALL RIGHTS RESERVED.
+ * These coded instructions, statements, and computer programs are the
+ * copyrighted works and confidential proprietary information of
+ * Cadence Design Systems Inc.  They may be adapted and modified by bona fide
+ * purchasers for internal use, but neither the original nor any adapted
+ * or modified version may be disclosed or distributed to third parties
+ * in any manner, medium, or form, in whole or in part, without the prior
+ * written consent of Cadence Design Systems Inc.  This software and its
+ * derivatives are to be executed solely on products incorporating a Cadence
+ * Design Systems processor.
+ */
+
+/* *****************************************************************************
+ * FILE:  img_map.h
+ *
+ * DESCRIPTION:
+ *
+ *    This file contains definitions of the memory mapped PGM/PPM image I/O.
+ *    Pixel data is used in place in the mapping, frames set up with
+ *    imgMapSetupFrame() point directly into the file.
+ *
+ *    8-bit images are not copied at all. 16-bit samples are stored big-endian
+ *    in the file, they are converted to native order in a private copy of the
+ *    mapped pages on open and back to big-endian on flush/close.
+ *
+ *    On Windows hosts the file is mapped with MapViewOfFile, on other hosts
+ *    with mmap. Xtensa targets (ISS) have no mmap, the file is read into a
+ *    buffer on open and written back on flush/close.
+ *
+ * ****************************************************************************/
+
+#ifndef __IMG_MAP_H__
+#define __IMG_MAP_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "tileManager.h"
+
+typedef enum
+{
+  IMG_SUCCESS        = 0,
+  IMG_ERROR_BAD_ARG  = -1,
+  IMG_ERROR_OPEN     = -2,
+  IMG_ERROR_FORMAT   = -3,
+  IMG_ERROR_MAP      = -4,
+  IMG_ERROR_ALLOC    = -5,
+  IMG_ERROR_WRITE    = -6
+} imgError_t;
+
+typedef struct imgMapStruct
+{
+  uint8_t  *pData;        // First pixel
+  int32_t  width;
+  int32_t  height;
+  int32_t  numChannels;   // 1 for PGM, 3 for PPM
+  int32_t  compWidth;     // Bits per component, 8 or 16
+  int32_t  pitch;         // Components per row
+  int32_t  dataSize;      // Bytes of pixel data
+  int32_t  writable;
+  void     *pMap;         // Start of mapping, header included
+  size_t   mapSize;
+  intptr_t fileHandle;
+  intptr_t mapHandle;
+} ImgMap;
+
+// Maps a binary PGM (P5) or PPM (P6) file for reading
+// pImg     - Image map object
+// filename - Name of the file
+// Returns IMG_SUCCESS or one of imgError_t
+int32_t imgMapOpen(ImgMap *pImg, const char *filename);
+
+// Creates a PGM/PPM file of the given size and maps it for writing
+// pImg        - Image map object
+// filename    - Name of the file, overwritten if it exists
+// width       - Width of image
+// height      - Height of image
+// numChannels - 1 for PGM, 3 for PPM
+// compWidth   - Bits per component, 8 or 16
+// Returns IMG_SUCCESS or one of imgError_t
+int32_t imgMapCreate(ImgMap *pImg, const char *filename, int32_t width, int32_t height, int32_t numChannels, int32_t compWidth);
+
+// Sets up a frame on the pixel data of the mapping. Frame has no padding in memory,
+// borders are filled by the Tile Manager as selected by paddingType.
+// pImg        - Image map object
+// pFrame      - Frame to set up
+// paddingType - FRAME_ZERO_PADDING, FRAME_CONSTANT_PADDING or FRAME_EDGE_PADDING
+// paddingVal  - Value used with FRAME_CONSTANT_PADDING
+// Returns IMG_SUCCESS or one of imgError_t
+int32_t imgMapSetupFrame(ImgMap *pImg, xvFrame *pFrame, int32_t paddingType, int32_t paddingVal);
+
+// Writes pixel data of a writable mapping to the file
+// Returns IMG_SUCCESS or one of imgError_t
+int32_t imgMapFlush(ImgMap *pImg);
+
+// Flushes a writable mapping and releases the mapping
+// Returns IMG_SUCCESS or one of imgError_t
+int32_t imgMapClose(ImgMap *pImg);
+
+// Returns a description of an imgError_t value
+const char *imgMapErrorString(int32_t error);
+
+#endif
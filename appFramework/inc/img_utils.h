@@ -27,5 +27,5 @@
 
 int32_t checkImage(uint8_t *img1, uint8_t *img2, int32_t width, int32_t height, int32_t pitch);
 PGMImage *readPGM(const char *filename);
-void writePGM(const char *filename, PGMImage *img);
+int32_t writePGM(const char *filename, PGMImage *img);
 
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2016 by Cadence Design Systems, Inc.  ALL RIGHTS RESERVED.
+ * These coded instructions, statements, and computer programs are the
+ * copyrighted works and confidential proprietary information of
+ * Cadence Design Systems Inc.  They may be adapted and modified by bona fide
+ * purchasers for internal use, but neither the original nor any adapted
+ * or modified version may be disclosed or distributed to third parties
+ * in any manner, medium, or form, in whole or in part, without the prior
+ * written consent of Cadence Design Systems Inc.  This software and its
+ * derivatives are to be executed solely on products incorporating a Cadence
+ * Design Systems processor.
+ */
+
+/* *****************************************************************************
+ * FILE:  vid_stream.h
+ *
+ * DESCRIPTION:
+ *
+ *    This file contains definitions of the raw video frame source and sink.
+ *    Y4M (4:2:0 only), planar YUV420 (I420) and NV12 files are supported.
+ *
+ *    The source reads frames sequentially into a bounded ring of frame
+ *    buffers. On hosts a reader thread fills free ring slots in the
+ *    background, so the next frames are loaded while the current one is
+ *    processed. Xtensa targets have no threads, frames are read when
+ *    vidSourceAcquire() finds the ring empty.
+ *
+ *    Each ring slot carries one xvFrame per plane, set up on the slot's
+ *    buffer, so frames can be handed to the Tile Manager without copies.
+ *
+ * ****************************************************************************/
+
+#ifndef __VID_STREAM_H__
+#define __VID_STREAM_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include "tileManager.h"
+
+#define VID_MAX_RING_SIZE  8
+
+typedef enum
+{
+  VID_FORMAT_Y4M = 0,
+  VID_FORMAT_YUV420,     // Planar Y, U, V
+  VID_FORMAT_NV12        // Planar Y, interleaved UV
+} vidFormat_t;
+
+typedef enum
+{
+  VID_SUCCESS        = 0,
+  VID_ERROR_BAD_ARG  = -1,
+  VID_ERROR_OPEN     = -2,
+  VID_ERROR_FORMAT   = -3,
+  VID_ERROR_ALLOC    = -4,
+  VID_ERROR_READ     = -5,
+  VID_ERROR_WRITE    = -6,
+  VID_ERROR_THREAD   = -7,
+  VID_ERROR_UNSUPPORTED = -8
+} vidError_t;
+
+typedef struct vidFrameStruct
+{
+  uint8_t *pPlane[3];   // Y, U, V. For NV12 Y, UV and NULL
+  int32_t pitch[3];     // Bytes per row of each plane
+  int32_t numPlanes;
+  int32_t width;        // Luma width
+  int32_t height;       // Luma height
+  int32_t frameIndex;   // Position in the stream
+  xvFrame plane[3];     // Frames set up on the planes, borders zero padded
+  uint8_t *pBuff;       // Buffer owned by the ring slot
+} VidFrame;
+
+typedef struct vidSourceStruct
+{
+  FILE     *fp;
+  int32_t  format;
+  int32_t  width;
+  int32_t  height;
+  int32_t  fpsNum;      // Frame rate from Y4M header, 30/1 for raw files
+  int32_t  fpsDen;
+  int32_t  frameSize;   // Bytes of pixel data per frame
+  int32_t  ringSize;
+  int32_t  head;        // Next slot filled by the reader
+  int32_t  tail;        // Next slot handed out by vidSourceAcquire()
+  int32_t  readyCount;  // Slots holding frames not yet handed out
+  int32_t  freeCount;   // Slots the reader can fill
+  int32_t  framesRead;
+  int32_t  eos;
+  int32_t  error;
+  int32_t  stop;
+  struct vidSyncStruct *pSync;
+  VidFrame slot[VID_MAX_RING_SIZE];
+} VidSource;
+
+typedef struct vidSinkStruct
+{
+  FILE    *fp;
+  int32_t format;
+  int32_t width;
+  int32_t height;
+  int32_t framesWritten;
+} VidSink;
+
+// Opens a video file and starts reading frames into the ring
+// pSrc     - Video source object
+// filename - Name of the file
+// format   - vidFormat_t value
+// width    - Luma width, ignored for Y4M
+// height   - Luma height, ignored for Y4M
+// ringSize - Number of frame buffers, 2 to VID_MAX_RING_SIZE
+// Returns VID_SUCCESS or one of vidError_t
+int32_t vidSourceOpen(VidSource *pSrc, const char *filename, int32_t format, int32_t width, int32_t height, int32_t ringSize);
+
+// Returns the next frame of the stream, waits until it is loaded.
+// Frames have to be released in the order they were acquired.
+// Returns NULL at end of stream or on error, pSrc->error tells which.
+VidFrame *vidSourceAcquire(VidSource *pSrc);
+
+// Returns a frame buffer to the ring so the reader can refill it
+// Returns VID_SUCCESS or one of vidError_t
+int32_t vidSourceRelease(VidSource *pSrc, VidFrame *pFrame);
+
+// Stops the reader and releases all buffers
+void vidSourceClose(VidSource *pSrc);
+
+// Creates a video file. Y4M files get a 4:2:0 header with the given frame rate.
+// pSink    - Video sink object
+// filename - Name of the file, overwritten if it exists
+// format   - vidFormat_t value
+// width    - Luma width
+// height   - Luma height
+// fpsNum   - Frame rate numerator, used for Y4M
+// fpsDen   - Frame rate denominator, used for Y4M
+// Returns VID_SUCCESS or one of vidError_t
+int32_t vidSinkOpen(VidSink *pSink, const char *filename, int32_t format, int32_t width, int32_t height, int32_t fpsNum, int32_t fpsDen);
+
+// Appends a frame. Planes are written row by row using the frame's pitches.
+// Returns VID_SUCCESS or one of vidError_t
+int32_t vidSinkWrite(VidSink *pSink, const VidFrame *pFrame);
+
+// Closes the video file
+// Returns VID_SUCCESS or one of vidError_t
+int32_t vidSinkClose(VidSink *pSink);
+
+// Returns a description of a vidError_t value
+const char *vidErrorString(int32_t error);
+
+#endif
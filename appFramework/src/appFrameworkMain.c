@@ -28,11 +28,15 @@
 #include <string.h>
 #define _USE_MATH_DEFINES
 #include <math.h>
+#include <time.h>
 
 #include "tileManager.h"
 #include "commonDef.h"
 #include "defines.h"
 #include "img_utils.h"
+#include "img_map.h"
+#include "vid_stream.h"
+#include "tileGraph.h"
 
 #if defined(__XTENSA__)
 #include <sys/times.h>
@@ -52,14 +56,15 @@ typedef struct intrCallbackDataStruct
 
 uint8_t ALIGN64 pBankBuffPool0[POOL_SIZE] _LOCAL_DRAM0_;
 uint8_t ALIGN64 pBankBuffPool1[POOL_SIZE] _LOCAL_DRAM1_;
-//uint8_t ALIGN64 memDstFrame[IMAGE_WIDTH * IMAGE_HEIGHT];
-uint8_t ALIGN64 memDstFrame[1920*1080];
 
 xvTileManager xvTMobj _LOCAL_DRAM1_;
-IDMA_BUFFER_DEFINE(idmaObjBuff, DMA_DESCR_CNT, IDMA_2D_DESC);
+IDMA_BUFFER_DEFINE(idmaObjBuff, DMA_DESCR_CNT, XVTM_DESC_TYPE);
 
 intrCbDataStruct cbData _LOCAL_DRAM0_;
 
+// Kernels applied by processData()
+xvTileGraph procGraph;
+
 // IDMA error callback function
 void errCallbackFunc(const idma_error_details_t* data)
 {
@@ -83,39 +88,24 @@ void intrCallbackFunc(void *pCallBackStr)
 
 /* ***********************************************************************
  * FUNCTION: processData()
- * DESCRIPTION: This is a place holder function for data processing.
- *				Currently data from input tile is copied into output tile
+ * DESCRIPTION: Runs the kernels of procGraph on the input tile and writes the
+ *				result into output tile. Input tile edges hold the graph halo.
  * INPUTS:
+ *          xvTileManager* pxvTM
  *          xvTile* pInTile
  * OUTPUTS:
  *          xvTile* pOutTile
+ *          Returns XVTM_ERROR if kernel fails, else XVTM_SUCCESS
  ************************************************************************/
 
-void processData(xvTile* pInTile, xvTile* pOutTile)
+int32_t processData(xvTileManager *pxvTM, xvTile* pInTile, xvTile* pOutTile)
 {
-  int32_t indx, indy, index, width, height, pitch;
-  uint8_t *pSrc, *pDst;
   XV_TILE_SET_WIDTH(pOutTile, XV_TILE_GET_WIDTH(pInTile));
-  XV_TILE_SET_PITCH(pOutTile, XV_TILE_GET_PITCH(pInTile));
   XV_TILE_SET_HEIGHT(pOutTile, XV_TILE_GET_HEIGHT(pInTile));
   XV_TILE_SET_X_COORD(pOutTile, XV_TILE_GET_X_COORD(pInTile));
   XV_TILE_SET_Y_COORD(pOutTile, XV_TILE_GET_Y_COORD(pInTile));
 
-  width  = XV_TILE_GET_WIDTH(pInTile);
-  height = XV_TILE_GET_HEIGHT(pInTile);
-  pitch  = XV_TILE_GET_PITCH(pInTile);
-
-  pSrc = (uint8_t *) XV_TILE_GET_DATA_PTR(pInTile);
-  pDst = (uint8_t *) XV_TILE_GET_DATA_PTR(pOutTile);
-
-  for (indy = 0; indy < height; indy++)
-  {
-    for (indx = 0; indx < width; indx++)
-    {
-      index       = indy * pitch + indx;
-      pDst[index] = pSrc[index];
-    }
-  }
+  return(xvExecuteTileGraph(pxvTM, &procGraph, pInTile, pOutTile));
 }
 
 #include <idma.h>
@@ -132,39 +122,302 @@ void idmaLogHander (const char* str)
  *  data transfer is initiated for first two input tiles,
  *  one for ping buffer and other for pong buffer.
  *
- *  In the main for loop, once the input data transfer
+ *  In the main loop, once the input data transfer
  *  is completed for the earlier input buffer,
  *  tile is processed and result is written into output tile.
  *  Output tile data transfer is initiated
- *  Next tile from the input frame is transferred to current input tile
+ *  Next tile is transferred to current input tile
  *  We flip the ping pong flag and continue with the loop
  *
+ *  The tile pipeline works on a queue of frames. Once the last tile of a
+ *  frame is fetched, the next tile comes from the next queued frame, so
+ *  the DMA queue is not drained at frame boundaries. A frame completes
+ *  when the output transfer of its last tile is done.
+ *
  */
+
+#define PIPE_MAX_FRAMES  2
+
+// Video frames are double buffered so a frame can be written while the next one is processed
+#ifdef VIDEO_INPUT
+#define NUM_OUT_FRAMES   PIPE_MAX_FRAMES
+#else
+#define NUM_OUT_FRAMES   1
+#endif
+
+typedef struct procStatsStruct
+{
+  int32_t tileCount;
+  int32_t totalCycles;     // Cycles spent in processData()
+  int32_t totalCycles2;    // Cycles spent requesting output transfers
+} procStats;
+
+typedef struct frameJobStruct
+{
+  xvFrame *pInFrame;
+  xvFrame *pOutFrame;
+  void    *pUser;          // Caller data, returned with the completed frame
+  int32_t tilesFetched;
+  int32_t tilesProcessed;
+} frameJob;
+
+typedef struct tilePipeStruct
+{
+  xvTile   *pInTile[2];
+  xvTile   *pOutTile[2];
+  frameJob *pLastOut[2];   // Frame whose last tile was transferred out from pOutTile[i]
+  frameJob job[PIPE_MAX_FRAMES];
+  int32_t  head;           // Oldest frame in the queue
+  int32_t  numJobs;
+  int32_t  numTilesX;
+  int32_t  numTiles;       // Full tiles per frame
+  int32_t  inFlight;       // Input tiles requested and not yet processed
+  int32_t  fetchFlag;      // Ping pong flag of next input transfer
+  int32_t  procFlag;       // Ping pong flag of next tile to process
+} tilePipe;
+
+/* ***********************************************************************
+ * FUNCTION: pipeInit()
+ * DESCRIPTION: Resets the tile pipeline. Frames have IMAGE_WIDTH x
+ *				IMAGE_HEIGHT pixels, only full tiles are processed.
+ * INPUTS:
+ *          xvTile* pInTile[2] : input ping pong tiles
+ *          xvTile* pOutTile[2] : output ping pong tiles
+ * OUTPUTS:
+ *          tilePipe* pPipe
+ *          Returns XVTM_ERROR if the frame holds no full tile, else XVTM_SUCCESS
+ ************************************************************************/
+int32_t pipeInit(tilePipe *pPipe, xvTile *pInTile[2], xvTile *pOutTile[2])
+{
+  memset(pPipe, 0, sizeof(tilePipe));
+  pPipe->pInTile[0]  = pInTile[0];
+  pPipe->pInTile[1]  = pInTile[1];
+  pPipe->pOutTile[0] = pOutTile[0];
+  pPipe->pOutTile[1] = pOutTile[1];
+  pPipe->numTilesX   = IMAGE_WIDTH / TILE_WIDTH;
+  pPipe->numTiles    = pPipe->numTilesX * (IMAGE_HEIGHT / TILE_HEIGHT);
+
+  // A frame without tiles would never complete
+  return((pPipe->numTiles > 0) ? XVTM_SUCCESS : XVTM_ERROR);
+}
+
+/* ***********************************************************************
+ * FUNCTION: pipeFetch()
+ * DESCRIPTION: Requests input transfers until both input tiles are in
+ *				flight or all queued frames are fetched.
+ * INPUTS:
+ *          xvTileManager* pxvTM
+ *          tilePipe* pPipe
+ * OUTPUTS:
+ *          Returns XVTM_ERROR if it encounters an error, else XVTM_SUCCESS
+ ************************************************************************/
+int32_t pipeFetch(xvTileManager *pxvTM, tilePipe *pPipe)
+{
+  frameJob *pJob;
+  xvTile *pTile;
+  int32_t indx, tileIdx;
+
+  for (indx = 0; (indx < pPipe->numJobs) && (pPipe->inFlight < 2); indx++)
+  {
+    pJob = &pPipe->job[(pPipe->head + indx) % PIPE_MAX_FRAMES];
+    while ((pJob->tilesFetched < pPipe->numTiles) && (pPipe->inFlight < 2))
+    {
+      tileIdx = pJob->tilesFetched;
+      pTile   = pPipe->pInTile[pPipe->fetchFlag];
+      XV_TILE_SET_FRAME_PTR(pTile, pJob->pInFrame);
+      XV_TILE_SET_X_COORD(pTile, (tileIdx % pPipe->numTilesX) * TILE_WIDTH);
+      XV_TILE_SET_Y_COORD(pTile, (tileIdx / pPipe->numTilesX) * TILE_HEIGHT);
+      if (xvReqTileTransferIn(pxvTM, pTile, NULL, INTERRUPT_ON_COMPLETION) == XVTM_ERROR)
+      {
+        xvGetErrorInfo(pxvTM);
+        return(XVTM_ERROR);
+      }
+      pJob->tilesFetched++;
+      pPipe->inFlight++;
+      pPipe->fetchFlag ^= 0x1;
+    }
+  }
+  return(XVTM_SUCCESS);
+}
+
+/* ***********************************************************************
+ * FUNCTION: pipeSubmitFrame()
+ * DESCRIPTION: Queues a frame. Its first tiles are fetched right away if
+ *				an input tile is free.
+ * INPUTS:
+ *          xvTileManager* pxvTM
+ *          tilePipe* pPipe
+ *          xvFrame* pInFrame : input frame
+ *          xvFrame* pOutFrame : output frame, not used by other queued frames
+ *          void* pUser : caller data
+ * OUTPUTS:
+ *          Returns XVTM_ERROR if the queue is full or on error, else XVTM_SUCCESS
+ ************************************************************************/
+int32_t pipeSubmitFrame(xvTileManager *pxvTM, tilePipe *pPipe, xvFrame *pInFrame, xvFrame *pOutFrame, void *pUser)
+{
+  frameJob *pJob;
+
+  if ((pPipe->numJobs == PIPE_MAX_FRAMES) || (pPipe->numTiles == 0))
+  {
+    return(XVTM_ERROR);
+  }
+
+  pJob                 = &pPipe->job[(pPipe->head + pPipe->numJobs) % PIPE_MAX_FRAMES];
+  pJob->pInFrame       = pInFrame;
+  pJob->pOutFrame      = pOutFrame;
+  pJob->pUser          = pUser;
+  pJob->tilesFetched   = 0;
+  pJob->tilesProcessed = 0;
+  pPipe->numJobs++;
+  return(pipeFetch(pxvTM, pPipe));
+}
+
+/* ***********************************************************************
+ * FUNCTION: pipeStep()
+ * DESCRIPTION: Processes the next tile and starts the next input
+ *				transfer. When no tile is left, waits for the oldest
+ *				pending output. Completed frames are removed from the
+ *				queue in submission order.
+ * INPUTS:
+ *          xvTileManager* pxvTM
+ *          tilePipe* pPipe
+ * OUTPUTS:
+ *          procStats* pStats : updated tile count and cycles
+ *          frameJob** ppDone : completed frame, NULL if none. Valid until
+ *				the next pipeSubmitFrame() call.
+ *          Returns XVTM_ERROR if it encounters an error, else XVTM_SUCCESS
+ ************************************************************************/
+int32_t pipeStep(xvTileManager *pxvTM, tilePipe *pPipe, procStats *pStats, frameJob **ppDone)
+{
+  int32_t flag = pPipe->procFlag;
+  int32_t indx, retVal;
+  int32_t cycleStart, cycleStop, cycleStart2, cycleStop2;
+  frameJob *pJob;
+
+  *ppDone = NULL;
+
+  // Nothing to process, flush the oldest pending output
+  if ((pPipe->inFlight == 0) && (pPipe->pLastOut[flag] == NULL))
+  {
+    flag ^= 0x1;
+  }
+
+  // Output tile is about to be reused or flushed. If it holds the last
+  // tile of a frame, that frame is complete once the transfer is done.
+  if (pPipe->pLastOut[flag] != NULL)
+  {
+    WAIT_FOR_TILE(pxvTM, pPipe->pOutTile[flag]);
+    *ppDone               = pPipe->pLastOut[flag];
+    pPipe->pLastOut[flag] = NULL;
+    pPipe->head           = (pPipe->head + 1) % PIPE_MAX_FRAMES;
+    pPipe->numJobs--;
+  }
+
+  if (pPipe->inFlight == 0)
+  {
+    return(XVTM_SUCCESS);
+  }
+
+  // Tiles are processed in fetch order, find the frame of this tile
+  pJob = &pPipe->job[pPipe->head];
+  for (indx = 0; (indx < pPipe->numJobs) && (pJob->tilesProcessed == pPipe->numTiles); indx++)
+  {
+    pJob = &pPipe->job[(pPipe->head + indx + 1) % PIPE_MAX_FRAMES];
+  }
+
+  WAIT_FOR_TILE(pxvTM, pPipe->pInTile[flag]);
+  if(XVTM_IS_TRANSFER_SUCCESS(pxvTM) == 0)
+  {
+    // If iDMA error occurs, application can either reset the DMA, return from the current function or can exit.
+    // In this example, iDMA is initialized again.
+    // Application needs to reset the exception and iDMA if it needs to use Tile Manager again.
+    XVTM_RESET_EXCEPTION();
+    retVal = xvInitIdma(pxvTM, (idma_buffer_t *) idmaObjBuff, DMA_DESCR_CNT, MAX_BLOCK_16, MAX_PIF, errCallbackFunc, intrCallbackFunc, (void *) &cbData);
+    if (retVal == XVTM_ERROR)
+    {
+      xvGetErrorInfo(pxvTM);
+      return(XVTM_ERROR);
+    }
+  }
+
+  // Process the input tile data and write results into output tile
+  XV_TILE_SET_FRAME_PTR(pPipe->pOutTile[flag], pJob->pOutFrame);
+#pragma no_reorder
+  TIME_STAMP(cycleStart);
+#pragma no_reorder
+  retVal = processData(pxvTM, pPipe->pInTile[flag], pPipe->pOutTile[flag]);
+#pragma no_reorder
+  TIME_STAMP(cycleStop);
+#pragma no_reorder
+  if (retVal == XVTM_ERROR)
+  {
+    xvGetErrorInfo(pxvTM);
+    return(XVTM_ERROR);
+  }
+  pStats->tileCount++;
+#ifndef VIDEO_INPUT
+  printf("tileCount =%d cycles=%d\n", pStats->tileCount, cycleStop-cycleStart );
+#endif
+  pStats->totalCycles += (cycleStop - cycleStart);
+
+#pragma no_reorder
+  TIME_STAMP(cycleStart2);
+#pragma no_reorder
+  // Initiate transfer from output tile data to output frame
+  retVal = xvReqTileTransferOut(pxvTM, pPipe->pOutTile[flag], INTERRUPT_ON_COMPLETION);
+#pragma no_reorder
+  TIME_STAMP(cycleStop2);
+  pStats->totalCycles2 += (cycleStop2 - cycleStart2);
+  if (retVal == XVTM_ERROR)
+  {
+    xvGetErrorInfo(pxvTM);
+    return(XVTM_ERROR);
+  }
+
+  pJob->tilesProcessed++;
+  if (pJob->tilesProcessed == pPipe->numTiles)
+  {
+    pPipe->pLastOut[flag] = pJob;
+  }
+  pPipe->inFlight--;
+
+  // flip the ping pong flag and initiate transfer for next input tile
+  pPipe->procFlag = flag ^ 0x1;
+  return(pipeFetch(pxvTM, pPipe));
+}
+
 int main()
 {
 //  USER_DEFINED_HOOKS_STOP();
   // File & directory names
   char fname[256];           // input image name
   char oname[256];           // output image name
-  int32_t str_len;
-
-  // Pointer to PGM image structures
-  PGMImage *image;
-  PGMImage oimage;
 
+#ifdef VIDEO_INPUT
+  // Video source and sink, processed luma is written with the source chroma
+  VidSource vidSrc;
+  VidSink vidSink;
+  VidFrame *pVidFrame, outVidFrame;
+  xvFrame *pFreeOutFrame;
+  int32_t frameCount = 0;
+  clock_t clockStart;
+  float seconds;
+#else
+  // Memory mapped input and output images
+  ImgMap inImage, outImage;
   // Greyscale input frame
   uint8_t *gSrc;
-  uint8_t *gOut;
+#endif
+
+  // Greyscale output frames
+  uint8_t *gOut[NUM_OUT_FRAMES];
   void *buffPool[2];
   int32_t buffSize[2];
-  int32_t cycleStart, cycleStop, totalCycles, tileCount;
-  int32_t cycleStart2, cycleStop2, totalCycles2; //, tileCount2;
-  totalCycles = 0;
-  totalCycles2 = 0;
-  tileCount   = 0;
-
-  // Source image dimensions and bit depth
-  int32_t srcWidth, srcHeight, srcBytes;
+  procStats stats = { 0, 0, 0 };
+  tilePipe pipe;
+  frameJob *pDone;
+  int32_t indx;
+
   int32_t alignType = EDGE_ALIGNED_64;
 
   // Source and destination tiles. Will be working in ping pong mode.
@@ -172,21 +425,76 @@ int main()
   // Data buffer pointers for source and destination tiles
   void *pinTileBuff[2], *poutTileBuff[2];
   // Source and destination frames
-  xvFrame *pInFrame, *pOutFrame;
-  // Indexes and flags
-  int32_t dstx, dsty, pingPongFlag = 0;
-  int32_t retVal, tileBuffSize, frameSize;
+  xvFrame *pInFrame, *pOutFrame[NUM_OUT_FRAMES];
+  int32_t retVal, tileBuffSize;
+  int32_t inTileBuffSize, inTilePitch, inTileEdge;
 
   xvTileManager *pxvTM = &xvTMobj;
 
-  // Read input image
+#ifdef VIDEO_INPUT
+  // Frames are read ahead into a ring while earlier frames are processed
+  sprintf(fname, VIDEO_INPUT);
+  retVal = vidSourceOpen(&vidSrc, fname, VIDEO_FORMAT, VIDEO_WIDTH, VIDEO_HEIGHT, VIDEO_RING_SIZE);
+  if (retVal != VID_SUCCESS)
+  {
+    printf("Unable to read '%s': %s\n", fname, vidErrorString(retVal));
+    return(RET_ERROR);
+  }
+
+  IMAGE_WIDTH = vidSrc.width;
+  IMAGE_HEIGHT = vidSrc.height;
+
+  sprintf(oname, VIDEO_OUTPUT);
+  retVal = vidSinkOpen(&vidSink, oname, VIDEO_FORMAT, IMAGE_WIDTH, IMAGE_HEIGHT, vidSrc.fpsNum, vidSrc.fpsDen);
+  if (retVal != VID_SUCCESS)
+  {
+    printf("Unable to create '%s': %s\n", oname, vidErrorString(retVal));
+    vidSourceClose(&vidSrc);
+    return(RET_ERROR);
+  }
+
+  for (indx = 0; indx < NUM_OUT_FRAMES; indx++)
+  {
+    gOut[indx] = (uint8_t *) calloc(IMAGE_WIDTH * IMAGE_HEIGHT, 1);
+    if (gOut[indx] == NULL)
+    {
+      printf("Unable to allocate output frame\n");
+      vidSourceClose(&vidSrc);
+      vidSinkClose(&vidSink);
+      return(RET_ERROR);
+    }
+  }
+#else
+  // Map input image, frame points directly into the file
   sprintf(fname, "data/Cars_1920x1080.pgm");
   //sprintf(fname, "data/Cars_320x180.pgm");
-  image = (PGMImage *) malloc(sizeof(PGMImage));
-  image = readPGM(fname);
+  retVal = imgMapOpen(&inImage, fname);
+  if (retVal != IMG_SUCCESS)
+  {
+    printf("Unable to read '%s': %s\n", fname, imgMapErrorString(retVal));
+    return(RET_ERROR);
+  }
+  if ((inImage.compWidth != 8) || (inImage.numChannels != 1))
+  {
+    printf("'%s' is not an 8-bit greyscale image\n", fname);
+    imgMapClose(&inImage);
+    return(RET_ERROR);
+  }
 
-  IMAGE_WIDTH = image->x;
-  IMAGE_HEIGHT = image->y;
+  IMAGE_WIDTH = inImage.width;
+  IMAGE_HEIGHT = inImage.height;
+
+  // Output is written directly to a mapped output file
+  int32_t str_len = sprintf(oname, "data/Cars_%dx%d", IMAGE_WIDTH, IMAGE_HEIGHT);
+  sprintf(oname + str_len, "_out.pgm");
+  retVal = imgMapCreate(&outImage, oname, IMAGE_WIDTH, IMAGE_HEIGHT, 1, 8);
+  if (retVal != IMG_SUCCESS)
+  {
+    printf("Unable to create '%s': %s\n", oname, imgMapErrorString(retVal));
+    imgMapClose(&inImage);
+    return(RET_ERROR);
+  }
+#endif
   // Initialize DMA and tile manager objects
   idma_log_handler(idmaLogHander);  
   // Initialize the DMA
@@ -217,30 +525,59 @@ int main()
     return(RET_ERROR);
   }
 
-  // Setup input and output frames.
-  srcWidth  = image->x;
-  srcHeight = image->y;
-  srcBytes  = image->compWidth;
-  gSrc      = (uint8_t *) image->data;
-  gOut      = memDstFrame;
-  frameSize = srcWidth * srcHeight;
-  pInFrame  = xvAllocateFrame(pxvTM);
-  if ((int32_t) pInFrame == XVTM_ERROR)
+  // Build the kernel graph. Intermediate tiles are allocated from the memory banks.
+  retVal = xvInitTileGraph(pxvTM, &procGraph);
+  if (retVal != XVTM_ERROR)
+  {
+    retVal = xvAddTileGraphNode(pxvTM, &procGraph, PROCESS_KERNEL, XV_GRAPH_INPUT, XV_GRAPH_NONE);
+  }
+#ifdef PROCESS_KERNEL_2
+  if (retVal != XVTM_ERROR)
+  {
+    retVal = xvAddTileGraphNode(pxvTM, &procGraph, PROCESS_KERNEL_2, retVal, XV_GRAPH_NONE);
+  }
+#endif
+  if (retVal != XVTM_ERROR)
+  {
+    retVal = xvFinalizeTileGraph(pxvTM, &procGraph, TILE_WIDTH, TILE_HEIGHT);
+  }
+  if (retVal == XVTM_ERROR)
   {
     xvGetErrorInfo(pxvTM);
     return(RET_ERROR);
   }
-  SETUP_FRAME(pInFrame, gSrc, frameSize, srcWidth, srcHeight, srcWidth, 0, 0, 1, 1, FRAME_ZERO_PADDING, 0);
 
-  pOutFrame = xvAllocateFrame(pxvTM);
-  if ((int32_t) pOutFrame == XVTM_ERROR)
+  // Setup input and output frames.
+  pInFrame  = xvAllocateFrame(pxvTM);
+  if ((int32_t) pInFrame == XVTM_ERROR)
   {
     xvGetErrorInfo(pxvTM);
     return(RET_ERROR);
   }
-  SETUP_FRAME(pOutFrame, gOut, frameSize, IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_WIDTH, 0, 0, 1, 1, FRAME_ZERO_PADDING, 0);
+#ifndef VIDEO_INPUT
+  gSrc      = inImage.pData;
+  gOut[0]   = outImage.pData;
+  imgMapSetupFrame(&inImage, pInFrame, FRAME_ZERO_PADDING, 0);
+#endif
 
-  memset(gOut, 0, IMAGE_WIDTH * IMAGE_HEIGHT);
+  for (indx = 0; indx < NUM_OUT_FRAMES; indx++)
+  {
+    pOutFrame[indx] = xvAllocateFrame(pxvTM);
+    if ((int32_t) pOutFrame[indx] == XVTM_ERROR)
+    {
+      xvGetErrorInfo(pxvTM);
+      return(RET_ERROR);
+    }
+  }
+#ifdef VIDEO_INPUT
+  for (indx = 0; indx < NUM_OUT_FRAMES; indx++)
+  {
+    SETUP_FRAME(pOutFrame[indx], gOut[indx], IMAGE_WIDTH * IMAGE_HEIGHT, IMAGE_WIDTH, IMAGE_HEIGHT, IMAGE_WIDTH, 0, 0, 1, 1, FRAME_ZERO_PADDING, 0);
+  }
+#else
+  // Output file is created zero filled
+  imgMapSetupFrame(&outImage, pOutFrame[0], FRAME_ZERO_PADDING, 0);
+#endif
 
   // Reset the interrupt count in the cbData structure
   cbData.intrCount = 0;
@@ -253,8 +590,11 @@ int main()
   // Allocate buffers for source and destination tiles.
   // Memory is allocated from memory banks.
   // Allocate the tiles and initialize the elements
+  // Input tiles carry the halo of the kernel graph as tile edges
   tileBuffSize   = TILE_WIDTH * TILE_HEIGHT;
-  pinTileBuff[0] = xvAllocateBuffer(pxvTM, tileBuffSize, XV_MEM_BANK_COLOR_0, 64);
+  inTileEdge     = xvGetTileGraphHalo(&procGraph);
+  inTileBuffSize = xvGetHaloTileBuffSize(TILE_WIDTH, TILE_HEIGHT, inTileEdge, 1, alignType, &inTilePitch);
+  pinTileBuff[0] = xvAllocateBuffer(pxvTM, inTileBuffSize, XV_MEM_BANK_COLOR_0, 64);
   if ((int32_t) pinTileBuff[0] == XVTM_ERROR)
   {
     xvGetErrorInfo(pxvTM);
@@ -268,12 +608,12 @@ int main()
     return(RET_ERROR);
   }
 #ifndef ERROR_CALLBACK_TEST
-  SETUP_TILE(pInTile[0], pinTileBuff[0], tileBuffSize, pInFrame, TILE_WIDTH, TILE_HEIGHT, TILE_WIDTH, XV_TILE_U8, 0, 0, 0, 0, alignType);
+  SETUP_TILE(pInTile[0], pinTileBuff[0], inTileBuffSize, pInFrame, TILE_WIDTH, TILE_HEIGHT, inTilePitch, XV_TILE_U8, inTileEdge, inTileEdge, 0, 0, alignType);
 #else
   SETUP_TILE(pInTile[0], XV_FRAME_GET_BUFF_PTR(pInFrame), tileBuffSize, pInFrame, TILE_WIDTH, TILE_HEIGHT, TILE_WIDTH, XV_TILE_U8, 0, 0, 0, 0, alignType);
 #endif
 
-  pinTileBuff[1] = xvAllocateBuffer(pxvTM, tileBuffSize, XV_MEM_BANK_COLOR_0, 64);
+  pinTileBuff[1] = xvAllocateBuffer(pxvTM, inTileBuffSize, XV_MEM_BANK_COLOR_0, 64);
   if ((int32_t) pinTileBuff[1] == XVTM_ERROR)
   {
     xvGetErrorInfo(pxvTM);
@@ -286,7 +626,7 @@ int main()
     xvGetErrorInfo(pxvTM);
     return(RET_ERROR);
   }
-  SETUP_TILE(pInTile[1], pinTileBuff[1], tileBuffSize, pInFrame, TILE_WIDTH, TILE_HEIGHT, TILE_WIDTH, XV_TILE_U8, 0, 0, 0, 0, alignType);
+  SETUP_TILE(pInTile[1], pinTileBuff[1], inTileBuffSize, pInFrame, TILE_WIDTH, TILE_HEIGHT, inTilePitch, XV_TILE_U8, inTileEdge, inTileEdge, 0, 0, alignType);
 
   /////////////////////////// 
   //inner pout
@@ -303,7 +643,7 @@ int main()
     xvGetErrorInfo(pxvTM);
     return(RET_ERROR);
   }
-  SETUP_TILE(pOutTile[0], poutTileBuff[0], tileBuffSize, pOutFrame, TILE_WIDTH, TILE_HEIGHT, TILE_WIDTH, XV_TILE_U8, 0, 0, 0, 0, alignType);
+  SETUP_TILE(pOutTile[0], poutTileBuff[0], tileBuffSize, pOutFrame[0], TILE_WIDTH, TILE_HEIGHT, TILE_WIDTH, XV_TILE_U8, 0, 0, 0, 0, alignType);
 
   poutTileBuff[1] = xvAllocateBuffer(pxvTM, tileBuffSize, XV_MEM_BANK_COLOR_1, 64);
   if ((int32_t) poutTileBuff[1] == XVTM_ERROR)
@@ -318,160 +658,137 @@ int main()
     xvGetErrorInfo(pxvTM);
     return(RET_ERROR);
   }
-  SETUP_TILE(pOutTile[1], poutTileBuff[1], tileBuffSize, pOutFrame, TILE_WIDTH, TILE_HEIGHT, TILE_WIDTH, XV_TILE_U8, 0, 0, 0, 0, alignType);
+  SETUP_TILE(pOutTile[1], poutTileBuff[1], tileBuffSize, pOutFrame[0], TILE_WIDTH, TILE_HEIGHT, TILE_WIDTH, XV_TILE_U8, 0, 0, 0, 0, alignType);
 
 
-  /////////////////////////// 
-  //END
-
-  pingPongFlag = 0;
-  int32_t tmIndX = 0;
-  int32_t tmIndY = 0;
-
-  XV_TILE_SET_X_COORD(pInTile[pingPongFlag], tmIndX);
-  XV_TILE_SET_Y_COORD(pInTile[pingPongFlag], tmIndY);
-  // Initiate data transfer of first tile into ping buffer
-  retVal = xvReqTileTransferIn(pxvTM, pInTile[pingPongFlag], NULL, INTERRUPT_ON_COMPLETION);
-  if (retVal == XVTM_ERROR)
+  int32_t result = 0;
+  if (pipeInit(&pipe, pInTile, pOutTile) == XVTM_ERROR)
   {
-    xvGetErrorInfo(pxvTM);
+    printf("Image %dx%d is smaller than a %dx%d tile\n", IMAGE_WIDTH, IMAGE_HEIGHT, TILE_WIDTH, TILE_HEIGHT);
     return(RET_ERROR);
   }
-
-  pingPongFlag = pingPongFlag ^ 0x1;
-  tmIndX      += TILE_WIDTH;
-  if (tmIndX >= IMAGE_WIDTH || (tmIndX + TILE_WIDTH) > IMAGE_WIDTH)
+#ifdef VIDEO_INPUT
+  // Luma of each frame is tiled through the pipeline directly from the
+  // source ring. Up to PIPE_MAX_FRAMES frames are queued, so the first
+  // tiles of the next frame are fetched while the current one drains.
+  clockStart = clock();
+  for (indx = 0; indx < NUM_OUT_FRAMES; indx++)
   {
-    tmIndY += TILE_HEIGHT;
-    tmIndX  = 0;
-    if (tmIndY >= IMAGE_HEIGHT || (tmIndY + TILE_HEIGHT) > IMAGE_HEIGHT)
+    pVidFrame = vidSourceAcquire(&vidSrc);
+    if (pVidFrame == NULL)
     {
-      tmIndY = 0;
+      break;
     }
-  }
-
-  XV_TILE_SET_X_COORD(pInTile[pingPongFlag], tmIndX);
-  XV_TILE_SET_Y_COORD(pInTile[pingPongFlag], tmIndY);
-  // Initiate data transfer of second tile into pong buffer
-  retVal = xvReqTileTransferIn(pxvTM, pInTile[pingPongFlag], NULL, INTERRUPT_ON_COMPLETION);
-  if (retVal == XVTM_ERROR)
-  {
-    xvGetErrorInfo(pxvTM);
-    return(RET_ERROR);
-  }
-
-  pingPongFlag = pingPongFlag ^ 0x1;
-  tmIndX      += TILE_WIDTH;
-  if (tmIndX >= IMAGE_WIDTH || (tmIndX + TILE_WIDTH) > IMAGE_WIDTH)
-  {
-    tmIndY += TILE_HEIGHT;
-    tmIndX  = 0;
-    if (tmIndY >= IMAGE_HEIGHT || (tmIndY + TILE_HEIGHT) > IMAGE_HEIGHT)
+    retVal = pipeSubmitFrame(pxvTM, &pipe, &pVidFrame->plane[0], pOutFrame[indx], pVidFrame);
+    if (retVal == XVTM_ERROR)
     {
-      tmIndY = 0;
+      return(RET_ERROR);
     }
   }
 
-  for (dsty = 0; dsty < IMAGE_HEIGHT; dsty += TILE_HEIGHT)
+  while (pipe.numJobs > 0)
   {
-    for (dstx = 0; dstx < IMAGE_WIDTH; dstx += TILE_WIDTH)
+    retVal = pipeStep(pxvTM, &pipe, &stats, &pDone);
+    if (retVal == XVTM_ERROR)
     {
-      WAIT_FOR_TILE(pxvTM, pInTile[pingPongFlag]);
-      if(XVTM_IS_TRANSFER_SUCCESS(pxvTM) == 0)
-      {
-	    // If iDMA error occurs, application can either reset the DMA, return from the current function or can exit.
-		// In this example, iDMA is initialized again. 
-		// Application needs to reset the exception and iDMA if it needs to use Tile Manager again.
-  	    XVTM_RESET_EXCEPTION();
-        retVal = xvInitIdma(pxvTM, (idma_buffer_t *) idmaObjBuff, DMA_DESCR_CNT, MAX_BLOCK_16, MAX_PIF, errCallbackFunc, intrCallbackFunc, (void *) &cbData);
-        if (retVal == XVTM_ERROR)
-        {
-          xvGetErrorInfo(pxvTM);
-          return(RET_ERROR);
-        }
-      }
-      // Process the input tile data and write results into output tile
-  //    USER_DEFINED_HOOKS_START();
-#pragma no_reorder
-      TIME_STAMP(cycleStart);
-#pragma no_reorder
-      processData(pInTile[pingPongFlag], pOutTile[pingPongFlag]);
-#pragma no_reorder
-      TIME_STAMP(cycleStop);
-#pragma no_reorder
-    //  USER_DEFINED_HOOKS_STOP();
-      tileCount++;
-      printf("tileCount =%d cycles=%d\n", tileCount, cycleStop-cycleStart );
-      totalCycles += (cycleStop - cycleStart);
-
-#pragma no_reorder
-      TIME_STAMP(cycleStart2);
-#pragma no_reorder
-      // Initiate transfer from output tile data to output frame
-      retVal = xvReqTileTransferOut(pxvTM, pOutTile[pingPongFlag], INTERRUPT_ON_COMPLETION);
-#pragma no_reorder
-      TIME_STAMP(cycleStop2);
-      totalCycles2 += (cycleStop2 - cycleStart2);
+      return(RET_ERROR);
+    }
+    if (pDone == NULL)
+    {
+      continue;
+    }
 
+    pVidFrame     = (VidFrame *) pDone->pUser;
+    pFreeOutFrame = pDone->pOutFrame;
+#ifndef PROCESS_KERNEL_2
+    if (PROCESS_KERNEL == XV_KERNEL_COPY_U8)
+    {
+      result |= checkImage(pVidFrame->pPlane[0], (uint8_t *) XV_FRAME_GET_BUFF_PTR(pFreeOutFrame), IMAGE_WIDTH / TILE_WIDTH * TILE_WIDTH, IMAGE_HEIGHT / TILE_HEIGHT * TILE_HEIGHT, IMAGE_WIDTH);
+    }
+#endif
 
-      if (retVal == XVTM_ERROR)
-      {
-        xvGetErrorInfo(pxvTM);
-        return(RET_ERROR);
-      }
+    outVidFrame           = *pVidFrame;
+    outVidFrame.pPlane[0] = (uint8_t *) XV_FRAME_GET_BUFF_PTR(pFreeOutFrame);
+    outVidFrame.pitch[0]  = IMAGE_WIDTH;
+    retVal                = vidSinkWrite(&vidSink, &outVidFrame);
+    vidSourceRelease(&vidSrc, pVidFrame);
+    if (retVal != VID_SUCCESS)
+    {
+      printf("Unable to write '%s': %s\n", oname, vidErrorString(retVal));
+      return(RET_ERROR);
+    }
+    frameCount++;
 
-      // Initiate transfer for next input tile
-      XV_TILE_SET_X_COORD(pInTile[pingPongFlag], tmIndX);
-      XV_TILE_SET_Y_COORD(pInTile[pingPongFlag], tmIndY);
-      retVal = xvReqTileTransferIn(pxvTM, pInTile[pingPongFlag], NULL, INTERRUPT_ON_COMPLETION);
+    // Queue the next frame on the output frame just written
+    pVidFrame = vidSourceAcquire(&vidSrc);
+    if (pVidFrame != NULL)
+    {
+      retVal = pipeSubmitFrame(pxvTM, &pipe, &pVidFrame->plane[0], pFreeOutFrame, pVidFrame);
       if (retVal == XVTM_ERROR)
       {
-        xvGetErrorInfo(pxvTM);
         return(RET_ERROR);
       }
-
-      // flip the ping pong flag
-      pingPongFlag = pingPongFlag ^ 0x1;
-      tmIndX      += TILE_WIDTH;
-      if (tmIndX >= IMAGE_WIDTH || (tmIndX + TILE_WIDTH) > IMAGE_WIDTH)
-      {
-        tmIndY += TILE_HEIGHT;
-        tmIndX  = 0;
-        if (tmIndY >= IMAGE_HEIGHT)
-        {
-          tmIndY = 0;
-        }
-      }
     }
   }
-
-  // Wait for the last output tile transfer
-  WAIT_FOR_TILE(pxvTM, pOutTile[pingPongFlag ^ 0x01]);
-  oimage.compWidth = 8;
-  //write output
-  oimage.x    = IMAGE_WIDTH;
-  oimage.y    = IMAGE_HEIGHT;
-  oimage.data = gOut;
-  str_len     = sprintf(oname, "data/Cars_%dx%d", oimage.x, oimage.y);
-  str_len     = sprintf(oname + str_len, "_out.pgm");
+  seconds = (float) (clock() - clockStart) / (float) CLOCKS_PER_SEC;
+  if (vidSrc.error != VID_SUCCESS)
+  {
+    printf("Error reading '%s': %s\n", fname, vidErrorString(vidSrc.error));
+    result = 1;
+  }
+  printf("Frames: %d, %f s, %f fps\n", frameCount, seconds, (seconds > 0.0f) ? (float) frameCount / seconds : 0.0f);
+#else
+  retVal = pipeSubmitFrame(pxvTM, &pipe, pInFrame, pOutFrame[0], NULL);
+  while ((retVal != XVTM_ERROR) && (pipe.numJobs > 0))
+  {
+    retVal = pipeStep(pxvTM, &pipe, &stats, &pDone);
+  }
+  if (retVal == XVTM_ERROR)
+  {
+    return(RET_ERROR);
+  }
+#ifndef PROCESS_KERNEL_2
+  if (PROCESS_KERNEL == XV_KERNEL_COPY_U8)
+  {
+    result = checkImage(gSrc, gOut[0], IMAGE_WIDTH / TILE_WIDTH * TILE_WIDTH, IMAGE_HEIGHT / TILE_HEIGHT * TILE_HEIGHT, IMAGE_WIDTH);
+  }
+#endif
+#endif
   printf("Writing Output: %s\n", oname);
-  //writePGM(oname, &oimage);
 
-  printf("Total tiles: %d, Interrupt Count = %d\n", tileCount, cbData.intrCount);
-  int32_t result = checkImage(gSrc, gOut, IMAGE_WIDTH / TILE_WIDTH * TILE_WIDTH, IMAGE_HEIGHT / TILE_HEIGHT * TILE_HEIGHT, IMAGE_WIDTH);
+  printf("Total tiles: %d, Interrupt Count = %d\n", stats.tileCount, cbData.intrCount);
   if (result)
   {
-    printf("\nappFramework\tprocessData\t%f\tCPP\tFAIL\n", (float) totalCycles / (float) (IMAGE_WIDTH * IMAGE_HEIGHT));
+    printf("\nappFramework\tprocessData\t%f\tCPP\tFAIL\n", (float) stats.totalCycles / (float) (stats.tileCount * TILE_WIDTH * TILE_HEIGHT));
   }
   else
   {
-    printf("\nappFramework\tprocessData\t%f\tCPP\tPASS\n", (float) totalCycles / (float) (IMAGE_WIDTH * IMAGE_HEIGHT));
+    printf("\nappFramework\tprocessData\t%f\tCPP\tPASS\n", (float) stats.totalCycles / (float) (stats.tileCount * TILE_WIDTH * TILE_HEIGHT));
   }
 
-  printf("total IDMA config transfer time =%f\n", (float)totalCycles2/(float)tileCount);
-  // Free input image
-  free(gSrc);
-  free(image);
+  printf("total IDMA config transfer time =%f\n", (float)stats.totalCycles2/(float)stats.tileCount);
+#ifdef VIDEO_INPUT
+  vidSourceClose(&vidSrc);
+  for (indx = 0; indx < NUM_OUT_FRAMES; indx++)
+  {
+    free(gOut[indx]);
+  }
+  retVal = vidSinkClose(&vidSink);
+  if (retVal != VID_SUCCESS)
+  {
+    printf("Unable to write '%s': %s\n", oname, vidErrorString(retVal));
+    return(RET_ERROR);
+  }
+#else
+  // Unmap images, output is written to the file
+  imgMapClose(&inImage);
+  retVal = imgMapClose(&outImage);
+  if (retVal != IMG_SUCCESS)
+  {
+    printf("Unable to write '%s': %s\n", oname, imgMapErrorString(retVal));
+    return(RET_ERROR);
+  }
+#endif
 
   // Free frames
   retVal = xvFreeFrame(pxvTM, pInFrame);
@@ -481,11 +798,14 @@ int main()
     return(RET_ERROR);
   }
 
-  retVal = xvFreeFrame(pxvTM, pOutFrame);
-  if (retVal == XVTM_ERROR)
+  for (indx = 0; indx < NUM_OUT_FRAMES; indx++)
   {
-    xvGetErrorInfo(pxvTM);
-    return(RET_ERROR);
+    retVal = xvFreeFrame(pxvTM, pOutFrame[indx]);
+    if (retVal == XVTM_ERROR)
+    {
+      xvGetErrorInfo(pxvTM);
+      return(RET_ERROR);
+    }
   }
 
   // Free tile data buffers
@@ -546,6 +866,14 @@ int main()
     return(RET_ERROR);
   }
 
+  // Free intermediate tiles of the kernel graph
+  retVal = xvFreeTileGraph(pxvTM, &procGraph);
+  if (retVal == XVTM_ERROR)
+  {
+    xvGetErrorInfo(pxvTM);
+    return(RET_ERROR);
+  }
+
   printf("\nDone\n");
 
   xvResetTileManager(pxvTM);
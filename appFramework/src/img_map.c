@@ -0,0 +1,601 @@
+/*
+ * Copyright (c) 2016 by Cadence Design Systems, Inc.  ALL RIGHTS RESERVED.
+ * These coded instructions, statements, and computer programs are the
+ * copyrighted works and confidential proprietary information of
+ * Cadence Design Systems Inc.  They may be adapted and modified by bona fide
+ * purchasers for internal use, but neither the original nor any adapted
+ * or modified version may be disclosed or distributed to third parties
+ * in any manner, medium, or form, in whole or in part, without the prior
+ * written consent of Cadence Design Systems Inc.  This software and its
+ * derivatives are to be executed solely on products incorporating a Cadence
+ * Design Systems processor.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "img_map.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#define IMG_MAP_WIN32
+#elif !defined(__XTENSA__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define IMG_MAP_POSIX
+#endif
+
+// fileHandle of an image map without a file
+#if defined(IMG_MAP_POSIX)
+#define IMG_NO_FILE       -1
+#else
+#define IMG_NO_FILE       0
+#endif
+
+#define IMG_MAX_DIM       65535
+#define IMG_HEADER_SIZE   64
+
+/* ***********************************************************************
+ * FUNCTION: swapBytes16()
+ * DESCRIPTION: converts 16-bit samples between big-endian file order
+ *              and native order. Does nothing on big-endian cores.
+ * INPUTS:
+ *          uint8_t *pData : pointer to samples
+ *          int32_t size : size in bytes
+ * OUTPUTS:
+ *          NONE
+ ************************************************************************/
+static void swapBytes16(uint8_t *pData, int32_t size)
+{
+  const uint16_t one = 1;
+  int32_t indx;
+  uint8_t tmp;
+
+  if (*(const uint8_t *) &one == 0)
+  {
+    return;
+  }
+  for (indx = 0; indx < size; indx += 2)
+  {
+    tmp             = pData[indx];
+    pData[indx]     = pData[indx + 1];
+    pData[indx + 1] = tmp;
+  }
+}
+
+// White space as defined by the netpbm formats
+static int32_t isHeaderSpace(uint8_t ch)
+{
+  return((ch == ' ') || (ch == '\t') || (ch == '\r') || (ch == '\n') || (ch == '\v') || (ch == '\f'));
+}
+
+/* ***********************************************************************
+ * FUNCTION: readHeaderInt()
+ * DESCRIPTION: reads a decimal header field, skipping white space and
+ *              comments in front of it
+ * INPUTS:
+ *          const uint8_t *pHdr : pointer to file data
+ *          size_t size : size of file data
+ *          size_t *pPos : read position, updated
+ * OUTPUTS:
+ *          int32_t *pVal : value of the field
+ *          return value IMG_SUCCESS or IMG_ERROR_FORMAT
+ ************************************************************************/
+static int32_t readHeaderInt(const uint8_t *pHdr, size_t size, size_t *pPos, int32_t *pVal)
+{
+  size_t pos = *pPos;
+  int32_t val = 0, digits = 0;
+
+  while (pos < size)
+  {
+    if (pHdr[pos] == '#')
+    {
+      while ((pos < size) && (pHdr[pos] != '\n'))
+      {
+        pos++;
+      }
+    }
+    else if (isHeaderSpace(pHdr[pos]))
+    {
+      pos++;
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  while ((pos < size) && (pHdr[pos] >= '0') && (pHdr[pos] <= '9'))
+  {
+    val = val * 10 + (pHdr[pos] - '0');
+    if (val > IMG_MAX_DIM)
+    {
+      return(IMG_ERROR_FORMAT);
+    }
+    pos++;
+    digits++;
+  }
+
+  // A field ends with white space, which the caller checks for at the end
+  // of the file
+  if ((digits == 0) || ((pos < size) && !isHeaderSpace(pHdr[pos])))
+  {
+    return(IMG_ERROR_FORMAT);
+  }
+  *pPos = pos;
+  *pVal = val;
+  return(IMG_SUCCESS);
+}
+
+/* ***********************************************************************
+ * FUNCTION: parseHeader()
+ * DESCRIPTION: parses a P5/P6 header and sets the image description
+ * INPUTS:
+ *          ImgMap *pImg : image map object, pMap and mapSize are set
+ * OUTPUTS:
+ *          return value IMG_SUCCESS or IMG_ERROR_FORMAT
+ ************************************************************************/
+static int32_t parseHeader(ImgMap *pImg)
+{
+  const uint8_t *pHdr = (const uint8_t *) pImg->pMap;
+  size_t pos = 2;
+  int32_t maxVal;
+  int64_t dataSize;
+
+  if ((pImg->mapSize < 3) || (pHdr[0] != 'P') || ((pHdr[1] != '5') && (pHdr[1] != '6')))
+  {
+    return(IMG_ERROR_FORMAT);
+  }
+  pImg->numChannels = (pHdr[1] == '5') ? 1 : 3;
+
+  if ((readHeaderInt(pHdr, pImg->mapSize, &pos, &pImg->width) != IMG_SUCCESS) ||
+      (readHeaderInt(pHdr, pImg->mapSize, &pos, &pImg->height) != IMG_SUCCESS) ||
+      (readHeaderInt(pHdr, pImg->mapSize, &pos, &maxVal) != IMG_SUCCESS))
+  {
+    return(IMG_ERROR_FORMAT);
+  }
+
+  // Exactly one white space character separates header and pixel data
+  if ((pImg->width == 0) || (pImg->height == 0) || (maxVal == 0) || (pos >= pImg->mapSize) ||
+      !isHeaderSpace(pHdr[pos]))
+  {
+    return(IMG_ERROR_FORMAT);
+  }
+  pos++;
+
+  pImg->compWidth = (maxVal > 255) ? 16 : 8;
+  pImg->pitch     = pImg->width * pImg->numChannels;
+  dataSize        = (int64_t) pImg->pitch * pImg->height * (pImg->compWidth / 8);
+  if ((dataSize > 0x7FFFFFFF) || ((uint64_t) dataSize > (uint64_t) (pImg->mapSize - pos)))
+  {
+    return(IMG_ERROR_FORMAT);
+  }
+  pImg->dataSize = (int32_t) dataSize;
+  pImg->pData    = (uint8_t *) pImg->pMap + pos;
+  return(IMG_SUCCESS);
+}
+
+/* ***********************************************************************
+ * FUNCTION: unmapFile()
+ * DESCRIPTION: releases the mapping and the file
+ * INPUTS:
+ *          ImgMap *pImg : image map object
+ * OUTPUTS:
+ *          NONE
+ ************************************************************************/
+static void unmapFile(ImgMap *pImg)
+{
+#if defined(IMG_MAP_WIN32)
+  if (pImg->pMap != NULL)
+  {
+    UnmapViewOfFile(pImg->pMap);
+  }
+  if (pImg->mapHandle != 0)
+  {
+    CloseHandle((HANDLE) pImg->mapHandle);
+  }
+  if (pImg->fileHandle != IMG_NO_FILE)
+  {
+    CloseHandle((HANDLE) pImg->fileHandle);
+  }
+#elif defined(IMG_MAP_POSIX)
+  if (pImg->pMap != NULL)
+  {
+    munmap(pImg->pMap, pImg->mapSize);
+  }
+  if (pImg->fileHandle >= 0)
+  {
+    close((int) pImg->fileHandle);
+  }
+#else
+  free(pImg->pMap);
+  if (pImg->fileHandle != IMG_NO_FILE)
+  {
+    fclose((FILE *) pImg->fileHandle);
+  }
+#endif
+  memset(pImg, 0, sizeof(ImgMap));
+  pImg->fileHandle = IMG_NO_FILE;
+}
+
+/* ***********************************************************************
+ * FUNCTION: syncFile()
+ * DESCRIPTION: writes the mapping to the file. 16-bit samples are
+ *              converted to file order, and back when keepNative is set.
+ * INPUTS:
+ *          ImgMap *pImg : image map object, writable
+ *          int32_t keepNative : restore native sample order after writing
+ * OUTPUTS:
+ *          return value IMG_SUCCESS or IMG_ERROR_WRITE
+ ************************************************************************/
+static int32_t syncFile(ImgMap *pImg, int32_t keepNative)
+{
+  int32_t retVal = IMG_SUCCESS;
+
+  if (pImg->compWidth == 16)
+  {
+    swapBytes16(pImg->pData, pImg->dataSize);
+  }
+
+#if defined(IMG_MAP_WIN32)
+  if (!FlushViewOfFile(pImg->pMap, pImg->mapSize))
+  {
+    retVal = IMG_ERROR_WRITE;
+  }
+#elif defined(IMG_MAP_POSIX)
+  if (msync(pImg->pMap, pImg->mapSize, MS_SYNC) != 0)
+  {
+    retVal = IMG_ERROR_WRITE;
+  }
+#else
+  if ((fseek((FILE *) pImg->fileHandle, 0, SEEK_SET) != 0) ||
+      (fwrite(pImg->pMap, 1, pImg->mapSize, (FILE *) pImg->fileHandle) != pImg->mapSize) ||
+      (fflush((FILE *) pImg->fileHandle) != 0))
+  {
+    retVal = IMG_ERROR_WRITE;
+  }
+#endif
+
+  if ((pImg->compWidth == 16) && keepNative)
+  {
+    swapBytes16(pImg->pData, pImg->dataSize);
+  }
+  return(retVal);
+}
+
+/* ***********************************************************************
+ * FUNCTION: imgMapOpen()
+ * DESCRIPTION: maps a binary PGM/PPM file. Mapping is private, pixel data
+ *              can be modified in place without changing the file.
+ * INPUTS:
+ *          ImgMap *pImg : image map object
+ *          const char *filename : name of the file
+ * OUTPUTS:
+ *          return value IMG_SUCCESS or one of imgError_t
+ ************************************************************************/
+int32_t imgMapOpen(ImgMap *pImg, const char *filename)
+{
+  int32_t retVal;
+
+  if ((pImg == NULL) || (filename == NULL))
+  {
+    return(IMG_ERROR_BAD_ARG);
+  }
+  memset(pImg, 0, sizeof(ImgMap));
+  pImg->fileHandle = IMG_NO_FILE;
+
+#if defined(IMG_MAP_WIN32)
+  {
+    HANDLE hFile, hMap;
+    LARGE_INTEGER fileSize;
+
+    hFile = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+      return(IMG_ERROR_OPEN);
+    }
+    pImg->fileHandle = (intptr_t) hFile;
+    if (!GetFileSizeEx(hFile, &fileSize) || (fileSize.QuadPart == 0))
+    {
+      unmapFile(pImg);
+      return(IMG_ERROR_FORMAT);
+    }
+    pImg->mapSize = (size_t) fileSize.QuadPart;
+
+    hMap = CreateFileMappingA(hFile, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (hMap == NULL)
+    {
+      unmapFile(pImg);
+      return(IMG_ERROR_MAP);
+    }
+    pImg->mapHandle = (intptr_t) hMap;
+    pImg->pMap      = MapViewOfFile(hMap, FILE_MAP_COPY, 0, 0, 0);
+    if (pImg->pMap == NULL)
+    {
+      unmapFile(pImg);
+      return(IMG_ERROR_MAP);
+    }
+  }
+#elif defined(IMG_MAP_POSIX)
+  {
+    struct stat fileStat;
+    void *pMap;
+    int fd;
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+      return(IMG_ERROR_OPEN);
+    }
+    pImg->fileHandle = fd;
+    if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size == 0))
+    {
+      unmapFile(pImg);
+      return(IMG_ERROR_FORMAT);
+    }
+    pImg->mapSize = (size_t) fileStat.st_size;
+
+    pMap = mmap(NULL, pImg->mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (pMap == MAP_FAILED)
+    {
+      unmapFile(pImg);
+      return(IMG_ERROR_MAP);
+    }
+    pImg->pMap = pMap;
+  }
+#else
+  {
+    FILE *fp;
+    long fileSize;
+
+    fp = fopen(filename, "rb");
+    if (fp == NULL)
+    {
+      return(IMG_ERROR_OPEN);
+    }
+    if ((fseek(fp, 0, SEEK_END) != 0) || ((fileSize = ftell(fp)) <= 0) || (fseek(fp, 0, SEEK_SET) != 0))
+    {
+      fclose(fp);
+      return(IMG_ERROR_FORMAT);
+    }
+    pImg->mapSize = (size_t) fileSize;
+    pImg->pMap    = malloc(pImg->mapSize);
+    if (pImg->pMap == NULL)
+    {
+      fclose(fp);
+      return(IMG_ERROR_ALLOC);
+    }
+    if (fread(pImg->pMap, 1, pImg->mapSize, fp) != pImg->mapSize)
+    {
+      fclose(fp);
+      unmapFile(pImg);
+      return(IMG_ERROR_OPEN);
+    }
+    fclose(fp);
+  }
+#endif
+
+  retVal = parseHeader(pImg);
+  if (retVal != IMG_SUCCESS)
+  {
+    unmapFile(pImg);
+    return(retVal);
+  }
+
+  if (pImg->compWidth == 16)
+  {
+    swapBytes16(pImg->pData, pImg->dataSize);
+  }
+  return(IMG_SUCCESS);
+}
+
+/* ***********************************************************************
+ * FUNCTION: imgMapCreate()
+ * DESCRIPTION: creates a PGM/PPM file of the given size and maps it
+ *              for writing. Pixel data is written to the file on
+ *              imgMapFlush() and imgMapClose().
+ * INPUTS:
+ *          ImgMap *pImg : image map object
+ *          const char *filename : name of the file
+ *          int32_t width : width of image
+ *          int32_t height : height of image
+ *          int32_t numChannels : 1 for PGM, 3 for PPM
+ *          int32_t compWidth : bits per component, 8 or 16
+ * OUTPUTS:
+ *          return value IMG_SUCCESS or one of imgError_t
+ ************************************************************************/
+int32_t imgMapCreate(ImgMap *pImg, const char *filename, int32_t width, int32_t height, int32_t numChannels, int32_t compWidth)
+{
+  char header[IMG_HEADER_SIZE];
+  int32_t headerSize;
+  int64_t dataSize;
+
+  if ((pImg == NULL) || (filename == NULL) || (width <= 0) || (width > IMG_MAX_DIM) || (height <= 0) || (height > IMG_MAX_DIM) ||
+      ((numChannels != 1) && (numChannels != 3)) || ((compWidth != 8) && (compWidth != 16)))
+  {
+    return(IMG_ERROR_BAD_ARG);
+  }
+
+  dataSize = (int64_t) width * height * numChannels * (compWidth / 8);
+  if (dataSize > 0x7FFFFFFF)
+  {
+    return(IMG_ERROR_BAD_ARG);
+  }
+
+  memset(pImg, 0, sizeof(ImgMap));
+  pImg->fileHandle = IMG_NO_FILE;
+  headerSize = sprintf(header, "P%c\n%d %d\n%d\n", (numChannels == 1) ? '5' : '6', width, height, (compWidth == 8) ? 255 : 65535);
+  pImg->mapSize = (size_t) headerSize + (size_t) dataSize;
+
+#if defined(IMG_MAP_WIN32)
+  {
+    HANDLE hFile, hMap;
+
+    hFile = CreateFileA(filename, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+      return(IMG_ERROR_OPEN);
+    }
+    pImg->fileHandle = (intptr_t) hFile;
+
+    // Mapping object sets the file size
+    hMap = CreateFileMappingA(hFile, NULL, PAGE_READWRITE, 0, (DWORD) pImg->mapSize, NULL);
+    if (hMap == NULL)
+    {
+      unmapFile(pImg);
+      return(IMG_ERROR_MAP);
+    }
+    pImg->mapHandle = (intptr_t) hMap;
+    pImg->pMap      = MapViewOfFile(hMap, FILE_MAP_WRITE, 0, 0, 0);
+    if (pImg->pMap == NULL)
+    {
+      unmapFile(pImg);
+      return(IMG_ERROR_MAP);
+    }
+  }
+#elif defined(IMG_MAP_POSIX)
+  {
+    void *pMap;
+    int fd;
+
+    fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+      return(IMG_ERROR_OPEN);
+    }
+    pImg->fileHandle = fd;
+    if (ftruncate(fd, (off_t) pImg->mapSize) != 0)
+    {
+      unmapFile(pImg);
+      return(IMG_ERROR_WRITE);
+    }
+
+    pMap = mmap(NULL, pImg->mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (pMap == MAP_FAILED)
+    {
+      unmapFile(pImg);
+      return(IMG_ERROR_MAP);
+    }
+    pImg->pMap = pMap;
+  }
+#else
+  {
+    FILE *fp;
+
+    fp = fopen(filename, "wb");
+    if (fp == NULL)
+    {
+      return(IMG_ERROR_OPEN);
+    }
+    pImg->fileHandle = (intptr_t) fp;
+    pImg->pMap       = calloc(1, pImg->mapSize);
+    if (pImg->pMap == NULL)
+    {
+      unmapFile(pImg);
+      return(IMG_ERROR_ALLOC);
+    }
+  }
+#endif
+
+  memcpy(pImg->pMap, header, headerSize);
+  pImg->pData       = (uint8_t *) pImg->pMap + headerSize;
+  pImg->width       = width;
+  pImg->height      = height;
+  pImg->numChannels = numChannels;
+  pImg->compWidth   = compWidth;
+  pImg->pitch       = width * numChannels;
+  pImg->dataSize    = (int32_t) dataSize;
+  pImg->writable    = 1;
+  return(IMG_SUCCESS);
+}
+
+/* ***********************************************************************
+ * FUNCTION: imgMapSetupFrame()
+ * DESCRIPTION: sets up a frame on the pixel data of the mapping
+ * INPUTS:
+ *          ImgMap *pImg : image map object
+ *          int32_t paddingType : frame padding type
+ *          int32_t paddingVal : padding value for constant padding
+ * OUTPUTS:
+ *          xvFrame *pFrame : frame pointing into the mapping
+ *          return value IMG_SUCCESS or IMG_ERROR_BAD_ARG
+ ************************************************************************/
+int32_t imgMapSetupFrame(ImgMap *pImg, xvFrame *pFrame, int32_t paddingType, int32_t paddingVal)
+{
+  if ((pImg == NULL) || (pImg->pData == NULL) || (pFrame == NULL) || ((int32_t) pFrame == XVTM_ERROR))
+  {
+    return(IMG_ERROR_BAD_ARG);
+  }
+
+  SETUP_FRAME(pFrame, pImg->pData, pImg->dataSize, pImg->width, pImg->height, pImg->pitch, 0, 0,
+              pImg->compWidth / 8, pImg->numChannels, paddingType, paddingVal);
+  return(IMG_SUCCESS);
+}
+
+/* ***********************************************************************
+ * FUNCTION: imgMapFlush()
+ * DESCRIPTION: writes pixel data of a writable mapping to the file
+ * INPUTS:
+ *          ImgMap *pImg : image map object
+ * OUTPUTS:
+ *          return value IMG_SUCCESS or one of imgError_t
+ ************************************************************************/
+int32_t imgMapFlush(ImgMap *pImg)
+{
+  if ((pImg == NULL) || (pImg->pMap == NULL) || (pImg->writable == 0))
+  {
+    return(IMG_ERROR_BAD_ARG);
+  }
+  return(syncFile(pImg, 1));
+}
+
+/* ***********************************************************************
+ * FUNCTION: imgMapClose()
+ * DESCRIPTION: flushes a writable mapping and releases the mapping.
+ *              Frames set up on the mapping must not be used afterwards.
+ * INPUTS:
+ *          ImgMap *pImg : image map object
+ * OUTPUTS:
+ *          return value IMG_SUCCESS or one of imgError_t
+ ************************************************************************/
+int32_t imgMapClose(ImgMap *pImg)
+{
+  int32_t retVal = IMG_SUCCESS;
+
+  if ((pImg == NULL) || (pImg->pMap == NULL))
+  {
+    return(IMG_ERROR_BAD_ARG);
+  }
+
+  if (pImg->writable)
+  {
+    retVal = syncFile(pImg, 0);
+  }
+  unmapFile(pImg);
+  return(retVal);
+}
+
+/* ***********************************************************************
+ * FUNCTION: imgMapErrorString()
+ * DESCRIPTION: returns a description of an error code
+ * INPUTS:
+ *          int32_t error : imgError_t value
+ * OUTPUTS:
+ *          return value pointer to description
+ ************************************************************************/
+const char *imgMapErrorString(int32_t error)
+{
+  switch (error)
+  {
+    case IMG_SUCCESS:       return("no error");
+    case IMG_ERROR_BAD_ARG: return("invalid argument");
+    case IMG_ERROR_OPEN:    return("unable to open file");
+    case IMG_ERROR_FORMAT:  return("not a binary PGM/PPM file");
+    case IMG_ERROR_MAP:     return("unable to map file");
+    case IMG_ERROR_ALLOC:   return("unable to allocate memory");
+    case IMG_ERROR_WRITE:   return("unable to write file");
+    default:                return("unknown error");
+  }
+}
@@ -54,7 +54,8 @@ int32_t checkImage(uint8_t *img1, uint8_t *img2, int32_t width, int32_t height,
  *
  * OUTPUTS:
  *          return value PGMImage * : pointer to the structure PPMImage, contains
- *          details of images such as base pointer to data, resolution and pixel depth
+ *          details of images such as base pointer to data, resolution and pixel depth.
+ *          NULL if the file can not be read
  ************************************************************************/
 PGMImage *readPGM(const char *filename)
 {
@@ -67,21 +68,23 @@ PGMImage *readPGM(const char *filename)
   if (!fp)
   {
     fprintf(stderr, "Unable to open file '%s'\n", filename);
-    exit(1);
+    return(NULL);
   }
 
   //read image format
   if (!fgets(buff, sizeof(buff), fp))
   {
     perror(filename);
-    exit(1);
+    fclose(fp);
+    return(NULL);
   }
 
   //check the image format
   if (buff[0] != 'P' || buff[1] != '5')
   {
     fprintf(stderr, "Invalid image format (must be 'P5')\n");
-    exit(1);
+    fclose(fp);
+    return(NULL);
   }
 
   //check for comments
@@ -100,21 +103,24 @@ PGMImage *readPGM(const char *filename)
   if (fscanf(fp, "%d %d", &x, &y) != 2)
   {
     fprintf(stderr, "Invalid image size (error loading '%s')\n", filename);
-    exit(1);
+    fclose(fp);
+    return(NULL);
   }
 
   //read rgb component
   if (fscanf(fp, "%d", &rgb_comp_color) != 1)
   {
     fprintf(stderr, "Invalid rgb component (error loading '%s')\n", filename);
-    exit(1);
+    fclose(fp);
+    return(NULL);
   }
 
   //check rgb component depth
   if (rgb_comp_color > (65535))
   {
     fprintf(stderr, "'%s' does not have 8/16-bits components\n", filename);
-    exit(1);
+    fclose(fp);
+    return(NULL);
   }
 
   //alloc memory form image
@@ -122,7 +128,8 @@ PGMImage *readPGM(const char *filename)
   if (!img)
   {
     fprintf(stderr, "Unable to allocate memory\n");
-    exit(1);
+    fclose(fp);
+    return(NULL);
   }
   img->x = x;
   img->y = y;
@@ -138,14 +145,19 @@ PGMImage *readPGM(const char *filename)
   if (!img->data)
   {
     fprintf(stderr, "Unable to allocate memory\n");
-    exit(1);
+    free(img);
+    fclose(fp);
+    return(NULL);
   }
 
   //read pixel data from file
   if (fread(img->data, img->x, img->y, fp) != (unsigned)img->y)
   {
     fprintf(stderr, "Error loading image '%s'\n", filename);
-    exit(1);
+    free(img->data);
+    free(img);
+    fclose(fp);
+    return(NULL);
   }
 
   fclose(fp);
@@ -160,9 +172,9 @@ PGMImage *readPGM(const char *filename)
  *      PGMImage *img       : pointer to image data to be written into a file
  *
  * OUTPUTS:
- *      NONE
+ *      return value 0 on success, -1 if the file can not be written
  ************************************************************************/
-void writePGM(const char *filename, PGMImage *img)
+int32_t writePGM(const char *filename, PGMImage *img)
 {
   FILE *fp;
 
@@ -172,7 +184,7 @@ void writePGM(const char *filename, PGMImage *img)
   if (!fp)
   {
     fprintf(stderr, "Unable to open file '%s'\n", filename);
-    exit(1);
+    return(-1);
   }
 
   //write the header file
@@ -189,8 +201,12 @@ void writePGM(const char *filename, PGMImage *img)
   if (img->compWidth == 8)
   {
     fprintf(fp, "%d\n", 255);
-    fwrite(img->data, img->x, img->y, fp);
+    if (fwrite(img->data, img->x, img->y, fp) != (unsigned)img->y)
+    {
+      fclose(fp);
+      return(-1);
+    }
   }
-  fclose(fp);
+  return(fclose(fp) == 0 ? 0 : -1);
 }
 
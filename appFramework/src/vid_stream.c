@@ -0,0 +1,704 @@
+/*
+ * Copyright (c) 2016 by Cadence Design Systems, Inc.  ALL RIGHTS RESERVED.
+ * These coded instructions, statements, and computer programs are the
+ * copyrighted works and confidential proprietary information of
+ * Cadence Design Systems Inc.  They may be adapted and modified by bona fide
+ * purchasers for internal use, but neither the original nor any adapted
+ * or modified version may be disclosed or distributed to third parties
+ * in any manner, medium, or form, in whole or in part, without the prior
+ * written consent of Cadence Design Systems Inc.  This software and its
+ * derivatives are to be executed solely on products incorporating a Cadence
+ * Design Systems processor.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vid_stream.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#define VID_THREAD_WIN32
+#elif !defined(__XTENSA__)
+#include <pthread.h>
+#define VID_THREAD_POSIX
+#endif
+
+#define VID_MAX_DIM       16384
+#define VID_LINE_SIZE     256
+
+// Reader thread synchronization. Without threads the functions are empty
+// and frames are read by the caller.
+struct vidSyncStruct
+{
+#if defined(VID_THREAD_WIN32)
+  CRITICAL_SECTION   mutex;
+  CONDITION_VARIABLE cond;
+  HANDLE             thread;
+#elif defined(VID_THREAD_POSIX)
+  pthread_mutex_t    mutex;
+  pthread_cond_t     cond;
+  pthread_t          thread;
+#else
+  int32_t            unused;
+#endif
+};
+
+#if defined(VID_THREAD_WIN32)
+#define VID_LOCK(pSync)     EnterCriticalSection(&(pSync)->mutex)
+#define VID_UNLOCK(pSync)   LeaveCriticalSection(&(pSync)->mutex)
+#define VID_WAIT(pSync)     SleepConditionVariableCS(&(pSync)->cond, &(pSync)->mutex, INFINITE)
+#define VID_SIGNAL(pSync)   WakeAllConditionVariable(&(pSync)->cond)
+#elif defined(VID_THREAD_POSIX)
+#define VID_LOCK(pSync)     pthread_mutex_lock(&(pSync)->mutex)
+#define VID_UNLOCK(pSync)   pthread_mutex_unlock(&(pSync)->mutex)
+#define VID_WAIT(pSync)     pthread_cond_wait(&(pSync)->cond, &(pSync)->mutex)
+#define VID_SIGNAL(pSync)   pthread_cond_broadcast(&(pSync)->cond)
+#else
+#define VID_LOCK(pSync)
+#define VID_UNLOCK(pSync)
+#define VID_WAIT(pSync)
+#define VID_SIGNAL(pSync)
+#endif
+
+/* ***********************************************************************
+ * FUNCTION: readLine()
+ * DESCRIPTION: reads a header line, without the new line character
+ * INPUTS:
+ *          FILE *fp : file
+ *          int32_t size : size of line buffer
+ * OUTPUTS:
+ *          char *pLine : line
+ *          return value length of line, -1 at end of file or if the
+ *          line does not fit
+ ************************************************************************/
+static int32_t readLine(FILE *fp, char *pLine, int32_t size)
+{
+  int32_t len = 0;
+  int c;
+
+  while ((c = fgetc(fp)) != '\n')
+  {
+    if ((c == EOF) || (len == size - 1))
+    {
+      return(-1);
+    }
+    pLine[len++] = (char) c;
+  }
+  pLine[len] = '\0';
+  return(len);
+}
+
+/* ***********************************************************************
+ * FUNCTION: parseY4MHeader()
+ * DESCRIPTION: reads the Y4M stream header. Only 4:2:0 progressive
+ *              8-bit streams are accepted.
+ * INPUTS:
+ *          VidSource *pSrc : video source object, file is open
+ * OUTPUTS:
+ *          return value VID_SUCCESS, VID_ERROR_FORMAT or
+ *          VID_ERROR_UNSUPPORTED
+ ************************************************************************/
+static int32_t parseY4MHeader(VidSource *pSrc)
+{
+  char line[VID_LINE_SIZE], *pTok;
+
+  if ((readLine(pSrc->fp, line, VID_LINE_SIZE) < 0) || (strncmp(line, "YUV4MPEG2", 9) != 0))
+  {
+    return(VID_ERROR_FORMAT);
+  }
+
+  pSrc->width  = 0;
+  pSrc->height = 0;
+  for (pTok = strtok(line + 9, " "); pTok != NULL; pTok = strtok(NULL, " "))
+  {
+    switch (pTok[0])
+    {
+      case 'W': pSrc->width = atoi(pTok + 1); break;
+      case 'H': pSrc->height = atoi(pTok + 1); break;
+      case 'F':
+        if ((sscanf(pTok + 1, "%d:%d", &pSrc->fpsNum, &pSrc->fpsDen) != 2) || (pSrc->fpsDen <= 0))
+        {
+          return(VID_ERROR_FORMAT);
+        }
+        break;
+      case 'I':
+        if ((pTok[1] != 'p') && (pTok[1] != '?'))
+        {
+          return(VID_ERROR_FORMAT);
+        }
+        break;
+      case 'C':
+        // 8-bit 4:2:0 with any chroma siting, not C420p10 and the like
+        if ((strcmp(pTok + 1, "420") != 0) && (strcmp(pTok + 1, "420jpeg") != 0) &&
+            (strcmp(pTok + 1, "420paldv") != 0) && (strcmp(pTok + 1, "420mpeg2") != 0))
+        {
+          return(VID_ERROR_UNSUPPORTED);
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  return(VID_SUCCESS);
+}
+
+/* ***********************************************************************
+ * FUNCTION: readFrame()
+ * DESCRIPTION: reads the next frame of the stream into a ring slot
+ * INPUTS:
+ *          VidSource *pSrc : video source object
+ *          VidFrame *pFrame : ring slot
+ * OUTPUTS:
+ *          return value 1 if a frame was read, 0 at end of stream,
+ *          VID_ERROR_FORMAT or VID_ERROR_READ on error
+ ************************************************************************/
+static int32_t readFrame(VidSource *pSrc, VidFrame *pFrame)
+{
+  char line[VID_LINE_SIZE];
+  size_t bytes;
+
+  if (pSrc->format == VID_FORMAT_Y4M)
+  {
+    if (readLine(pSrc->fp, line, VID_LINE_SIZE) < 0)
+    {
+      return(feof(pSrc->fp) ? 0 : VID_ERROR_FORMAT);
+    }
+    if (strncmp(line, "FRAME", 5) != 0)
+    {
+      return(VID_ERROR_FORMAT);
+    }
+  }
+
+  bytes = fread(pFrame->pBuff, 1, pSrc->frameSize, pSrc->fp);
+  if (bytes == 0)
+  {
+    return(feof(pSrc->fp) ? 0 : VID_ERROR_READ);
+  }
+  if (bytes != (size_t) pSrc->frameSize)
+  {
+    // Truncated last frame
+    return(VID_ERROR_READ);
+  }
+
+  pFrame->frameIndex = pSrc->framesRead++;
+  return(1);
+}
+
+/* ***********************************************************************
+ * FUNCTION: fillSlot()
+ * DESCRIPTION: reads the next frame into the free slot at head. Called
+ *              with the lock held, the lock is released while reading.
+ * INPUTS:
+ *          VidSource *pSrc : video source object, freeCount > 0
+ * OUTPUTS:
+ *          NONE
+ ************************************************************************/
+static void fillSlot(VidSource *pSrc)
+{
+  VidFrame *pFrame = &pSrc->slot[pSrc->head];
+  int32_t retVal;
+
+  VID_UNLOCK(pSrc->pSync);
+  retVal = readFrame(pSrc, pFrame);
+  VID_LOCK(pSrc->pSync);
+
+  if (retVal == 1)
+  {
+    pSrc->head = (pSrc->head + 1) % pSrc->ringSize;
+    pSrc->freeCount--;
+    pSrc->readyCount++;
+  }
+  else
+  {
+    pSrc->eos   = 1;
+    pSrc->error = retVal;
+  }
+  VID_SIGNAL(pSrc->pSync);
+}
+
+#if defined(VID_THREAD_WIN32) || defined(VID_THREAD_POSIX)
+/* ***********************************************************************
+ * FUNCTION: readerThread()
+ * DESCRIPTION: fills free ring slots until end of stream or until the
+ *              source is closed
+ * INPUTS:
+ *          void *pArg : video source object
+ * OUTPUTS:
+ *          NONE
+ ************************************************************************/
+#if defined(VID_THREAD_WIN32)
+static DWORD WINAPI readerThread(LPVOID pArg)
+#else
+static void *readerThread(void *pArg)
+#endif
+{
+  VidSource *pSrc = (VidSource *) pArg;
+
+  VID_LOCK(pSrc->pSync);
+  while (!pSrc->stop && !pSrc->eos)
+  {
+    if (pSrc->freeCount == 0)
+    {
+      VID_WAIT(pSrc->pSync);
+      continue;
+    }
+    fillSlot(pSrc);
+  }
+  VID_UNLOCK(pSrc->pSync);
+  return(0);
+}
+#endif
+
+/* ***********************************************************************
+ * FUNCTION: setupSlot()
+ * DESCRIPTION: allocates the buffer of a ring slot and sets up plane
+ *              pointers and plane frames
+ * INPUTS:
+ *          VidSource *pSrc : video source object
+ *          VidFrame *pFrame : ring slot
+ * OUTPUTS:
+ *          return value VID_SUCCESS or VID_ERROR_ALLOC
+ ************************************************************************/
+static int32_t setupSlot(VidSource *pSrc, VidFrame *pFrame)
+{
+  int32_t width     = pSrc->width;
+  int32_t height    = pSrc->height;
+  int32_t chWidth   = (width + 1) / 2;
+  int32_t chHeight  = (height + 1) / 2;
+  int32_t lumaSize  = width * height;
+
+  memset(pFrame, 0, sizeof(VidFrame));
+  pFrame->pBuff = (uint8_t *) malloc(pSrc->frameSize);
+  if (pFrame->pBuff == NULL)
+  {
+    return(VID_ERROR_ALLOC);
+  }
+  pFrame->width     = width;
+  pFrame->height    = height;
+  pFrame->pPlane[0] = pFrame->pBuff;
+  pFrame->pitch[0]  = width;
+  SETUP_FRAME(&pFrame->plane[0], pFrame->pPlane[0], lumaSize, width, height, width, 0, 0, 1, 1, FRAME_ZERO_PADDING, 0);
+
+  if (pSrc->format == VID_FORMAT_NV12)
+  {
+    pFrame->numPlanes = 2;
+    pFrame->pPlane[1] = pFrame->pBuff + lumaSize;
+    pFrame->pitch[1]  = 2 * chWidth;
+    SETUP_FRAME(&pFrame->plane[1], pFrame->pPlane[1], 2 * chWidth * chHeight, chWidth, chHeight, 2 * chWidth, 0, 0, 1, 2, FRAME_ZERO_PADDING, 0);
+  }
+  else
+  {
+    pFrame->numPlanes = 3;
+    pFrame->pPlane[1] = pFrame->pBuff + lumaSize;
+    pFrame->pPlane[2] = pFrame->pPlane[1] + chWidth * chHeight;
+    pFrame->pitch[1]  = chWidth;
+    pFrame->pitch[2]  = chWidth;
+    SETUP_FRAME(&pFrame->plane[1], pFrame->pPlane[1], chWidth * chHeight, chWidth, chHeight, chWidth, 0, 0, 1, 1, FRAME_ZERO_PADDING, 0);
+    SETUP_FRAME(&pFrame->plane[2], pFrame->pPlane[2], chWidth * chHeight, chWidth, chHeight, chWidth, 0, 0, 1, 1, FRAME_ZERO_PADDING, 0);
+  }
+  return(VID_SUCCESS);
+}
+
+/* ***********************************************************************
+ * FUNCTION: vidSourceOpen()
+ * DESCRIPTION: opens a video file, allocates the frame ring and starts
+ *              the reader thread on hosts
+ * INPUTS:
+ *          VidSource *pSrc : video source object
+ *          const char *filename : name of the file
+ *          int32_t format : vidFormat_t value
+ *          int32_t width : luma width, ignored for Y4M
+ *          int32_t height : luma height, ignored for Y4M
+ *          int32_t ringSize : number of frame buffers
+ * OUTPUTS:
+ *          return value VID_SUCCESS or one of vidError_t
+ ************************************************************************/
+int32_t vidSourceOpen(VidSource *pSrc, const char *filename, int32_t format, int32_t width, int32_t height, int32_t ringSize)
+{
+  int32_t indx, retVal;
+
+  if ((pSrc == NULL) || (filename == NULL) || (format < VID_FORMAT_Y4M) || (format > VID_FORMAT_NV12) ||
+      (ringSize < 2) || (ringSize > VID_MAX_RING_SIZE))
+  {
+    return(VID_ERROR_BAD_ARG);
+  }
+
+  memset(pSrc, 0, sizeof(VidSource));
+  pSrc->format   = format;
+  pSrc->width    = width;
+  pSrc->height   = height;
+  pSrc->fpsNum   = 30;
+  pSrc->fpsDen   = 1;
+  pSrc->ringSize = ringSize;
+
+  pSrc->fp = fopen(filename, "rb");
+  if (pSrc->fp == NULL)
+  {
+    return(VID_ERROR_OPEN);
+  }
+
+  if (format == VID_FORMAT_Y4M)
+  {
+    retVal = parseY4MHeader(pSrc);
+    if (retVal != VID_SUCCESS)
+    {
+      vidSourceClose(pSrc);
+      return(retVal);
+    }
+  }
+
+  if ((pSrc->width <= 0) || (pSrc->width > VID_MAX_DIM) || (pSrc->height <= 0) || (pSrc->height > VID_MAX_DIM))
+  {
+    vidSourceClose(pSrc);
+    return((format == VID_FORMAT_Y4M) ? VID_ERROR_FORMAT : VID_ERROR_BAD_ARG);
+  }
+  pSrc->frameSize = pSrc->width * pSrc->height + 2 * ((pSrc->width + 1) / 2) * ((pSrc->height + 1) / 2);
+
+  for (indx = 0; indx < ringSize; indx++)
+  {
+    if (setupSlot(pSrc, &pSrc->slot[indx]) != VID_SUCCESS)
+    {
+      vidSourceClose(pSrc);
+      return(VID_ERROR_ALLOC);
+    }
+  }
+  pSrc->freeCount = ringSize;
+
+  pSrc->pSync = (struct vidSyncStruct *) malloc(sizeof(struct vidSyncStruct));
+  if (pSrc->pSync == NULL)
+  {
+    vidSourceClose(pSrc);
+    return(VID_ERROR_ALLOC);
+  }
+
+#if defined(VID_THREAD_WIN32)
+  InitializeCriticalSection(&pSrc->pSync->mutex);
+  InitializeConditionVariable(&pSrc->pSync->cond);
+  pSrc->pSync->thread = CreateThread(NULL, 0, readerThread, pSrc, 0, NULL);
+  if (pSrc->pSync->thread == NULL)
+  {
+    DeleteCriticalSection(&pSrc->pSync->mutex);
+    free(pSrc->pSync);
+    pSrc->pSync = NULL;
+    vidSourceClose(pSrc);
+    return(VID_ERROR_THREAD);
+  }
+#elif defined(VID_THREAD_POSIX)
+  pthread_mutex_init(&pSrc->pSync->mutex, NULL);
+  pthread_cond_init(&pSrc->pSync->cond, NULL);
+  if (pthread_create(&pSrc->pSync->thread, NULL, readerThread, pSrc) != 0)
+  {
+    pthread_cond_destroy(&pSrc->pSync->cond);
+    pthread_mutex_destroy(&pSrc->pSync->mutex);
+    free(pSrc->pSync);
+    pSrc->pSync = NULL;
+    vidSourceClose(pSrc);
+    return(VID_ERROR_THREAD);
+  }
+#endif
+  return(VID_SUCCESS);
+}
+
+/* ***********************************************************************
+ * FUNCTION: vidSourceAcquire()
+ * DESCRIPTION: returns the next frame of the stream, waits until the
+ *              reader has loaded it
+ * INPUTS:
+ *          VidSource *pSrc : video source object
+ * OUTPUTS:
+ *          return value pointer to frame, NULL at end of stream or on
+ *          error. pSrc->error is VID_SUCCESS at end of stream.
+ ************************************************************************/
+VidFrame *vidSourceAcquire(VidSource *pSrc)
+{
+  VidFrame *pFrame = NULL;
+
+  if ((pSrc == NULL) || (pSrc->pSync == NULL))
+  {
+    return(NULL);
+  }
+
+  VID_LOCK(pSrc->pSync);
+#if defined(VID_THREAD_WIN32) || defined(VID_THREAD_POSIX)
+  while ((pSrc->readyCount == 0) && !pSrc->eos)
+  {
+    VID_WAIT(pSrc->pSync);
+  }
+#else
+  if ((pSrc->readyCount == 0) && !pSrc->eos && (pSrc->freeCount > 0))
+  {
+    fillSlot(pSrc);
+  }
+#endif
+  if (pSrc->readyCount > 0)
+  {
+    pFrame     = &pSrc->slot[pSrc->tail];
+    pSrc->tail = (pSrc->tail + 1) % pSrc->ringSize;
+    pSrc->readyCount--;
+  }
+  VID_UNLOCK(pSrc->pSync);
+  return(pFrame);
+}
+
+/* ***********************************************************************
+ * FUNCTION: vidSourceRelease()
+ * DESCRIPTION: returns the oldest acquired frame to the ring
+ * INPUTS:
+ *          VidSource *pSrc : video source object
+ *          VidFrame *pFrame : frame returned by vidSourceAcquire()
+ * OUTPUTS:
+ *          return value VID_SUCCESS or VID_ERROR_BAD_ARG
+ ************************************************************************/
+int32_t vidSourceRelease(VidSource *pSrc, VidFrame *pFrame)
+{
+  int32_t oldest;
+
+  if ((pSrc == NULL) || (pSrc->pSync == NULL) || (pFrame == NULL))
+  {
+    return(VID_ERROR_BAD_ARG);
+  }
+
+  VID_LOCK(pSrc->pSync);
+  // Acquired frames are the ones between head and tail that are not ready
+  oldest = (pSrc->tail + pSrc->ringSize - (pSrc->ringSize - pSrc->freeCount - pSrc->readyCount)) % pSrc->ringSize;
+  if ((pSrc->freeCount + pSrc->readyCount == pSrc->ringSize) || (pFrame != &pSrc->slot[oldest]))
+  {
+    VID_UNLOCK(pSrc->pSync);
+    return(VID_ERROR_BAD_ARG);
+  }
+  pSrc->freeCount++;
+  VID_SIGNAL(pSrc->pSync);
+  VID_UNLOCK(pSrc->pSync);
+  return(VID_SUCCESS);
+}
+
+/* ***********************************************************************
+ * FUNCTION: vidSourceClose()
+ * DESCRIPTION: stops the reader thread, closes the file and frees the
+ *              frame ring
+ * INPUTS:
+ *          VidSource *pSrc : video source object
+ * OUTPUTS:
+ *          NONE
+ ************************************************************************/
+void vidSourceClose(VidSource *pSrc)
+{
+  int32_t indx;
+
+  if (pSrc == NULL)
+  {
+    return;
+  }
+
+  if (pSrc->pSync != NULL)
+  {
+    VID_LOCK(pSrc->pSync);
+    pSrc->stop = 1;
+    VID_SIGNAL(pSrc->pSync);
+    VID_UNLOCK(pSrc->pSync);
+#if defined(VID_THREAD_WIN32)
+    WaitForSingleObject(pSrc->pSync->thread, INFINITE);
+    CloseHandle(pSrc->pSync->thread);
+    DeleteCriticalSection(&pSrc->pSync->mutex);
+#elif defined(VID_THREAD_POSIX)
+    pthread_join(pSrc->pSync->thread, NULL);
+    pthread_cond_destroy(&pSrc->pSync->cond);
+    pthread_mutex_destroy(&pSrc->pSync->mutex);
+#endif
+    free(pSrc->pSync);
+    pSrc->pSync = NULL;
+  }
+
+  for (indx = 0; indx < VID_MAX_RING_SIZE; indx++)
+  {
+    free(pSrc->slot[indx].pBuff);
+    pSrc->slot[indx].pBuff = NULL;
+  }
+
+  if (pSrc->fp != NULL)
+  {
+    fclose(pSrc->fp);
+    pSrc->fp = NULL;
+  }
+}
+
+/* ***********************************************************************
+ * FUNCTION: vidSinkOpen()
+ * DESCRIPTION: creates a video file, writes the Y4M stream header
+ * INPUTS:
+ *          VidSink *pSink : video sink object
+ *          const char *filename : name of the file
+ *          int32_t format : vidFormat_t value
+ *          int32_t width : luma width
+ *          int32_t height : luma height
+ *          int32_t fpsNum : frame rate numerator
+ *          int32_t fpsDen : frame rate denominator
+ * OUTPUTS:
+ *          return value VID_SUCCESS or one of vidError_t
+ ************************************************************************/
+int32_t vidSinkOpen(VidSink *pSink, const char *filename, int32_t format, int32_t width, int32_t height, int32_t fpsNum, int32_t fpsDen)
+{
+  if ((pSink == NULL) || (filename == NULL) || (format < VID_FORMAT_Y4M) || (format > VID_FORMAT_NV12) ||
+      (width <= 0) || (width > VID_MAX_DIM) || (height <= 0) || (height > VID_MAX_DIM))
+  {
+    return(VID_ERROR_BAD_ARG);
+  }
+
+  memset(pSink, 0, sizeof(VidSink));
+  pSink->format = format;
+  pSink->width  = width;
+  pSink->height = height;
+
+  pSink->fp = fopen(filename, "wb");
+  if (pSink->fp == NULL)
+  {
+    return(VID_ERROR_OPEN);
+  }
+
+  if (format == VID_FORMAT_Y4M)
+  {
+    if ((fpsNum <= 0) || (fpsDen <= 0))
+    {
+      fpsNum = 30;
+      fpsDen = 1;
+    }
+    if (fprintf(pSink->fp, "YUV4MPEG2 W%d H%d F%d:%d Ip A1:1 C420jpeg\n", width, height, fpsNum, fpsDen) < 0)
+    {
+      fclose(pSink->fp);
+      pSink->fp = NULL;
+      return(VID_ERROR_WRITE);
+    }
+  }
+  return(VID_SUCCESS);
+}
+
+/* ***********************************************************************
+ * FUNCTION: writePlane()
+ * DESCRIPTION: writes the rows of a plane
+ * INPUTS:
+ *          FILE *fp : file
+ *          const uint8_t *pPlane : pointer to first row
+ *          int32_t rowSize : bytes per row
+ *          int32_t pitch : bytes between rows
+ *          int32_t height : number of rows
+ * OUTPUTS:
+ *          return value VID_SUCCESS or VID_ERROR_WRITE
+ ************************************************************************/
+static int32_t writePlane(FILE *fp, const uint8_t *pPlane, int32_t rowSize, int32_t pitch, int32_t height)
+{
+  int32_t indy;
+
+  if (pitch == rowSize)
+  {
+    return((fwrite(pPlane, rowSize, height, fp) == (size_t) height) ? VID_SUCCESS : VID_ERROR_WRITE);
+  }
+  for (indy = 0; indy < height; indy++)
+  {
+    if (fwrite(pPlane + indy * pitch, 1, rowSize, fp) != (size_t) rowSize)
+    {
+      return(VID_ERROR_WRITE);
+    }
+  }
+  return(VID_SUCCESS);
+}
+
+/* ***********************************************************************
+ * FUNCTION: vidSinkWrite()
+ * DESCRIPTION: appends a frame to the video file. Planes can live in
+ *              different buffers, e.g. processed luma with the chroma
+ *              planes of the source frame.
+ * INPUTS:
+ *          VidSink *pSink : video sink object
+ *          const VidFrame *pFrame : frame, same size as the sink
+ * OUTPUTS:
+ *          return value VID_SUCCESS or one of vidError_t
+ ************************************************************************/
+int32_t vidSinkWrite(VidSink *pSink, const VidFrame *pFrame)
+{
+  int32_t chWidth, chHeight, retVal;
+
+  if ((pSink == NULL) || (pSink->fp == NULL) || (pFrame == NULL) ||
+      (pFrame->width != pSink->width) || (pFrame->height != pSink->height) || (pFrame->pPlane[0] == NULL) ||
+      (pFrame->pPlane[1] == NULL) || ((pSink->format != VID_FORMAT_NV12) && (pFrame->pPlane[2] == NULL)))
+  {
+    return(VID_ERROR_BAD_ARG);
+  }
+
+  chWidth  = (pSink->width + 1) / 2;
+  chHeight = (pSink->height + 1) / 2;
+
+  if ((pSink->format == VID_FORMAT_Y4M) && (fputs("FRAME\n", pSink->fp) < 0))
+  {
+    return(VID_ERROR_WRITE);
+  }
+
+  retVal = writePlane(pSink->fp, pFrame->pPlane[0], pSink->width, pFrame->pitch[0], pSink->height);
+  if (retVal == VID_SUCCESS)
+  {
+    if (pSink->format == VID_FORMAT_NV12)
+    {
+      retVal = writePlane(pSink->fp, pFrame->pPlane[1], 2 * chWidth, pFrame->pitch[1], chHeight);
+    }
+    else
+    {
+      retVal = writePlane(pSink->fp, pFrame->pPlane[1], chWidth, pFrame->pitch[1], chHeight);
+      if (retVal == VID_SUCCESS)
+      {
+        retVal = writePlane(pSink->fp, pFrame->pPlane[2], chWidth, pFrame->pitch[2], chHeight);
+      }
+    }
+  }
+
+  if (retVal == VID_SUCCESS)
+  {
+    pSink->framesWritten++;
+  }
+  return(retVal);
+}
+
+/* ***********************************************************************
+ * FUNCTION: vidSinkClose()
+ * DESCRIPTION: closes the video file
+ * INPUTS:
+ *          VidSink *pSink : video sink object
+ * OUTPUTS:
+ *          return value VID_SUCCESS or one of vidError_t
+ ************************************************************************/
+int32_t vidSinkClose(VidSink *pSink)
+{
+  int32_t retVal;
+
+  if ((pSink == NULL) || (pSink->fp == NULL))
+  {
+    return(VID_ERROR_BAD_ARG);
+  }
+  retVal    = (fclose(pSink->fp) == 0) ? VID_SUCCESS : VID_ERROR_WRITE;
+  pSink->fp = NULL;
+  return(retVal);
+}
+
+/* ***********************************************************************
+ * FUNCTION: vidErrorString()
+ * DESCRIPTION: returns a description of an error code
+ * INPUTS:
+ *          int32_t error : vidError_t value
+ * OUTPUTS:
+ *          return value pointer to description
+ ************************************************************************/
+const char *vidErrorString(int32_t error)
+{
+  switch (error)
+  {
+    case VID_SUCCESS:       return("no error");
+    case VID_ERROR_BAD_ARG: return("invalid argument");
+    case VID_ERROR_OPEN:    return("unable to open file");
+    case VID_ERROR_FORMAT:  return("unsupported video format");
+    case VID_ERROR_ALLOC:   return("unable to allocate memory");
+    case VID_ERROR_READ:    return("unable to read frame");
+    case VID_ERROR_WRITE:   return("unable to write frame");
+    case VID_ERROR_THREAD:  return("unable to start reader thread");
+    case VID_ERROR_UNSUPPORTED: return("unsupported color space");
+    default:                return("unknown error");
+  }
+}
@@ -35,6 +35,14 @@ int IMAGE_HEIGHT;
 #define MAX_PIF                  (64)
 
 #define INTERRUPT_ON_COMPLETION  (1)
+
+// Worker tasks of the work stealing tile executor, see tileExec.h.
+// 0 processes the tiles in the appframework task itself. To use the
+// executor, build with e.g. -DTILE_EXEC_NUM_WORKERS=2.
+#ifndef TILE_EXEC_NUM_WORKERS
+#define TILE_EXEC_NUM_WORKERS    (0)
+#endif
+#define TILE_EXEC_WORKER_PRIO    (2)
 #define RET_ERROR                (-1)
 
 #endif //__DEFINES__
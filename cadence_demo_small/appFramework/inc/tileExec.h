@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2016 by Cadence Design Systems, Inc.  ALL RIGHTS RESERVED.
+ * These coded instructions, statements, and computer programs are the
+ * copyrighted works and confidential proprietary information of
+ * Cadence Design Systems Inc.  They may be adapted and modified by bona fide
+ * purchasers for internal use, but neither the original nor any adapted
+ * or modified version may be disclosed or distributed to third parties
+ * in any manner, medium, or form, in whole or in part, without the prior
+ * written consent of Cadence Design Systems Inc.  This software and its
+ * derivatives are to be executed solely on products incorporating a Cadence
+ * Design Systems processor.
+ */
+
+/* *****************************************************************************
+ * FILE:  tileExec.h
+ *
+ * DESCRIPTION:
+ *
+ *    Work stealing tile executor. The tiles of a frame are processed by a
+ *    number of FreeRTOS worker tasks sharing one tile manager. Each worker
+ *    owns a range of the frame's tiles, takes them from the front and
+ *    double buffers their input transfers. A worker whose range is empty
+ *    steals the back half of the largest range of another worker, so that
+ *    workers that drew cheap tiles help the ones that drew expensive ones.
+ *    Processed tiles are handed to a write-back task that transfers them
+ *    out and gives the output tiles back to their worker.
+ *
+ *    Workers and the write-back task block on task notifications while
+ *    they wait for a transfer. tileExecDmaDoneFromISR() must be called from
+ *    the iDMA completion callback to wake them, without it they poll once
+ *    a tick.
+ *
+ * ****************************************************************************/
+
+#ifndef __TILE_EXEC_H__
+#define __TILE_EXEC_H__
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "tileManager.h"
+
+#define TILE_EXEC_MAX_WORKERS  4
+#ifndef TILE_EXEC_STACK_SIZE
+#define TILE_EXEC_STACK_SIZE   (configMINIMAL_STACK_SIZE + 0x400)
+#endif
+
+// Output tiles owned by each worker. Every one of them can be waiting for
+// write-back, so this many times the number of workers bounds the
+// write-back ring.
+#define TILE_EXEC_OUT_TILES    2
+#define TILE_EXEC_WB_RING      (TILE_EXEC_MAX_WORKERS * TILE_EXEC_OUT_TILES)
+
+// Processes one tile. pOutTile has the position of pInTile when called
+typedef void (*tileExecProcessFn)(xvTile *pInTile, xvTile *pOutTile, void *pArg);
+
+struct tileExecStruct;
+
+typedef struct tileExecWorkerStruct
+{
+  struct tileExecStruct *pExec;
+  TaskHandle_t          xTask;
+  int32_t               index;
+  volatile int32_t      front;        // Next tile the worker takes
+  volatile int32_t      back;         // One past the last tile of the worker
+  xvTile                *pInTile[2];
+  xvTile                *pOutTile[TILE_EXEC_OUT_TILES];
+  void                  *pInBuff[2];
+  void                  *pOutBuff[TILE_EXEC_OUT_TILES];
+  volatile int32_t      outBusy[TILE_EXEC_OUT_TILES];  // Set while an output tile waits for write-back
+  int32_t               outNext;
+  int32_t               tilesDone;    // Per frame statistics
+  int32_t               tilesStolen;
+  int32_t               steals;
+} tileExecWorker;
+
+typedef struct tileExecWbEntryStruct
+{
+  tileExecWorker   *pWorker;
+  int32_t          outIndex;
+} tileExecWbEntry;
+
+typedef struct tileExecStruct
+{
+  xvTileManager     *pxvTM;
+  SemaphoreHandle_t xTMLock;          // Serializes the tile manager calls
+  int32_t           numWorkers;
+  tileExecWorker    workers[TILE_EXEC_MAX_WORKERS];
+  TaskHandle_t      xWbTask;
+  TaskHandle_t      xCaller;          // Task waiting in tileExecRunFrame() or tileExecDelete()
+  volatile uint32_t dmaWaiters;       // Bit per worker, and one above them for write-back
+  volatile int32_t  stop;
+
+  // Tile geometry
+  int32_t           tileWidth;
+  int32_t           tileHeight;
+  int32_t           edgeWidth;
+  int32_t           edgeHeight;
+  tileExecProcessFn process;
+  void              *pArg;
+
+  // Current frame
+  xvFrame           *pInFrame;
+  xvFrame           *pOutFrame;
+  int32_t           tilesPerRow;
+  int32_t           numTiles;
+  volatile int32_t  tilesDone;
+  volatile int32_t  errFlag;
+
+  // Output tiles handed from the workers to write-back
+  tileExecWbEntry   wbRing[TILE_EXEC_WB_RING];
+  volatile uint32_t wbHead;
+  volatile uint32_t wbTail;
+} tileExec;
+
+/* ***********************************************************************
+ * FUNCTION: tileExecInit()
+ * DESCRIPTION: Allocates the tiles and buffers of numWorkers workers from
+ *              pxvTM and creates the worker and write-back tasks. Input
+ *              tile buffers come from bank 0 and output ones from bank 1.
+ *              The workers run at priority, the write-back task one above.
+ * OUTPUTS:
+ *          Returns XVTM_ERROR if an error occurs
+ ************************************************************************/
+int32_t tileExecInit(tileExec *pExec, xvTileManager *pxvTM, int32_t numWorkers, UBaseType_t priority,
+                     int32_t tileWidth, int32_t tileHeight, int32_t edgeWidth, int32_t edgeHeight,
+                     tileExecProcessFn process, void *pArg);
+
+/* ***********************************************************************
+ * FUNCTION: tileExecRunFrame()
+ * DESCRIPTION: Processes all full tiles of pInFrame into pOutFrame and
+ *              returns once the last one is written back. Must not be
+ *              called from a worker.
+ * OUTPUTS:
+ *          Returns the number of tiles processed, XVTM_ERROR if a
+ *          transfer failed
+ ************************************************************************/
+int32_t tileExecRunFrame(tileExec *pExec, xvFrame *pInFrame, xvFrame *pOutFrame);
+
+/* ***********************************************************************
+ * FUNCTION: tileExecDelete()
+ * DESCRIPTION: Ends the tasks of the executor and frees its tiles and
+ *              buffers
+ * OUTPUTS:
+ *          Returns XVTM_ERROR if an error occurs
+ ************************************************************************/
+int32_t tileExecDelete(tileExec *pExec);
+
+/* ***********************************************************************
+ * FUNCTION: tileExecDmaDoneFromISR()
+ * DESCRIPTION: Wakes the tasks of the executor waiting for a transfer.
+ *              Called from the iDMA completion callback, does nothing
+ *              if the executor is not running.
+ ************************************************************************/
+void tileExecDmaDoneFromISR(tileExec *pExec);
+
+#endif //__TILE_EXEC_H__
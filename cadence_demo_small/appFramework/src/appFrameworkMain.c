@@ -38,6 +38,9 @@
 #include "commonDef.h"
 #include "defines.h"
 #include "img_utils.h"
+#if (TILE_EXEC_NUM_WORKERS > 0)
+#include "tileExec.h"
+#endif
 
 #if defined(__XTENSA__)
 #include <sys/times.h>
@@ -67,6 +70,10 @@ IDMA_BUFFER_DEFINE(idmaObjBuff, DMA_DESCR_CNT, IDMA_2D_DESC);
 
 intrCbDataStruct cbData _LOCAL_DRAM0_;
 
+#if (TILE_EXEC_NUM_WORKERS > 0)
+tileExec tileExecObj;
+#endif
+
 // IDMA error callback function
 void errCallbackFunc(const idma_error_details_t* data)
 {
@@ -84,6 +91,9 @@ void intrCallbackFunc(void *pCallBackStr)
 {
   //printf("INTERRUPT CALLBACK : processing iDMA interrupt\n");
   ((intrCbDataStruct *) pCallBackStr)->intrCount++;
+#if (TILE_EXEC_NUM_WORKERS > 0)
+  tileExecDmaDoneFromISR(&tileExecObj);
+#endif
   //printf("INTERRUPT CALLBACK : processing iDMA interrupt count=%d\n", ((intrCbDataStruct *) pCallBackStr)->intrCount);
   return;
 }
@@ -125,6 +135,13 @@ void processData(xvTile* pInTile, xvTile* pOutTile)
   }
 }
 
+#if (TILE_EXEC_NUM_WORKERS > 0)
+static void processTile(xvTile* pInTile, xvTile* pOutTile, void *pArg)
+{
+  (void) pArg;
+  processData(pInTile, pOutTile);
+}
+#endif
 
 void process_eason(){
 
@@ -299,6 +316,38 @@ void appframework( void * pdata )
 
 
   //K_PrintASSERT(0, "framework_fail at line %d FILE=%s", __LINE__, __FILE__);
+#if (TILE_EXEC_NUM_WORKERS > 0)
+  int32_t workerInd;
+
+  // The workers of the executor own the tiles and their buffers
+  retVal = tileExecInit(&tileExecObj, pxvTM, TILE_EXEC_NUM_WORKERS, TILE_EXEC_WORKER_PRIO,
+                        TILE_WIDTH, TILE_HEIGHT, 0, 0, processTile, NULL);
+  if (retVal == XVTM_ERROR)
+  {
+    xvGetErrorInfo(pxvTM);
+    K_PrintASSERT(0, "framework_fail at line %d FILE=%s", __LINE__, __FILE__);
+  }
+
+  // Cycles of the whole frame, transfers included
+#pragma no_reorder
+  TIME_STAMP(cycleStart);
+#pragma no_reorder
+  tileCount = tileExecRunFrame(&tileExecObj, pInFrame, pOutFrame);
+#pragma no_reorder
+  TIME_STAMP(cycleStop);
+#pragma no_reorder
+  totalCycles = cycleStop - cycleStart;
+  if (tileCount == XVTM_ERROR)
+  {
+    K_PrintASSERT(0, " dma error\n");
+    tileCount = 0;
+  }
+  for (workerInd = 0; workerInd < TILE_EXEC_NUM_WORKERS; workerInd++)
+  {
+    printf("worker %d: tiles %d, stolen %d in %d steals\n", workerInd, tileExecObj.workers[workerInd].tilesDone,
+           tileExecObj.workers[workerInd].tilesStolen, tileExecObj.workers[workerInd].steals);
+  }
+#else
   /////////////////////////// 
   //INNER pIN
 
@@ -518,6 +567,7 @@ void appframework( void * pdata )
   //taskEXIT_CRITICAL();
   // Wait for the last output tile transfer
   WAIT_FOR_TILE(pxvTM, pOutTile[pingPongFlag ^ 0x01]);
+#endif
   oimage.compWidth = 8;
   //write output
   oimage.x    = IMAGE_WIDTH;
@@ -539,7 +589,9 @@ void appframework( void * pdata )
     printf("\nappFramework\tprocessData\t%f\tCPP\tPASS\n", (float) totalCycles / (float) (IMAGE_WIDTH * IMAGE_HEIGHT));
   }
 
+#if (TILE_EXEC_NUM_WORKERS == 0)
   printf("total IDMA config transfer time =%f\n", (float)totalCycles2/(float)tileCount);
+#endif
   // Free input image
   free(gSrc);
   free(image);
@@ -561,6 +613,14 @@ void appframework( void * pdata )
   //  return(RET_ERROR);
   }
 
+#if (TILE_EXEC_NUM_WORKERS > 0)
+  retVal = tileExecDelete(&tileExecObj);
+  if (retVal == XVTM_ERROR)
+  {
+    xvGetErrorInfo(pxvTM);
+    K_PrintASSERT(0, "framework_fail at line %d FILE=%s", __LINE__, __FILE__);
+  }
+#else
   // Free tile data buffers
   retVal = xvFreeBuffer(pxvTM, pinTileBuff[0]);
   if (retVal == XVTM_ERROR)
@@ -626,6 +686,7 @@ void appframework( void * pdata )
     K_PrintASSERT(0, "framework_fail at line %d FILE=%s", __LINE__, __FILE__);
   //  return(RET_ERROR);
   }
+#endif
 
   printf("\nDone\n");
 
@@ -0,0 +1,658 @@
+/*
+ * Copyright (c) 2016 by Cadence Design Systems, Inc.  ALL RIGHTS RESERVED.
+ * These coded instructions, statements, and computer programs are the
+ * copyrighted works and confidential proprietary information of
+ * Cadence Design Systems Inc.  They may be adapted and modified by bona fide
+ * purchasers for internal use, but neither the original nor any adapted
+ * or modified version may be disclosed or distributed to third parties
+ * in any manner, medium, or form, in whole or in part, without the prior
+ * written consent of Cadence Design Systems Inc.  This software and its
+ * derivatives are to be executed solely on products incorporating a Cadence
+ * Design Systems processor.
+ */
+
+/* *****************************************************************************
+ * FILE:  tileExec.c
+ *
+ * DESCRIPTION:
+ *
+ *    Work stealing tile executor, see tileExec.h.
+ *
+ *    The tiles of a frame are numbered in raster order and each worker owns
+ *    the tiles [front, back). The owner takes tiles from the front and
+ *    thieves take them from the back, both in a critical section. The
+ *    kernel runs all tasks on one core, so the critical section is all the
+ *    two ends need.
+ *
+ *    Every tile is counted once in tilesDone, by write-back when its output
+ *    transfer completed or by whoever saw its transfer fail.
+ *
+ * ****************************************************************************/
+
+#include <string.h>
+
+#include "tileExec.h"
+
+#define TILE_EXEC_NO_TILE  -1
+
+static void tmLock(tileExec *pExec)
+{
+  xSemaphoreTake(pExec->xTMLock, portMAX_DELAY);
+}
+
+static void tmUnlock(tileExec *pExec)
+{
+  xSemaphoreGive(pExec->xTMLock);
+}
+
+// Counts one tile of the frame as done and wakes the caller after the last
+static void tileDone(tileExec *pExec, int32_t status)
+{
+  int32_t done;
+
+  taskENTER_CRITICAL();
+  if (status == XVTM_ERROR)
+  {
+    pExec->errFlag = XVTM_ERROR;
+  }
+  done = ++pExec->tilesDone;
+  taskEXIT_CRITICAL();
+
+  if (done == pExec->numTiles)
+  {
+    xTaskNotifyGive(pExec->xCaller);
+  }
+}
+
+static int32_t takeTile(tileExecWorker *pWorker)
+{
+  int32_t tile = TILE_EXEC_NO_TILE;
+
+  taskENTER_CRITICAL();
+  if (pWorker->front < pWorker->back)
+  {
+    tile = pWorker->front++;
+  }
+  taskEXIT_CRITICAL();
+  return(tile);
+}
+
+// Moves the back half of the largest range of the other workers to the
+// empty range of pWorker and takes its first tile
+static int32_t stealTiles(tileExecWorker *pWorker)
+{
+  tileExec *pExec = pWorker->pExec;
+  tileExecWorker *pVictim = NULL;
+  int32_t indx, left, most = 0, count;
+  int32_t tile = TILE_EXEC_NO_TILE;
+
+  taskENTER_CRITICAL();
+  for (indx = 1; indx < pExec->numWorkers; indx++)
+  {
+    tileExecWorker *pOther = &pExec->workers[(pWorker->index + indx) % pExec->numWorkers];
+    left = pOther->back - pOther->front;
+    if (left > most)
+    {
+      most    = left;
+      pVictim = pOther;
+    }
+  }
+  if (pVictim != NULL)
+  {
+    count           = (most + 1) / 2;
+    pWorker->back   = pVictim->back;
+    pVictim->back  -= count;
+    pWorker->front  = pVictim->back;
+    tile            = pWorker->front++;
+    pWorker->steals++;
+    pWorker->tilesStolen += count;
+  }
+  taskEXIT_CRITICAL();
+  return(tile);
+}
+
+/* ***********************************************************************
+ * FUNCTION: checkTile()
+ * DESCRIPTION: Checks whether the transfer of pTile completed. The caller
+ *              is marked as waiting for a transfer first, so that the
+ *              completion interrupt of a transfer that is still going on
+ *              notifies it.
+ * OUTPUTS:
+ *          Returns 1 if the transfer completed, 0 if it did not and
+ *          XVTM_ERROR if it failed
+ ************************************************************************/
+static int32_t checkTile(tileExec *pExec, xvTile *pTile, uint32_t waitBit)
+{
+  int32_t ready;
+
+  taskENTER_CRITICAL();
+  pExec->dmaWaiters |= waitBit;
+  taskEXIT_CRITICAL();
+
+  tmLock(pExec);
+  ready = xvCheckTileReady(pExec->pxvTM, pTile);
+  if ((ready == 0) && (pExec->pxvTM->idmaErrorFlag != XV_ERROR_SUCCESS))
+  {
+    ready = XVTM_ERROR;
+  }
+  tmUnlock(pExec);
+
+  if (ready != 0)
+  {
+    taskENTER_CRITICAL();
+    pExec->dmaWaiters &= ~waitBit;
+    taskEXIT_CRITICAL();
+  }
+  return(ready);
+}
+
+// Blocks until a transfer completes, or for a tick if no completion
+// interrupt wakes the caller
+static void sleepForDma(void)
+{
+#if (configGENERATE_RUN_TIME_STATS == 1)
+  vTaskSetWaitReason(eWaitDMA);
+#endif
+  ulTaskNotifyTake(pdTRUE, 1);
+#if (configGENERATE_RUN_TIME_STATS == 1)
+  vTaskSetWaitReason(eWaitNone);
+#endif
+}
+
+static int32_t waitForTile(tileExec *pExec, xvTile *pTile, uint32_t waitBit)
+{
+  int32_t ready;
+
+  while ((ready = checkTile(pExec, pTile, waitBit)) == 0)
+  {
+    sleepForDma();
+  }
+  return((ready == 1) ? XVTM_SUCCESS : XVTM_ERROR);
+}
+
+static int32_t reqTileIn(tileExecWorker *pWorker, xvTile *pInTile, int32_t tile)
+{
+  tileExec *pExec = pWorker->pExec;
+  int32_t retVal;
+
+  XV_TILE_SET_FRAME_PTR(pInTile, pExec->pInFrame);
+  XV_TILE_SET_X_COORD(pInTile, (tile % pExec->tilesPerRow) * pExec->tileWidth);
+  XV_TILE_SET_Y_COORD(pInTile, (tile / pExec->tilesPerRow) * pExec->tileHeight);
+
+  tmLock(pExec);
+  retVal = xvReqTileTransferIn(pExec->pxvTM, pInTile, NULL, 1);
+  tmUnlock(pExec);
+  return(retVal);
+}
+
+// Processes pInTile into the next output tile of the worker and hands
+// that to write-back
+static void processTile(tileExecWorker *pWorker, xvTile *pInTile)
+{
+  tileExec *pExec = pWorker->pExec;
+  int32_t outIndex = pWorker->outNext;
+  xvTile *pOutTile = pWorker->pOutTile[outIndex];
+  tileExecWbEntry *pEntry;
+
+  // Write-back gives the output tile back after its transfer
+  while (pWorker->outBusy[outIndex])
+  {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+
+  XV_TILE_SET_FRAME_PTR(pOutTile, pExec->pOutFrame);
+  XV_TILE_SET_X_COORD(pOutTile, XV_TILE_GET_X_COORD(pInTile));
+  XV_TILE_SET_Y_COORD(pOutTile, XV_TILE_GET_Y_COORD(pInTile));
+  pExec->process(pInTile, pOutTile, pExec->pArg);
+  pWorker->tilesDone++;
+
+  pWorker->outBusy[outIndex] = 1;
+  pWorker->outNext           = (outIndex + 1) % TILE_EXEC_OUT_TILES;
+
+  taskENTER_CRITICAL();
+  pEntry           = &pExec->wbRing[pExec->wbHead % TILE_EXEC_WB_RING];
+  pEntry->pWorker  = pWorker;
+  pEntry->outIndex = outIndex;
+  pExec->wbHead++;
+  taskEXIT_CRITICAL();
+
+  xTaskNotifyGive(pExec->xWbTask);
+}
+
+/* ***********************************************************************
+ * FUNCTION: workerTask()
+ * DESCRIPTION: Takes the tiles of its range, or steals some when it is
+ *              empty, and processes them. The input transfer of the next
+ *              tile is started before the current one is processed.
+ ************************************************************************/
+static void workerTask(void *pdata)
+{
+  tileExecWorker *pWorker = (tileExecWorker *) pdata;
+  tileExec *pExec         = pWorker->pExec;
+  uint32_t waitBit        = 1u << pWorker->index;
+  int32_t tile, nextTile, pingPongFlag = 0;
+
+  tile = TILE_EXEC_NO_TILE;
+  for (;;)
+  {
+    if (tile == TILE_EXEC_NO_TILE)
+    {
+      tile = takeTile(pWorker);
+      if (tile == TILE_EXEC_NO_TILE)
+      {
+        tile = stealTiles(pWorker);
+      }
+      if (tile == TILE_EXEC_NO_TILE)
+      {
+        if (pExec->stop)
+        {
+          break;
+        }
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        continue;
+      }
+      if (reqTileIn(pWorker, pWorker->pInTile[pingPongFlag], tile) == XVTM_ERROR)
+      {
+        tileDone(pExec, XVTM_ERROR);
+        tile = TILE_EXEC_NO_TILE;
+        continue;
+      }
+    }
+
+    nextTile = takeTile(pWorker);
+    if (nextTile == TILE_EXEC_NO_TILE)
+    {
+      nextTile = stealTiles(pWorker);
+    }
+    if ((nextTile != TILE_EXEC_NO_TILE) &&
+        (reqTileIn(pWorker, pWorker->pInTile[pingPongFlag ^ 0x1], nextTile) == XVTM_ERROR))
+    {
+      tileDone(pExec, XVTM_ERROR);
+      nextTile = TILE_EXEC_NO_TILE;
+    }
+
+    if (waitForTile(pExec, pWorker->pInTile[pingPongFlag], waitBit) == XVTM_SUCCESS)
+    {
+      processTile(pWorker, pWorker->pInTile[pingPongFlag]);
+    }
+    else
+    {
+      tileDone(pExec, XVTM_ERROR);
+    }
+
+    tile         = nextTile;
+    pingPongFlag = pingPongFlag ^ 0x1;
+  }
+
+  taskENTER_CRITICAL();
+  pWorker->xTask     = NULL;
+  pExec->dmaWaiters &= ~waitBit;
+  taskEXIT_CRITICAL();
+  xTaskNotifyGive(pExec->xCaller);
+  vTaskDelete(NULL);
+}
+
+static void releaseOutTile(tileExecWbEntry *pEntry)
+{
+  pEntry->pWorker->outBusy[pEntry->outIndex] = 0;
+  xTaskNotifyGive(pEntry->pWorker->xTask);
+}
+
+/* ***********************************************************************
+ * FUNCTION: writeBackTask()
+ * DESCRIPTION: Starts the output transfers of the tiles handed over by the
+ *              workers and gives each tile back to its worker once its
+ *              transfer completed. Transfers complete in the order they
+ *              were started, so they are retired in that order.
+ ************************************************************************/
+static void writeBackTask(void *pdata)
+{
+  tileExec *pExec  = (tileExec *) pdata;
+  uint32_t waitBit = 1u << pExec->numWorkers;
+  tileExecWbEntry inFlight[TILE_EXEC_WB_RING];
+  tileExecWbEntry *pEntry;
+  uint32_t inHead = 0, inTail = 0;
+  int32_t retVal;
+
+  for (;;)
+  {
+    while (pExec->wbTail != pExec->wbHead)
+    {
+      pEntry = &inFlight[inHead % TILE_EXEC_WB_RING];
+      *pEntry = pExec->wbRing[pExec->wbTail % TILE_EXEC_WB_RING];
+      pExec->wbTail++;
+
+      tmLock(pExec);
+      retVal = xvReqTileTransferOut(pExec->pxvTM, pEntry->pWorker->pOutTile[pEntry->outIndex], 1);
+      tmUnlock(pExec);
+      if (retVal == XVTM_ERROR)
+      {
+        releaseOutTile(pEntry);
+        tileDone(pExec, XVTM_ERROR);
+      }
+      else
+      {
+        inHead++;
+      }
+    }
+
+    while (inTail != inHead)
+    {
+      pEntry = &inFlight[inTail % TILE_EXEC_WB_RING];
+      retVal = checkTile(pExec, pEntry->pWorker->pOutTile[pEntry->outIndex], waitBit);
+      if (retVal == 0)
+      {
+        break;
+      }
+      inTail++;
+      releaseOutTile(pEntry);
+      tileDone(pExec, (retVal == 1) ? XVTM_SUCCESS : XVTM_ERROR);
+    }
+
+    if (inTail != inHead)
+    {
+      sleepForDma();
+    }
+    else if (pExec->stop && (pExec->wbTail == pExec->wbHead))
+    {
+      break;
+    }
+    else
+    {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+  }
+
+  taskENTER_CRITICAL();
+  pExec->xWbTask     = NULL;
+  pExec->dmaWaiters &= ~waitBit;
+  taskEXIT_CRITICAL();
+  xTaskNotifyGive(pExec->xCaller);
+  vTaskDelete(NULL);
+}
+
+/* ***********************************************************************
+ * FUNCTION: tileExecInit()
+ * DESCRIPTION: Allocates the tiles and buffers of the workers and creates
+ *              the worker and write-back tasks
+ * INPUTS:
+ *          xvTileManager *pxvTM      : Tile manager, initialized
+ *          int32_t numWorkers        : 1 to TILE_EXEC_MAX_WORKERS
+ *          UBaseType_t priority      : Priority of the workers
+ *          int32_t tileWidth, tileHeight, edgeWidth, edgeHeight
+ *                                    : Input tile geometry, output tiles
+ *                                      have no edges
+ *          tileExecProcessFn process : Tile processing function
+ *          void *pArg                : Passed to process
+ * OUTPUTS:
+ *          tileExec *pExec : executor object
+ *          Returns XVTM_ERROR if an error occurs
+ ************************************************************************/
+int32_t tileExecInit(tileExec *pExec, xvTileManager *pxvTM, int32_t numWorkers, UBaseType_t priority,
+                     int32_t tileWidth, int32_t tileHeight, int32_t edgeWidth, int32_t edgeHeight,
+                     tileExecProcessFn process, void *pArg)
+{
+  int32_t indx, buf, inPitch, inBuffSize, outBuffSize;
+  tileExecWorker *pWorker;
+
+  if ((pExec == NULL) || (pxvTM == NULL) || (process == NULL) ||
+      (numWorkers < 1) || (numWorkers > TILE_EXEC_MAX_WORKERS))
+  {
+    return(XVTM_ERROR);
+  }
+
+  memset(pExec, 0, sizeof(tileExec));
+  pExec->pxvTM      = pxvTM;
+  pExec->tileWidth  = tileWidth;
+  pExec->tileHeight = tileHeight;
+  pExec->edgeWidth  = edgeWidth;
+  pExec->edgeHeight = edgeHeight;
+  pExec->process    = process;
+  pExec->pArg       = pArg;
+  pExec->errFlag    = XVTM_SUCCESS;
+
+  pExec->xTMLock = xSemaphoreCreateMutex();
+  if (pExec->xTMLock == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+
+  inPitch     = tileWidth + 2 * edgeWidth;
+  inBuffSize  = inPitch * (tileHeight + 2 * edgeHeight);
+  outBuffSize = tileWidth * tileHeight;
+
+  for (indx = 0; indx < numWorkers; indx++)
+  {
+    pWorker        = &pExec->workers[indx];
+    pWorker->pExec = pExec;
+    pWorker->index = indx;
+    pExec->numWorkers++;
+
+    for (buf = 0; buf < 2; buf++)
+    {
+      pWorker->pInBuff[buf] = xvAllocateBuffer(pxvTM, inBuffSize, XV_MEM_BANK_COLOR_0, 64);
+      pWorker->pInTile[buf] = xvAllocateTile(pxvTM);
+      if (((int32_t) pWorker->pInBuff[buf] == XVTM_ERROR) || ((int32_t) pWorker->pInTile[buf] == XVTM_ERROR))
+      {
+        tileExecDelete(pExec);
+        return(XVTM_ERROR);
+      }
+      SETUP_TILE(pWorker->pInTile[buf], pWorker->pInBuff[buf], inBuffSize, NULL, tileWidth, tileHeight, inPitch,
+                 XV_TILE_U8, edgeWidth, edgeHeight, 0, 0, EDGE_ALIGNED_64);
+    }
+
+    for (buf = 0; buf < TILE_EXEC_OUT_TILES; buf++)
+    {
+      pWorker->pOutBuff[buf] = xvAllocateBuffer(pxvTM, outBuffSize, XV_MEM_BANK_COLOR_1, 64);
+      pWorker->pOutTile[buf] = xvAllocateTile(pxvTM);
+      if (((int32_t) pWorker->pOutBuff[buf] == XVTM_ERROR) || ((int32_t) pWorker->pOutTile[buf] == XVTM_ERROR))
+      {
+        tileExecDelete(pExec);
+        return(XVTM_ERROR);
+      }
+      SETUP_TILE(pWorker->pOutTile[buf], pWorker->pOutBuff[buf], outBuffSize, NULL, tileWidth, tileHeight, tileWidth,
+                 XV_TILE_U8, 0, 0, 0, 0, EDGE_ALIGNED_64);
+    }
+  }
+
+  // Write-back first, the workers hand tiles to it
+  if (xTaskCreate(writeBackTask, "tileWb", TILE_EXEC_STACK_SIZE, pExec, priority + 1, &pExec->xWbTask) != pdPASS)
+  {
+    pExec->xWbTask = NULL;
+    tileExecDelete(pExec);
+    return(XVTM_ERROR);
+  }
+  for (indx = 0; indx < numWorkers; indx++)
+  {
+    pWorker = &pExec->workers[indx];
+    if (xTaskCreate(workerTask, "tileWorker", TILE_EXEC_STACK_SIZE, pWorker, priority, &pWorker->xTask) != pdPASS)
+    {
+      pWorker->xTask = NULL;
+      tileExecDelete(pExec);
+      return(XVTM_ERROR);
+    }
+  }
+  return(XVTM_SUCCESS);
+}
+
+/* ***********************************************************************
+ * FUNCTION: tileExecRunFrame()
+ * DESCRIPTION: Splits the full tiles of the frame into one range per
+ *              worker, wakes the workers and waits until the last tile is
+ *              written back
+ * INPUTS:
+ *          tileExec *pExec    : executor object
+ *          xvFrame *pInFrame  : input frame
+ *          xvFrame *pOutFrame : output frame, same size as pInFrame
+ * OUTPUTS:
+ *          Returns the number of tiles processed, XVTM_ERROR if a
+ *          transfer failed
+ ************************************************************************/
+int32_t tileExecRunFrame(tileExec *pExec, xvFrame *pInFrame, xvFrame *pOutFrame)
+{
+  int32_t indx, numTiles;
+  tileExecWorker *pWorker;
+
+  if ((pExec == NULL) || (pExec->xWbTask == NULL) || (pInFrame == NULL) || (pOutFrame == NULL))
+  {
+    return(XVTM_ERROR);
+  }
+
+  pExec->pInFrame    = pInFrame;
+  pExec->pOutFrame   = pOutFrame;
+  pExec->tilesPerRow = XV_FRAME_GET_WIDTH(pInFrame) / pExec->tileWidth;
+  numTiles           = pExec->tilesPerRow * (XV_FRAME_GET_HEIGHT(pInFrame) / pExec->tileHeight);
+  if (numTiles == 0)
+  {
+    return(0);
+  }
+  pExec->numTiles  = numTiles;
+  pExec->tilesDone = 0;
+  pExec->errFlag   = XVTM_SUCCESS;
+  pExec->xCaller   = xTaskGetCurrentTaskHandle();
+
+  // Equal ranges in raster order, stealing evens out the cost
+  taskENTER_CRITICAL();
+  for (indx = 0; indx < pExec->numWorkers; indx++)
+  {
+    pWorker              = &pExec->workers[indx];
+    pWorker->front       = (numTiles * indx) / pExec->numWorkers;
+    pWorker->back        = (numTiles * (indx + 1)) / pExec->numWorkers;
+    pWorker->tilesDone   = 0;
+    pWorker->tilesStolen = 0;
+    pWorker->steals      = 0;
+  }
+  taskEXIT_CRITICAL();
+
+  for (indx = 0; indx < pExec->numWorkers; indx++)
+  {
+    xTaskNotifyGive(pExec->workers[indx].xTask);
+  }
+
+  while (pExec->tilesDone < numTiles)
+  {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+
+  return((pExec->errFlag == XVTM_ERROR) ? XVTM_ERROR : numTiles);
+}
+
+/* ***********************************************************************
+ * FUNCTION: tileExecDelete()
+ * DESCRIPTION: Stops the tasks, waits for them to end and frees the
+ *              tiles and buffers of the workers. Also cleans up after a
+ *              failed tileExecInit().
+ * INPUTS:
+ *          tileExec *pExec : executor object
+ * OUTPUTS:
+ *          Returns XVTM_ERROR if an error occurs
+ ************************************************************************/
+int32_t tileExecDelete(tileExec *pExec)
+{
+  TaskHandle_t xTasks[TILE_EXEC_MAX_WORKERS + 1];
+  int32_t indx, buf, numTasks = 0, ended = 0, retVal = XVTM_SUCCESS;
+  tileExecWorker *pWorker;
+
+  if (pExec == NULL)
+  {
+    return(XVTM_ERROR);
+  }
+
+  pExec->xCaller = xTaskGetCurrentTaskHandle();
+
+  // No task runs before all are told to stop
+  vTaskSuspendAll();
+  pExec->stop = 1;
+  for (indx = 0; indx < pExec->numWorkers; indx++)
+  {
+    if (pExec->workers[indx].xTask != NULL)
+    {
+      xTasks[numTasks++] = pExec->workers[indx].xTask;
+    }
+  }
+  if (pExec->xWbTask != NULL)
+  {
+    xTasks[numTasks++] = pExec->xWbTask;
+  }
+  for (indx = 0; indx < numTasks; indx++)
+  {
+    xTaskNotifyGive(xTasks[indx]);
+  }
+  xTaskResumeAll();
+
+  while (ended < numTasks)
+  {
+    ended += (int32_t) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+
+  for (indx = 0; indx < pExec->numWorkers; indx++)
+  {
+    pWorker = &pExec->workers[indx];
+    for (buf = 0; buf < 2; buf++)
+    {
+      if ((pWorker->pInTile[buf] != NULL) && ((int32_t) pWorker->pInTile[buf] != XVTM_ERROR))
+      {
+        retVal |= xvFreeTile(pExec->pxvTM, pWorker->pInTile[buf]);
+      }
+      if ((pWorker->pInBuff[buf] != NULL) && ((int32_t) pWorker->pInBuff[buf] != XVTM_ERROR))
+      {
+        retVal |= xvFreeBuffer(pExec->pxvTM, pWorker->pInBuff[buf]);
+      }
+    }
+    for (buf = 0; buf < TILE_EXEC_OUT_TILES; buf++)
+    {
+      if ((pWorker->pOutTile[buf] != NULL) && ((int32_t) pWorker->pOutTile[buf] != XVTM_ERROR))
+      {
+        retVal |= xvFreeTile(pExec->pxvTM, pWorker->pOutTile[buf]);
+      }
+      if ((pWorker->pOutBuff[buf] != NULL) && ((int32_t) pWorker->pOutBuff[buf] != XVTM_ERROR))
+      {
+        retVal |= xvFreeBuffer(pExec->pxvTM, pWorker->pOutBuff[buf]);
+      }
+    }
+  }
+
+  if (pExec->xTMLock != NULL)
+  {
+    vSemaphoreDelete(pExec->xTMLock);
+    pExec->xTMLock = NULL;
+  }
+  pExec->numWorkers = 0;
+
+  return((retVal == XVTM_SUCCESS) ? XVTM_SUCCESS : XVTM_ERROR);
+}
+
+/* ***********************************************************************
+ * FUNCTION: tileExecDmaDoneFromISR()
+ * DESCRIPTION: Notifies the tasks waiting for a transfer. They check their
+ *              tile again, so one notification for any completion is
+ *              enough.
+ * INPUTS:
+ *          tileExec *pExec : executor object
+ ************************************************************************/
+void tileExecDmaDoneFromISR(tileExec *pExec)
+{
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  uint32_t waiters;
+  int32_t indx;
+
+  waiters = pExec->dmaWaiters;
+  if (waiters == 0)
+  {
+    return;
+  }
+  pExec->dmaWaiters = 0;
+
+  for (indx = 0; indx < pExec->numWorkers; indx++)
+  {
+    if ((waiters & (1u << indx)) && (pExec->workers[indx].xTask != NULL))
+    {
+      vTaskNotifyGiveFromISR(pExec->workers[indx].xTask, &xHigherPriorityTaskWoken);
+    }
+  }
+  if ((waiters & (1u << pExec->numWorkers)) && (pExec->xWbTask != NULL))
+  {
+    vTaskNotifyGiveFromISR(pExec->xWbTask, &xHigherPriorityTaskWoken);
+  }
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
@@ -32,9 +32,14 @@
 #include "FreeRTOS.h"
 #include "semphr.h"
 #include "event_groups.h"
+#include "objpool.h"
 
 #include <testcommon.h>
 
+#ifdef IDMA_MONITOR
+#include "idma_monitor.h"
+#endif
+
 #if (XT_USE_THREAD_SAFE_CLIB > 0)
 #include <stdio.h>
 #endif
@@ -55,7 +60,8 @@
 #define DISPLAY_TASK_PRIO       1
 #endif
 
-// Default task stack size.
+// Default task stack size. Tasks created from the pools need it to fit
+// configPOOL_LARGE_STACK_DEPTH of FreeRTOSConfig.h.
 #define TASK_STK_SIZE            (XT_STACK_MIN_SIZE + 0x400)
 
 // Flags set by each task on completion.
@@ -67,6 +73,18 @@
 // Message queue size.
 #define QUEUE_SIZE              10
 
+// The queue and the tasks Init_Task creates and deletes come from the
+// object pools if FreeRTOSConfig.h enables them.
+#if configUSE_OBJECT_POOLS
+#define QUEUE_CREATE            xQueueCreateFromPool
+#define QUEUE_DELETE            vQueueDeleteFromPool
+#define TASK_CREATE             xTaskCreateFromPool
+#else
+#define QUEUE_CREATE            xQueueCreate
+#define QUEUE_DELETE            vQueueDelete
+#define TASK_CREATE             xTaskCreate
+#endif
+
 EventGroupHandle_t TaskTermFlags;
 QueueHandle_t      Queue;
 TaskHandle_t       Count_Task_TCB;
@@ -217,7 +235,7 @@ void Init_Task( void * pdata )
 
     // Create queue for sequence of counts.
     PRINTF( "[Init_Task] Creating queue for sequence of counts.\n" );
-    Queue = xQueueCreate( QUEUE_SIZE, sizeof(uint32_t) );
+    Queue = QUEUE_CREATE( QUEUE_SIZE, sizeof(uint32_t) );
     if ( Queue == NULL )
     {
         PRINTF( "...FAILED .2!\n" );
@@ -228,7 +246,7 @@ void Init_Task( void * pdata )
     // Create reporting task.
     PRINTF( "[Init_Task] Creating reporting task Report_Task.\n" );
 
-    err = xTaskCreate( Report_Task, "Report_Task", TASK_STK_SIZE, NULL, REPORT_TASK_PRIO, &Report_Task_TCB );
+    err = TASK_CREATE( Report_Task, "Report_Task", TASK_STK_SIZE, NULL, REPORT_TASK_PRIO, &Report_Task_TCB );
     if ( err != pdPASS )
     {
         PRINTF( "...FAILED! .3!\n" );
@@ -237,7 +255,7 @@ void Init_Task( void * pdata )
 
     // Create counting task.
     PRINTF( "[Init_Task] Creating counting task Count_Task.\n" );
-    err = xTaskCreate( Count_Task, "Count_Task", TASK_STK_SIZE, NULL, COUNT_TASK_PRIO, &Count_Task_TCB );
+    err = TASK_CREATE( Count_Task, "Count_Task", TASK_STK_SIZE, NULL, COUNT_TASK_PRIO, &Count_Task_TCB );
     if ( err != pdPASS )
     {
         PRINTF( "...FAILED! .4!\n" );
@@ -286,16 +304,27 @@ void Init_Task( void * pdata )
     xEventGroupWaitBits( TaskTermFlags, TASK_TERM_REPORT | TASK_TERM_COUNT | TASK_TERM_IDMA, 0, pdTRUE, portMAX_DELAY );
 
 done:
-{
-	char pcWriteBuffer[200];
-    //vTaskGetRunTimeStats(pcWriteBuffer);
+#if (XT_USE_THREAD_SAFE_CLIB > 0) && (configGENERATE_RUN_TIME_STATS == 1) && (configUSE_STATS_FORMATTING_FUNCTIONS > 0)
+    {
+        // About 80 bytes per task. All times are in CCOUNT cycles.
+        static char pcWriteBuffer[1024];
+
+        printf( "[Init_Task] Run time stats:\nTask\t\tRun\t\tShare\n" );
+        vTaskGetRunTimeStats( pcWriteBuffer );
+        printf( "%s", pcWriteBuffer );
+
+        printf( "[Init_Task] Wait time stats:\nTask\t\tRun\tQueue\tiDMA\tOther\n" );
+        vTaskGetWaitTimeStats( pcWriteBuffer );
+        printf( "%s", pcWriteBuffer );
+        fflush( stdout );
+    }
+#endif
 
-}
     // Clean up and shut down.
     exit_code = ( err != pdPASS );
     PRINTF( "[Init_Task] Cleaning up resources and terminating.\n" );
 
-    vQueueDelete( Queue );
+    QUEUE_DELETE( Queue );
     vEventGroupDelete( TaskTermFlags );
 
 #ifdef XT_SIMULATOR
@@ -316,6 +345,10 @@ done:
 #if configUSE_TICK_HOOK
 void vApplicationTickHook( void )
 {
+#ifdef IDMA_MONITOR
+    // Sample iDMA utilization once per tick, see idma_monitor_get().
+    idma_monitor_sample();
+#endif
 }
 #endif
 
@@ -35,6 +35,7 @@
 
 #ifdef _FREERTOS_
 #include "FreeRTOS.h"
+#include "task.h"
 #include "semphr.h"
 extern  QueueHandle_t IDMA_SEMA;
 #endif
@@ -158,7 +159,14 @@ test(void* arg, int unused)
 
 #ifdef _FREERTOS_
    printf("xSemaphoreTake\n");
+#if (configGENERATE_RUN_TIME_STATS == 1)
+   vTaskSetWaitReason(eWaitDMA);
+#endif
    ret = xSemaphoreTake(IDMA_SEMA, portMAX_DELAY );
+   portbenchmarkIntWait(portbenchmarkSRC_IDMA_DONE);
+#if (configGENERATE_RUN_TIME_STATS == 1)
+   vTaskSetWaitReason(eWaitNone);
+#endif
    if(ret != pdPASS)
 	   K_ASSERT(0, "xSemaphoreTake err =%x", ret);
 
@@ -0,0 +1,210 @@
+/*
+ * FreeRTOS Kernel V10.2.1
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Host iDMA model for the POSIX simulation port, see idma_sim.h.
+ *
+ * Transfers are kept in a ring indexed by three counters: ulSubmitted is
+ * advanced by the tasks that queue transfers, ulCompleted by the model
+ * thread once it copied the data, and ulRetired by the interrupt handler
+ * once it ran the completion callback.  A slot is reused only after it has
+ * been retired.
+ */
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "idma_sim.h"
+
+typedef struct xSIM_IDMA_TRANSFER
+{
+	void *pvDst;
+	const void *pvSrc;
+	size_t xBytes;
+	portSimIdmaCallback pxCallback;
+	void *pvArg;
+} SimIdmaTransfer_t;
+
+static SimIdmaTransfer_t xTransfers[ portSIM_IDMA_QUEUE_LENGTH ];
+static volatile uint32_t ulSubmitted = 0;
+static volatile uint32_t ulCompleted = 0;
+static volatile uint32_t ulRetired = 0;
+
+/* Protects ulSubmitted and the slots being filled against the model thread. */
+static pthread_mutex_t xIdmaMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t xIdmaCond = PTHREAD_COND_INITIALIZER;
+static pthread_t xIdmaThread;
+
+/*
+ * Executes the queued transfers one after the other.
+ */
+static void *prvIdmaThread( void *pvParameters );
+
+/*
+ * portSIM_INT_IDMA handler, runs the callbacks of the completed transfers.
+ */
+static void prvIdmaInterrupt( void *pvArg );
+
+/*-----------------------------------------------------------*/
+
+static void *prvIdmaThread( void *pvParameters )
+{
+SimIdmaTransfer_t *pxTransfer;
+struct timespec xDelay;
+sigset_t xSignals;
+uint64_t ullNanoseconds;
+
+	( void ) pvParameters;
+
+	/* Simulated interrupts are only delivered to task threads. */
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, SIGUSR1 );
+	pthread_sigmask( SIG_BLOCK, &xSignals, NULL );
+
+	for( ;; )
+	{
+		pthread_mutex_lock( &xIdmaMutex );
+		while( ulCompleted == ulSubmitted )
+		{
+			pthread_cond_wait( &xIdmaCond, &xIdmaMutex );
+		}
+		pxTransfer = &xTransfers[ ulCompleted % portSIM_IDMA_QUEUE_LENGTH ];
+		pthread_mutex_unlock( &xIdmaMutex );
+
+		/* Take as long as the transfer would take on the target. */
+		ullNanoseconds = ( ( uint64_t ) pxTransfer->xBytes * 1000ULL ) / portSIM_IDMA_BYTES_PER_US;
+		xDelay.tv_sec = ( time_t ) ( ullNanoseconds / 1000000000ULL );
+		xDelay.tv_nsec = ( long ) ( ullNanoseconds % 1000000000ULL );
+		while( nanosleep( &xDelay, &xDelay ) == -1 )
+		{
+			if( errno != EINTR )
+			{
+				break;
+			}
+		}
+
+		memcpy( pxTransfer->pvDst, pxTransfer->pvSrc, pxTransfer->xBytes );
+
+		/* The copy is visible to the handler before the completion is. */
+		__atomic_add_fetch( &ulCompleted, 1, __ATOMIC_SEQ_CST );
+		vPortSimRaiseInterrupt( portSIM_INT_IDMA );
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvIdmaInterrupt( void *pvArg )
+{
+uint32_t ulDone;
+SimIdmaTransfer_t *pxTransfer;
+portSimIdmaCallback pxCallback;
+void *pvCallbackArg;
+
+	( void ) pvArg;
+
+	ulDone = __atomic_load_n( &ulCompleted, __ATOMIC_SEQ_CST );
+
+	while( ulRetired != ulDone )
+	{
+		pxTransfer = &xTransfers[ ulRetired % portSIM_IDMA_QUEUE_LENGTH ];
+		pxCallback = pxTransfer->pxCallback;
+		pvCallbackArg = pxTransfer->pvArg;
+
+		/* Free the slot first, the callback may queue the next transfer. */
+		__atomic_add_fetch( &ulRetired, 1, __ATOMIC_SEQ_CST );
+
+		if( pxCallback != NULL )
+		{
+			pxCallback( pvCallbackArg );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortSimIdmaInit( void )
+{
+	if( xPortSimSetInterruptHandler( portSIM_INT_IDMA, prvIdmaInterrupt, NULL ) != pdPASS )
+	{
+		return pdFAIL;
+	}
+
+	if( pthread_create( &xIdmaThread, NULL, prvIdmaThread, NULL ) != 0 )
+	{
+		return pdFAIL;
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortSimIdmaCopy( void *pvDst, const void *pvSrc, size_t xBytes, portSimIdmaCallback pxCallback, void *pvArg )
+{
+SimIdmaTransfer_t *pxTransfer;
+UBaseType_t uxSavedInterruptStatus;
+BaseType_t xReturn;
+
+	/* The running task must not be switched out while it holds the mutex,
+	another task queueing a transfer would deadlock on it. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	pthread_mutex_lock( &xIdmaMutex );
+
+	if( ( ulSubmitted - __atomic_load_n( &ulRetired, __ATOMIC_SEQ_CST ) ) >= portSIM_IDMA_QUEUE_LENGTH )
+	{
+		xReturn = pdFAIL;
+	}
+	else
+	{
+		pxTransfer = &xTransfers[ ulSubmitted % portSIM_IDMA_QUEUE_LENGTH ];
+		pxTransfer->pvDst = pvDst;
+		pxTransfer->pvSrc = pvSrc;
+		pxTransfer->xBytes = xBytes;
+		pxTransfer->pxCallback = pxCallback;
+		pxTransfer->pvArg = pvArg;
+		ulSubmitted++;
+		pthread_cond_signal( &xIdmaCond );
+		xReturn = pdPASS;
+	}
+
+	pthread_mutex_unlock( &xIdmaMutex );
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortSimIdmaOutstanding( void )
+{
+	return ( UBaseType_t ) ( __atomic_load_n( &ulSubmitted, __ATOMIC_SEQ_CST ) - __atomic_load_n( &ulRetired, __ATOMIC_SEQ_CST ) );
+}
+/*-----------------------------------------------------------*/
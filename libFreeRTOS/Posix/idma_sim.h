@@ -0,0 +1,85 @@
+/*
+ * FreeRTOS Kernel V10.2.1
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef IDMA_SIM_H
+#define IDMA_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Host model of one iDMA channel for the POSIX simulation port.
+ *
+ * Transfers are executed in submission order by a model thread, which takes
+ * the time a transfer would take at portSIM_IDMA_BYTES_PER_US, copies the
+ * data and raises portSIM_INT_IDMA.  The completion callbacks then run on the
+ * running task's thread like the iDMA done interrupt handler, so they may use
+ * the ...FromISR() API functions.  The idle task sleeping in tickless idle
+ * is woken by the completion like WAITI on the target.
+ *
+ * The model stands in for the iDMA hardware, not for libidma: libidma
+ * accesses the iDMA registers and is not built for the host.  Task and DMA
+ * interaction (blocking until a transfer completes, tickless idle through
+ * transfers, completion interrupt load) is modelled through this API.
+ */
+
+#ifndef portSIM_IDMA_BYTES_PER_US
+	#define portSIM_IDMA_BYTES_PER_US		1000U
+#endif
+
+/* Transfers that can be outstanding at once. */
+#ifndef portSIM_IDMA_QUEUE_LENGTH
+	#define portSIM_IDMA_QUEUE_LENGTH		16U
+#endif
+
+typedef void (*portSimIdmaCallback)( void *pvArg );
+
+/*
+ * Starts the model thread and installs the portSIM_INT_IDMA handler.  Call
+ * once before the first transfer.
+ */
+BaseType_t xPortSimIdmaInit( void );
+
+/*
+ * Queues a copy of xBytes bytes from pvSrc to pvDst.  pxCallback, if not
+ * NULL, is called with pvArg from the simulated interrupt once the copy
+ * completed.  Returns pdFAIL if portSIM_IDMA_QUEUE_LENGTH transfers are
+ * outstanding.  May be called from tasks and from simulated interrupts.
+ */
+BaseType_t xPortSimIdmaCopy( void *pvDst, const void *pvSrc, size_t xBytes, portSimIdmaCallback pxCallback, void *pvArg );
+
+/*
+ * Returns the number of transfers whose completion callback has not run yet.
+ */
+UBaseType_t uxPortSimIdmaOutstanding( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IDMA_SIM_H */
@@ -0,0 +1,670 @@
+/*
+ * FreeRTOS Kernel V10.2.1
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * POSIX simulation port.
+ *
+ * Runs the kernel and the application as a Linux process, with the same
+ * include/FreeRTOSConfig.h as the Xtensa port (tickless idle mode 2, 25
+ * priorities, software timers, queue sets), so scheduling behaviour and
+ * kernel overhead can be measured on the host before running on the ISS or
+ * hardware.  Build it together with the kernel sources, for example:
+ *
+ *	gcc -Iinclude -IPosix tasks.c queue.c list.c timers.c timer_wheel.c \
+ *		event_groups.c stream_buffer.c objpool.c channel.c MemMang/heap_tlsf.c \
+ *		Posix/port.c Posix/idma_sim.c app.c -lpthread
+ *
+ * Posix/ provides portmacro.h and a stand-in xtensa_config.h, so it must come
+ * before any Xtensa include path.  The Xplorer project excludes Posix/ from
+ * the Xtensa build.
+ *
+ * Each task runs on its own pthread, but only the thread of the task in
+ * pxCurrentTCB executes, all others wait on their own event.  A context switch
+ * signals the event of the next task and waits on the event of the current
+ * one.  The control block of the thread is kept at the top of the task stack
+ * and pxTopOfStack points to it.
+ *
+ * Interrupts are simulated with SIGUSR1.  A timer thread counts the ticks and
+ * host models raise the lines of portmacro.h with vPortSimRaiseInterrupt(),
+ * both then send SIGUSR1 to the running thread.  The signal handler processes
+ * the pending ticks and interrupt lines only while the running task has
+ * interrupts enabled; otherwise they stay pending until the task enables them
+ * again, as on hardware.
+ *
+ * Posix/idma_sim.c models the iDMA: it executes transfers on a model thread
+ * and raises portSIM_INT_IDMA when they complete.  It replaces the iDMA
+ * hardware, libidma itself is not built for the host.
+ *
+ * Because a task can be switched out from the signal handler at any point
+ * where its interrupts are enabled, a task must not be preempted while it
+ * holds a lock of the host C library (printf(), malloc() ...), or the next
+ * task using it deadlocks.  Call those functions within a critical section.
+ */
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Control block of the thread that runs a task. */
+typedef struct xTHREAD
+{
+	pthread_t xThread;
+	TaskFunction_t pxCode;
+	void *pvParameters;
+	volatile BaseType_t xDying;		/*<< Set when the kernel deletes the task. */
+	pthread_mutex_t xMutex;			/*<< Event the thread waits on while not running. */
+	pthread_cond_t xCond;
+	BaseType_t xEventSet;
+} Thread_t;
+
+/* Simulated interrupt lines. */
+typedef struct xSIM_INTERRUPT
+{
+	portSimHandler pxHandler;
+	void *pvArg;
+} SimInterrupt_t;
+
+/* The task control block's first member points to the thread. */
+extern void * volatile pxCurrentTCB;
+#define portTHREAD( pxTCB )		( *( Thread_t ** ) ( pxTCB ) )
+
+/* Interrupt enable, per thread like the PS register is per task on the
+target.  Threads that are not running always have interrupts disabled. */
+static __thread volatile BaseType_t xInterruptsEnabled = pdFALSE;
+
+/* Set while the pending interrupts are processed on this thread. */
+static __thread volatile BaseType_t xInISR = pdFALSE;
+static __thread volatile BaseType_t xYieldFromISR = pdFALSE;
+
+/* Pending ticks and interrupt lines, set from any thread. */
+static volatile uint32_t ulPendingTicks = 0;
+static volatile uint32_t ulPendingInterrupts = 0;
+static SimInterrupt_t xSimInterrupts[ portSIM_NUM_INTERRUPTS ];
+
+/* Thread of the running task, the target of SIGUSR1. */
+static pthread_mutex_t xRunningMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t xRunningThread;
+
+/* Tick timer and tickless idle state, under xTickMutex. */
+static pthread_mutex_t xTickMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t xSleepCond = PTHREAD_COND_INITIALIZER;
+static pthread_t xTimerThread;
+static BaseType_t xSleeping = pdFALSE;
+static TickType_t xSleepTicks = 0;
+static TickType_t xSkippedTicks = 0;
+
+/* Scheduler end, signalled to the thread in xPortStartScheduler(). */
+static pthread_mutex_t xEndMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t xEndCond = PTHREAD_COND_INITIALIZER;
+static volatile BaseType_t xSchedulerEnd = pdFALSE;
+
+/* Time the run time counter counts from. */
+static uint64_t ullRunTimeCounterBase = 0;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Event a thread waits on while its task is not running.
+ */
+static void prvEventSignal( Thread_t *pxThread );
+static void prvEventWait( Thread_t *pxThread );
+
+/*
+ * Entry point of the thread of a task.
+ */
+static void *prvThreadEntry( void *pvParameters );
+
+/*
+ * Switches to the task selected by vTaskSwitchContext(), called by the
+ * running task with interrupts disabled.  Returns when the task runs again.
+ */
+static void prvSwitchContext( void );
+
+/*
+ * Processes the pending ticks and interrupt lines on the running thread, as
+ * the interrupt handlers of the target would.
+ */
+static void prvProcessInterrupts( void );
+
+/*
+ * CLOCK_MONOTONIC in microseconds.
+ */
+static uint64_t prvGetMicroseconds( void );
+
+/*
+ * SIGUSR1 handler.
+ */
+static void prvInterruptSignal( int iSignal );
+
+/*
+ * Sends SIGUSR1 to the running thread.
+ */
+static void prvKickRunningThread( void );
+
+/*
+ * Generates the ticks.
+ */
+static void *prvTimerThread( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static void prvEventSignal( Thread_t *pxThread )
+{
+	pthread_mutex_lock( &pxThread->xMutex );
+	pxThread->xEventSet = pdTRUE;
+	pthread_cond_signal( &pxThread->xCond );
+	pthread_mutex_unlock( &pxThread->xMutex );
+}
+/*-----------------------------------------------------------*/
+
+static void prvEventWait( Thread_t *pxThread )
+{
+	pthread_mutex_lock( &pxThread->xMutex );
+	while( pxThread->xEventSet == pdFALSE )
+	{
+		pthread_cond_wait( &pxThread->xCond, &pxThread->xMutex );
+	}
+	pxThread->xEventSet = pdFALSE;
+	pthread_mutex_unlock( &pxThread->xMutex );
+}
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+Thread_t *pxThread;
+pthread_attr_t xAttr;
+UBaseType_t uxSavedInterruptStatus;
+int iResult;
+
+	/* The thread's control block goes at the (aligned) top of the stack. */
+	pxThread = ( Thread_t * ) ( ( ( portPOINTER_SIZE_TYPE ) ( pxTopOfStack + 1 ) - sizeof( Thread_t ) ) & ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) );
+
+	memset( pxThread, 0, sizeof( Thread_t ) );
+	pxThread->pxCode = pxCode;
+	pxThread->pvParameters = pvParameters;
+	pthread_mutex_init( &pxThread->xMutex, NULL );
+	pthread_cond_init( &pxThread->xCond, NULL );
+
+	/* The thread waits for the task to be scheduled.  Creating it must not be
+	preempted, see the note at the top of the file. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pthread_attr_init( &xAttr );
+		iResult = pthread_create( &pxThread->xThread, &xAttr, prvThreadEntry, pxThread );
+		pthread_attr_destroy( &xAttr );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	configASSERT( iResult == 0 );
+	( void ) iResult;
+
+	return ( StackType_t * ) pxThread;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvThreadEntry( void *pvParameters )
+{
+Thread_t *pxThread = ( Thread_t * ) pvParameters;
+sigset_t xSignals;
+
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, SIGUSR1 );
+	pthread_sigmask( SIG_UNBLOCK, &xSignals, NULL );
+
+	prvEventWait( pxThread );
+
+	if( pxThread->xDying == pdFALSE )
+	{
+		/* A task starts with interrupts enabled. */
+		vPortEnableInterrupts();
+
+		pxThread->pxCode( pxThread->pvParameters );
+
+		/* Tasks should not return, delete those that do. */
+		vTaskDelete( NULL );
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+void vPortCancelThread( void *pxTaskToDelete )
+{
+Thread_t *pxThread = portTHREAD( pxTaskToDelete );
+
+	/* The task is not running, so its thread waits on its event.  Wake it to
+	exit and wait for it before the kernel frees the stack holding pxThread. */
+	pxThread->xDying = pdTRUE;
+	prvEventSignal( pxThread );
+	pthread_join( pxThread->xThread, NULL );
+
+	pthread_cond_destroy( &pxThread->xCond );
+	pthread_mutex_destroy( &pxThread->xMutex );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchContext( void )
+{
+Thread_t *pxOld = portTHREAD( pxCurrentTCB );
+Thread_t *pxNew;
+
+	vTaskSwitchContext();
+	pxNew = portTHREAD( pxCurrentTCB );
+
+	if( pxNew != pxOld )
+	{
+		pthread_mutex_lock( &xRunningMutex );
+		xRunningThread = pxNew->xThread;
+		pthread_mutex_unlock( &xRunningMutex );
+
+		prvEventSignal( pxNew );
+		prvEventWait( pxOld );
+
+		if( pxOld->xDying != pdFALSE )
+		{
+			pthread_exit( NULL );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+BaseType_t xWasEnabled = xInterruptsEnabled;
+
+	if( xInISR != pdFALSE )
+	{
+		/* From an interrupt handler, switch once it is done. */
+		xYieldFromISR = pdTRUE;
+		return;
+	}
+
+	xInterruptsEnabled = pdFALSE;
+	prvSwitchContext();
+
+	/* Restore the interrupt state of this task, portYIELD_WITHIN_API() is
+	called from critical sections. */
+	if( xWasEnabled != pdFALSE )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldFromISR( void )
+{
+	if( xInISR != pdFALSE )
+	{
+		xYieldFromISR = pdTRUE;
+	}
+	else
+	{
+		vPortYield();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	xInterruptsEnabled = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	xInterruptsEnabled = pdTRUE;
+
+	/* Take what was raised while they were disabled.  Anything raised from
+	here on is taken by the signal handler. */
+	if( ( __atomic_load_n( &ulPendingTicks, __ATOMIC_SEQ_CST ) != 0 ) ||
+		( __atomic_load_n( &ulPendingInterrupts, __ATOMIC_SEQ_CST ) != 0 ) )
+	{
+		prvProcessInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortSetInterruptMask( void )
+{
+UBaseType_t uxState = ( UBaseType_t ) xInterruptsEnabled;
+
+	xInterruptsEnabled = pdFALSE;
+	return uxState;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( UBaseType_t uxState )
+{
+	if( uxState != 0 )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessInterrupts( void )
+{
+uint32_t ulTicks, ulLines;
+UBaseType_t uxLine;
+
+	xInterruptsEnabled = pdFALSE;
+
+	for( ;; )
+	{
+		ulTicks = __atomic_exchange_n( &ulPendingTicks, 0, __ATOMIC_SEQ_CST );
+		ulLines = __atomic_exchange_n( &ulPendingInterrupts, 0, __ATOMIC_SEQ_CST );
+
+		if( ( ulTicks == 0 ) && ( ulLines == 0 ) )
+		{
+			break;
+		}
+
+		xInISR = pdTRUE;
+		xYieldFromISR = pdFALSE;
+
+		while( ulTicks-- > 0 )
+		{
+			if( xTaskIncrementTick() != pdFALSE )
+			{
+				xYieldFromISR = pdTRUE;
+			}
+		}
+
+		for( uxLine = 0; ulLines != 0; uxLine++, ulLines >>= 1 )
+		{
+			if( ( ( ulLines & 1UL ) != 0 ) && ( xSimInterrupts[ uxLine ].pxHandler != NULL ) )
+			{
+				xSimInterrupts[ uxLine ].pxHandler( xSimInterrupts[ uxLine ].pvArg );
+			}
+		}
+
+		xInISR = pdFALSE;
+
+		if( xYieldFromISR != pdFALSE )
+		{
+			prvSwitchContext();
+		}
+	}
+
+	xInterruptsEnabled = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInterruptSignal( int iSignal )
+{
+int iSavedErrno = errno;
+
+	( void ) iSignal;
+
+	/* Only the running thread has interrupts enabled. */
+	if( ( xInterruptsEnabled != pdFALSE ) && ( xInISR == pdFALSE ) )
+	{
+		prvProcessInterrupts();
+	}
+
+	errno = iSavedErrno;
+}
+/*-----------------------------------------------------------*/
+
+static void prvKickRunningThread( void )
+{
+	pthread_mutex_lock( &xRunningMutex );
+	pthread_kill( xRunningThread, SIGUSR1 );
+	pthread_mutex_unlock( &xRunningMutex );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortSimSetInterruptHandler( UBaseType_t uxLine, portSimHandler pxHandler, void *pvArg )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	if( uxLine >= portSIM_NUM_INTERRUPTS )
+	{
+		return pdFAIL;
+	}
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		xSimInterrupts[ uxLine ].pvArg = pvArg;
+		xSimInterrupts[ uxLine ].pxHandler = pxHandler;
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimRaiseInterrupt( UBaseType_t uxLine )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( uxLine < portSIM_NUM_INTERRUPTS );
+
+	__atomic_or_fetch( &ulPendingInterrupts, 1UL << uxLine, __ATOMIC_SEQ_CST );
+
+	/* A task raising a line takes it when it enables interrupts again, not
+	within the signal handler while it holds the locks below. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+	pthread_mutex_lock( &xTickMutex );
+	if( xSleeping != pdFALSE )
+	{
+		/* Wake the idle task from tickless idle. */
+		pthread_cond_signal( &xSleepCond );
+	}
+	else
+	{
+		prvKickRunningThread();
+	}
+	pthread_mutex_unlock( &xTickMutex );
+
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTimerThread( void *pvParameters )
+{
+struct timespec xNext;
+
+	( void ) pvParameters;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNext );
+
+	while( xSchedulerEnd == pdFALSE )
+	{
+		xNext.tv_nsec += 1000000000L / configTICK_RATE_HZ;
+		if( xNext.tv_nsec >= 1000000000L )
+		{
+			xNext.tv_nsec -= 1000000000L;
+			xNext.tv_sec++;
+		}
+
+		while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &xNext, NULL ) == EINTR )
+		{
+		}
+
+		pthread_mutex_lock( &xTickMutex );
+		if( ( xSleeping != pdFALSE ) && ( xSkippedTicks < xSleepTicks ) )
+		{
+			/* Tickless idle, count the tick instead of interrupting. */
+			if( ++xSkippedTicks == xSleepTicks )
+			{
+				pthread_cond_signal( &xSleepCond );
+			}
+		}
+		else
+		{
+			__atomic_add_fetch( &ulPendingTicks, 1, __ATOMIC_SEQ_CST );
+			prvKickRunningThread();
+		}
+		pthread_mutex_unlock( &xTickMutex );
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+TickType_t xSkipped;
+
+	/* Called by the idle task with the scheduler suspended. */
+	vPortDisableInterrupts();
+
+	if( ( eTaskConfirmSleepModeStatus() == eAbortSleep ) ||
+		( __atomic_load_n( &ulPendingTicks, __ATOMIC_SEQ_CST ) != 0 ) ||
+		( __atomic_load_n( &ulPendingInterrupts, __ATOMIC_SEQ_CST ) != 0 ) )
+	{
+		vPortEnableInterrupts();
+		return;
+	}
+
+	/* Sleep until the expected idle time has passed or an interrupt line is
+	raised, the tick thread counts the ticks meanwhile. */
+	pthread_mutex_lock( &xTickMutex );
+	xSkippedTicks = 0;
+	xSleepTicks = xExpectedIdleTime;
+	xSleeping = pdTRUE;
+
+	while( ( xSkippedTicks < xSleepTicks ) &&
+		   ( __atomic_load_n( &ulPendingInterrupts, __ATOMIC_SEQ_CST ) == 0 ) &&
+		   ( xSchedulerEnd == pdFALSE ) )
+	{
+		pthread_cond_wait( &xSleepCond, &xTickMutex );
+	}
+
+	xSleeping = pdFALSE;
+	xSkipped = xSkippedTicks;
+	pthread_mutex_unlock( &xTickMutex );
+
+	/* Step over all but the last tick, which is processed as a normal tick
+	so the task that caused the wake up is unblocked. */
+	if( xSkipped > 0 )
+	{
+		vTaskStepTick( xSkipped - 1 );
+		__atomic_add_fetch( &ulPendingTicks, 1, __ATOMIC_SEQ_CST );
+	}
+
+	vPortEnableInterrupts();
+}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+struct sigaction xAction;
+sigset_t xSignals;
+Thread_t *pxFirst;
+
+	/* Only task threads take the simulated interrupts. */
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, SIGUSR1 );
+	pthread_sigmask( SIG_BLOCK, &xSignals, NULL );
+
+	memset( &xAction, 0, sizeof( xAction ) );
+	xAction.sa_handler = prvInterruptSignal;
+	xAction.sa_flags = SA_RESTART;
+	sigemptyset( &xAction.sa_mask );
+	sigaction( SIGUSR1, &xAction, NULL );
+
+	pxFirst = portTHREAD( pxCurrentTCB );
+	xRunningThread = pxFirst->xThread;
+
+	if( pthread_create( &xTimerThread, NULL, prvTimerThread, NULL ) != 0 )
+	{
+		return pdFALSE;
+	}
+
+	prvEventSignal( pxFirst );
+
+	/* Wait for vPortEndScheduler(). */
+	pthread_mutex_lock( &xEndMutex );
+	while( xSchedulerEnd == pdFALSE )
+	{
+		pthread_cond_wait( &xEndCond, &xEndMutex );
+	}
+	pthread_mutex_unlock( &xEndMutex );
+
+	pthread_join( xTimerThread, NULL );
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	/* The task threads are left waiting, they end with the process. */
+	vPortDisableInterrupts();
+
+	pthread_mutex_lock( &xTickMutex );
+	pthread_mutex_lock( &xEndMutex );
+	xSchedulerEnd = pdTRUE;
+	pthread_cond_signal( &xEndCond );
+	pthread_cond_signal( &xSleepCond );
+	pthread_mutex_unlock( &xEndMutex );
+	pthread_mutex_unlock( &xTickMutex );
+
+	if( xInISR == pdFALSE )
+	{
+		prvEventWait( portTHREAD( pxCurrentTCB ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetMicroseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( uint64_t ) xNow.tv_sec * 1000000ULL + ( uint64_t ) xNow.tv_nsec / 1000ULL;
+}
+/*-----------------------------------------------------------*/
+
+void vPortConfigureRunTimeCounter( void )
+{
+	ullRunTimeCounterBase = prvGetMicroseconds();
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullPortGetRunTimeCounterValue( void )
+{
+	/* Microseconds since the scheduler was started. */
+	return prvGetMicroseconds() - ullRunTimeCounterBase;
+}
+/*-----------------------------------------------------------*/
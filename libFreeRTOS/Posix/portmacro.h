@@ -0,0 +1,168 @@
+/*
+ * FreeRTOS Kernel V10.2.1
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*-----------------------------------------------------------
+ * Port specific definitions of the POSIX simulation port.
+ *
+ * Each task runs on its own pthread, only one of them at a time.  See
+ * port.c for how interrupts and the tick are simulated.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. */
+
+#define portCHAR		int8_t
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		int32_t
+#define portSHORT		int16_t
+#define portSTACK_TYPE	unsigned long
+#define portBASE_TYPE	long
+
+typedef portSTACK_TYPE			StackType_t;
+typedef portBASE_TYPE			BaseType_t;
+typedef unsigned portBASE_TYPE	UBaseType_t;
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+#endif
+/*-----------------------------------------------------------*/
+
+// Simulated interrupt enable. Interrupts are delivered to the running task
+// only while enabled, pending ones are taken when they are enabled again.
+extern void vPortDisableInterrupts( void );
+extern void vPortEnableInterrupts( void );
+#define portDISABLE_INTERRUPTS()    vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()     vPortEnableInterrupts()
+
+// Nested critical sections. Nesting managed by FreeRTOS.
+#define portCRITICAL_NESTING_IN_TCB	1
+
+extern void vTaskEnterCritical(void);
+extern void vTaskExitCritical(void);
+#define portENTER_CRITICAL()        vTaskEnterCritical()
+#define portEXIT_CRITICAL()         vTaskExitCritical()
+
+// These can be called from interrupt context.
+extern UBaseType_t uxPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( UBaseType_t uxState );
+#define portSET_INTERRUPT_MASK_FROM_ISR()            uxPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(state)     vPortClearInterruptMask( state )
+
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+#define portPOINTER_SIZE_TYPE		uintptr_t
+#define portNOP()
+/*-----------------------------------------------------------*/
+
+/* Port optimised task selection.  uxTopReadyPriority holds one bit per
+priority with ready tasks, and the highest one is found with a count
+leading zeros, as with NSAU on the target. */
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+	#if ( configMAX_PRIORITIES > 32 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.
+	#endif
+
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31UL - ( uint32_t ) __builtin_clz( ( uint32_t ) ( uxReadyPriorities ) ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
+/* Fine resolution time, in microseconds of CLOCK_MONOTONIC since the
+scheduler was started */
+extern void vPortConfigureRunTimeCounter( void );
+extern uint64_t ullPortGetRunTimeCounterValue( void );
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()  vPortConfigureRunTimeCounter()
+#define portGET_RUN_TIME_COUNTER_VALUE()  ullPortGetRunTimeCounterValue()
+
+/* Kernel utilities. */
+extern void vPortYield( void );
+extern void vPortYieldFromISR( void );
+#define portYIELD()       vPortYield()
+#define portYIELD_FROM_ISR( xHigherPriorityTaskWoken )	\
+	if ( ( xHigherPriorityTaskWoken ) != 0 ) {	\
+		vPortYieldFromISR();			\
+	}
+
+/* Tickless idle */
+#if ( configUSE_TICKLESS_IDLE != 0 )
+#ifndef portSUPPRESS_TICKS_AND_SLEEP
+extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )	vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+#endif
+
+/* The thread of a task ends when the kernel deletes its TCB. */
+extern void vPortCancelThread( void *pxTaskToDelete );
+#define portCLEAN_UP_TCB( pxTCB )	vPortCancelThread( pxTCB )
+
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+/*-----------------------------------------------------------*/
+
+/* Simulated interrupt lines.  Host models (such as a DMA model thread) raise
+a line with vPortSimRaiseInterrupt() from any thread, the handler then runs
+on the running task's thread with interrupts disabled, like an ISR, and may
+use the ...FromISR() API functions and portYIELD_FROM_ISR(). */
+#define portSIM_NUM_INTERRUPTS		32
+#define portSIM_INT_IDMA			0	/* iDMA completion, raised by the model of idma_sim.h */
+
+typedef void (*portSimHandler)( void *pvArg );
+
+extern BaseType_t xPortSimSetInterruptHandler( UBaseType_t uxLine, portSimHandler pxHandler, void *pvArg );
+extern void vPortSimRaiseInterrupt( UBaseType_t uxLine );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
@@ -0,0 +1,49 @@
+/*
+ * FreeRTOS Kernel V10.2.1
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Stand-in for the Xtensa port's xtensa_config.h, so the POSIX simulation
+ * port builds with the unmodified include/FreeRTOSConfig.h.  Only the values
+ * FreeRTOSConfig.h uses are defined.
+ */
+
+#ifndef XTENSA_CONFIG_H
+#define XTENSA_CONFIG_H
+
+/* Task stacks only hold the simulation thread's control block, the code of
+the task runs on the pthread's own stack. */
+#define XT_STACK_MIN_SIZE			2048
+
+/* Used for configMAX_SYSCALL_INTERRUPT_PRIORITY, interrupts are either
+enabled or disabled here. */
+#define XCHAL_EXCM_LEVEL			3
+
+/* The host C library is thread safe by itself. */
+#define XT_USE_THREAD_SAFE_CLIB		0
+#define XT_HAVE_THREAD_SAFE_CLIB	0
+
+#endif /* XTENSA_CONFIG_H */
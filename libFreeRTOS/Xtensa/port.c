@@ -74,8 +74,8 @@ extern void _xt_task_start( void );
 // Timer tick interval in cycles.
 static uint32_t xt_tick_cycles;
 
-// Flag to indicate tick handling should be skipped.
-static uint32_t xt_skip_tick;
+// Set while the idle task sleeps with the tick suppressed.
+static volatile uint32_t xt_skip_tick;
 
 // Duplicate of inaccessible xSchedulerRunning.
 uint32_t port_xSchedulerRunning = 0U;
@@ -83,45 +83,79 @@ uint32_t port_xSchedulerRunning = 0U;
 // Interrupt nesting level.
 uint32_t port_interruptNesting  = 0U;
 
+// Upper half and last value of the 64-bit run time counter.
+static uint32_t xt_ccount_high;
+static uint32_t xt_ccount_last;
+
 
 //-----------------------------------------------------------------------------
 // Tick timer interrupt handler.
 //-----------------------------------------------------------------------------
 static void xt_tick_handler( void )
 {
-    uint32_t diff;
+    const uint32_t ulTickCycles = xt_tick_cycles;
+    uint32_t   diff;
+    uint32_t   interruptMask;
+    BaseType_t xSwitchRequired = pdFALSE;
 
-    // Skip if flag set, but clear flag.
+    // While the idle task sleeps with the tick suppressed, only acknowledge
+    // the interrupt. The idle task accounts for the elapsed ticks.
     if (xt_skip_tick > 0) {
-        xt_skip_tick = 0;
+        xt_set_ccompare( XT_TIMER_INDEX, xt_get_ccompare( XT_TIMER_INDEX ) );
         return;
     }
 
+    portbenchmarkIntLatency();
+
+#if configGENERATE_RUN_TIME_STATS || configUSE_HR_TIMERS
+    // Keep the run time counter from missing a CCOUNT wrap.
+    (void) ullPortGetRunTimeCounterValue();
+#endif
+
+    // Interrupts upto configMAX_SYSCALL_INTERRUPT_PRIORITY must be
+    // disabled before calling xTaskIncrementTick as it accesses the
+    // kernel lists. Raise the level once for all ticks to catch up.
+    interruptMask = portSET_INTERRUPT_MASK_FROM_ISR();
+
     do
     {
-        BaseType_t ret;
-        uint32_t   interruptMask;
-        uint32_t   ulOldCCompare = xt_get_ccompare( XT_TIMER_INDEX );
+        uint32_t ulOldCCompare = xt_get_ccompare( XT_TIMER_INDEX );
 
         // Set CCOMPARE for next tick.
-        xt_set_ccompare( XT_TIMER_INDEX, ulOldCCompare + xt_tick_cycles );
-
-        portbenchmarkIntLatency();
+        xt_set_ccompare( XT_TIMER_INDEX, ulOldCCompare + ulTickCycles );
 
-        // Interrupts upto configMAX_SYSCALL_INTERRUPT_PRIORITY must be
-        // disabled before calling xTaskIncrementTick as it accesses the
-        // kernel lists.
-        interruptMask = portSET_INTERRUPT_MASK_FROM_ISR();
-        {
-            ret = xTaskIncrementTick();
+        if ( xTaskIncrementTick() != pdFALSE ) {
+            xSwitchRequired = pdTRUE;
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( interruptMask );
-
-        portYIELD_FROM_ISR( ret );
 
         diff = xt_get_ccount() - ulOldCCompare;
     }
-    while ( diff > xt_tick_cycles );
+    while ( diff > ulTickCycles );
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( interruptMask );
+
+    // The switch happens on interrupt exit, request it once.
+    portYIELD_FROM_ISR( xSwitchRequired );
+}
+
+//-----------------------------------------------------------------------------
+// Run time counter: CCOUNT extended to 64 bits. Must be called at least once
+// per CCOUNT wrap, which the tick handler ensures.
+//-----------------------------------------------------------------------------
+uint64_t ullPortGetRunTimeCounterValue( void )
+{
+    uint32_t interruptMask = portSET_INTERRUPT_MASK_FROM_ISR();
+    uint32_t ccount        = xthal_get_ccount();
+    uint64_t ret;
+
+    if ( ccount < xt_ccount_last ) {
+        xt_ccount_high++;
+    }
+    xt_ccount_last = ccount;
+    ret = ((uint64_t) xt_ccount_high << 32) | ccount;
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( interruptMask );
+    return ret;
 }
 
 //-----------------------------------------------------------------------------
@@ -268,21 +302,15 @@ StackType_t *pxPortInitialiseStack( StackType_t * pxTopOfStack,
 #if ( configUSE_TICKLESS_IDLE != 0 )
 void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
 {
-    TickType_t xMaxSuppressedTicks = 0xFFFFFFFFU / xt_tick_cycles;
+    // Half the CCOUNT range, so the run time counter sees every wrap.
+    TickType_t xMaxSuppressedTicks = 0x7FFFFFFFU / xt_tick_cycles;
     eSleepModeStatus eSleepStatus;
-    uint32_t num_cycles;
     uint32_t ps;
 
-    // Compute number of cycles to sleep for, capped by max limit.
-    // we use one less than the number of ticks because we are already
-    // partway through the current tick. This is adjusted later below.
+    // Sleep at most as long as CCOMPARE can reach.
     if ( xExpectedIdleTime > xMaxSuppressedTicks )
     {
-        num_cycles = xt_tick_cycles * ( xMaxSuppressedTicks - 1U );
-    }
-    else
-    {
-        num_cycles = xt_tick_cycles * ( xExpectedIdleTime - 1U );
+        xExpectedIdleTime = xMaxSuppressedTicks;
     }
 
     // Lock out all interrupts. Otherwise reading and using ccount can
@@ -299,17 +327,11 @@ void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
     {
         uint32_t cnt1;
         uint32_t cnt2;
+        uint32_t next;
         uint32_t ticks;
         uint32_t save_ccompare = xt_get_ccompare( XT_TIMER_INDEX );
 
-        // We don't want the timer handler to be run before execution can
-        // resume after waiti, so set the skip flag.
-        xt_skip_tick = 1;
-
-        // Adjust for the remaining time in the current tick period.
         cnt1 = xthal_get_ccount();
-        num_cycles += save_ccompare - cnt1;
-
         if ( (save_ccompare - cnt1) > xt_tick_cycles )
         {
             // The only way this can happen is if the interrupt is pending.
@@ -317,51 +339,59 @@ void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
             return;
         }
 
-        // Set up for timer interrupt and sleep.
-        xt_set_ccompare( XT_TIMER_INDEX, cnt1 + num_cycles );
+        // save_ccompare is the next tick. Sleep until the tick at which the
+        // kernel's next deadline expires, or until any other interrupt, such
+        // as iDMA done, wakes us up. Ticks are counted from save_ccompare
+        // so they stay in phase.
+        xt_skip_tick = 1;
+        xt_set_ccompare( XT_TIMER_INDEX, save_ccompare + xt_tick_cycles * ( xExpectedIdleTime - 1U ) );
         XT_WAITI( 0 );
 
         // Block interrupts again before messing around with ccount.
         XT_RSIL( XCHAL_NUM_INTLEVELS );
+        xt_skip_tick = 0;
         cnt2 = xthal_get_ccount();
 
-        // Set up the next tick. This works whether we were woken up by the
-        // tick interrupt or some other interrupt. It pulls in the next tick
-        // interrupt if we were woken by something else.
-
-        // Set up the next tick. How we do it depends on what woke us up.
-        // If we still haven't reached the 'old' tick target (save_ccompare)
-        // then obviously we were woken by another interrupt. Set the next
-        // tick time back to what it was, as long as it is not so close to
-        // ccount as to risk ccount going past it while we are setting it.
-        if ( (int32_t)(save_ccompare - cnt2) > 100 )
+        // Count the ticks that were due while asleep, whatever woke us up,
+        // and set up the next one. A tick that is too close to set without
+        // ccount passing it is counted now instead.
+        if ( (int32_t)(cnt2 - save_ccompare) < 0 )
         {
-            xt_set_ccompare( XT_TIMER_INDEX, save_ccompare );
+            ticks = 0U;
         }
         else
         {
-            xt_set_ccompare( XT_TIMER_INDEX, xt_tick_cycles - ((cnt2 - cnt1) % xt_tick_cycles) + cnt2 );
+            ticks = ( ( cnt2 - save_ccompare ) / xt_tick_cycles ) + 1U;
         }
 
-        // Step the tick count forward by the number of ticks that actually
-        // elapsed before wakeup, less 1.
-        ticks = ( cnt2 - cnt1 ) / xt_tick_cycles;
-
-        if ( ticks > 1U )
+        next = save_ccompare + ( ticks * xt_tick_cycles );
+        if ( (next - cnt2) < 100U )
         {
-            vTaskStepTick( ticks - 1U );
+            next += xt_tick_cycles;
+            ticks++;
         }
-        else
-        {
-            // We need to keep track of partial tick periods spent in sleep
-            // else the tick count will fall behind.
-            static uint32_t accum_cycles = 0U;
+        xt_set_ccompare( XT_TIMER_INDEX, next );
 
-            accum_cycles += cnt2 - cnt1;
-            while ( accum_cycles > xt_tick_cycles )
+        if ( ticks > 0U )
+        {
+            // Step over all but the last tick, which is counted like a
+            // normal tick so the task waiting for it is unblocked. The step
+            // must not pass the next unblock time, later ticks are counted
+            // normally too. The scheduler is suspended, so the kernel
+            // processes them when the idle task resumes it.
+            TickType_t xStep = ticks - 1U;
+
+            if ( xStep > ( xExpectedIdleTime - 1U ) )
+            {
+                xStep = xExpectedIdleTime - 1U;
+            }
+            if ( xStep > 0U )
+            {
+                vTaskStepTick( xStep );
+            }
+            for ( ticks -= xStep; ticks > 0U; ticks-- )
             {
-                vTaskStepTick( 1 );
-                accum_cycles -= xt_tick_cycles;
+                (void) xTaskIncrementTick();
             }
         }
     }
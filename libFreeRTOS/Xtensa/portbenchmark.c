@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2015-2019 Cadence Design Systems, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/******************************************************************************
+  Interrupt latency benchmark, see portbenchmark.h.
+******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <xtensa/hal.h>
+
+#include "FreeRTOS.h"
+#include "xtensa_api.h"
+#include "xtensa_timer.h"
+
+#if configBENCHMARK
+
+typedef struct {
+    uint32_t ulCount;
+    uint32_t ulMin;
+    uint32_t ulMax;
+    uint64_t ullSum;
+    uint32_t ulBins[portbenchmarkNUM_BINS];
+} Histogram_t;
+
+typedef struct {
+    Histogram_t xEntry;
+    Histogram_t xResume;
+    uint32_t    ulLastEntry;        // CCOUNT at the latest handler entry
+    uint32_t    ulEntryPending;     // Set by the handler, cleared by the resumed task
+} Source_t;
+
+static Source_t xSources[portbenchmarkNUM_SOURCES];
+
+static const char * const pcSourceNames[portbenchmarkNUM_SOURCES] = {
+    "tick", "idma-done", "idma-err"
+};
+
+
+//-----------------------------------------------------------------------------
+// Add one latency to a histogram.
+//-----------------------------------------------------------------------------
+static void prvRecord( Histogram_t * pxHist, uint32_t ulCycles )
+{
+    uint32_t ulBin = ulCycles / portbenchmarkBIN_CYCLES;
+
+    if ( ulBin >= portbenchmarkNUM_BINS ) {
+        ulBin = portbenchmarkNUM_BINS - 1;
+    }
+
+    if ( pxHist->ulCount == 0 || ulCycles < pxHist->ulMin ) {
+        pxHist->ulMin = ulCycles;
+    }
+    if ( ulCycles > pxHist->ulMax ) {
+        pxHist->ulMax = ulCycles;
+    }
+
+    pxHist->ulCount++;
+    pxHist->ullSum += ulCycles;
+    pxHist->ulBins[ulBin]++;
+}
+
+//-----------------------------------------------------------------------------
+// Latency below which ulPercent percent of the samples are. Resolution is
+// one bin, the result is clamped to the recorded min and max.
+//-----------------------------------------------------------------------------
+static uint32_t prvPercentile( const Histogram_t * pxHist, uint32_t ulPercent )
+{
+    uint32_t ulTarget = (uint32_t) ( ( (uint64_t) pxHist->ulCount * ulPercent + 99 ) / 100 );
+    uint32_t ulSeen   = 0;
+    uint32_t ulBin;
+    uint32_t ulValue  = pxHist->ulMax;
+
+    for ( ulBin = 0; ulBin < portbenchmarkNUM_BINS - 1; ulBin++ ) {
+        ulSeen += pxHist->ulBins[ulBin];
+        if ( ulSeen >= ulTarget ) {
+            ulValue = ( ulBin + 1 ) * portbenchmarkBIN_CYCLES - 1;
+            break;
+        }
+    }
+
+    if ( ulValue > pxHist->ulMax ) {
+        ulValue = pxHist->ulMax;
+    }
+    if ( ulValue < pxHist->ulMin ) {
+        ulValue = pxHist->ulMin;
+    }
+
+    return ulValue;
+}
+
+static void prvStats( const Histogram_t * pxHist, BenchmarkStats_t * pxStats )
+{
+    memset( pxStats, 0, sizeof( *pxStats ) );
+
+    if ( pxHist->ulCount > 0 ) {
+        pxStats->count = pxHist->ulCount;
+        pxStats->min   = pxHist->ulMin;
+        pxStats->avg   = (uint32_t) ( pxHist->ullSum / pxHist->ulCount );
+        pxStats->max   = pxHist->ulMax;
+        pxStats->p50   = prvPercentile( pxHist, 50 );
+        pxStats->p90   = prvPercentile( pxHist, 90 );
+        pxStats->p99   = prvPercentile( pxHist, 99 );
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Tick handler entry. Called before CCOMPARE is moved to the next tick, so
+// it still holds the cycle the interrupt was asserted at.
+//-----------------------------------------------------------------------------
+void vPortBenchmarkTickEntry( void )
+{
+    uint32_t ulNow    = xthal_get_ccount();
+    uint32_t ulAssert = xt_get_ccompare( XT_TIMER_INDEX );
+    Source_t * pxSrc  = &xSources[portbenchmarkSRC_TICK];
+
+    prvRecord( &pxSrc->xEntry, ulNow - ulAssert );
+    pxSrc->ulLastEntry    = ulNow;
+    pxSrc->ulEntryPending = 1;
+}
+
+//-----------------------------------------------------------------------------
+// Handler entry of an interrupt without an assertion time stamp.
+//-----------------------------------------------------------------------------
+void vPortBenchmarkIntEntry( UBaseType_t uxSource )
+{
+    if ( uxSource < portbenchmarkNUM_SOURCES ) {
+        xSources[uxSource].ulLastEntry    = xthal_get_ccount();
+        xSources[uxSource].ulEntryPending = 1;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Called by a task when its wait for the interrupt has returned.
+//-----------------------------------------------------------------------------
+void vPortBenchmarkIntWait( UBaseType_t uxSource )
+{
+    uint32_t ulNow = xthal_get_ccount();
+    UBaseType_t uxSavedInterruptStatus;
+
+    if ( uxSource >= portbenchmarkNUM_SOURCES ) {
+        return;
+    }
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    if ( xSources[uxSource].ulEntryPending != 0 ) {
+        xSources[uxSource].ulEntryPending = 0;
+        prvRecord( &xSources[uxSource].xResume, ulNow - xSources[uxSource].ulLastEntry );
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+
+//-----------------------------------------------------------------------------
+// Clear all statistics.
+//-----------------------------------------------------------------------------
+void vPortBenchmarkReset( void )
+{
+    UBaseType_t uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    memset( xSources, 0, sizeof( xSources ) );
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+
+//-----------------------------------------------------------------------------
+// Machine readable statistics.
+//-----------------------------------------------------------------------------
+BaseType_t xPortBenchmarkGetStats( UBaseType_t uxSource, BaseType_t xResume, BenchmarkStats_t * pxStats )
+{
+    Histogram_t xCopy;
+    UBaseType_t uxSavedInterruptStatus;
+
+    if ( uxSource >= portbenchmarkNUM_SOURCES || pxStats == NULL ) {
+        return pdFALSE;
+    }
+
+    // Copy with interrupts masked so the statistics are consistent.
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    xCopy = xResume ? xSources[uxSource].xResume : xSources[uxSource].xEntry;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    prvStats( &xCopy, pxStats );
+    return pdTRUE;
+}
+
+//-----------------------------------------------------------------------------
+// Print a report of all sources.
+//-----------------------------------------------------------------------------
+void vPortBenchmarkPrint( void )
+{
+    BenchmarkStats_t xStats;
+    UBaseType_t uxSource;
+    BaseType_t  xResume;
+
+    printf("Interrupt latency (cycles)    count      min      avg      max      p50      p90      p99\n");
+
+    for ( uxSource = 0; uxSource < portbenchmarkNUM_SOURCES; uxSource++ ) {
+        for ( xResume = 0; xResume <= 1; xResume++ ) {
+            (void) xPortBenchmarkGetStats( uxSource, xResume, &xStats );
+            if ( xStats.count == 0 ) {
+                continue;
+            }
+            printf("%-10s %-6s to %-6s %8u %8u %8u %8u %8u %8u %8u\n",
+                   pcSourceNames[uxSource],
+                   xResume ? "entry" : "assert",
+                   xResume ? "resume" : "entry",
+                   (unsigned) xStats.count, (unsigned) xStats.min, (unsigned) xStats.avg,
+                   (unsigned) xStats.max, (unsigned) xStats.p50, (unsigned) xStats.p90,
+                   (unsigned) xStats.p99);
+        }
+    }
+}
+
+#endif /* configBENCHMARK */
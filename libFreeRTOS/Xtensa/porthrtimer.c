@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2015-2019 Cadence Design Systems, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/******************************************************************************
+  High resolution timers on a spare CCOMPARE, see porthrtimer.h.
+******************************************************************************/
+
+#include <xtensa/hal.h>
+#include <xtensa/config/core.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "xtensa_api.h"
+#include "xtensa_timer.h"
+
+#if configUSE_HR_TIMERS
+
+// Select the timer: the lowest numbered one that is not the tick's and
+// whose interrupt is low or medium priority.
+#ifndef XT_HRTIMER_INDEX
+  #if XCHAL_TIMER3_INTERRUPT != XTHAL_TIMER_UNCONFIGURED && XT_TIMER_INDEX != 3
+    #if XCHAL_INT_LEVEL(XCHAL_TIMER3_INTERRUPT) <= XCHAL_EXCM_LEVEL
+      #undef  XT_HRTIMER_INDEX
+      #define XT_HRTIMER_INDEX  3
+    #endif
+  #endif
+  #if XCHAL_TIMER2_INTERRUPT != XTHAL_TIMER_UNCONFIGURED && XT_TIMER_INDEX != 2
+    #if XCHAL_INT_LEVEL(XCHAL_TIMER2_INTERRUPT) <= XCHAL_EXCM_LEVEL
+      #undef  XT_HRTIMER_INDEX
+      #define XT_HRTIMER_INDEX  2
+    #endif
+  #endif
+  #if XCHAL_TIMER1_INTERRUPT != XTHAL_TIMER_UNCONFIGURED && XT_TIMER_INDEX != 1
+    #if XCHAL_INT_LEVEL(XCHAL_TIMER1_INTERRUPT) <= XCHAL_EXCM_LEVEL
+      #undef  XT_HRTIMER_INDEX
+      #define XT_HRTIMER_INDEX  1
+    #endif
+  #endif
+  #if XCHAL_TIMER0_INTERRUPT != XTHAL_TIMER_UNCONFIGURED && XT_TIMER_INDEX != 0
+    #if XCHAL_INT_LEVEL(XCHAL_TIMER0_INTERRUPT) <= XCHAL_EXCM_LEVEL
+      #undef  XT_HRTIMER_INDEX
+      #define XT_HRTIMER_INDEX  0
+    #endif
+  #endif
+#endif
+#ifndef XT_HRTIMER_INDEX
+  #error "There is no spare timer for configUSE_HR_TIMERS in this Xtensa configuration."
+#endif
+
+#define XT_HRTIMER_INTNUM       XCHAL_TIMER_INTERRUPT(XT_HRTIMER_INDEX)
+
+#if XT_HRTIMER_INDEX == XT_TIMER_INDEX
+  #error "XT_HRTIMER_INDEX selects the tick timer."
+#elif XT_HRTIMER_INTNUM == XTHAL_TIMER_UNCONFIGURED
+  #error "The timer selected by XT_HRTIMER_INDEX does not exist in this core."
+#elif XCHAL_INT_LEVEL(XT_HRTIMER_INTNUM) > XCHAL_EXCM_LEVEL
+  #error "The high resolution timer interrupt cannot be high priority (use medium or low)."
+#endif
+
+// Active timers in deadline order.
+static HRTimer_t * xt_hrtimer_list;
+
+// Set once the interrupt handler is installed.
+static uint32_t xt_hrtimer_ready;
+
+
+//-----------------------------------------------------------------------------
+// Insert into / remove from the active list. Interrupts must be masked.
+//-----------------------------------------------------------------------------
+static void xt_hrtimer_insert( HRTimer_t * pxTimer )
+{
+    HRTimer_t ** ppxPos = &xt_hrtimer_list;
+
+    // After the timers with the same deadline, so they expire in start order.
+    while ( *ppxPos != NULL && (*ppxPos)->ullDeadline <= pxTimer->ullDeadline ) {
+        ppxPos = &(*ppxPos)->pxNext;
+    }
+
+    pxTimer->pxNext  = *ppxPos;
+    *ppxPos          = pxTimer;
+    pxTimer->ulActive = 1;
+}
+
+static void xt_hrtimer_remove( HRTimer_t * pxTimer )
+{
+    HRTimer_t ** ppxPos = &xt_hrtimer_list;
+
+    while ( *ppxPos != NULL && *ppxPos != pxTimer ) {
+        ppxPos = &(*ppxPos)->pxNext;
+    }
+
+    if ( *ppxPos != NULL ) {
+        *ppxPos = pxTimer->pxNext;
+    }
+    pxTimer->pxNext   = NULL;
+    pxTimer->ulActive = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Program CCOMPARE for the first timer, no closer than portHRTIMER_MIN_CYCLES
+// from now so the interrupt is not missed. Deadlines more than half the
+// CCOUNT range away take an intermediate interrupt. With no timers the
+// interrupt is disabled. Interrupts must be masked.
+//-----------------------------------------------------------------------------
+static void xt_hrtimer_program( void )
+{
+    uint64_t ullNow;
+    uint64_t ullDelta;
+    uint32_t ulTarget;
+
+    if ( xt_hrtimer_list == NULL ) {
+        xt_interrupt_disable( XT_HRTIMER_INTNUM );
+        return;
+    }
+
+    do {
+        ullNow = ullPortGetRunTimeCounterValue();
+
+        ullDelta = ( xt_hrtimer_list->ullDeadline > ullNow ) ? ( xt_hrtimer_list->ullDeadline - ullNow ) : 0;
+        if ( ullDelta < portHRTIMER_MIN_CYCLES ) {
+            ullDelta = portHRTIMER_MIN_CYCLES;
+        }
+        if ( ullDelta > 0x7FFFFFFFU ) {
+            ullDelta = 0x7FFFFFFFU;
+        }
+
+        ulTarget = (uint32_t) ullNow + (uint32_t) ullDelta;
+        xthal_set_ccompare( XT_HRTIMER_INDEX, ulTarget );
+
+        // Only a higher priority interrupt between reading CCOUNT and
+        // writing CCOMPARE can make CCOUNT pass the target, try again then.
+    } while ( (int32_t) ( xthal_get_ccount() - ulTarget ) >= 0 );
+
+    xt_interrupt_enable( XT_HRTIMER_INTNUM );
+}
+
+//-----------------------------------------------------------------------------
+// Timer interrupt handler. Calls the callbacks of the timers that are due,
+// waiting for those due within portHRTIMER_MIN_CYCLES, then programs the
+// next interrupt.
+//-----------------------------------------------------------------------------
+static void xt_hrtimer_handler( void * arg )
+{
+    HRTimer_t * pxTimer;
+    uint64_t    ullNow;
+    uint32_t    interruptMask;
+
+    (void) arg;
+
+    // Writing CCOMPARE clears the interrupt.
+    xthal_set_ccompare( XT_HRTIMER_INDEX, xthal_get_ccompare( XT_HRTIMER_INDEX ) );
+
+    for ( ;; ) {
+        interruptMask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+        ullNow  = ullPortGetRunTimeCounterValue();
+        pxTimer = xt_hrtimer_list;
+
+        if ( pxTimer == NULL || pxTimer->ullDeadline >= ullNow + portHRTIMER_MIN_CYCLES ) {
+            xt_hrtimer_program();
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( interruptMask );
+            break;
+        }
+
+        // Close enough to wait for the exact cycle.
+        while ( pxTimer->ullDeadline > ullNow ) {
+            ullNow = ullPortGetRunTimeCounterValue();
+        }
+
+        xt_hrtimer_list = pxTimer->pxNext;
+        pxTimer->pxNext = NULL;
+
+        if ( pxTimer->ulPeriod != 0 ) {
+            pxTimer->ullDeadline += pxTimer->ulPeriod;
+            if ( pxTimer->ullDeadline <= ullNow ) {
+                pxTimer->ullDeadline += ( ( ullNow - pxTimer->ullDeadline ) / pxTimer->ulPeriod + 1 ) * pxTimer->ulPeriod;
+            }
+            xt_hrtimer_insert( pxTimer );
+        }
+        else {
+            pxTimer->ulActive = 0;
+        }
+
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( interruptMask );
+
+        pxTimer->pxCallback( pxTimer, pxTimer->pvArg );
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Initialise a timer before its first start.
+//-----------------------------------------------------------------------------
+void vPortHRTimerInit( HRTimer_t * pxTimer, HRTimerCallback_t pxCallback, void * pvArg )
+{
+    configASSERT( pxTimer != NULL && pxCallback != NULL );
+
+    pxTimer->pxNext      = NULL;
+    pxTimer->ullDeadline = 0;
+    pxTimer->ulPeriod    = 0;
+    pxTimer->ulActive    = 0;
+    pxTimer->pxCallback  = pxCallback;
+    pxTimer->pvArg       = pvArg;
+}
+
+//-----------------------------------------------------------------------------
+// Start or restart a timer.
+//-----------------------------------------------------------------------------
+BaseType_t xPortHRTimerStart( HRTimer_t * pxTimer, uint64_t ullDeadline, uint32_t ulPeriodCycles )
+{
+    uint32_t interruptMask;
+
+    configASSERT( pxTimer != NULL );
+
+    interruptMask = portSET_INTERRUPT_MASK_FROM_ISR();
+
+    if ( xt_hrtimer_ready == 0 ) {
+        xt_set_interrupt_handler( XT_HRTIMER_INTNUM, xt_hrtimer_handler, 0 );
+        xt_hrtimer_ready = 1;
+    }
+
+    if ( pxTimer->ulActive != 0 ) {
+        xt_hrtimer_remove( pxTimer );
+    }
+
+    pxTimer->ullDeadline = ullDeadline;
+    pxTimer->ulPeriod    = ulPeriodCycles;
+    xt_hrtimer_insert( pxTimer );
+
+    // Only a new first timer needs CCOMPARE to move. A stopped first timer
+    // just takes an interrupt that finds nothing to do.
+    if ( xt_hrtimer_list == pxTimer ) {
+        xt_hrtimer_program();
+    }
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( interruptMask );
+    return pdPASS;
+}
+
+//-----------------------------------------------------------------------------
+// Stop a timer.
+//-----------------------------------------------------------------------------
+BaseType_t xPortHRTimerStop( HRTimer_t * pxTimer )
+{
+    uint32_t   interruptMask;
+    BaseType_t xWasActive;
+
+    configASSERT( pxTimer != NULL );
+
+    interruptMask = portSET_INTERRUPT_MASK_FROM_ISR();
+    xWasActive = ( pxTimer->ulActive != 0 ) ? pdTRUE : pdFALSE;
+    if ( xWasActive ) {
+        xt_hrtimer_remove( pxTimer );
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( interruptMask );
+
+    return xWasActive;
+}
+
+BaseType_t xPortHRTimerIsActive( HRTimer_t * pxTimer )
+{
+    return ( pxTimer->ulActive != 0 ) ? pdTRUE : pdFALSE;
+}
+
+//-----------------------------------------------------------------------------
+// Cycle accurate vTaskDelayUntil().
+//-----------------------------------------------------------------------------
+static void xt_hrtimer_delay_callback( HRTimer_t * pxTimer, void * pvArg )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    (void) pxTimer;
+
+    vTaskNotifyGiveFromISR( (TaskHandle_t) pvArg, &xHigherPriorityTaskWoken );
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+
+void vTaskDelayUntilCycles( uint64_t * pullPreviousWakeCycles, uint32_t ulIncrementCycles )
+{
+    HRTimer_t xTimer;
+    uint64_t  ullWake;
+    uint32_t  ulTaken = 0;
+
+    configASSERT( pullPreviousWakeCycles != NULL );
+
+    ullWake = *pullPreviousWakeCycles + ulIncrementCycles;
+    *pullPreviousWakeCycles = ullWake;
+
+    if ( ullWake <= ullPortGetRunTimeCounterValue() ) {
+        return;
+    }
+
+    vPortHRTimerInit( &xTimer, xt_hrtimer_delay_callback, xTaskGetCurrentTaskHandle() );
+    (void) xPortHRTimerStart( &xTimer, ullWake, 0 );
+
+    // Notifications from elsewhere end the wait early, wait until the timer
+    // has expired. The callback has given its notification by then.
+    while ( xPortHRTimerIsActive( &xTimer ) ) {
+        ulTaken += ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+    ulTaken += ulTaskNotifyTake( pdTRUE, 0 );
+
+    // Give back all but the timer's one.
+    while ( ulTaken > 1 ) {
+        xTaskNotifyGive( xTaskGetCurrentTaskHandle() );
+        ulTaken--;
+    }
+}
+
+#endif /* configUSE_HR_TIMERS */
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2015-2019 Cadence Design Systems, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * High resolution timers. With configUSE_HR_TIMERS set to 1 in
+ * FreeRTOSConfig.h, porthrtimer.c calls one-shot and periodic callbacks at
+ * exact CCOUNT cycles, independently of the tick. They run on the interrupt
+ * of a CCOMPARE register the tick does not use, the lowest numbered one
+ * that is not above XCHAL_EXCM_LEVEL, or XT_HRTIMER_INDEX if defined with -D.
+ *
+ * Times are in cycles of CCOUNT extended to 64 bits, the same counter as
+ * ullPortGetRunTimeCounterValue() returns, so they do not wrap.
+ *
+ * Callbacks run in interrupt context, with interrupts up to the level of the
+ * timer interrupt masked, and may use the ...FromISR() API functions and
+ * portYIELD_FROM_ISR(). A timer can be started and stopped from tasks, from
+ * interrupts and from its own callback.
+ */
+
+#ifndef PORTHRTIMER_H
+#define PORTHRTIMER_H
+
+#if configUSE_HR_TIMERS
+
+// A deadline closer than this many cycles when the timer is programmed is
+// waited for in the interrupt handler instead, so it is not missed.
+#ifndef portHRTIMER_MIN_CYCLES
+#define portHRTIMER_MIN_CYCLES          200
+#endif
+
+struct HRTimer;
+typedef void (*HRTimerCallback_t)( struct HRTimer * pxTimer, void * pvArg );
+
+// A timer. Allocated by the caller, the members are private to porthrtimer.c.
+typedef struct HRTimer {
+	struct HRTimer *    pxNext;
+	uint64_t            ullDeadline;
+	uint32_t            ulPeriod;
+	uint32_t            ulActive;
+	HRTimerCallback_t   pxCallback;
+	void *              pvArg;
+} HRTimer_t;
+
+// Current time in cycles.
+#define portHRTIMER_NOW()               ullPortGetRunTimeCounterValue()
+
+void vPortHRTimerInit( HRTimer_t * pxTimer, HRTimerCallback_t pxCallback, void * pvArg );
+
+// (Re)starts the timer to expire at cycle ullDeadline, then every
+// ulPeriodCycles if not 0. A deadline that has passed expires at once. A
+// periodic timer that misses periods skips them, keeping its phase.
+BaseType_t xPortHRTimerStart( HRTimer_t * pxTimer, uint64_t ullDeadline, uint32_t ulPeriodCycles );
+
+// Stops the timer. Returns pdFALSE if it was not active.
+BaseType_t xPortHRTimerStop( HRTimer_t * pxTimer );
+
+BaseType_t xPortHRTimerIsActive( HRTimer_t * pxTimer );
+
+// Blocks the calling task until cycle *pullPreviousWakeCycles +
+// ulIncrementCycles and updates *pullPreviousWakeCycles to it, like
+// vTaskDelayUntil() does with ticks. Does not block if that cycle has
+// passed. Waits on the task notification, used as a counting semaphore, and
+// gives back notifications received from elsewhere while waiting.
+void vTaskDelayUntilCycles( uint64_t * pullPreviousWakeCycles, uint32_t ulIncrementCycles );
+
+#endif /* configUSE_HR_TIMERS */
+
+#endif /* PORTHRTIMER_H */
@@ -64,6 +64,9 @@ extern "C" {
 #include <xtensa/tie/xt_core.h>
 #include <xtensa/hal.h>
 #include <xtensa/config/system.h>	/* required for XSHAL_CLIB */
+#if XCHAL_HAVE_NSA
+#include <xtensa/tie/xt_misc.h>		/* XT_NSAU for portGET_HIGHEST_PRIORITY */
+#endif
 
 /*-----------------------------------------------------------
  * Port specific definitions.
@@ -168,8 +171,35 @@ portEXIT_CRITICAL_NESTED(uint32_t state)
 #define portNOP()					XT_NOP()
 /*-----------------------------------------------------------*/
 
-/* Fine resolution time */
-#define portGET_RUN_TIME_COUNTER_VALUE()  xthal_get_ccount()
+/* Port optimised task selection.  uxTopReadyPriority holds one bit per
+priority with ready tasks, and NSAU finds the highest one in a single
+instruction, instead of tasks.c searching the ready lists downward. */
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+	#if ( configMAX_PRIORITIES > 32 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.
+	#endif
+
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	#if XCHAL_HAVE_NSA
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31UL - ( uint32_t ) XT_NSAU( ( uxReadyPriorities ) ) )
+	#else
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31UL - ( uint32_t ) __builtin_clz( ( uxReadyPriorities ) ) )
+	#endif
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
+/* Fine resolution time, CCOUNT extended to 64 bits. CCOUNT always runs, and
+the tick handler reads the counter often enough to catch every wrap. */
+extern uint64_t ullPortGetRunTimeCounterValue( void );
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()  ullPortGetRunTimeCounterValue()
+
+/* High resolution timers on a spare CCOMPARE, see porthrtimer.h. */
+#include "porthrtimer.h"
 
 /* Kernel utilities. */
 void vPortYield( void );
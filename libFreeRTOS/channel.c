@@ -0,0 +1,402 @@
+/*
+ * FreeRTOS Kernel V10.2.1
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "channel.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configUSE_CHANNELS == 1 )
+
+/* The producer and the consumer run on the same core, so they see each other's
+accesses in program order and only the compiler could reorder them.  The item
+must be in the ring before the head says so, and an index must be updated
+before the other side's waiting list is checked, or a wake up can be lost. */
+#define chanBARRIER()		__asm__ __volatile__( "" ::: "memory" )
+
+/*
+ * Copies one item.  Items of a word or less are copied with a constant size,
+ * which the compiler turns into single loads and stores.
+ */
+static inline void prvCopyItem( void *pvDest, const void *pvSrc, UBaseType_t uxItemSize )
+{
+	switch( uxItemSize )
+	{
+		case sizeof( uint32_t ):	( void ) memcpy( pvDest, pvSrc, sizeof( uint32_t ) ); break;
+		case sizeof( uint16_t ):	( void ) memcpy( pvDest, pvSrc, sizeof( uint16_t ) ); break;
+		case sizeof( uint8_t ):		( void ) memcpy( pvDest, pvSrc, sizeof( uint8_t ) ); break;
+		default:					( void ) memcpy( pvDest, pvSrc, ( size_t ) uxItemSize ); break;
+	}
+}
+
+/*
+ * Blocks the calling task on pxWaitingList until the other side of the channel
+ * removes it from the list or *pxTicksToWait expires.  The channel is checked
+ * again with interrupts masked and the other side checks the list after
+ * updating its index, so the other side cannot miss the task.
+ */
+static void prvWait( Channel_t *pxChannel, List_t *pxWaitingList, BaseType_t xSending, TimeOut_t *pxTimeOut, TickType_t *pxTicksToWait )
+{
+BaseType_t xMustWait;
+
+	taskENTER_CRITICAL();
+	{
+		if( xSending != pdFALSE )
+		{
+			xMustWait = ( ( pxChannel->uxHead - pxChannel->uxTail ) > pxChannel->uxMask );
+		}
+		else
+		{
+			xMustWait = ( pxChannel->uxHead == pxChannel->uxTail );
+		}
+
+		if( xMustWait != pdFALSE )
+		{
+			/* Should only be one task on each side. */
+			configASSERT( listLIST_IS_EMPTY( pxWaitingList ) != pdFALSE );
+
+			/* As in ulTaskNotifyTake(), the yield takes effect once the
+			critical section exits. */
+			vTaskPlaceOnEventList( pxWaitingList, *pxTicksToWait );
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	/* Sets *pxTicksToWait to 0 once the time out has expired. */
+	( void ) xTaskCheckForTimeOut( pxTimeOut, pxTicksToWait );
+}
+
+/*
+ * Unblocks the task on pxWaitingList, if there is one, after the caller
+ * updated its index.  The list is only locked when a task is waiting, so the
+ * common case stays free of critical sections.
+ */
+static inline void prvWake( List_t *pxWaitingList, BaseType_t *pxHigherPriorityTaskWoken, BaseType_t xFromISR )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	chanBARRIER();
+
+	if( listLIST_IS_EMPTY( pxWaitingList ) == pdFALSE )
+	{
+		if( xFromISR != pdFALSE )
+		{
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				if( listLIST_IS_EMPTY( pxWaitingList ) == pdFALSE )
+				{
+					if( ( xTaskRemoveFromEventList( pxWaitingList ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			taskENTER_CRITICAL();
+			{
+				/* The task may have timed out since the list was checked. */
+				if( listLIST_IS_EMPTY( pxWaitingList ) == pdFALSE )
+				{
+					if( xTaskRemoveFromEventList( pxWaitingList ) != pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+
+/*
+ * Sends an item if there is space, returns pdFALSE if the channel is full.
+ */
+static inline BaseType_t prvPush( Channel_t *pxChannel, const void *pvItem )
+{
+UBaseType_t uxHead = pxChannel->uxHead;
+BaseType_t xReturn;
+
+	if( ( uxHead - pxChannel->uxTail ) <= pxChannel->uxMask )
+	{
+		prvCopyItem( &( pxChannel->pucStorage[ ( uxHead & pxChannel->uxMask ) * pxChannel->uxItemSize ] ), pvItem, pxChannel->uxItemSize );
+		chanBARRIER();
+		pxChannel->uxHead = uxHead + 1U;
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+
+/*
+ * Receives an item if there is one, returns pdFALSE if the channel is empty.
+ */
+static inline BaseType_t prvPop( Channel_t *pxChannel, void *pvItem )
+{
+UBaseType_t uxTail = pxChannel->uxTail;
+BaseType_t xReturn;
+
+	if( pxChannel->uxHead != uxTail )
+	{
+		chanBARRIER();
+		prvCopyItem( pvItem, &( pxChannel->pucStorage[ ( uxTail & pxChannel->uxMask ) * pxChannel->uxItemSize ] ), pxChannel->uxItemSize );
+		chanBARRIER();
+		pxChannel->uxTail = uxTail + 1U;
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vChannelInit( Channel_t *pxChannel, void *pvStorage, UBaseType_t uxLength, UBaseType_t uxItemSize )
+{
+	configASSERT( pxChannel );
+	configASSERT( pvStorage );
+	configASSERT( uxItemSize > 0U );
+
+	/* A power of two, so the free running indices wrap on a slot boundary. */
+	configASSERT( ( uxLength > 0U ) && ( ( uxLength & ( uxLength - 1U ) ) == 0U ) );
+
+	pxChannel->uxHead = 0;
+	pxChannel->uxTail = 0;
+	pxChannel->uxMask = uxLength - 1U;
+	pxChannel->uxItemSize = uxItemSize;
+	pxChannel->pucStorage = ( uint8_t * ) pvStorage;
+	vListInitialise( &( pxChannel->xTasksWaitingToReceive ) );
+	vListInitialise( &( pxChannel->xTasksWaitingToSend ) );
+}
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	Channel_t *pxChannelCreate( UBaseType_t uxLength, UBaseType_t uxItemSize )
+	{
+	Channel_t *pxChannel;
+	size_t xHeaderSize = ( sizeof( Channel_t ) + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+		/* The storage follows the structure, aligned as pvPortMalloc() aligns. */
+		pxChannel = ( Channel_t * ) pvPortMalloc( xHeaderSize + ( ( size_t ) uxLength * uxItemSize ) );
+
+		if( pxChannel != NULL )
+		{
+			vChannelInit( pxChannel, ( ( uint8_t * ) pxChannel ) + xHeaderSize, uxLength, uxItemSize );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxChannel;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vChannelDelete( Channel_t *pxChannel )
+	{
+		configASSERT( pxChannel );
+		configASSERT( listLIST_IS_EMPTY( &( pxChannel->xTasksWaitingToReceive ) ) != pdFALSE );
+		configASSERT( listLIST_IS_EMPTY( &( pxChannel->xTasksWaitingToSend ) ) != pdFALSE );
+
+		vPortFree( pxChannel );
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+BaseType_t xChannelSend( Channel_t *pxChannel, const void *pvItem, TickType_t xTicksToWait )
+{
+TimeOut_t xTimeOut;
+BaseType_t xReturn;
+
+	configASSERT( pxChannel );
+	configASSERT( pvItem );
+
+	xReturn = prvPush( pxChannel, pvItem );
+
+	if( ( xReturn == pdFALSE ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+	{
+		configASSERT( xTaskGetSchedulerState() != taskSCHEDULER_SUSPENDED );
+		vTaskSetTimeOutState( &xTimeOut );
+
+		do
+		{
+			prvWait( pxChannel, &( pxChannel->xTasksWaitingToSend ), pdTRUE, &xTimeOut, &xTicksToWait );
+			xReturn = prvPush( pxChannel, pvItem );
+		} while( ( xReturn == pdFALSE ) && ( xTicksToWait != ( TickType_t ) 0 ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xReturn != pdFALSE )
+	{
+		prvWake( &( pxChannel->xTasksWaitingToReceive ), NULL, pdFALSE );
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = errQUEUE_FULL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xChannelSendFromISR( Channel_t *pxChannel, const void *pvItem, BaseType_t *pxHigherPriorityTaskWoken )
+{
+BaseType_t xReturn;
+
+	configASSERT( pxChannel );
+	configASSERT( pvItem );
+
+	if( prvPush( pxChannel, pvItem ) != pdFALSE )
+	{
+		prvWake( &( pxChannel->xTasksWaitingToReceive ), pxHigherPriorityTaskWoken, pdTRUE );
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = errQUEUE_FULL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xChannelReceive( Channel_t *pxChannel, void *pvItem, TickType_t xTicksToWait )
+{
+TimeOut_t xTimeOut;
+BaseType_t xReturn;
+
+	configASSERT( pxChannel );
+	configASSERT( pvItem );
+
+	xReturn = prvPop( pxChannel, pvItem );
+
+	if( ( xReturn == pdFALSE ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+	{
+		configASSERT( xTaskGetSchedulerState() != taskSCHEDULER_SUSPENDED );
+		vTaskSetTimeOutState( &xTimeOut );
+
+		do
+		{
+			prvWait( pxChannel, &( pxChannel->xTasksWaitingToReceive ), pdFALSE, &xTimeOut, &xTicksToWait );
+			xReturn = prvPop( pxChannel, pvItem );
+		} while( ( xReturn == pdFALSE ) && ( xTicksToWait != ( TickType_t ) 0 ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xReturn != pdFALSE )
+	{
+		prvWake( &( pxChannel->xTasksWaitingToSend ), NULL, pdFALSE );
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xChannelReceiveFromISR( Channel_t *pxChannel, void *pvItem, BaseType_t *pxHigherPriorityTaskWoken )
+{
+BaseType_t xReturn;
+
+	configASSERT( pxChannel );
+	configASSERT( pvItem );
+
+	if( prvPop( pxChannel, pvItem ) != pdFALSE )
+	{
+		prvWake( &( pxChannel->xTasksWaitingToSend ), pxHigherPriorityTaskWoken, pdTRUE );
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxChannelMessagesWaiting( const Channel_t *pxChannel )
+{
+	configASSERT( pxChannel );
+
+	return pxChannel->uxHead - pxChannel->uxTail;
+}
+
+#endif /* configUSE_CHANNELS */
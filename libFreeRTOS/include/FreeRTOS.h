@@ -712,6 +712,13 @@ extern "C" {
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
 
+#ifndef configRUN_TIME_COUNTER_TYPE
+	/* Defaults to uint32_t for backward compatibility, but can be overridden in
+	FreeRTOSConfig.h if uint32_t is too restrictive, for example when a fast
+	run time stats clock would overflow it. */
+	#define configRUN_TIME_COUNTER_TYPE uint32_t
+#endif
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 	#ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
@@ -826,6 +833,22 @@ extern "C" {
 	#define configAPPLICATION_ALLOCATED_HEAP 0
 #endif
 
+#ifndef configUSE_TLSF_HEAP
+	#define configUSE_TLSF_HEAP 0
+#endif
+
+#ifndef configUSE_OBJECT_POOLS
+	#define configUSE_OBJECT_POOLS 0
+#endif
+
+#ifndef configUSE_TIMER_WHEEL
+	#define configUSE_TIMER_WHEEL 0
+#endif
+
+#ifndef configUSE_CHANNELS
+	#define configUSE_CHANNELS 0
+#endif
+
 #ifndef configUSE_TASK_NOTIFICATIONS
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
@@ -1133,7 +1156,8 @@ typedef struct xSTATIC_TCB
 		void			*pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 	#endif
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulDummy16;
+		configRUN_TIME_COUNTER_TYPE	ulDummy16[ 5 ];
+		uint8_t			ucDummy16[ 2 ];
 	#endif
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		struct	_reent	xDummy17;
@@ -1241,6 +1265,24 @@ typedef struct xSTATIC_EVENT_GROUP
  * the hope users will recognise that it would be unwise to make direct use of
  * the structure members.
  */
+#if( configUSE_TIMER_WHEEL == 1 )
+
+typedef struct xSTATIC_TIMER
+{
+	void				*pvDummy1[ 3 ];
+	TickType_t			xDummy2[ 2 ];
+	void 				*pvDummy5;
+	TaskFunction_t		pvDummy6;
+	#if( configUSE_TRACE_FACILITY == 1 )
+		UBaseType_t		uxDummy7;
+	#endif
+	uint16_t			usDummy8;
+	uint8_t 			ucDummy9;
+
+} StaticTimer_t;
+
+#else
+
 typedef struct xSTATIC_TIMER
 {
 	void				*pvDummy1;
@@ -1255,6 +1297,8 @@ typedef struct xSTATIC_TIMER
 
 } StaticTimer_t;
 
+#endif /* configUSE_TIMER_WHEEL */
+
 /*
 * In line with software engineering best practice, especially when supplying a
 * library that is likely to change in future versions, FreeRTOS implements a
@@ -1271,7 +1315,7 @@ typedef struct xSTATIC_TIMER
 */
 typedef struct xSTATIC_STREAM_BUFFER
 {
-	size_t uxDummy1[ 4 ];
+	size_t uxDummy1[ 6 ];
 	void * pvDummy2[ 3 ];
 	uint8_t ucDummy3;
 	#if ( configUSE_TRACE_FACILITY == 1 )
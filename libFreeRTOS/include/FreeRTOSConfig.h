@@ -123,6 +123,10 @@
 #define configMAX_PRIORITIES			( 25 )
 #endif
 
+/* Select the highest ready priority with the port's NSAU bitmap macros
+   instead of searching the ready lists. Limits configMAX_PRIORITIES to 32. */
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION	1
+
 /* Minimal stack size. This may need to be increased for your application */
 /* NOTE: The FreeRTOS demos may not work reliably with stack size < 4KB.  */
 /* The Xtensa-specific examples should be fine with XT_STACK_MIN_SIZE.    */
@@ -152,11 +156,67 @@
 #define configTOTAL_HEAP_SIZE			( ( size_t ) (256 * 1024) )
 #endif
 
+/* The optional features below default to off. Enable one by defining it
+   to 1 on the compiler command line, for the kernel library and for the
+   application alike, e.g. -DconfigUSE_TLSF_HEAP=1. */
+
+/* Use the TLSF heap (MemMang/heap_tlsf.c) instead of heap_4.c. It splits
+   the heap into one region per memory of the LSP memory map. Small objects
+   go to the local data RAMs first, larger ones to system RAM. */
+#ifndef configUSE_TLSF_HEAP
+#define configUSE_TLSF_HEAP				0
+#endif
+#ifdef SMALL_TEST
+#define configHEAP_DRAM0_SIZE			0
+#define configHEAP_DRAM1_SIZE			( ( size_t ) (8 * 1024) )
+#else
+#define configHEAP_DRAM0_SIZE			0
+#define configHEAP_DRAM1_SIZE			( ( size_t ) (64 * 1024) )
+#endif
+#define configHEAP_SRAM_SIZE			( configTOTAL_HEAP_SIZE - configHEAP_DRAM0_SIZE - configHEAP_DRAM1_SIZE )
+#define configHEAP_LOCAL_MAX_SIZE		1024
+
+/* Fixed size pools of kernel objects (objpool.c), for objects created and
+   deleted while running, see objpool.h. They need static allocation. */
+#ifndef configUSE_OBJECT_POOLS
+#define configUSE_OBJECT_POOLS			0
+#endif
+#define configSUPPORT_STATIC_ALLOCATION	configUSE_OBJECT_POOLS
+#define configPOOL_SECTION				".dram1.data"
+#define configPOOL_STACK_SECTION		".sram.bss"
+#ifdef SMALL_TEST
+/* The pooled demo tasks use TASK_STK_SIZE of example.c, the large class */
+#define configPOOL_QUEUES				2
+#define configPOOL_SEMAPHORES			2
+#define configPOOL_SMALL_TASKS			0
+#define configPOOL_LARGE_TASKS			2
+#define configPOOL_MESSAGE_BUFFERS		0
+#else
+#define configPOOL_QUEUES				8
+#define configPOOL_SEMAPHORES			8
+#define configPOOL_SMALL_TASKS			4
+#define configPOOL_LARGE_TASKS			4
+#define configPOOL_MESSAGE_BUFFERS		4
+#endif
+#define configPOOL_QUEUE_STORAGE_SIZE	64
+#define configPOOL_SMALL_STACK_DEPTH	configMINIMAL_STACK_SIZE
+#define configPOOL_LARGE_STACK_DEPTH	( XT_STACK_MIN_SIZE + 0x400 )
+#define configPOOL_MESSAGE_BUFFER_SIZE	256
+
 #define configMAX_TASK_NAME_LEN			( 8 )
-#define configUSE_TRACE_FACILITY		0		/* Used by vTaskList in main.c */
-#define configUSE_STATS_FORMATTING_FUNCTIONS	0	/* Used by vTaskList in main.c */
+#ifndef configGENERATE_RUN_TIME_STATS
+#define configGENERATE_RUN_TIME_STATS	0		/* CCOUNT based run time and wait time stats */
+#endif
+#define configRUN_TIME_COUNTER_TYPE		uint64_t	/* CCOUNT extended to 64 bits by the port */
+#define configUSE_TRACE_FACILITY		configGENERATE_RUN_TIME_STATS	/* Used by vTaskList in main.c and by uxTaskGetSystemState() */
+#define configUSE_STATS_FORMATTING_FUNCTIONS	configGENERATE_RUN_TIME_STATS	/* Used by vTaskList in main.c and by vTaskGetRunTimeStats() */
 #define configUSE_TRACE_FACILITY_2      0		/* Provided by Xtensa port patch */
-#define configBENCHMARK					0		/* Provided by Xtensa port patch */
+#ifndef configBENCHMARK
+#define configBENCHMARK					1		/* Interrupt latency benchmark, see portbenchmark.h */
+#endif
+#ifndef configUSE_HR_TIMERS
+#define configUSE_HR_TIMERS				0		/* Cycle accurate timers on a spare CCOMPARE, see porthrtimer.h */
+#endif
 #define configUSE_16_BIT_TICKS			0
 #define configIDLE_SHOULD_YIELD			0
 #define configQUEUE_REGISTRY_SIZE		0
@@ -222,6 +282,20 @@
 #define configTIMER_QUEUE_LENGTH            10
 #define configTIMER_TASK_STACK_DEPTH        configMINIMAL_STACK_SIZE
 
+/* Keep active timers in a hierarchical timing wheel (timer_wheel.c) instead of
+   the sorted lists of timers.c. Start, reset and stop are constant time and
+   are applied by the caller, also from interrupts, without going through the
+   timer queue. */
+#ifndef configUSE_TIMER_WHEEL
+#define configUSE_TIMER_WHEEL               0
+#endif
+
+/* Single producer, single consumer channels (channel.c), a cheaper alternative
+   to queues for high rate item streams, see channel.h. */
+#ifndef configUSE_CHANNELS
+#define configUSE_CHANNELS                  0
+#endif
+
 #ifdef SMALL_TEST
 #define INCLUDE_xTimerPendFunctionCall		0
 #define INCLUDE_eTaskGetState				0
@@ -0,0 +1,135 @@
+/*
+ * FreeRTOS Kernel V10.2.1
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Single producer, single consumer channels.
+ *
+ * A channel is a ring of equally sized items between one producer and one
+ * consumer, each of which is either a task or an interrupt.  The producer only
+ * writes the head index and the consumer only writes the tail index, so
+ * sending to a channel that is not full and receiving from one that is not
+ * empty take no critical section and touch no task state - an item is copied
+ * and an index is updated.  A task that blocks on a full or empty channel is
+ * placed on the channel's own event list, which the other side only locks when
+ * it sees a task on it.  This makes channels much cheaper than queues for high
+ * rate streams of small items, such as counts, events or buffer pointers.
+ *
+ * ***NOTE***:  As with stream buffers, it is not safe to have more than one
+ * producer or more than one consumer.  Channels rely on the producer and the
+ * consumer running on the same core, which is always the case on this port.
+ * Channels do not use task notifications, so a task blocking on a channel can
+ * use its notification for other purposes.
+ *
+ * Requires configUSE_CHANNELS set to 1.
+ */
+
+#ifndef CHANNEL_H
+#define CHANNEL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include channel.h"
+#endif
+
+#include "task.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* Channel control structure.  The members are private to channel.c, a channel
+can be declared statically and set up with vChannelInit(). */
+typedef struct xCHANNEL
+{
+	volatile UBaseType_t uxHead;				/*<< Number of items sent, written by the producer only. */
+	volatile UBaseType_t uxTail;				/*<< Number of items received, written by the consumer only. */
+	UBaseType_t uxMask;							/*<< Number of items the channel holds minus one. */
+	UBaseType_t uxItemSize;
+	uint8_t *pucStorage;
+	List_t xTasksWaitingToReceive;				/*<< Consumer blocked on an empty channel, if any. */
+	List_t xTasksWaitingToSend;					/*<< Producer blocked on a full channel, if any. */
+} Channel_t;
+
+/*
+ * Sets up a channel of uxLength items of uxItemSize bytes in pvStorage, which
+ * must hold uxLength * uxItemSize bytes.  uxLength must be a power of two.
+ */
+void vChannelInit( Channel_t *pxChannel, void *pvStorage, UBaseType_t uxLength, UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	/*
+	 * Allocates and sets up a channel with pvPortMalloc(), NULL if there is not
+	 * enough heap.  uxLength must be a power of two.
+	 */
+	Channel_t *pxChannelCreate( UBaseType_t uxLength, UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Frees a channel created with pxChannelCreate().  No task may be blocked on
+	 * it.
+	 */
+	void vChannelDelete( Channel_t *pxChannel ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Copies the item at pvItem into the channel.  If the channel is full the
+ * calling task blocks for up to xTicksToWait ticks for space.  Returns pdPASS
+ * if the item was sent, errQUEUE_FULL otherwise.  With xTicksToWait set to 0
+ * it never blocks and can be used while the scheduler is suspended.
+ */
+BaseType_t xChannelSend( Channel_t *pxChannel, const void *pvItem, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Version of xChannelSend() for interrupts, never blocks.
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if a consumer with a priority
+ * above the interrupted task was unblocked, a context switch should then be
+ * requested with portYIELD_FROM_ISR() before the interrupt exits.
+ */
+BaseType_t xChannelSendFromISR( Channel_t *pxChannel, const void *pvItem, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the oldest item of the channel to pvItem and removes it.  If the
+ * channel is empty the calling task blocks for up to xTicksToWait ticks for an
+ * item.  Returns pdPASS if an item was received, pdFAIL otherwise.
+ */
+BaseType_t xChannelReceive( Channel_t *pxChannel, void *pvItem, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Version of xChannelReceive() for interrupts, never blocks.
+ */
+BaseType_t xChannelReceiveFromISR( Channel_t *pxChannel, void *pvItem, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Number of items in the channel.  Exact when called by the producer or the
+ * consumer, a snapshot when called by anyone else.
+ */
+UBaseType_t uxChannelMessagesWaiting( const Channel_t *pxChannel ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+} /* extern "C" */
+#endif
+
+#endif /* CHANNEL_H */
+
@@ -586,6 +586,230 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
 									size_t xBufferLengthBytes,
 									BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+                                 void **ppvTxData,
+                                 size_t xDataLengthBytes,
+                                 TickType_t xTicksToWait );
+</pre>
+ *
+ * Reserves space in a stream buffer so the writer can write data in place
+ * instead of having it copied by xStreamBufferSend().  The data is not
+ * available to the reader until xStreamBufferSendCommit() is called.
+ *
+ * The reserved space is contiguous.  As a stream buffer's data wraps around
+ * from the end of its storage area to the start of it, at most the bytes up to
+ * the end of the storage area are reserved at once - write the rest after
+ * committing them.  Message buffers use xMessageBufferSendReserve() instead,
+ * which reserves whole messages.
+ *
+ * Uniquely among FreeRTOS objects, the stream buffer implementation assumes
+ * there is only one writer - see the note at the top of this file.  Only one
+ * reservation can be outstanding, and the writer must not call
+ * xStreamBufferSend() while it is.
+ *
+ * Use xStreamBufferSendReserve() to reserve space from a task.  Use
+ * xStreamBufferSendReserveFromISR() to reserve space from an interrupt service
+ * routine (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer in which space is being
+ * reserved.
+ *
+ * @param ppvTxData Set to the reserved space, or to NULL if no space was
+ * reserved.
+ *
+ * @param xDataLengthBytes The number of bytes wanted.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for xDataLengthBytes contiguous bytes, or for all the
+ * bytes up to the end of the storage area, to become free.  If the time out
+ * expires first then the bytes that are free are reserved.
+ *
+ * @return The number of bytes reserved.
+ *
+ * \defgroup xStreamBufferSendReserve xStreamBufferSendReserve
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+								 void **ppvTxData,
+								 size_t xDataLengthBytes,
+								 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferSendReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        void **ppvTxData,
+                                        size_t xDataLengthBytes );
+</pre>
+ *
+ * A version of xStreamBufferSendReserve() that can be called from an
+ * interrupt service routine (ISR).  It never blocks.
+ *
+ * \defgroup xStreamBufferSendReserveFromISR xStreamBufferSendReserveFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+										void **ppvTxData,
+										size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer, size_t xDataLengthBytes );
+</pre>
+ *
+ * Makes the first xDataLengthBytes bytes of the space reserved by
+ * xStreamBufferSendReserve() available to the reader, and unblocks a reader
+ * waiting for data if the trigger level has been reached, as
+ * xStreamBufferSend() does.  The rest of the reservation is returned to the
+ * stream buffer.  Committing 0 bytes cancels the reservation.
+ *
+ * Use xStreamBufferSendCommit() from a task.  Use
+ * xStreamBufferSendCommitFromISR() from an interrupt service routine (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer.
+ *
+ * @param xDataLengthBytes The number of bytes written to the reserved space,
+ * which must not be more than were reserved.
+ *
+ * @return The number of bytes committed.
+ *
+ * \defgroup xStreamBufferSendCommit xStreamBufferSendCommit
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer, size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                       size_t xDataLengthBytes,
+                                       BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xStreamBufferSendCommit() that can be called from an interrupt
+ * service routine (ISR).  *pxHigherPriorityTaskWoken is set to pdTRUE if a
+ * task was unblocked that has a priority above the priority of the currently
+ * running task, as by xStreamBufferSendFromISR().
+ *
+ * \defgroup xStreamBufferSendCommitFromISR xStreamBufferSendCommitFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+									   size_t xDataLengthBytes,
+									   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+                                    void **ppvRxData,
+                                    TickType_t xTicksToWait );
+</pre>
+ *
+ * Points the reader at data in a stream buffer so it can be used in place
+ * instead of having it copied by xStreamBufferReceive().  The data stays in
+ * the stream buffer until vStreamBufferReceiveRelease() is called.
+ *
+ * The data pointed to is contiguous, at most the bytes up to the end of the
+ * storage area are acquired at once - the rest are acquired after releasing
+ * them.  Message buffers use xMessageBufferReceiveAcquire() instead, which
+ * acquires whole messages.
+ *
+ * Use xStreamBufferReceiveAcquire() from a task.  Use
+ * xStreamBufferReceiveAcquireFromISR() from an interrupt service routine
+ * (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer from which data is
+ * being acquired.
+ *
+ * @param ppvRxData Set to the acquired data, or to NULL if there is none.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for data, as for xStreamBufferReceive().
+ *
+ * @return The number of bytes acquired.
+ *
+ * \defgroup xStreamBufferReceiveAcquire xStreamBufferReceiveAcquire
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+									void **ppvRxData,
+									TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferReceiveAcquireFromISR( StreamBufferHandle_t xStreamBuffer,
+                                           void **ppvRxData );
+</pre>
+ *
+ * A version of xStreamBufferReceiveAcquire() that can be called from an
+ * interrupt service routine (ISR).  It never blocks.
+ *
+ * \defgroup xStreamBufferReceiveAcquireFromISR xStreamBufferReceiveAcquireFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveAcquireFromISR( StreamBufferHandle_t xStreamBuffer,
+										   void **ppvRxData ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+void vStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer, size_t xDataLengthBytes );
+</pre>
+ *
+ * Removes the first xDataLengthBytes bytes of the data acquired by
+ * xStreamBufferReceiveAcquire() from the stream buffer, and unblocks a writer
+ * waiting for space, as xStreamBufferReceive() does.  Bytes that are not
+ * released are acquired again by the next call to
+ * xStreamBufferReceiveAcquire().
+ *
+ * Use vStreamBufferReceiveRelease() from a task.  Use
+ * vStreamBufferReceiveReleaseFromISR() from an interrupt service routine
+ * (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer.
+ *
+ * @param xDataLengthBytes The number of bytes to release, which must not be more
+ * than were acquired.
+ *
+ * \defgroup vStreamBufferReceiveRelease vStreamBufferReceiveRelease
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer, size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+void vStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+                                         size_t xDataLengthBytes,
+                                         BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of vStreamBufferReceiveRelease() that can be called from an
+ * interrupt service routine (ISR).  *pxHigherPriorityTaskWoken is set to
+ * pdTRUE if a task was unblocked that has a priority above the priority of the
+ * currently running task, as by xStreamBufferReceiveFromISR().
+ *
+ * \defgroup vStreamBufferReceiveReleaseFromISR vStreamBufferReceiveReleaseFromISR
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+										 size_t xDataLengthBytes,
+										 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
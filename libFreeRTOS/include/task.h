@@ -142,11 +142,24 @@ typedef struct xTASK_STATUS
 	eTaskState eCurrentState;		/* The state in which the task existed when the structure was populated. */
 	UBaseType_t uxCurrentPriority;	/* The priority at which the task was running (may be inherited) when the structure was populated. */
 	UBaseType_t uxBasePriority;		/* The priority to which the task will return if the task's current priority has been inherited to avoid unbounded priority inversion when obtaining a mutex.  Only valid if configUSE_MUTEXES is defined as 1 in FreeRTOSConfig.h. */
-	uint32_t ulRunTimeCounter;		/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+	configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;	/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+	configRUN_TIME_COUNTER_TYPE ulQueueWaitTime;	/* The total time the task has spent in the Blocked state waiting for a queue, semaphore, mutex or event group, as defined by the run time stats clock.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+	configRUN_TIME_COUNTER_TYPE ulDMAWaitTime;		/* As ulQueueWaitTime, for waits the task marked as waiting for a DMA transfer with vTaskSetWaitReason(). */
+	configRUN_TIME_COUNTER_TYPE ulOtherWaitTime;	/* As ulQueueWaitTime, for all other waits, such as delays and task notifications. */
 	StackType_t *pxStackBase;		/* Points to the lowest address of the task's stack area. */
 	configSTACK_DEPTH_TYPE usStackHighWaterMark;	/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+/* What a task is waiting for while it is in the Blocked state.  Used by the
+run time statistics, see vTaskSetWaitReason(). */
+typedef enum
+{
+	eWaitNone = 0,	/* Not blocked, or no reason set. */
+	eWaitQueue,		/* Blocked on a queue, semaphore, mutex or event group. */
+	eWaitDMA,		/* Blocked waiting for a DMA transfer to complete. */
+	eWaitOther		/* Any other wait, such as a delay or a task notification. */
+} eWaitReason;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -1579,7 +1592,7 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 	{
 	TaskStatus_t *pxTaskStatusArray;
 	volatile UBaseType_t uxArraySize, x;
-	uint32_t ulTotalRunTime, ulStatsAsPercentage;
+	configRUN_TIME_COUNTER_TYPE ulTotalRunTime, ulStatsAsPercentage;
 
 		// Make sure the write buffer does not contain a string.
 		*pcWriteBuffer = 0x00;
@@ -1633,7 +1646,7 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 	}
 	</pre>
  */
-UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
+UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
 
 /**
  * task. h
@@ -1736,9 +1749,67 @@ void vTaskList( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unquali
  */
 void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
+/**
+ * task. h
+ * <PRE>void vTaskGetWaitTimeStats( char *pcWriteBuffer );</PRE>
+ *
+ * configGENERATE_RUN_TIME_STATS and configUSE_STATS_FORMATTING_FUNCTIONS
+ * must both be defined as 1 for this function to be available.  The
+ * application must also then provide definitions for
+ * portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() and portGET_RUN_TIME_COUNTER_VALUE()
+ * as for vTaskGetRunTimeStats().
+ *
+ * Like vTaskGetRunTimeStats(), but the table shows for each task the time
+ * spent in the Running state next to the time spent in the Blocked state
+ * waiting for queues (including semaphores, mutexes and event groups), for
+ * DMA transfers and for anything else, all in run time stats clock units.
+ * See vTaskSetWaitReason().
+ *
+ * The same notes as for vTaskGetRunTimeStats() apply.  Production systems
+ * should call uxTaskGetSystemState() directly, the ulQueueWaitTime,
+ * ulDMAWaitTime and ulOtherWaitTime members of TaskStatus_t hold the raw data.
+ *
+ * @param pcWriteBuffer A buffer into which the table is written, in ASCII
+ * form.  This buffer is assumed to be large enough to contain the generated
+ * report.  Approximately 80 bytes per task should be sufficient.
+ *
+ * \defgroup vTaskGetWaitTimeStats vTaskGetWaitTimeStats
+ * \ingroup TaskUtils
+ */
+void vTaskGetWaitTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/**
+ * task. h
+ * <PRE>void vTaskSetWaitReason( eWaitReason eReason );</PRE>
+ *
+ * configGENERATE_RUN_TIME_STATS must be defined as 1 for this function to be
+ * available.
+ *
+ * The run time statistics charge the time a task spends in the Blocked state
+ * to what it was waiting for: to eWaitQueue when it blocked on a queue,
+ * semaphore, mutex or event group, and to eWaitOther otherwise.  A task that
+ * waits for something else through one of these, such as for a DMA transfer
+ * through a semaphore given by the DMA interrupt, sets the reason for the
+ * calls that follow with vTaskSetWaitReason(), and sets it back to eWaitNone
+ * afterwards.
+ *
+ * @param eReason What the calling task's following blocking calls wait for,
+ * or eWaitNone to go back to the default.
+ *
+ * Example usage:
+   <pre>
+	vTaskSetWaitReason( eWaitDMA );
+	xSemaphoreTake( xDMADone, portMAX_DELAY );
+	vTaskSetWaitReason( eWaitNone );
+   </pre>
+ * \defgroup vTaskSetWaitReason vTaskSetWaitReason
+ * \ingroup TaskUtils
+ */
+void vTaskSetWaitReason( eWaitReason eReason ) PRIVILEGED_FUNCTION;
+
 /**
 * task. h
-* <PRE>TickType_t xTaskGetIdleRunTimeCounter( void );</PRE>
+* <PRE>configRUN_TIME_COUNTER_TYPE xTaskGetIdleRunTimeCounter( void );</PRE>
 *
 * configGENERATE_RUN_TIME_STATS and configUSE_STATS_FORMATTING_FUNCTIONS
 * must both be defined as 1 for this function to be available.  The application
@@ -1764,7 +1835,7 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
 * \defgroup xTaskGetIdleRunTimeCounter xTaskGetIdleRunTimeCounter
 * \ingroup TaskUtils
 */
-TickType_t xTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
+configRUN_TIME_COUNTER_TYPE xTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 
 /**
  * task. h
@@ -0,0 +1,500 @@
+/*
+ * FreeRTOS Kernel V10.2.1
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "message_buffer.h"
+#include "objpool.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configUSE_OBJECT_POOLS == 1 )
+
+#if( configSUPPORT_STATIC_ALLOCATION == 0 )
+	#error configUSE_OBJECT_POOLS requires configSUPPORT_STATIC_ALLOCATION to be 1
+#endif
+
+/* Default pool sizes, overridden in FreeRTOSConfig.h. */
+#ifndef configPOOL_SECTION
+	#define configPOOL_SECTION				".dram1.data"
+#endif
+
+#ifndef configPOOL_STACK_SECTION
+	#define configPOOL_STACK_SECTION		configPOOL_SECTION
+#endif
+
+#ifndef configPOOL_QUEUES
+	#define configPOOL_QUEUES				4
+#endif
+
+#ifndef configPOOL_QUEUE_STORAGE_SIZE
+	#define configPOOL_QUEUE_STORAGE_SIZE	64
+#endif
+
+#ifndef configPOOL_SEMAPHORES
+	#define configPOOL_SEMAPHORES			4
+#endif
+
+#ifndef configPOOL_SMALL_TASKS
+	#define configPOOL_SMALL_TASKS			2
+#endif
+
+#ifndef configPOOL_SMALL_STACK_DEPTH
+	#define configPOOL_SMALL_STACK_DEPTH	configMINIMAL_STACK_SIZE
+#endif
+
+#ifndef configPOOL_LARGE_TASKS
+	#define configPOOL_LARGE_TASKS			2
+#endif
+
+#ifndef configPOOL_LARGE_STACK_DEPTH
+	#define configPOOL_LARGE_STACK_DEPTH	( 2 * configMINIMAL_STACK_SIZE )
+#endif
+
+#ifndef configPOOL_MESSAGE_BUFFERS
+	#define configPOOL_MESSAGE_BUFFERS		4
+#endif
+
+#ifndef configPOOL_MESSAGE_BUFFER_SIZE
+	#define configPOOL_MESSAGE_BUFFER_SIZE	256
+#endif
+
+#define poolALIGN( x )		( ( ( x ) + ( ( size_t ) portBYTE_ALIGNMENT - 1 ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* Pool blocks.  The handle of the object created on a block is the address of
+its static control structure, which comes first so a handle converts back to
+its block. */
+typedef struct xQUEUE_BLOCK
+{
+	StaticQueue_t xQueue;
+	uint8_t ucStorage[ poolALIGN( configPOOL_QUEUE_STORAGE_SIZE ) ];
+} QueueBlock_t;
+
+typedef struct xMESSAGE_BUFFER_BLOCK
+{
+	StaticMessageBuffer_t xMessageBuffer;
+	/* Stream buffers need one byte more than their size. */
+	uint8_t ucStorage[ poolALIGN( configPOOL_MESSAGE_BUFFER_SIZE + 1 ) ];
+} MessageBufferBlock_t;
+
+/* Stacks are held apart from the TCBs so they can be placed in another
+section. */
+typedef struct xTASK_POOL
+{
+	ObjectPool_t xTCBs;
+	StackType_t *puxStacks;
+	configSTACK_DEPTH_TYPE usStackDepth;
+} TaskPool_t;
+
+/*-----------------------------------------------------------*/
+
+#define poolSECTION( name )		__attribute__((section( name ))) __attribute__((aligned( portBYTE_ALIGNMENT )))
+
+#if( configPOOL_QUEUES > 0 )
+	static QueueBlock_t xQueueBlocks[ configPOOL_QUEUES ] poolSECTION( configPOOL_SECTION );
+#endif
+#if( configPOOL_SEMAPHORES > 0 )
+	static StaticSemaphore_t xSemaphoreBlocks[ configPOOL_SEMAPHORES ] poolSECTION( configPOOL_SECTION );
+#endif
+#if( configPOOL_MESSAGE_BUFFERS > 0 )
+	static MessageBufferBlock_t xMessageBufferBlocks[ configPOOL_MESSAGE_BUFFERS ] poolSECTION( configPOOL_SECTION );
+#endif
+#if( configPOOL_SMALL_TASKS > 0 )
+	static StaticTask_t xSmallTCBs[ configPOOL_SMALL_TASKS ] poolSECTION( configPOOL_SECTION );
+	static StackType_t uxSmallStacks[ configPOOL_SMALL_TASKS ][ configPOOL_SMALL_STACK_DEPTH ] poolSECTION( configPOOL_STACK_SECTION );
+#endif
+#if( configPOOL_LARGE_TASKS > 0 )
+	static StaticTask_t xLargeTCBs[ configPOOL_LARGE_TASKS ] poolSECTION( configPOOL_SECTION );
+	static StackType_t uxLargeStacks[ configPOOL_LARGE_TASKS ][ configPOOL_LARGE_STACK_DEPTH ] poolSECTION( configPOOL_STACK_SECTION );
+#endif
+
+static ObjectPool_t xQueuePool;
+static ObjectPool_t xSemaphorePool;
+static ObjectPool_t xMessageBufferPool;
+
+/* Stack classes, smallest first. */
+static TaskPool_t xTaskPools[ 2 ];
+
+static BaseType_t xPoolsInitialised = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Sets up the kernel object pools, the first time one is used.
+ */
+static void prvPoolsInit( void );
+
+/*-----------------------------------------------------------*/
+
+void vPoolInit( ObjectPool_t *pxPool, void *pvBuffer, size_t xBlockSize, UBaseType_t uxBlocks )
+{
+UBaseType_t ux;
+uint8_t *pucBlock;
+
+	configASSERT( ( ( ( size_t ) pvBuffer ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+	if( xBlockSize < sizeof( void * ) )
+	{
+		xBlockSize = sizeof( void * );
+	}
+	xBlockSize = poolALIGN( xBlockSize );
+
+	/* Thread the free list through the blocks in address order. */
+	pucBlock = ( uint8_t * ) pvBuffer;
+	for( ux = 0; ux < uxBlocks; ux++ )
+	{
+		*( ( void ** ) pucBlock ) = ( ux + 1 < uxBlocks ) ? ( void * ) ( pucBlock + xBlockSize ) : NULL;
+		pucBlock += xBlockSize;
+	}
+
+	pxPool->pvFreeList = ( uxBlocks > 0 ) ? pvBuffer : NULL;
+	pxPool->pucStart = ( uint8_t * ) pvBuffer;
+	pxPool->pucEnd = pucBlock;
+	pxPool->xBlockSize = xBlockSize;
+	pxPool->uxBlocks = uxBlocks;
+	pxPool->uxFreeBlocks = uxBlocks;
+	pxPool->uxMinimumEverFreeBlocks = uxBlocks;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPoolAlloc( ObjectPool_t *pxPool )
+{
+void *pvReturn;
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pvReturn = pxPool->pvFreeList;
+
+		if( pvReturn != NULL )
+		{
+			pxPool->pvFreeList = *( ( void ** ) pvReturn );
+			pxPool->uxFreeBlocks--;
+
+			if( pxPool->uxFreeBlocks < pxPool->uxMinimumEverFreeBlocks )
+			{
+				pxPool->uxMinimumEverFreeBlocks = pxPool->uxFreeBlocks;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPoolFree( ObjectPool_t *pxPool, void *pv )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( xPoolContains( pxPool, pv ) != pdFALSE );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		*( ( void ** ) pv ) = pxPool->pvFreeList;
+		pxPool->pvFreeList = pv;
+		pxPool->uxFreeBlocks++;
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPoolContains( const ObjectPool_t *pxPool, const void *pv )
+{
+const uint8_t *puc = ( const uint8_t * ) pv;
+
+	if( ( puc >= pxPool->pucStart ) && ( puc < pxPool->pucEnd ) && ( ( ( size_t ) ( puc - pxPool->pucStart ) % pxPool->xBlockSize ) == 0 ) )
+	{
+		return pdTRUE;
+	}
+
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+QueueHandle_t xQueueCreateFromPool( UBaseType_t uxQueueLength, UBaseType_t uxItemSize )
+{
+QueueBlock_t *pxBlock;
+QueueHandle_t xReturn = NULL;
+
+	prvPoolsInit();
+
+	if( ( size_t ) uxQueueLength * ( size_t ) uxItemSize <= configPOOL_QUEUE_STORAGE_SIZE )
+	{
+		pxBlock = ( QueueBlock_t * ) pvPoolAlloc( &xQueuePool );
+
+		if( pxBlock != NULL )
+		{
+			xReturn = xQueueCreateStatic( uxQueueLength, uxItemSize, pxBlock->ucStorage, &( pxBlock->xQueue ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vQueueDeleteFromPool( QueueHandle_t xQueue )
+{
+	vQueueDelete( xQueue );
+	vPoolFree( &xQueuePool, ( void * ) xQueue );
+}
+/*-----------------------------------------------------------*/
+
+SemaphoreHandle_t xSemaphoreCreateBinaryFromPool( void )
+{
+StaticSemaphore_t *pxBlock;
+
+	prvPoolsInit();
+	pxBlock = ( StaticSemaphore_t * ) pvPoolAlloc( &xSemaphorePool );
+
+	return ( pxBlock != NULL ) ? xSemaphoreCreateBinaryStatic( pxBlock ) : NULL;
+}
+/*-----------------------------------------------------------*/
+
+SemaphoreHandle_t xSemaphoreCreateCountingFromPool( UBaseType_t uxMaxCount, UBaseType_t uxInitialCount )
+{
+StaticSemaphore_t *pxBlock;
+
+	prvPoolsInit();
+	pxBlock = ( StaticSemaphore_t * ) pvPoolAlloc( &xSemaphorePool );
+
+	return ( pxBlock != NULL ) ? xSemaphoreCreateCountingStatic( uxMaxCount, uxInitialCount, pxBlock ) : NULL;
+}
+/*-----------------------------------------------------------*/
+
+SemaphoreHandle_t xSemaphoreCreateMutexFromPool( void )
+{
+StaticSemaphore_t *pxBlock;
+
+	prvPoolsInit();
+	pxBlock = ( StaticSemaphore_t * ) pvPoolAlloc( &xSemaphorePool );
+
+	return ( pxBlock != NULL ) ? xSemaphoreCreateMutexStatic( pxBlock ) : NULL;
+}
+/*-----------------------------------------------------------*/
+
+void vSemaphoreDeleteFromPool( SemaphoreHandle_t xSemaphore )
+{
+	vSemaphoreDelete( xSemaphore );
+	vPoolFree( &xSemaphorePool, ( void * ) xSemaphore );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskCreateFromPool( TaskFunction_t pxTaskCode,
+								const char * const pcName,
+								const configSTACK_DEPTH_TYPE usStackDepth,
+								void * const pvParameters,
+								UBaseType_t uxPriority,
+								TaskHandle_t * const pxCreatedTask )
+{
+StaticTask_t *pxTCB = NULL;
+TaskPool_t *pxTaskPool = NULL;
+TaskHandle_t xHandle;
+UBaseType_t ux;
+
+	prvPoolsInit();
+
+	/* Smallest class that fits and has a free block. */
+	for( ux = 0; ( ux < sizeof( xTaskPools ) / sizeof( xTaskPools[ 0 ] ) ) && ( pxTCB == NULL ); ux++ )
+	{
+		if( xTaskPools[ ux ].usStackDepth >= usStackDepth )
+		{
+			pxTaskPool = &xTaskPools[ ux ];
+			pxTCB = ( StaticTask_t * ) pvPoolAlloc( &( pxTaskPool->xTCBs ) );
+		}
+	}
+
+	if( pxTCB == NULL )
+	{
+		return errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+	}
+
+	/* The stack of a block has the index of its TCB. */
+	ux = ( UBaseType_t ) ( ( ( uint8_t * ) pxTCB - pxTaskPool->xTCBs.pucStart ) / pxTaskPool->xTCBs.xBlockSize );
+	xHandle = xTaskCreateStatic( pxTaskCode, pcName, pxTaskPool->usStackDepth, pvParameters, uxPriority,
+								 &( pxTaskPool->puxStacks[ ux * pxTaskPool->usStackDepth ] ), pxTCB );
+
+	if( xHandle == NULL )
+	{
+		vPoolFree( &( pxTaskPool->xTCBs ), pxTCB );
+		return errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+	}
+
+	if( pxCreatedTask != NULL )
+	{
+		*pxCreatedTask = xHandle;
+	}
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vPoolReleaseTask( void *pxTCB )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < sizeof( xTaskPools ) / sizeof( xTaskPools[ 0 ] ); ux++ )
+	{
+		if( xPoolContains( &( xTaskPools[ ux ].xTCBs ), pxTCB ) != pdFALSE )
+		{
+			vPoolFree( &( xTaskPools[ ux ].xTCBs ), pxTCB );
+			break;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+MessageBufferHandle_t xMessageBufferCreateFromPool( size_t xBufferSizeBytes )
+{
+MessageBufferBlock_t *pxBlock;
+MessageBufferHandle_t xReturn = NULL;
+
+	prvPoolsInit();
+
+	if( xBufferSizeBytes <= configPOOL_MESSAGE_BUFFER_SIZE )
+	{
+		pxBlock = ( MessageBufferBlock_t * ) pvPoolAlloc( &xMessageBufferPool );
+
+		if( pxBlock != NULL )
+		{
+			xReturn = xMessageBufferCreateStatic( xBufferSizeBytes, pxBlock->ucStorage, &( pxBlock->xMessageBuffer ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vMessageBufferDeleteFromPool( MessageBufferHandle_t xMessageBuffer )
+{
+	vMessageBufferDelete( xMessageBuffer );
+	vPoolFree( &xMessageBufferPool, ( void * ) xMessageBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPoolsInit( void )
+{
+	/* Checked again in the critical section, pools can first be used by
+	several tasks at once. */
+	if( xPoolsInitialised != pdFALSE )
+	{
+		return;
+	}
+
+	taskENTER_CRITICAL();
+	{
+		if( xPoolsInitialised == pdFALSE )
+		{
+			#if( configPOOL_QUEUES > 0 )
+				vPoolInit( &xQueuePool, xQueueBlocks, sizeof( QueueBlock_t ), configPOOL_QUEUES );
+			#endif
+			#if( configPOOL_SEMAPHORES > 0 )
+				vPoolInit( &xSemaphorePool, xSemaphoreBlocks, sizeof( StaticSemaphore_t ), configPOOL_SEMAPHORES );
+			#endif
+			#if( configPOOL_MESSAGE_BUFFERS > 0 )
+				vPoolInit( &xMessageBufferPool, xMessageBufferBlocks, sizeof( MessageBufferBlock_t ), configPOOL_MESSAGE_BUFFERS );
+			#endif
+			#if( configPOOL_SMALL_TASKS > 0 )
+				vPoolInit( &( xTaskPools[ 0 ].xTCBs ), xSmallTCBs, sizeof( StaticTask_t ), configPOOL_SMALL_TASKS );
+				xTaskPools[ 0 ].puxStacks = &uxSmallStacks[ 0 ][ 0 ];
+				xTaskPools[ 0 ].usStackDepth = configPOOL_SMALL_STACK_DEPTH;
+			#endif
+			#if( configPOOL_LARGE_TASKS > 0 )
+				vPoolInit( &( xTaskPools[ 1 ].xTCBs ), xLargeTCBs, sizeof( StaticTask_t ), configPOOL_LARGE_TASKS );
+				xTaskPools[ 1 ].puxStacks = &uxLargeStacks[ 0 ][ 0 ];
+				xTaskPools[ 1 ].usStackDepth = configPOOL_LARGE_STACK_DEPTH;
+			#endif
+
+			xPoolsInitialised = pdTRUE;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+/* Static allocation, needed by the pools, makes the kernel ask the
+application for the idle and timer task memory.  Applications that place
+these themselves override the weak definitions below. */
+__attribute__((weak)) void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize )
+{
+static StaticTask_t xIdleTaskTCB;
+static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+	*ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+	*ppxIdleTaskStackBuffer = uxIdleTaskStack;
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMERS == 1 )
+
+	__attribute__((weak)) void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize )
+	{
+	static StaticTask_t xTimerTaskTCB;
+	static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+		*ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+		*ppxTimerTaskStackBuffer = uxTimerTaskStack;
+		*pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+	}
+
+#endif /* configUSE_TIMERS */
+
+#endif /* configUSE_OBJECT_POOLS */
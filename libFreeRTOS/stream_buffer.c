@@ -135,6 +135,12 @@ that uses task notifications. */
 #define sbFLAGS_IS_MESSAGE_BUFFER		( ( uint8_t ) 1 ) /* Set if the stream buffer was created as a message buffer, in which case it holds discrete messages rather than a stream. */
 #define sbFLAGS_IS_STATICALLY_ALLOCATED ( ( uint8_t ) 2 ) /* Set if the stream buffer was created using statically allocated memory. */
 
+/* A message length of zero marks padding.  xStreamBufferSendCommit() writes it
+when a reserved message would not fit between its length and the end of the
+buffer, the message then starts at the beginning of the buffer and the reader
+skips the rest of the buffer.  Zero length messages are never written. */
+#define sbMESSAGE_PADDING				( ( configMESSAGE_BUFFER_LENGTH_TYPE ) 0 )
+
 /*-----------------------------------------------------------*/
 
 /* Structure that hold state information on the buffer. */
@@ -144,6 +150,8 @@ typedef struct StreamBufferDef_t /*lint !e9058 Style convention uses tag. */
 	volatile size_t xHead;				/* Index to the next item to write within the buffer. */
 	size_t xLength;						/* The length of the buffer pointed to by pucBuffer. */
 	size_t xTriggerLevelBytes;			/* The number of bytes that must be in the stream buffer before a task that is waiting for data is unblocked. */
+	size_t xReservedOffset;				/* Index of the space reserved by xStreamBufferSendReserve().  For a message buffer the length of the message is written in front of it when it is committed. */
+	size_t xReservedLength;				/* The number of bytes reserved, or 0 if there is no reservation. */
 	volatile TaskHandle_t xTaskWaitingToReceive; /* Holds the handle of a task waiting for data, or NULL if no tasks are waiting. */
 	volatile TaskHandle_t xTaskWaitingToSend;	/* Holds the handle of a task waiting to send data to a message buffer that is full. */
 	uint8_t *pucBuffer;					/* Points to the buffer itself - that is - the RAM that stores the data passed through the buffer. */
@@ -202,6 +210,58 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer,
 									  size_t xMaxCount,
 									  size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copy xCount bytes from pucData into the buffer's storage area starting at
+ * xIndex, wrapping around to the start of the storage area if necessary.
+ * Returns the index following the last byte written.  Neither xHead nor xTail
+ * is updated.
+ */
+static size_t prvCopyToBuffer( const StreamBuffer_t * const pxStreamBuffer, size_t xIndex, const uint8_t *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy xCount bytes from the buffer's storage area starting at xIndex into
+ * pucData, wrapping around to the start of the storage area if necessary.
+ * Returns the index following the last byte read.  Neither xHead nor xTail is
+ * updated.
+ */
+static size_t prvCopyFromBuffer( const StreamBuffer_t * const pxStreamBuffer, size_t xIndex, uint8_t *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * If the next message in a message buffer is padding written by
+ * xStreamBufferSendCommit() then remove the padding, so xTail indexes the length
+ * of the message that follows it.  Returns the number of bytes available once
+ * the padding, if any, has been removed.
+ */
+static size_t prvSkipMessagePadding( StreamBuffer_t * const pxStreamBuffer, size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
+
+/*
+ * Attempt to reserve xDataLengthBytes contiguous bytes of storage for the
+ * writer.  A message buffer reserves the whole message or nothing.  A stream
+ * buffer reserves as many bytes as are free before the end of the storage area,
+ * up to xDataLengthBytes.  Returns the number of bytes reserved, and sets
+ * *ppvTxData to the reserved space or NULL if nothing was reserved.
+ */
+static size_t prvReserveSpace( StreamBuffer_t * const pxStreamBuffer, void **ppvTxData, size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Make xDataLengthBytes bytes of the current reservation available to the
+ * reader.  Returns the number of bytes committed.
+ */
+static size_t prvCommitReservedSpace( StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Point *ppvRxData at the next message, or at the contiguous bytes that can be
+ * read before the end of the storage area, without removing them from the
+ * buffer.  Returns the number of bytes pointed to.
+ */
+static size_t prvAcquireData( StreamBuffer_t * const pxStreamBuffer, void **ppvRxData, size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove the acquired message, or xDataLengthBytes acquired bytes, from the
+ * buffer.  Returns the number of bytes removed.
+ */
+static size_t prvReleaseData( StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -667,10 +727,11 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
 	BaseType_t xShouldWrite;
 	size_t xReturn;
 
-	if( xSpace == ( size_t ) 0 )
+	if( ( xSpace == ( size_t ) 0 ) || ( xDataLengthBytes == ( size_t ) 0 ) )
 	{
 		/* Doesn't matter if this is a stream buffer or a message buffer, there
-		is no space to write. */
+		is no space to write, or nothing to write.  A zero length message must
+		not be written as it would be read as padding. */
 		xShouldWrite = pdFALSE;
 	}
 	else if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
@@ -833,7 +894,9 @@ configMESSAGE_BUFFER_LENGTH_TYPE xTempReturn;
 			is available.  Return its length without removing the length bytes
 			from the buffer.  A copy of the tail is stored so the buffer can be
 			returned to its prior state as the message is not actually being
-			removed from the buffer. */
+			removed from the buffer.  Padding in front of the message is not
+			part of it and is removed. */
+			xBytesAvailable = prvSkipMessagePadding( pxStreamBuffer, xBytesAvailable );
 			xOriginalTail = pxStreamBuffer->xTail;
 			( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempReturn, sbBYTES_TO_STORE_MESSAGE_LENGTH, xBytesAvailable );
 			xReturn = ( size_t ) xTempReturn;
@@ -926,6 +989,10 @@ configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
 
 	if( xBytesToStoreMessageLength != ( size_t ) 0 )
 	{
+		/* Messages written with xStreamBufferSendCommit() may be preceded by
+		padding. */
+		xBytesAvailable = prvSkipMessagePadding( pxStreamBuffer, xBytesAvailable );
+
 		/* A discrete message is being received.  First receive the length
 		of the message.  A copy of the tail is stored so the buffer can be
 		returned to its prior state if the length of the message is too
@@ -1085,22 +1152,324 @@ UBaseType_t uxSavedInterruptStatus;
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount )
+size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+								 void **ppvTxData,
+								 size_t xDataLengthBytes,
+								 TickType_t xTicksToWait )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xReturn, xRequiredLength = xDataLengthBytes, xContiguous;
+TimeOut_t xTimeOut;
+
+	configASSERT( ppvTxData );
+	configASSERT( pxStreamBuffer );
+
+	/* A stream buffer cannot reserve past the end of its storage area, so
+	only wait for the contiguous space that can ever be free at the head.  The
+	writer owns the head so it does not move while waiting. */
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
+	{
+		xContiguous = pxStreamBuffer->xLength - pxStreamBuffer->xHead;
+		if( pxStreamBuffer->xHead == ( size_t ) 0 )
+		{
+			/* One byte always stays free between the head and the tail. */
+			xContiguous--;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xRequiredLength = configMIN( xRequiredLength, xContiguous );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xReturn = prvReserveSpace( pxStreamBuffer, ppvTxData, xDataLengthBytes );
+
+	if( ( xReturn < xRequiredLength ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+
+		do
+		{
+			/* Wait until the required contiguous space is free. */
+			taskENTER_CRITICAL();
+			{
+				xReturn = prvReserveSpace( pxStreamBuffer, ppvTxData, xDataLengthBytes );
+
+				if( xReturn >= xRequiredLength )
+				{
+					taskEXIT_CRITICAL();
+					break;
+				}
+				else if( prvBytesInBuffer( pxStreamBuffer ) == ( size_t ) 0 )
+				{
+					/* The head only moves when data is written, so a message
+					that does not fit contiguously into the empty buffer never
+					will. */
+					taskEXIT_CRITICAL();
+					break;
+				}
+				else
+				{
+					/* Clear notification state as going to wait for space. */
+					( void ) xTaskNotifyStateClear( NULL );
+
+					/* Should only be one writer. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+		} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+
+		/* Take whatever is free if the wait timed out. */
+		xReturn = prvReserveSpace( pxStreamBuffer, ppvTxData, xDataLengthBytes );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+										void **ppvTxData,
+										size_t xDataLengthBytes )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+	configASSERT( ppvTxData );
+	configASSERT( pxStreamBuffer );
+
+	return prvReserveSpace( pxStreamBuffer, ppvTxData, xDataLengthBytes );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer, size_t xDataLengthBytes )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	xReturn = prvCommitReservedSpace( pxStreamBuffer, xDataLengthBytes );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+		/* Was a task waiting for the data? */
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETED( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+									   size_t xDataLengthBytes,
+									   BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	xReturn = prvCommitReservedSpace( pxStreamBuffer, xDataLengthBytes );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		/* Was a task waiting for the data? */
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+									void **ppvRxData,
+									TickType_t xTicksToWait )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xBytesAvailable, xBytesToStoreMessageLength;
+
+	configASSERT( ppvRxData );
+	configASSERT( pxStreamBuffer );
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+	}
+	else
+	{
+		xBytesToStoreMessageLength = 0;
+	}
+
+	if( xTicksToWait != ( TickType_t ) 0 )
+	{
+		/* Checking if there is data and clearing the notification state must be
+		performed atomically. */
+		taskENTER_CRITICAL();
+		{
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+			if( xBytesAvailable <= xBytesToStoreMessageLength )
+			{
+				/* Clear notification state as going to wait for data. */
+				( void ) xTaskNotifyStateClear( NULL );
+
+				/* Should only be one reader. */
+				configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+				pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBytesAvailable <= xBytesToStoreMessageLength )
+		{
+			/* Wait for data to be available. */
+			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+			pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+			/* Recheck the data available after blocking. */
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+	}
+
+	return prvAcquireData( pxStreamBuffer, ppvRxData, xBytesAvailable );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveAcquireFromISR( StreamBufferHandle_t xStreamBuffer,
+										   void **ppvRxData )
 {
-size_t xNextHead, xFirstLength;
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+	configASSERT( ppvRxData );
+	configASSERT( pxStreamBuffer );
 
+	return prvAcquireData( pxStreamBuffer, ppvRxData, prvBytesInBuffer( pxStreamBuffer ) );
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer, size_t xDataLengthBytes )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xReleasedLength;
+
+	configASSERT( pxStreamBuffer );
+
+	xReleasedLength = prvReleaseData( pxStreamBuffer, xDataLengthBytes );
+
+	/* Was a task waiting for space in the buffer? */
+	if( xReleasedLength != ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReleasedLength );
+		sbRECEIVE_COMPLETED( pxStreamBuffer );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+										 size_t xDataLengthBytes,
+										 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+size_t xReleasedLength;
+
+	configASSERT( pxStreamBuffer );
+
+	xReleasedLength = prvReleaseData( pxStreamBuffer, xDataLengthBytes );
+
+	/* Was a task waiting for space in the buffer? */
+	if( xReleasedLength != ( size_t ) 0 )
+	{
+		sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReleasedLength );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount )
+{
 	configASSERT( xCount > ( size_t ) 0 );
 
-	xNextHead = pxStreamBuffer->xHead;
+	pxStreamBuffer->xHead = prvCopyToBuffer( pxStreamBuffer, pxStreamBuffer->xHead, pucData, xCount );
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCopyToBuffer( const StreamBuffer_t * const pxStreamBuffer, size_t xIndex, const uint8_t *pucData, size_t xCount )
+{
+size_t xFirstLength;
 
 	/* Calculate the number of bytes that can be added in the first write -
 	which may be less than the total number of bytes that need to be added if
 	the buffer will wrap back to the beginning. */
-	xFirstLength = configMIN( pxStreamBuffer->xLength - xNextHead, xCount );
+	xFirstLength = configMIN( pxStreamBuffer->xLength - xIndex, xCount );
 
 	/* Write as many bytes as can be written in the first write. */
-	configASSERT( ( xNextHead + xFirstLength ) <= pxStreamBuffer->xLength );
-	( void ) memcpy( ( void* ) ( &( pxStreamBuffer->pucBuffer[ xNextHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+	configASSERT( ( xIndex + xFirstLength ) <= pxStreamBuffer->xLength );
+	( void ) memcpy( ( void* ) ( &( pxStreamBuffer->pucBuffer[ xIndex ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
 
 	/* If the number of bytes written was less than the number that could be
 	written in the first write... */
@@ -1115,74 +1484,351 @@ size_t xNextHead, xFirstLength;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	xNextHead += xCount;
-	if( xNextHead >= pxStreamBuffer->xLength )
+	xIndex += xCount;
+	if( xIndex >= pxStreamBuffer->xLength )
 	{
-		xNextHead -= pxStreamBuffer->xLength;
+		xIndex -= pxStreamBuffer->xLength;
 	}
 	else
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	pxStreamBuffer->xHead = xNextHead;
-
-	return xCount;
+	return xIndex;
 }
 /*-----------------------------------------------------------*/
 
 static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer, uint8_t *pucData, size_t xMaxCount, size_t xBytesAvailable )
 {
-size_t xCount, xFirstLength, xNextTail;
+size_t xCount;
 
 	/* Use the minimum of the wanted bytes and the available bytes. */
 	xCount = configMIN( xBytesAvailable, xMaxCount );
 
 	if( xCount > ( size_t ) 0 )
 	{
-		xNextTail = pxStreamBuffer->xTail;
-
-		/* Calculate the number of bytes that can be read - which may be
-		less than the number wanted if the data wraps around to the start of
+		/* Move the tail pointer to effectively remove the data read from
 		the buffer. */
-		xFirstLength = configMIN( pxStreamBuffer->xLength - xNextTail, xCount );
+		pxStreamBuffer->xTail = prvCopyFromBuffer( pxStreamBuffer, pxStreamBuffer->xTail, pucData, xCount );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
 
-		/* Obtain the number of bytes it is possible to obtain in the first
-		read.  Asserts check bounds of read and write. */
-		configASSERT( xFirstLength <= xMaxCount );
-		configASSERT( ( xNextTail + xFirstLength ) <= pxStreamBuffer->xLength );
-		( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xNextTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+static size_t prvCopyFromBuffer( const StreamBuffer_t * const pxStreamBuffer, size_t xIndex, uint8_t *pucData, size_t xCount )
+{
+size_t xFirstLength;
+
+	/* Calculate the number of bytes that can be read - which may be less than
+	the number wanted if the data wraps around to the start of the buffer. */
+	xFirstLength = configMIN( pxStreamBuffer->xLength - xIndex, xCount );
+
+	/* Obtain the number of bytes it is possible to obtain in the first read.
+	Asserts check bounds of read and write. */
+	configASSERT( ( xIndex + xFirstLength ) <= pxStreamBuffer->xLength );
+	( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xIndex ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+	/* If the total number of wanted bytes is greater than the number that
+	could be read in the first read... */
+	if( xCount > xFirstLength )
+	{
+		/*...then read the remaining bytes from the start of the buffer. */
+		configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
+		( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xIndex += xCount;
+	if( xIndex >= pxStreamBuffer->xLength )
+	{
+		xIndex -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xIndex;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvSkipMessagePadding( StreamBuffer_t * const pxStreamBuffer, size_t xBytesAvailable )
+{
+size_t xTail;
+configMESSAGE_BUFFER_LENGTH_TYPE xTempLength;
 
-		/* If the total number of wanted bytes is greater than the number
-		that could be read in the first read... */
-		if( xCount > xFirstLength )
+	if( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+	{
+		xTail = pxStreamBuffer->xTail;
+		( void ) prvCopyFromBuffer( pxStreamBuffer, xTail, ( uint8_t * ) &xTempLength, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+
+		if( xTempLength == sbMESSAGE_PADDING )
 		{
-			/*...then read the remaining bytes from the start of the buffer. */
-			configASSERT( xCount <= xMaxCount );
-			( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+			/* The padding runs to the end of the storage area and is always
+			followed by a message at the start of the storage area. */
+			xBytesAvailable -= pxStreamBuffer->xLength - xTail;
+			configASSERT( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH );
+			pxStreamBuffer->xTail = 0;
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
 
-		/* Move the tail pointer to effectively remove the data read from
-		the buffer. */
-		xNextTail += xCount;
+	return xBytesAvailable;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReserveSpace( StreamBuffer_t * const pxStreamBuffer, void **ppvTxData, size_t xDataLengthBytes )
+{
+size_t xSpace, xHead, xOffset, xReturn = 0;
+
+	xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+	xHead = pxStreamBuffer->xHead;
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
+	{
+		/* A stream is written at the head.  The free space is contiguous up
+		to the end of the storage area, the rest of it is reserved after this
+		reservation has been committed. */
+		xOffset = xHead;
+		xReturn = configMIN( xDataLengthBytes, configMIN( xSpace, pxStreamBuffer->xLength - xHead ) );
+	}
+	else if( ( xDataLengthBytes > ( size_t ) 0 ) && ( xSpace >= ( xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH ) ) )
+	{
+		/* A message is written after its length. */
+		xOffset = xHead + sbBYTES_TO_STORE_MESSAGE_LENGTH;
 
-		if( xNextTail >= pxStreamBuffer->xLength )
+		if( xOffset >= pxStreamBuffer->xLength )
+		{
+			/* The length wraps or ends at the end of the storage area, so the
+			message starts at the beginning of it and is contiguous. */
+			xOffset -= pxStreamBuffer->xLength;
+			xReturn = xDataLengthBytes;
+		}
+		else if( ( xOffset + xDataLengthBytes ) <= pxStreamBuffer->xLength )
+		{
+			/* The message fits before the end of the storage area. */
+			xReturn = xDataLengthBytes;
+		}
+		else if( xSpace >= ( ( pxStreamBuffer->xLength - xHead ) + sbBYTES_TO_STORE_MESSAGE_LENGTH + xDataLengthBytes ) )
+		{
+			/* The message would wrap.  Pad to the end of the storage area and
+			place the length and the message at the beginning of it. */
+			xOffset = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+			xReturn = xDataLengthBytes;
+		}
+		else
 		{
-			xNextTail -= pxStreamBuffer->xLength;
+			/* There is enough space, but not contiguous. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		/* There is not enough space. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		pxStreamBuffer->xReservedOffset = xOffset;
+		*ppvTxData = ( void * ) &( pxStreamBuffer->pucBuffer[ xOffset ] );
+	}
+	else
+	{
+		*ppvTxData = NULL;
+	}
+
+	pxStreamBuffer->xReservedLength = xReturn;
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCommitReservedSpace( StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes )
+{
+size_t xHead, xLengthOffset;
+configMESSAGE_BUFFER_LENGTH_TYPE xTempLength;
+
+	/* Can only commit what was reserved, and only once. */
+	configASSERT( xDataLengthBytes <= pxStreamBuffer->xReservedLength );
+
+	if( ( xDataLengthBytes > ( size_t ) 0 ) && ( xDataLengthBytes <= pxStreamBuffer->xReservedLength ) )
+	{
+		xHead = pxStreamBuffer->xHead;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xLengthOffset = xHead + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+			if( xLengthOffset >= pxStreamBuffer->xLength )
+			{
+				xLengthOffset -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xLengthOffset != pxStreamBuffer->xReservedOffset )
+			{
+				/* The message was placed at the beginning of the storage area,
+				mark the rest of the storage area as padding. */
+				xTempLength = sbMESSAGE_PADDING;
+				( void ) prvCopyToBuffer( pxStreamBuffer, xHead, ( const uint8_t * ) &xTempLength, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+				xHead = 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xTempLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes;
+			( void ) prvCopyToBuffer( pxStreamBuffer, xHead, ( const uint8_t * ) &xTempLength, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xHead = pxStreamBuffer->xReservedOffset + xDataLengthBytes;
+		if( xHead >= pxStreamBuffer->xLength )
+		{
+			xHead -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
 		}
 
-		pxStreamBuffer->xTail = xNextTail;
+		/* The reader sees the padding, the length and the data together. */
+		pxStreamBuffer->xHead = xHead;
+	}
+	else
+	{
+		/* Nothing is committed. */
+		xDataLengthBytes = 0;
+	}
+
+	pxStreamBuffer->xReservedLength = 0;
+
+	return xDataLengthBytes;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvAcquireData( StreamBuffer_t * const pxStreamBuffer, void **ppvRxData, size_t xBytesAvailable )
+{
+size_t xTail, xReturn = 0;
+configMESSAGE_BUFFER_LENGTH_TYPE xTempLength;
+
+	*ppvRxData = NULL;
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		if( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+		{
+			( void ) prvSkipMessagePadding( pxStreamBuffer, xBytesAvailable );
+
+			/* The message follows its length, its bytes are contiguous unless
+			it was written with xStreamBufferSend().  A message that wraps
+			cannot be acquired, its length is returned with *ppvRxData left
+			NULL so the reader can receive it by copying it instead. */
+			xTail = prvCopyFromBuffer( pxStreamBuffer, pxStreamBuffer->xTail, ( uint8_t * ) &xTempLength, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+			xReturn = ( size_t ) xTempLength;
+			if( ( xTail + xReturn ) <= pxStreamBuffer->xLength )
+			{
+				*ppvRxData = ( void * ) &( pxStreamBuffer->pucBuffer[ xTail ] );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else if( xBytesAvailable > ( size_t ) 0 )
+	{
+		/* The bytes up to the end of the storage area, the rest are acquired
+		once these have been released. */
+		xTail = pxStreamBuffer->xTail;
+		xReturn = configMIN( xBytesAvailable, pxStreamBuffer->xLength - xTail );
+		*ppvRxData = ( void * ) &( pxStreamBuffer->pucBuffer[ xTail ] );
 	}
 	else
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	return xCount;
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReleaseData( StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes )
+{
+size_t xBytesAvailable, xTail;
+configMESSAGE_BUFFER_LENGTH_TYPE xTempLength;
+
+	xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		/* The whole message is released, whatever xDataLengthBytes is. */
+		if( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+		{
+			( void ) prvSkipMessagePadding( pxStreamBuffer, xBytesAvailable );
+			xTail = prvCopyFromBuffer( pxStreamBuffer, pxStreamBuffer->xTail, ( uint8_t * ) &xTempLength, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+			xDataLengthBytes = ( size_t ) xTempLength;
+		}
+		else
+		{
+			xTail = pxStreamBuffer->xTail;
+			xDataLengthBytes = 0;
+		}
+	}
+	else
+	{
+		/* Can only release what is in the buffer. */
+		configASSERT( xDataLengthBytes <= xBytesAvailable );
+		xDataLengthBytes = configMIN( xDataLengthBytes, xBytesAvailable );
+		xTail = pxStreamBuffer->xTail;
+	}
+
+	if( xDataLengthBytes > ( size_t ) 0 )
+	{
+		xTail += xDataLengthBytes;
+		if( xTail >= pxStreamBuffer->xLength )
+		{
+			xTail -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxStreamBuffer->xTail = xTail;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xDataLengthBytes;
 }
 /*-----------------------------------------------------------*/
 
@@ -40,6 +40,10 @@ task.h is included from an application file. */
 #include "timers.h"
 #include "stack_macros.h"
 
+#if( configUSE_OBJECT_POOLS == 1 )
+	#include "objpool.h"
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
 because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
 for the header files above, but not in this file, in order to generate the
@@ -216,12 +220,24 @@ count overflows. */
  * the task.  It is inserted at the end of the list.
  */
 #define prvAddTaskToReadyList( pxTCB )																\
+	taskRECORD_WAIT_END( pxTCB );																	\
 	traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
 	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
 	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
 	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 /*-----------------------------------------------------------*/
 
+/*
+ * Charges the time a task spent in the Blocked state to what it was waiting
+ * for, as the task leaves the Blocked state.
+ */
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+	#define taskRECORD_WAIT_END( pxTCB ) prvRecordWaitEnd( pxTCB )
+#else
+	#define taskRECORD_WAIT_END( pxTCB )
+#endif
+/*-----------------------------------------------------------*/
+
 /*
  * Several functions take an TaskHandle_t parameter that can optionally be NULL,
  * where NULL is used to indicate that the handle of the currently executing
@@ -290,7 +306,13 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 	#endif
 
 	#if( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+		configRUN_TIME_COUNTER_TYPE	ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+		configRUN_TIME_COUNTER_TYPE	ulQueueWaitTime;	/*< Time spent blocked on queues, semaphores, mutexes and event groups. */
+		configRUN_TIME_COUNTER_TYPE	ulDMAWaitTime;		/*< Time spent blocked on DMA transfers, see vTaskSetWaitReason(). */
+		configRUN_TIME_COUNTER_TYPE	ulOtherWaitTime;	/*< Time spent blocked for any other reason. */
+		configRUN_TIME_COUNTER_TYPE	ulBlockedTime;		/*< Value of the run time counter when the task last entered the Blocked state. */
+		uint8_t			ucWaitReason;		/*< eWaitReason set by the task itself, eWaitNone if not set. */
+		uint8_t			ucBlockedOn;		/*< eWaitReason of the current wait, eWaitNone if the task is not blocked. */
 	#endif
 
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -389,8 +411,8 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 	/* Do not move these variables to function scope as doing so prevents the
 	code working with debuggers that need to remove the static qualifier. */
-	PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
-	PRIVILEGED_DATA static uint32_t ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
+	PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
+	PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
 
 #endif
 
@@ -475,6 +497,21 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
  */
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
 
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	/*
+	 * Returns the current value of the run time stats clock.
+	 */
+	static configRUN_TIME_COUNTER_TYPE prvGetRunTimeCounterValue( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The task is leaving the Blocked state, add the time it was blocked to
+	 * the wait time of what it was waiting for.  See taskRECORD_WAIT_END().
+	 */
+	static void prvRecordWaitEnd( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Fills an TaskStatus_t structure with information on each task that is
  * referenced from the pxList list (which may be a ready list, a delayed list,
@@ -961,6 +998,12 @@ UBaseType_t x;
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
 	{
 		pxNewTCB->ulRunTimeCounter = 0UL;
+		pxNewTCB->ulQueueWaitTime = 0UL;
+		pxNewTCB->ulDMAWaitTime = 0UL;
+		pxNewTCB->ulOtherWaitTime = 0UL;
+		pxNewTCB->ulBlockedTime = 0UL;
+		pxNewTCB->ucWaitReason = ( uint8_t ) eWaitNone;
+		pxNewTCB->ucBlockedOn = ( uint8_t ) eWaitNone;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
@@ -2058,6 +2101,14 @@ BaseType_t xReturn;
 		FreeRTOSConfig.h file. */
 		portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
 
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			/* The first task starts running now, the time before belongs to
+			no task. */
+			ulTaskSwitchedInTime = prvGetRunTimeCounterValue();
+		}
+		#endif
+
 		traceTASK_SWITCHED_IN();
 
 		/* Setting up the timer tick is hardware specific and thus in the
@@ -2482,7 +2533,7 @@ TCB_t *pxTCB;
 
 #if ( configUSE_TRACE_FACILITY == 1 )
 
-	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime )
+	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
 	{
 	UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
 
@@ -2959,11 +3010,7 @@ void vTaskSwitchContext( void )
 
 		#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		{
-			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-				portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-			#else
-				ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-			#endif
+			ulTotalRunTime = prvGetRunTimeCounterValue();
 
 			/* Add the amount of time the task has been running to the
 			accumulated time so far.  The time the task started running was
@@ -3030,6 +3077,12 @@ void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksT
 	list is locked, preventing simultaneous access from interrupts. */
 	vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
 
+	#if ( configGENERATE_RUN_TIME_STATS == 1 )
+	{
+		pxCurrentTCB->ucBlockedOn = ( uint8_t ) eWaitQueue;
+	}
+	#endif
+
 	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
 }
 /*-----------------------------------------------------------*/
@@ -3054,6 +3107,12 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xIte
 	the task level). */
 	vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
 
+	#if ( configGENERATE_RUN_TIME_STATS == 1 )
+	{
+		pxCurrentTCB->ucBlockedOn = ( uint8_t ) eWaitQueue;
+	}
+	#endif
+
 	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
 }
 /*-----------------------------------------------------------*/
@@ -3084,6 +3143,12 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xIte
 			xTicksToWait = portMAX_DELAY;
 		}
 
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			pxCurrentTCB->ucBlockedOn = ( uint8_t ) eWaitQueue;
+		}
+		#endif
+
 		traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
 		prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
 	}
@@ -3631,11 +3696,41 @@ static void prvCheckTasksWaitingTermination( void )
 
 		#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		{
-			pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+			taskENTER_CRITICAL();
+			{
+				pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+				pxTaskStatus->ulQueueWaitTime = pxTCB->ulQueueWaitTime;
+				pxTaskStatus->ulDMAWaitTime = pxTCB->ulDMAWaitTime;
+				pxTaskStatus->ulOtherWaitTime = pxTCB->ulOtherWaitTime;
+
+				/* Include the wait the task is in now, so tasks that block
+				for a long time do not show up as never waiting. */
+				if( pxTCB->ucBlockedOn != ( uint8_t ) eWaitNone )
+				{
+				configRUN_TIME_COUNTER_TYPE ulWaitTime = prvGetRunTimeCounterValue() - pxTCB->ulBlockedTime;
+
+					if( pxTCB->ucBlockedOn == ( uint8_t ) eWaitQueue )
+					{
+						pxTaskStatus->ulQueueWaitTime += ulWaitTime;
+					}
+					else if( pxTCB->ucBlockedOn == ( uint8_t ) eWaitDMA )
+					{
+						pxTaskStatus->ulDMAWaitTime += ulWaitTime;
+					}
+					else
+					{
+						pxTaskStatus->ulOtherWaitTime += ulWaitTime;
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
 		}
 		#else
 		{
 			pxTaskStatus->ulRunTimeCounter = 0;
+			pxTaskStatus->ulQueueWaitTime = 0;
+			pxTaskStatus->ulDMAWaitTime = 0;
+			pxTaskStatus->ulOtherWaitTime = 0;
 		}
 		#endif
 
@@ -3872,6 +3967,15 @@ static void prvCheckTasksWaitingTermination( void )
 			}
 		}
 		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+		#if( configUSE_OBJECT_POOLS == 1 )
+		{
+			/* Tasks created by xTaskCreateFromPool() go back to their pool
+			only now, as nothing uses the TCB or the stack any more.  Other
+			TCBs are ignored. */
+			vPoolReleaseTask( pxTCB );
+		}
+		#endif /* configUSE_OBJECT_POOLS */
 	}
 
 #endif /* INCLUDE_vTaskDelete */
@@ -4409,7 +4513,7 @@ TCB_t *pxTCB;
 	{
 	TaskStatus_t *pxTaskStatusArray;
 	UBaseType_t uxArraySize, x;
-	uint32_t ulTotalTime, ulStatsAsPercentage;
+	configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
 
 		#if( configUSE_TRACE_FACILITY != 1 )
 		{
@@ -4478,35 +4582,18 @@ TCB_t *pxTCB;
 					easily. */
 					pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
 
+					/* The run time counter can be wider than an int, see
+					configRUN_TIME_COUNTER_TYPE, so it is printed as an
+					unsigned long long. */
 					if( ulStatsAsPercentage > 0UL )
 					{
-						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
-						}
-						#else
-						{
-							/* sizeof( int ) == sizeof( long ) so a smaller
-							printf() library can be used. */
-							sprintf( pcWriteBuffer, "\t%u\t\t%u%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
-						}
-						#endif
+						sprintf( pcWriteBuffer, "\t%llu\t\t%u%%\r\n", ( unsigned long long ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
 					}
 					else
 					{
 						/* If the percentage is zero here then the task has
 						consumed less than 1% of the total run time. */
-						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
-						}
-						#else
-						{
-							/* sizeof( int ) == sizeof( long ) so a smaller
-							printf() library can be used. */
-							sprintf( pcWriteBuffer, "\t%u\t\t<1%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
-						}
-						#endif
+						sprintf( pcWriteBuffer, "\t%llu\t\t<1%%\r\n", ( unsigned long long ) pxTaskStatusArray[ x ].ulRunTimeCounter ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
 					}
 
 					pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
@@ -4530,6 +4617,85 @@ TCB_t *pxTCB;
 #endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	void vTaskGetWaitTimeStats( char *pcWriteBuffer )
+	{
+	TaskStatus_t *pxTaskStatusArray;
+	UBaseType_t uxArraySize, x;
+
+		#if( configUSE_TRACE_FACILITY != 1 )
+		{
+			#error configUSE_TRACE_FACILITY must also be set to 1 in FreeRTOSConfig.h to use vTaskGetWaitTimeStats().
+		}
+		#endif
+
+		/*
+		 * PLEASE NOTE:
+		 *
+		 * This function is provided for convenience only, the same notes as
+		 * for vTaskGetRunTimeStats() apply.  It formats the run time and the
+		 * wait times from uxTaskGetSystemState() into a human readable table.
+		 */
+
+		/* Make sure the write buffer does not contain a string. */
+		*pcWriteBuffer = ( char ) 0x00;
+
+		/* Take a snapshot of the number of tasks in case it changes while this
+		function is executing. */
+		uxArraySize = uxCurrentNumberOfTasks;
+
+		/* Allocate an array index for each task.  NOTE!  If
+		configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
+		equate to NULL. */
+		pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+
+		if( pxTaskStatusArray != NULL )
+		{
+			/* Generate the (binary) data. */
+			uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
+
+			/* Create a human readable table from the binary data, one column
+			each for the run time, the queue wait, the DMA wait and the other
+			wait times. */
+			for( x = 0; x < uxArraySize; x++ )
+			{
+				pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+
+				sprintf( pcWriteBuffer, "\t%llu\t%llu\t%llu\t%llu\r\n",
+						 ( unsigned long long ) pxTaskStatusArray[ x ].ulRunTimeCounter,
+						 ( unsigned long long ) pxTaskStatusArray[ x ].ulQueueWaitTime,
+						 ( unsigned long long ) pxTaskStatusArray[ x ].ulDMAWaitTime,
+						 ( unsigned long long ) pxTaskStatusArray[ x ].ulOtherWaitTime ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+
+				pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+			}
+
+			/* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+			is 0 then vPortFree() will be #defined to nothing. */
+			vPortFree( pxTaskStatusArray );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	void vTaskSetWaitReason( eWaitReason eReason )
+	{
+		/* Only the calling task reads this, as it blocks, so no critical
+		section is needed. */
+		pxCurrentTCB->ucWaitReason = ( uint8_t ) eReason;
+	}
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
 TickType_t uxTaskResetEventItemValue( void )
 {
 TickType_t uxReturn;
@@ -5071,18 +5237,92 @@ TickType_t uxReturn;
 /*-----------------------------------------------------------*/
 
 #if( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
-	TickType_t xTaskGetIdleRunTimeCounter( void )
+	configRUN_TIME_COUNTER_TYPE xTaskGetIdleRunTimeCounter( void )
 	{
 		return xIdleTaskHandle->ulRunTimeCounter;
 	}
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	static configRUN_TIME_COUNTER_TYPE prvGetRunTimeCounterValue( void )
+	{
+	configRUN_TIME_COUNTER_TYPE ulTime;
+
+		#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+			portALT_GET_RUN_TIME_COUNTER_VALUE( ulTime );
+		#else
+			ulTime = portGET_RUN_TIME_COUNTER_VALUE();
+		#endif
+
+		return ulTime;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvRecordWaitEnd( TCB_t * const pxTCB )
+	{
+	configRUN_TIME_COUNTER_TYPE ulWaitTime;
+
+		/* Also called when tasks that are not blocked are moved to a ready
+		list, for example on a priority change. */
+		if( pxTCB->ucBlockedOn != ( uint8_t ) eWaitNone )
+		{
+			ulWaitTime = prvGetRunTimeCounterValue() - pxTCB->ulBlockedTime;
+
+			switch( pxTCB->ucBlockedOn )
+			{
+				case eWaitQueue:
+					pxTCB->ulQueueWaitTime += ulWaitTime;
+					break;
+
+				case eWaitDMA:
+					pxTCB->ulDMAWaitTime += ulWaitTime;
+					break;
+
+				default:
+					pxTCB->ulOtherWaitTime += ulWaitTime;
+					break;
+			}
+
+			pxTCB->ucBlockedOn = ( uint8_t ) eWaitNone;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely )
 {
 TickType_t xTimeToWake;
 const TickType_t xConstTickCount = xTickCount;
 
+	#if ( configGENERATE_RUN_TIME_STATS == 1 )
+	{
+		/* Note what the task is about to wait for, and since when.  The event
+		list functions have already set eWaitQueue, a reason set by the task
+		itself takes precedence. */
+		if( pxCurrentTCB->ucWaitReason != ( uint8_t ) eWaitNone )
+		{
+			pxCurrentTCB->ucBlockedOn = pxCurrentTCB->ucWaitReason;
+		}
+		else if( pxCurrentTCB->ucBlockedOn == ( uint8_t ) eWaitNone )
+		{
+			pxCurrentTCB->ucBlockedOn = ( uint8_t ) eWaitOther;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxCurrentTCB->ulBlockedTime = prvGetRunTimeCounterValue();
+	}
+	#endif
+
 	#if( INCLUDE_xTaskAbortDelay == 1 )
 	{
 		/* About to enter a delayed list, so ensure the ucDelayAborted flag is
@@ -0,0 +1,1176 @@
+/*
+ * FreeRTOS Kernel V10.2.1
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Hierarchical timing wheel implementation of the software timer API in
+ * timers.h, used instead of timers.c when configUSE_TIMER_WHEEL is 1.
+ *
+ * Active timers are kept in tmrWHEEL_LEVELS levels of tmrWHEEL_SLOTS slots.
+ * Level 0 holds the timers that expire within the next tmrWHEEL_SLOTS ticks,
+ * one slot per tick, each further level covers tmrWHEEL_SLOTS times the range
+ * of the level below.  When the timer service task reaches the start of a
+ * slot of a higher level the timers in it are moved (cascaded) to the lower
+ * levels.  Starting, resetting and stopping a timer is therefore constant
+ * time, however many timers are active.
+ *
+ * Start, reset, stop and change period commands are applied to the wheel
+ * directly by the calling task or interrupt, within a critical section,
+ * instead of being sent to the timer service task on the timer queue.  The
+ * timer service task is only sent a message when the new expiry time is
+ * before the time it is blocked until, and then only once until it runs
+ * again, so a burst of commands from an interrupt costs at most one queue
+ * write.  Deleting a timer and xTimerPendFunctionCall() still go through
+ * the timer queue as the timer service task may be executing the callback
+ * of the timer being deleted.
+ *
+ * Timer callbacks are executed by the timer service task, as with timers.c.
+ * Timer periods are limited to half the tick count range.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+
+/* This entire source file will be skipped if the application is not configured
+to use the timing wheel implementation of the software timers.  This #if is
+closed at the very bottom of this file. */
+#if ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_WHEEL == 1 )
+
+/* Misc definitions. */
+#define tmrNO_DELAY		( TickType_t ) 0U
+
+/* The name assigned to the timer service task.  This can be overridden by
+defining trmTIMER_SERVICE_TASK_NAME in FreeRTOSConfig.h. */
+#ifndef configTIMER_SERVICE_TASK_NAME
+	#define configTIMER_SERVICE_TASK_NAME "Tmr Svc"
+#endif
+
+/* Sent to the timer service task when a timer was started with an expiry time
+before the time the task is blocked until.  Carries no parameters. */
+#define tmrCOMMAND_WAKE_DAEMON				( ( BaseType_t ) -3 )
+
+/* Bit definitions used in the ucStatus member of a timer structure. */
+#define tmrSTATUS_IS_ACTIVE					( ( uint8_t ) 0x01 )
+#define tmrSTATUS_IS_STATICALLY_ALLOCATED	( ( uint8_t ) 0x02 )
+#define tmrSTATUS_IS_AUTORELOAD				( ( uint8_t ) 0x04 )
+
+/* Wheel geometry.  Each level has 64 slots, one bit of a 64-bit occupancy
+mask each, and there are enough levels to cover the whole tick count range. */
+#define tmrWHEEL_SLOT_BITS					( 6U )
+#define tmrWHEEL_SLOTS						( 1U << tmrWHEEL_SLOT_BITS )
+#define tmrWHEEL_SLOT_MASK					( tmrWHEEL_SLOTS - 1U )
+#define tmrWHEEL_LEVELS						( ( ( sizeof( TickType_t ) * 8U ) + tmrWHEEL_SLOT_BITS - 1U ) / tmrWHEEL_SLOT_BITS )
+
+/* The longest timer period.  Expiry times further ahead than this are taken to
+be in the past. */
+#define tmrMAX_PERIOD						( portMAX_DELAY >> 1 )
+
+/* The longest time the timer service task blocks for.  Limiting it keeps the
+wheel time within tmrMAX_SLEEP of the tick count, so the distance from the
+wheel time to any expiry time always fits in a TickType_t. */
+#define tmrMAX_SLEEP						( portMAX_DELAY >> 2 )
+
+/* The definition of the timers themselves.  The layout must match
+StaticTimer_t in FreeRTOS.h. */
+typedef struct tmrTimerControl /* The old naming convention is used to prevent breaking kernel aware debuggers. */
+{
+	const char				*pcTimerName;		/*<< Text name.  This is not used by the kernel, it is included simply to make debugging easier. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	struct tmrTimerControl	*pxNext;			/*<< The next timer in the same wheel slot. */
+	struct tmrTimerControl	**ppxPrev;			/*<< The pointer that points to this timer, either the slot or pxNext of the previous timer. */
+	TickType_t				xExpiryTime;		/*<< The tick at which the timer expires next. */
+	TickType_t				xTimerPeriodInTicks;/*<< How quickly and often the timer expires. */
+	void 					*pvTimerID;			/*<< An ID to identify the timer.  This allows the timer to be identified when the same callback is used for multiple timers. */
+	TimerCallbackFunction_t	pxCallbackFunction;	/*<< The function that will be called when the timer expires. */
+	#if( configUSE_TRACE_FACILITY == 1 )
+		UBaseType_t			uxTimerNumber;		/*<< An ID assigned by trace tools such as FreeRTOS+Trace */
+	#endif
+	uint16_t				usSlot;				/*<< The wheel slot the timer was last inserted in, level * tmrWHEEL_SLOTS + index. */
+	uint8_t 				ucStatus;			/*<< Holds bits to say if the timer was statically allocated or not, and if it is active or not. */
+} xTIMER;
+
+/* The old xTIMER name is maintained above then typedefed to the new Timer_t
+name below to enable the use of older kernel aware debuggers. */
+typedef xTIMER Timer_t;
+
+/* The definition of messages that can be sent and received on the timer queue.
+Only deletes, pended function calls and wake ups are sent to the timer service
+task, all other commands are applied to the wheel directly. */
+typedef struct tmrTimerParameters
+{
+	TickType_t			xMessageValue;		/*<< An optional value used by a subset of commands, for example, when changing the period of a timer. */
+	Timer_t *			pxTimer;			/*<< The timer to which the command will be applied. */
+} TimerParameter_t;
+
+
+typedef struct tmrCallbackParameters
+{
+	PendedFunction_t	pxCallbackFunction;	/* << The callback function to execute. */
+	void *pvParameter1;						/* << The value that will be used as the callback functions first parameter. */
+	uint32_t ulParameter2;					/* << The value that will be used as the callback functions second parameter. */
+} CallbackParameters_t;
+
+/* The structure that contains the two message types, along with an identifier
+that is used to determine which message type is valid. */
+typedef struct tmrTimerQueueMessage
+{
+	BaseType_t			xMessageID;			/*<< The command being sent to the timer service task. */
+	union
+	{
+		TimerParameter_t xTimerParameters;
+
+		/* Don't include xCallbackParameters if it is not going to be used as
+		it makes the structure (and therefore the timer queue) larger. */
+		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+			CallbackParameters_t xCallbackParameters;
+		#endif /* INCLUDE_xTimerPendFunctionCall */
+	} u;
+} DaemonTaskMessage_t;
+
+/*lint -save -e956 A manual analysis and inspection has been used to determine
+which static variables must be declared volatile. */
+
+/* The wheel.  Each slot is the head of a linked list of timers, a bit is set
+in the level's occupancy mask for each slot that is not empty.  All accesses
+are made from within a critical section. */
+PRIVILEGED_DATA static Timer_t *pxWheel[ tmrWHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+PRIVILEGED_DATA static uint64_t ullWheelOccupied[ tmrWHEEL_LEVELS ];
+
+/* The first tick the timer service task has not processed yet.  Timers are
+placed in the wheel relative to this time. */
+PRIVILEGED_DATA static TickType_t xWheelTime = ( TickType_t ) configINITIAL_TICK_COUNT;
+
+/* Set while the timer service task is blocked on the timer queue, together
+with the tick it is blocked until. */
+PRIVILEGED_DATA static BaseType_t xDaemonBlocked = pdFALSE;
+PRIVILEGED_DATA static TickType_t xDaemonWakeTime = ( TickType_t ) 0U;
+
+/* A queue that is used to send commands to the timer service task. */
+PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
+PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
+
+/*lint -restore */
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	/* If static allocation is supported then the application must provide the
+	following callback function - which enables the application to optionally
+	provide the memory that will be used by the timer task as the task's stack
+	and TCB. */
+	extern void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize );
+
+#endif
+
+/*
+ * Initialise the infrastructure used by the timer service task if it has not
+ * been initialised already.
+ */
+static void prvCheckForValidListAndQueue( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * The timer service task (daemon).  Expires the timers in the wheel and
+ * processes the commands received on the xTimerQueue queue.
+ */
+static portTASK_FUNCTION_PROTO( prvTimerTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the timer service task to interpret and process a command it
+ * received on the timer queue.
+ */
+static void prvProcessReceivedCommand( const DaemonTaskMessage_t * const pxMessage ) PRIVILEGED_FUNCTION;
+
+/*
+ * Advance the wheel up to and including xTimeNow, cascading the higher levels
+ * and calling the callbacks of the timers that expire on the way.  Only called
+ * by the timer service task.
+ */
+static void prvProcessWheel( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Apply a start, reset, stop or change period command to the wheel.  Called
+ * from within a critical section.  Returns pdTRUE if the timer service task
+ * has to be woken to process the timer in time.
+ */
+static BaseType_t prvApplyCommand( Timer_t * const pxTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert the timer into the wheel slot of its xExpiryTime and return the
+ * number of ticks from xWheelTime to that slot.  Called from within a critical
+ * section.
+ */
+static TickType_t prvWheelInsert( Timer_t * const pxTimer, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove the timer from the slot, or the detached slot list, it is in.  Called
+ * from within a critical section.
+ */
+static void prvWheelRemove( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move the timers of a slot to the list *ppxList, leaving the slot empty.
+ * Called from within a critical section.
+ */
+static void prvWheelDetachSlot( const UBaseType_t uxLevel, const UBaseType_t uxIndex, Timer_t **ppxList ) PRIVILEGED_FUNCTION;
+
+/*
+ * The number of ticks from xWheelTime to the first tick at which the timer
+ * service task has something to do, either a level 0 slot to expire or a
+ * higher level slot to cascade.  portMAX_DELAY if the wheel is empty.  Called
+ * from within a critical section.
+ */
+static TickType_t prvWheelNextEventDelay( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called after a Timer_t structure has been allocated either statically or
+ * dynamically to fill in the structure's members.
+ */
+static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+									const TickType_t xTimerPeriodInTicks,
+									const UBaseType_t uxAutoReload,
+									void * const pvTimerID,
+									TimerCallbackFunction_t pxCallbackFunction,
+									Timer_t *pxNewTimer ) PRIVILEGED_FUNCTION;
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerCreateTimerTask( void )
+{
+BaseType_t xReturn = pdFAIL;
+
+	/* This function is called when the scheduler is started if
+	configUSE_TIMERS is set to 1.  Check that the infrastructure used by the
+	timer service task has been created/initialised.  If timers have already
+	been created then the initialisation will already have been performed. */
+	prvCheckForValidListAndQueue();
+
+	if( xTimerQueue != NULL )
+	{
+		#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+			StaticTask_t *pxTimerTaskTCBBuffer = NULL;
+			StackType_t *pxTimerTaskStackBuffer = NULL;
+			uint32_t ulTimerTaskStackSize;
+
+			vApplicationGetTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &ulTimerTaskStackSize );
+			xTimerTaskHandle = xTaskCreateStatic(	prvTimerTask,
+													configTIMER_SERVICE_TASK_NAME,
+													ulTimerTaskStackSize,
+													NULL,
+													( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+													pxTimerTaskStackBuffer,
+													pxTimerTaskTCBBuffer );
+
+			if( xTimerTaskHandle != NULL )
+			{
+				xReturn = pdPASS;
+			}
+		}
+		#else
+		{
+			xReturn = xTaskCreate(	prvTimerTask,
+									configTIMER_SERVICE_TASK_NAME,
+									configTIMER_TASK_STACK_DEPTH,
+									NULL,
+									( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+									&xTimerTaskHandle );
+		}
+		#endif /* configSUPPORT_STATIC_ALLOCATION */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	configASSERT( xReturn );
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	TimerHandle_t xTimerCreate(	const char * const pcTimerName,			/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+								const TickType_t xTimerPeriodInTicks,
+								const UBaseType_t uxAutoReload,
+								void * const pvTimerID,
+								TimerCallbackFunction_t pxCallbackFunction )
+	{
+	Timer_t *pxNewTimer;
+
+		pxNewTimer = ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of Timer_t is always a pointer to the timer's mame. */
+
+		if( pxNewTimer != NULL )
+		{
+			/* Status is thus far zero as the timer is not created statically
+			and has not been started.  The autoreload bit may get set in
+			prvInitialiseNewTimer. */
+			pxNewTimer->ucStatus = 0x00;
+			prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer );
+		}
+		else
+		{
+			traceTIMER_CREATE_FAILED();
+		}
+
+		return pxNewTimer;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	TimerHandle_t xTimerCreateStatic(	const char * const pcTimerName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+										const TickType_t xTimerPeriodInTicks,
+										const UBaseType_t uxAutoReload,
+										void * const pvTimerID,
+										TimerCallbackFunction_t pxCallbackFunction,
+										StaticTimer_t *pxTimerBuffer )
+	{
+	Timer_t *pxNewTimer;
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticTimer_t equals the size of the real timer
+			structure. */
+			volatile size_t xSize = sizeof( StaticTimer_t );
+			configASSERT( xSize == sizeof( Timer_t ) );
+			( void ) xSize; /* Keeps lint quiet when configASSERT() is not defined. */
+		}
+		#endif /* configASSERT_DEFINED */
+
+		/* A pointer to a StaticTimer_t structure MUST be provided, use it. */
+		configASSERT( pxTimerBuffer );
+		pxNewTimer = ( Timer_t * ) pxTimerBuffer; /*lint !e740 !e9087 StaticTimer_t is a pointer to a Timer_t, so guaranteed to be aligned and sized correctly (checked by an assert()), so this is safe. */
+
+		if( pxNewTimer != NULL )
+		{
+			/* Timers can be created statically or dynamically so note this
+			timer was created statically in case it is later deleted.  The
+			autoreload bit may get set in prvInitialiseNewTimer(). */
+			pxNewTimer->ucStatus = tmrSTATUS_IS_STATICALLY_ALLOCATED;
+
+			prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer );
+		}
+
+		return pxNewTimer;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+									const TickType_t xTimerPeriodInTicks,
+									const UBaseType_t uxAutoReload,
+									void * const pvTimerID,
+									TimerCallbackFunction_t pxCallbackFunction,
+									Timer_t *pxNewTimer )
+{
+	/* 0 is not a valid value for xTimerPeriodInTicks, and the wheel does not
+	take periods of more than half the tick count range. */
+	configASSERT( ( xTimerPeriodInTicks > 0 ) );
+	configASSERT( ( xTimerPeriodInTicks <= tmrMAX_PERIOD ) );
+
+	if( pxNewTimer != NULL )
+	{
+		/* Ensure the infrastructure used by the timer service task has been
+		created/initialised. */
+		prvCheckForValidListAndQueue();
+
+		/* Initialise the timer structure members using the function
+		parameters. */
+		pxNewTimer->pcTimerName = pcTimerName;
+		pxNewTimer->pxNext = NULL;
+		pxNewTimer->ppxPrev = NULL;
+		pxNewTimer->xExpiryTime = ( TickType_t ) 0U;
+		pxNewTimer->xTimerPeriodInTicks = xTimerPeriodInTicks;
+		pxNewTimer->pvTimerID = pvTimerID;
+		pxNewTimer->pxCallbackFunction = pxCallbackFunction;
+		pxNewTimer->usSlot = 0U;
+		if( uxAutoReload != pdFALSE )
+		{
+			pxNewTimer->ucStatus |= tmrSTATUS_IS_AUTORELOAD;
+		}
+		traceTIMER_CREATE( pxNewTimer );
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerGenericCommand( TimerHandle_t xTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait )
+{
+BaseType_t xReturn = pdFAIL;
+BaseType_t xWakeDaemon;
+DaemonTaskMessage_t xMessage;
+TickType_t xTimeNow;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( xTimer );
+
+	if( xTimerQueue != NULL )
+	{
+		xMessage.xMessageID = xCommandID;
+		xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
+		xMessage.u.xTimerParameters.pxTimer = xTimer;
+
+		if( xCommandID == tmrCOMMAND_DELETE )
+		{
+			/* The timer is freed by the timer service task, as it may be
+			executing the timer's callback at this moment. */
+			if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+			{
+				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+			}
+			else
+			{
+				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+			}
+		}
+		else if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+		{
+			xTimeNow = xTaskGetTickCount();
+
+			taskENTER_CRITICAL();
+			{
+				xWakeDaemon = prvApplyCommand( xTimer, xCommandID, xOptionalValue, xTimeNow );
+			}
+			taskEXIT_CRITICAL();
+
+			if( xWakeDaemon != pdFALSE )
+			{
+				/* If the queue is full the timer service task has messages to
+				process, so will run soon anyway. */
+				xMessage.xMessageID = tmrCOMMAND_WAKE_DAEMON;
+				( void ) xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xTimeNow = xTaskGetTickCountFromISR();
+
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				xWakeDaemon = prvApplyCommand( xTimer, xCommandID, xOptionalValue, xTimeNow );
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+			if( xWakeDaemon != pdFALSE )
+			{
+				xMessage.xMessageID = tmrCOMMAND_WAKE_DAEMON;
+				( void ) xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+			}
+
+			xReturn = pdPASS;
+		}
+
+		traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xTimerGetTimerDaemonTaskHandle( void )
+{
+	/* If xTimerGetTimerDaemonTaskHandle() is called before the scheduler has been
+	started, then xTimerTaskHandle will be NULL. */
+	configASSERT( ( xTimerTaskHandle != NULL ) );
+	return xTimerTaskHandle;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTimerGetPeriod( TimerHandle_t xTimer )
+{
+Timer_t *pxTimer = xTimer;
+
+	configASSERT( xTimer );
+	return pxTimer->xTimerPeriodInTicks;
+}
+/*-----------------------------------------------------------*/
+
+void vTimerSetReloadMode( TimerHandle_t xTimer, const UBaseType_t uxAutoReload )
+{
+Timer_t * pxTimer =  xTimer;
+
+	configASSERT( xTimer );
+	taskENTER_CRITICAL();
+	{
+		if( uxAutoReload != pdFALSE )
+		{
+			pxTimer->ucStatus |= tmrSTATUS_IS_AUTORELOAD;
+		}
+		else
+		{
+			pxTimer->ucStatus &= ~tmrSTATUS_IS_AUTORELOAD;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer )
+{
+Timer_t * pxTimer =  xTimer;
+TickType_t xReturn;
+
+	configASSERT( xTimer );
+	taskENTER_CRITICAL();
+	{
+		xReturn = pxTimer->xExpiryTime;
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+const char * pcTimerGetName( TimerHandle_t xTimer ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+{
+Timer_t *pxTimer = xTimer;
+
+	configASSERT( xTimer );
+	return pxTimer->pcTimerName;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvApplyCommand( Timer_t * const pxTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, const TickType_t xTimeNow )
+{
+BaseType_t xWakeDaemon = pdFALSE;
+TickType_t xDelay;
+
+	traceTIMER_COMMAND_RECEIVED( pxTimer, xCommandID, xOptionalValue );
+
+	switch( xCommandID )
+	{
+		case tmrCOMMAND_START :
+		case tmrCOMMAND_START_FROM_ISR :
+		case tmrCOMMAND_RESET :
+		case tmrCOMMAND_RESET_FROM_ISR :
+		case tmrCOMMAND_START_DONT_TRACE :
+			/* Start or restart a timer, relative to the time the command was
+			issued. */
+			pxTimer->xExpiryTime = xOptionalValue + pxTimer->xTimerPeriodInTicks;
+			break;
+
+		case tmrCOMMAND_CHANGE_PERIOD :
+		case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
+			/* The new period does not really have a reference, and can be
+			longer or shorter than the old one.  The timer is restarted with
+			the new period relative to now. */
+			configASSERT( ( xOptionalValue > 0 ) );
+			configASSERT( ( xOptionalValue <= tmrMAX_PERIOD ) );
+			pxTimer->xTimerPeriodInTicks = xOptionalValue;
+			pxTimer->xExpiryTime = xTimeNow + xOptionalValue;
+			break;
+
+		case tmrCOMMAND_STOP :
+		case tmrCOMMAND_STOP_FROM_ISR :
+			if( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) != 0 )
+			{
+				prvWheelRemove( pxTimer );
+				pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+			}
+			return pdFALSE;
+
+		default	:
+			/* Don't expect to get here. */
+			return pdFALSE;
+	}
+
+	if( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) != 0 )
+	{
+		prvWheelRemove( pxTimer );
+	}
+	pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+	xDelay = prvWheelInsert( pxTimer, xTimeNow );
+
+	/* Wake the timer service task if it would otherwise sleep past the new
+	expiry time.  Clearing xDaemonBlocked means that further commands don't
+	send another message until the task has run. */
+	if( xDaemonBlocked != pdFALSE )
+	{
+		if( xDelay < ( TickType_t ) ( xDaemonWakeTime - xWheelTime ) )
+		{
+			xDaemonBlocked = pdFALSE;
+			xWakeDaemon = pdTRUE;
+		}
+	}
+
+	return xWakeDaemon;
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvWheelInsert( Timer_t * const pxTimer, const TickType_t xTimeNow )
+{
+TickType_t xDelay = pxTimer->xExpiryTime - xWheelTime;
+UBaseType_t uxLevel = 0U;
+UBaseType_t uxIndex;
+Timer_t **ppxSlot;
+
+	/* A timer that is already due goes into the first slot still to be
+	processed.  That is the case when the expiry time is before the tick
+	count, or before the wheel time.  xTimeNow may be read before the
+	timer service task advanced the wheel past it, so the wheel time is
+	checked as well. */
+	if( ( ( TickType_t ) ( pxTimer->xExpiryTime - xTimeNow ) > tmrMAX_PERIOD ) || ( xDelay > tmrMAX_PERIOD ) )
+	{
+		xDelay = ( TickType_t ) 0U;
+	}
+
+	/* The lowest level whose range covers the delay. */
+	while( ( uxLevel < ( tmrWHEEL_LEVELS - 1U ) ) && ( ( xDelay >> ( ( uxLevel + 1U ) * tmrWHEEL_SLOT_BITS ) ) != 0U ) )
+	{
+		uxLevel++;
+	}
+
+	uxIndex = ( UBaseType_t ) ( ( TickType_t ) ( xWheelTime + xDelay ) >> ( uxLevel * tmrWHEEL_SLOT_BITS ) ) & tmrWHEEL_SLOT_MASK;
+	ppxSlot = &( pxWheel[ uxLevel ][ uxIndex ] );
+
+	pxTimer->pxNext = *ppxSlot;
+	if( pxTimer->pxNext != NULL )
+	{
+		pxTimer->pxNext->ppxPrev = &( pxTimer->pxNext );
+	}
+	pxTimer->ppxPrev = ppxSlot;
+	*ppxSlot = pxTimer;
+
+	pxTimer->usSlot = ( uint16_t ) ( ( uxLevel << tmrWHEEL_SLOT_BITS ) | uxIndex );
+	ullWheelOccupied[ uxLevel ] |= ( ( uint64_t ) 1U ) << uxIndex;
+
+	return xDelay;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWheelRemove( Timer_t * const pxTimer )
+{
+UBaseType_t uxLevel = ( UBaseType_t ) pxTimer->usSlot >> tmrWHEEL_SLOT_BITS;
+UBaseType_t uxIndex = ( UBaseType_t ) pxTimer->usSlot & tmrWHEEL_SLOT_MASK;
+
+	*( pxTimer->ppxPrev ) = pxTimer->pxNext;
+	if( pxTimer->pxNext != NULL )
+	{
+		pxTimer->pxNext->ppxPrev = pxTimer->ppxPrev;
+	}
+	pxTimer->pxNext = NULL;
+	pxTimer->ppxPrev = NULL;
+
+	/* The timer may have been in a list detached by the timer service task,
+	in which case the slot is already empty or holds other timers. */
+	if( pxWheel[ uxLevel ][ uxIndex ] == NULL )
+	{
+		ullWheelOccupied[ uxLevel ] &= ~( ( ( uint64_t ) 1U ) << uxIndex );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWheelDetachSlot( const UBaseType_t uxLevel, const UBaseType_t uxIndex, Timer_t **ppxList )
+{
+	*ppxList = pxWheel[ uxLevel ][ uxIndex ];
+	if( *ppxList != NULL )
+	{
+		( *ppxList )->ppxPrev = ppxList;
+	}
+	pxWheel[ uxLevel ][ uxIndex ] = NULL;
+	ullWheelOccupied[ uxLevel ] &= ~( ( ( uint64_t ) 1U ) << uxIndex );
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvWheelNextEventDelay( void )
+{
+TickType_t xDelay = portMAX_DELAY;
+TickType_t xPeriod, xCandidate;
+UBaseType_t uxLevel, uxShift, uxStart, uxFirst;
+uint64_t ullPending;
+
+	for( uxLevel = 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+	{
+		if( ullWheelOccupied[ uxLevel ] == 0U )
+		{
+			continue;
+		}
+
+		/* The slot of the wheel time's own period is only still to be
+		processed if the wheel time is at the start of that period, otherwise
+		the search starts at the next slot.  Slots are searched in time order
+		by rotating the occupancy mask. */
+		uxShift = uxLevel * tmrWHEEL_SLOT_BITS;
+		xPeriod = xWheelTime >> uxShift;
+		if( ( xWheelTime & ( ( ( TickType_t ) 1U << uxShift ) - 1U ) ) != 0U )
+		{
+			xPeriod++;
+		}
+
+		uxStart = ( UBaseType_t ) xPeriod & tmrWHEEL_SLOT_MASK;
+		ullPending = ullWheelOccupied[ uxLevel ];
+		if( uxStart != 0U )
+		{
+			ullPending = ( ullPending >> uxStart ) | ( ullPending << ( tmrWHEEL_SLOTS - uxStart ) );
+		}
+		uxFirst = ( UBaseType_t ) __builtin_ctzll( ullPending );
+
+		xCandidate = ( TickType_t ) ( ( TickType_t ) ( xPeriod + uxFirst ) << uxShift ) - xWheelTime;
+		if( xCandidate < xDelay )
+		{
+			xDelay = xCandidate;
+		}
+	}
+
+	return xDelay;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessWheel( const TickType_t xTimeNow )
+{
+Timer_t *pxList;
+Timer_t *pxTimer;
+TickType_t xTick, xDelay;
+UBaseType_t uxLevel, uxShift;
+
+	for( ;; )
+	{
+		/* Skip straight to the next tick that has a slot to expire or to
+		cascade, if that is no later than xTimeNow. */
+		taskENTER_CRITICAL();
+		{
+			xDelay = prvWheelNextEventDelay();
+			if( xDelay >= ( TickType_t ) ( xTimeNow + 1U - xWheelTime ) )
+			{
+				xWheelTime = xTimeNow + 1U;
+				xDelay = portMAX_DELAY;
+			}
+			else
+			{
+				xWheelTime += xDelay;
+			}
+			xTick = xWheelTime;
+		}
+		taskEXIT_CRITICAL();
+
+		if( xDelay == portMAX_DELAY )
+		{
+			break;
+		}
+
+		/* At the start of a period of level 1 and above move the timers of
+		the slot for that period down.  Each timer is moved in its own
+		critical section to keep the interrupt latency low, the detached list
+		is kept consistent in between so commands can still be applied to the
+		timers in it. */
+		for( uxLevel = 1U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+		{
+			uxShift = uxLevel * tmrWHEEL_SLOT_BITS;
+			if( ( xTick & ( ( ( TickType_t ) 1U << uxShift ) - 1U ) ) != 0U )
+			{
+				break;
+			}
+
+			taskENTER_CRITICAL();
+			{
+				prvWheelDetachSlot( uxLevel, ( UBaseType_t ) ( xTick >> uxShift ) & tmrWHEEL_SLOT_MASK, &pxList );
+			}
+			taskEXIT_CRITICAL();
+
+			do
+			{
+				taskENTER_CRITICAL();
+				{
+					pxTimer = pxList;
+					if( pxTimer != NULL )
+					{
+						prvWheelRemove( pxTimer );
+						( void ) prvWheelInsert( pxTimer, xTimeNow );
+					}
+				}
+				taskEXIT_CRITICAL();
+			} while( pxTimer != NULL );
+		}
+
+		/* Expire the timers of the level 0 slot for this tick. */
+		taskENTER_CRITICAL();
+		{
+			prvWheelDetachSlot( 0U, ( UBaseType_t ) xTick & tmrWHEEL_SLOT_MASK, &pxList );
+			xWheelTime = xTick + 1U;
+		}
+		taskEXIT_CRITICAL();
+
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				pxTimer = pxList;
+				if( pxTimer != NULL )
+				{
+					prvWheelRemove( pxTimer );
+
+					/* An auto reload timer is reloaded relative to when it
+					should have expired, so it keeps its phase. */
+					if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+					{
+						pxTimer->xExpiryTime += pxTimer->xTimerPeriodInTicks;
+						( void ) prvWheelInsert( pxTimer, xTimeNow );
+					}
+					else
+					{
+						pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( pxTimer == NULL )
+			{
+				break;
+			}
+
+			/* Call the timer callback. */
+			traceTIMER_EXPIRED( pxTimer );
+			pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvTimerTask, pvParameters )
+{
+DaemonTaskMessage_t xMessage;
+TickType_t xDelay, xTicksToWait;
+
+	/* Just to avoid compiler warnings. */
+	( void ) pvParameters;
+
+	#if( configUSE_DAEMON_TASK_STARTUP_HOOK == 1 )
+	{
+		extern void vApplicationDaemonTaskStartupHook( void );
+
+		/* Allow the application writer to execute some code in the context of
+		this task at the point the task starts executing.  This is useful if the
+		application includes initialisation code that would benefit from
+		executing after the scheduler has been started. */
+		vApplicationDaemonTaskStartupHook();
+	}
+	#endif /* configUSE_DAEMON_TASK_STARTUP_HOOK */
+
+	for( ;; )
+	{
+		/* Expire everything that is due. */
+		prvProcessWheel( xTaskGetTickCount() );
+
+		/* Work out when there is something to do next.  From here on a
+		command that needs the task earlier sends it a message. */
+		taskENTER_CRITICAL();
+		{
+			xDelay = prvWheelNextEventDelay();
+			if( xDelay > tmrMAX_SLEEP )
+			{
+				xDelay = tmrMAX_SLEEP;
+			}
+			xDaemonWakeTime = xWheelTime + xDelay;
+			xDaemonBlocked = pdTRUE;
+		}
+		taskEXIT_CRITICAL();
+
+		xTicksToWait = xDaemonWakeTime - xTaskGetTickCount();
+		if( xTicksToWait > tmrMAX_PERIOD )
+		{
+			/* The wake time has passed already. */
+			xTicksToWait = tmrNO_DELAY;
+		}
+
+		if( xQueueReceive( xTimerQueue, &xMessage, xTicksToWait ) != pdFAIL )
+		{
+			xDaemonBlocked = pdFALSE;
+
+			do
+			{
+				prvProcessReceivedCommand( &xMessage );
+			} while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL );
+		}
+		else
+		{
+			xDaemonBlocked = pdFALSE;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessReceivedCommand( const DaemonTaskMessage_t * const pxMessage )
+{
+Timer_t *pxTimer;
+
+	#if ( INCLUDE_xTimerPendFunctionCall == 1 )
+	{
+		/* Negative commands are pended function calls rather than timer
+		commands. */
+		if( ( pxMessage->xMessageID == tmrCOMMAND_EXECUTE_CALLBACK ) || ( pxMessage->xMessageID == tmrCOMMAND_EXECUTE_CALLBACK_FROM_ISR ) )
+		{
+			const CallbackParameters_t * const pxCallback = &( pxMessage->u.xCallbackParameters );
+
+			/* The timer uses the xCallbackParameters member to request a
+			callback be executed.  Check the callback is not NULL. */
+			configASSERT( pxCallback );
+
+			/* Call the function. */
+			pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
+			return;
+		}
+	}
+	#endif /* INCLUDE_xTimerPendFunctionCall */
+
+	if( pxMessage->xMessageID == tmrCOMMAND_DELETE )
+	{
+		pxTimer = pxMessage->u.xTimerParameters.pxTimer;
+		traceTIMER_COMMAND_RECEIVED( pxTimer, pxMessage->xMessageID, pxMessage->u.xTimerParameters.xMessageValue );
+
+		taskENTER_CRITICAL();
+		{
+			if( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) != 0 )
+			{
+				prvWheelRemove( pxTimer );
+				pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* The timer has already been removed from the wheel, free the memory
+		if it was dynamically allocated. */
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+			{
+				vPortFree( pxTimer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+	}
+	else
+	{
+		/* tmrCOMMAND_WAKE_DAEMON, nothing to do but to run the loop of the
+		timer service task again. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckForValidListAndQueue( void )
+{
+	/* Check that the queue used to communicate with the timer service task
+	has been initialised.  The wheel itself is statically initialised. */
+	taskENTER_CRITICAL();
+	{
+		if( xTimerQueue == NULL )
+		{
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				/* The timer queue is allocated statically in case
+				configSUPPORT_DYNAMIC_ALLOCATION is 0. */
+				static StaticQueue_t xStaticTimerQueue; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+				static uint8_t ucStaticTimerQueueStorage[ ( size_t ) configTIMER_QUEUE_LENGTH * sizeof( DaemonTaskMessage_t ) ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+
+				xTimerQueue = xQueueCreateStatic( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ), &( ucStaticTimerQueueStorage[ 0 ] ), &xStaticTimerQueue );
+			}
+			#else
+			{
+				xTimerQueue = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, sizeof( DaemonTaskMessage_t ) );
+			}
+			#endif
+
+			#if ( configQUEUE_REGISTRY_SIZE > 0 )
+			{
+				if( xTimerQueue != NULL )
+				{
+					vQueueAddToRegistry( xTimerQueue, "TmrQ" );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configQUEUE_REGISTRY_SIZE */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerIsTimerActive( TimerHandle_t xTimer )
+{
+BaseType_t xReturn;
+Timer_t *pxTimer = xTimer;
+
+	configASSERT( xTimer );
+
+	/* Is the timer in the wheel? */
+	taskENTER_CRITICAL();
+	{
+		if( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) == 0 )
+		{
+			xReturn = pdFALSE;
+		}
+		else
+		{
+			xReturn = pdTRUE;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+} /*lint !e818 Can't be pointer to const due to the typedef. */
+/*-----------------------------------------------------------*/
+void *pvTimerGetTimerID( const TimerHandle_t xTimer )
+{
+Timer_t * const pxTimer = xTimer;
+void *pvReturn;
+
+	configASSERT( xTimer );
+
+	taskENTER_CRITICAL();
+	{
+		pvReturn = pxTimer->pvTimerID;
+	}
+	taskEXIT_CRITICAL();
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTimerSetTimerID( TimerHandle_t xTimer, void *pvNewID )
+{
+Timer_t * const pxTimer = xTimer;
+
+	configASSERT( xTimer );
+
+	taskENTER_CRITICAL();
+	{
+		pxTimer->pvTimerID = pvNewID;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+#if( INCLUDE_xTimerPendFunctionCall == 1 )
+
+	BaseType_t xTimerPendFunctionCallFromISR( PendedFunction_t xFunctionToPend, void *pvParameter1, uint32_t ulParameter2, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	DaemonTaskMessage_t xMessage;
+	BaseType_t xReturn;
+
+		/* Complete the message with the function parameters and post it to the
+		daemon task. */
+		xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK_FROM_ISR;
+		xMessage.u.xCallbackParameters.pxCallbackFunction = xFunctionToPend;
+		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
+		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
+
+		xReturn = xQueueSendFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+
+		tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
+
+		return xReturn;
+	}
+
+#endif /* INCLUDE_xTimerPendFunctionCall */
+/*-----------------------------------------------------------*/
+
+#if( INCLUDE_xTimerPendFunctionCall == 1 )
+
+	BaseType_t xTimerPendFunctionCall( PendedFunction_t xFunctionToPend, void *pvParameter1, uint32_t ulParameter2, TickType_t xTicksToWait )
+	{
+	DaemonTaskMessage_t xMessage;
+	BaseType_t xReturn;
+
+		/* This function can only be called after a timer has been created or
+		after the scheduler has been started because, until then, the timer
+		queue does not exist. */
+		configASSERT( xTimerQueue );
+
+		/* Complete the message with the function parameters and post it to the
+		daemon task. */
+		xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK;
+		xMessage.u.xCallbackParameters.pxCallbackFunction = xFunctionToPend;
+		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
+		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
+
+		xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+
+		tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
+
+		return xReturn;
+	}
+
+#endif /* INCLUDE_xTimerPendFunctionCall */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	UBaseType_t uxTimerGetTimerNumber( TimerHandle_t xTimer )
+	{
+		return ( ( Timer_t * ) xTimer )->uxTimerNumber;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	void vTimerSetTimerNumber( TimerHandle_t xTimer, UBaseType_t uxTimerNumber )
+	{
+		( ( Timer_t * ) xTimer )->uxTimerNumber = uxTimerNumber;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to use the timing wheel implementation of the software timers. */
+#endif /* ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_WHEEL == 1 ) */
+
+
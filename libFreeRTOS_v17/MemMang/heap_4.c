@@ -45,6 +45,9 @@ task.h is included from an application file. */
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* heap_tlsf.c is used instead. */
+#if( configUSE_TLSF_HEAP == 0 )
+
 #if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
 	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
 #endif
@@ -434,3 +437,4 @@ uint8_t *puc;
 	}
 }
 
+#endif /* configUSE_TLSF_HEAP */
@@ -0,0 +1,742 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * An implementation of pvPortMalloc() and vPortFree() that manages one heap
+ * per memory of the LSP memory map (DRAM0, DRAM1 and system RAM) with a
+ * two level segregated fit (TLSF) allocator.
+ *
+ * Free blocks are kept in size class lists indexed by a first level (power of
+ * two) and a second level (heapSL_COUNT linear steps within the power of two).
+ * Two bitmaps record which lists are non empty, so finding a block and
+ * freeing one (including merging it with its physical neighbours) take a
+ * constant number of steps whatever the number of free blocks.
+ *
+ * pvPortMalloc() places small allocations (kernel objects) in the local data
+ * RAMs and large ones (stacks, buffers) in system RAM, falling back to the
+ * other regions when the preferred ones are full.  pvPortMallocInRegion()
+ * lets the caller choose.  Only used when configUSE_TLSF_HEAP is 1, heap_4.c
+ * is used otherwise.
+ *
+ * See heap_4.c for the general purpose single region implementation, and the
+ * memory management pages of http://www.FreeRTOS.org for more information.
+ */
+#include <stdlib.h>
+#include <stddef.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configUSE_TLSF_HEAP == 1 )
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_DRAM0_SIZE
+	#define configHEAP_DRAM0_SIZE		0
+#endif
+
+#ifndef configHEAP_DRAM1_SIZE
+	#define configHEAP_DRAM1_SIZE		0
+#endif
+
+#ifndef configHEAP_SRAM_SIZE
+	#define configHEAP_SRAM_SIZE		configTOTAL_HEAP_SIZE
+#endif
+
+/* pvPortMalloc() requests up to this size go to the local data RAMs first. */
+#ifndef configHEAP_LOCAL_MAX_SIZE
+	#define configHEAP_LOCAL_MAX_SIZE	1024
+#endif
+
+/* Second level lists per power of two, as log2. */
+#define heapSL_INDEX_LOG2		( 3 )
+#define heapSL_COUNT			( 1 << heapSL_INDEX_LOG2 )
+
+/* Blocks below heapSMALL_BLOCK_SIZE all go to first level 0, split in
+heapSL_COUNT lists of 4 bytes. */
+#define heapFL_INDEX_SHIFT		( heapSL_INDEX_LOG2 + 2 )
+#define heapSMALL_BLOCK_SIZE	( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/* Blocks must be smaller than 1 << heapFL_INDEX_MAX bytes. */
+#define heapFL_INDEX_MAX		( 24 )
+#define heapFL_COUNT			( heapFL_INDEX_MAX - heapFL_INDEX_SHIFT + 1 )
+#define heapMAX_BLOCK_SIZE		( ( ( size_t ) 1 << heapFL_INDEX_MAX ) - portBYTE_ALIGNMENT )
+
+/* Flags kept in the low bits of xBlockSize, which block sizes being multiples
+of portBYTE_ALIGNMENT leave clear. */
+#define heapBLOCK_FREE			( ( size_t ) 1 )
+#define heapPREV_FREE			( ( size_t ) 2 )
+#define heapFLAG_MASK			( heapBLOCK_FREE | heapPREV_FREE )
+
+#define heapREGION_MASK_ALL		( ( 1UL << eHeapRegionCount ) - 1UL )
+
+#define heapFLS( x )			( 31 - __builtin_clz( ( unsigned int ) ( x ) ) )
+#define heapFFS( x )			( __builtin_ctz( ( unsigned int ) ( x ) ) )
+
+/* Header of every block.  Blocks are laid out back to back in their region,
+the region ends with a zero size sentinel block that is never free.  The free
+list links overlap the payload, so they are only valid while the block is
+free. */
+typedef struct A_TLSF_BLOCK
+{
+	struct A_TLSF_BLOCK *pxPrevPhysBlock;	/*<< The block just below this one in memory. */
+	size_t xBlockSize;						/*<< Size including the header, flags in the low bits. */
+	struct A_TLSF_BLOCK *pxNextFreeBlock;	/*<< The next block in the same free list. */
+	struct A_TLSF_BLOCK *pxPrevFreeBlock;	/*<< The previous block in the same free list. */
+} TLSFBlock_t;
+
+/* Control structure of one region. */
+typedef struct A_TLSF_REGION
+{
+	uint8_t *pucStart;						/*<< First block, NULL if the region has no memory. */
+	uint8_t *pucEnd;						/*<< Sentinel block. */
+	uint32_t ulFLBitmap;					/*<< Bit per first level with a non empty list. */
+	uint32_t ulSLBitmap[ heapFL_COUNT ];	/*<< Bit per non empty second level list. */
+	TLSFBlock_t *pxFreeLists[ heapFL_COUNT ][ heapSL_COUNT ];
+	size_t xTotalBytes;
+	size_t xFreeBytes;
+	size_t xMinimumEverFreeBytes;
+	size_t xNumberOfFreeBlocks;
+	size_t xNumberOfAllocations;
+	size_t xNumberOfFrees;
+} TLSFRegion_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Hands the static region buffers to their regions, the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void );
+
+/*
+ * Sets up pxRegion as a single free block spanning xSize bytes at pvStart.
+ */
+static void prvRegionInit( TLSFRegion_t *pxRegion, void *pvStart, size_t xSize );
+
+/*
+ * Maps a block size to the free list holding it.
+ */
+static void prvMappingInsert( size_t xSize, UBaseType_t *puxFL, UBaseType_t *puxSL );
+
+/*
+ * Links a free block into / out of the free list matching its size.
+ */
+static void prvInsertFreeBlock( TLSFRegion_t *pxRegion, TLSFBlock_t *pxBlock );
+static void prvRemoveFreeBlock( TLSFRegion_t *pxRegion, TLSFBlock_t *pxBlock );
+
+/*
+ * Allocates xBlockSize bytes, header included, from one region.
+ */
+static void *prvRegionMalloc( TLSFRegion_t *pxRegion, size_t xBlockSize );
+
+/*
+ * Returns the region holding pv, NULL if pv is not heap memory.
+ */
+static TLSFRegion_t *prvRegionOf( const void *pv );
+
+/*-----------------------------------------------------------*/
+
+/* Allocate the memory of the regions declared in FreeRTOSConfig.h, in the
+sections the LSP memory map places in each memory.  The sizes may contain
+casts, so unused regions are skipped at run time rather than by the
+preprocessor, at the cost of a byte. */
+#define heapREGION_ARRAY_SIZE( x )	( ( ( x ) > 0 ) ? ( x ) : 1 )
+
+static uint8_t ucHeapDRAM0[ heapREGION_ARRAY_SIZE( configHEAP_DRAM0_SIZE ) ] __attribute__((section(".dram0.data")));
+static uint8_t ucHeapDRAM1[ heapREGION_ARRAY_SIZE( configHEAP_DRAM1_SIZE ) ] __attribute__((section(".dram1.data")));
+static uint8_t ucHeapSRAM[ heapREGION_ARRAY_SIZE( configHEAP_SRAM_SIZE ) ] __attribute__((section(".sram.bss")));
+
+/* The header in front of the payload of allocated blocks, which overlaps the
+free list links of free blocks. */
+static const size_t xHeaderSize = ( offsetof( TLSFBlock_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* Free blocks must hold the full structure. */
+static const size_t xMinimumBlockSize = ( sizeof( TLSFBlock_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+static TLSFRegion_t xRegions[ eHeapRegionCount ];
+static BaseType_t xHeapInitialised = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+static inline TLSFBlock_t *prvNextPhysBlock( const TLSFBlock_t *pxBlock )
+{
+	return ( TLSFBlock_t * ) ( ( ( uint8_t * ) pxBlock ) + ( pxBlock->xBlockSize & ~heapFLAG_MASK ) );
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMallocInRegion( size_t xWantedSize, uint32_t ulHint )
+{
+void *pvReturn = NULL;
+size_t xBlockSize;
+uint32_t ulMask;
+UBaseType_t uxPass, uxRegion;
+
+	/* Work out the size of the block, header included. */
+	if( ( xWantedSize > 0 ) && ( xWantedSize <= heapMAX_BLOCK_SIZE - xHeaderSize ) )
+	{
+		xBlockSize = ( xWantedSize + xHeaderSize + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+		if( xBlockSize < xMinimumBlockSize )
+		{
+			xBlockSize = xMinimumBlockSize;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		xBlockSize = 0;
+	}
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the regions will require
+		initialisation to setup their free lists. */
+		if( xHeapInitialised == pdFALSE )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xBlockSize != 0 )
+		{
+			/* Try the hinted regions first, then unless the hint is strict the
+			others.  Within a pass regions are tried in eHeapRegion order. */
+			ulMask = ulHint & heapREGION_MASK_ALL;
+
+			for( uxPass = 0; ( uxPass < 2 ) && ( pvReturn == NULL ); uxPass++ )
+			{
+				for( uxRegion = 0; ( uxRegion < eHeapRegionCount ) && ( pvReturn == NULL ); uxRegion++ )
+				{
+					if( ( ( ulMask >> uxRegion ) & 1UL ) != 0 )
+					{
+						pvReturn = prvRegionMalloc( &xRegions[ uxRegion ], xBlockSize );
+					}
+				}
+
+				if( ( ulHint & portHEAP_HINT_STRICT ) != 0 )
+				{
+					break;
+				}
+
+				ulMask = ~ulMask & heapREGION_MASK_ALL;
+			}
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+	if( xWantedSize <= configHEAP_LOCAL_MAX_SIZE )
+	{
+		return pvPortMallocInRegion( xWantedSize, portHEAP_HINT_LOCAL );
+	}
+
+	return pvPortMallocInRegion( xWantedSize, portHEAP_HINT_SRAM );
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+TLSFRegion_t *pxRegion;
+TLSFBlock_t *pxBlock, *pxNeighbour;
+
+	if( pv != NULL )
+	{
+		pxBlock = ( TLSFBlock_t * ) ( ( ( uint8_t * ) pv ) - xHeaderSize );
+		pxRegion = prvRegionOf( pv );
+
+		/* Check the block is actually allocated from a heap region. */
+		configASSERT( pxRegion != NULL );
+		configASSERT( ( pxBlock->xBlockSize & heapBLOCK_FREE ) == 0 );
+
+		if( ( pxRegion != NULL ) && ( ( pxBlock->xBlockSize & heapBLOCK_FREE ) == 0 ) )
+		{
+			vTaskSuspendAll();
+			{
+				pxRegion->xFreeBytes += pxBlock->xBlockSize & ~heapFLAG_MASK;
+				pxRegion->xNumberOfFrees++;
+				traceFREE( pv, pxBlock->xBlockSize & ~heapFLAG_MASK );
+
+				/* Merge with the block below if it is free. */
+				if( ( pxBlock->xBlockSize & heapPREV_FREE ) != 0 )
+				{
+					pxNeighbour = pxBlock->pxPrevPhysBlock;
+					prvRemoveFreeBlock( pxRegion, pxNeighbour );
+					pxNeighbour->xBlockSize += pxBlock->xBlockSize & ~heapFLAG_MASK;
+					pxBlock = pxNeighbour;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Merge with the block above if it is free.  The sentinel is
+				never free so this stays within the region. */
+				pxNeighbour = prvNextPhysBlock( pxBlock );
+				if( ( pxNeighbour->xBlockSize & heapBLOCK_FREE ) != 0 )
+				{
+					prvRemoveFreeBlock( pxRegion, pxNeighbour );
+					pxBlock->xBlockSize += pxNeighbour->xBlockSize & ~heapFLAG_MASK;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxBlock->xBlockSize |= heapBLOCK_FREE;
+				pxNeighbour = prvNextPhysBlock( pxBlock );
+				pxNeighbour->pxPrevPhysBlock = pxBlock;
+				pxNeighbour->xBlockSize |= heapPREV_FREE;
+				prvInsertFreeBlock( pxRegion, pxBlock );
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortAddHeapRegion( eHeapRegion eRegion, void *pvStart, size_t xSizeInBytes )
+{
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( eRegion < eHeapRegionCount );
+
+	vTaskSuspendAll();
+	{
+		if( xHeapInitialised == pdFALSE )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* A region spans a single range of memory. */
+		if( ( eRegion < eHeapRegionCount ) && ( xRegions[ eRegion ].pucStart == NULL ) && ( xSizeInBytes >= xHeaderSize + xMinimumBlockSize + portBYTE_ALIGNMENT ) )
+		{
+			prvRegionInit( &xRegions[ eRegion ], pvStart, xSizeInBytes );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapRegionStats( eHeapRegion eRegion, HeapRegionStats_t *pxStats )
+{
+TLSFRegion_t *pxRegion;
+TLSFBlock_t *pxBlock;
+UBaseType_t uxFL, uxSL;
+size_t xLargest = 0;
+
+	configASSERT( eRegion < eHeapRegionCount );
+	configASSERT( pxStats != NULL );
+
+	pxRegion = &xRegions[ eRegion ];
+
+	vTaskSuspendAll();
+	{
+		/* The largest free block is in the highest non empty list.  Blocks of
+		one list differ by less than a second level step, so only that list
+		is searched. */
+		if( pxRegion->ulFLBitmap != 0 )
+		{
+			uxFL = heapFLS( pxRegion->ulFLBitmap );
+			uxSL = heapFLS( pxRegion->ulSLBitmap[ uxFL ] );
+
+			for( pxBlock = pxRegion->pxFreeLists[ uxFL ][ uxSL ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+			{
+				if( ( pxBlock->xBlockSize & ~heapFLAG_MASK ) > xLargest )
+				{
+					xLargest = pxBlock->xBlockSize & ~heapFLAG_MASK;
+				}
+			}
+		}
+
+		pxStats->xTotalBytes = pxRegion->xTotalBytes;
+		pxStats->xFreeBytes = pxRegion->xFreeBytes;
+		pxStats->xMinimumEverFreeBytes = pxRegion->xMinimumEverFreeBytes;
+		pxStats->xLargestFreeBlock = ( xLargest > xHeaderSize ) ? xLargest - xHeaderSize : 0;
+		pxStats->xNumberOfFreeBlocks = pxRegion->xNumberOfFreeBlocks;
+		pxStats->xNumberOfAllocations = pxRegion->xNumberOfAllocations;
+		pxStats->xNumberOfFrees = pxRegion->xNumberOfFrees;
+
+		/* Share of the free memory not usable by a single allocation. */
+		if( pxRegion->xFreeBytes != 0 )
+		{
+			pxStats->uxFragmentation = ( UBaseType_t ) ( 100U - ( ( ( uint64_t ) xLargest * 100U ) / pxRegion->xFreeBytes ) );
+		}
+		else
+		{
+			pxStats->uxFragmentation = 0;
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+size_t xFree = 0;
+UBaseType_t uxRegion;
+
+	for( uxRegion = 0; uxRegion < eHeapRegionCount; uxRegion++ )
+	{
+		xFree += xRegions[ uxRegion ].xFreeBytes;
+	}
+
+	return xFree;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+size_t xFree = 0;
+UBaseType_t uxRegion;
+
+	/* Sum of the per region minimums, which may have been reached at
+	different times. */
+	for( uxRegion = 0; uxRegion < eHeapRegionCount; uxRegion++ )
+	{
+		xFree += xRegions[ uxRegion ].xMinimumEverFreeBytes;
+	}
+
+	return xFree;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+	xHeapInitialised = pdTRUE;
+
+	if( configHEAP_DRAM0_SIZE > 0 )
+	{
+		prvRegionInit( &xRegions[ eHeapRegionDRAM0 ], ucHeapDRAM0, sizeof( ucHeapDRAM0 ) );
+	}
+
+	if( configHEAP_DRAM1_SIZE > 0 )
+	{
+		prvRegionInit( &xRegions[ eHeapRegionDRAM1 ], ucHeapDRAM1, sizeof( ucHeapDRAM1 ) );
+	}
+
+	if( configHEAP_SRAM_SIZE > 0 )
+	{
+		prvRegionInit( &xRegions[ eHeapRegionSRAM ], ucHeapSRAM, sizeof( ucHeapSRAM ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRegionInit( TLSFRegion_t *pxRegion, void *pvStart, size_t xSize )
+{
+TLSFBlock_t *pxFirstFreeBlock, *pxSentinel;
+size_t uxAddress, uxEnd;
+
+	/* Ensure the region starts and ends on correctly aligned boundaries. */
+	uxAddress = ( ( size_t ) pvStart + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	uxEnd = ( ( size_t ) pvStart + xSize - xHeaderSize ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+	/* Larger regions are only used up to the largest block size. */
+	if( uxEnd - uxAddress > heapMAX_BLOCK_SIZE )
+	{
+		uxEnd = uxAddress + heapMAX_BLOCK_SIZE;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxFirstFreeBlock = ( TLSFBlock_t * ) uxAddress;
+	pxFirstFreeBlock->pxPrevPhysBlock = NULL;
+	pxFirstFreeBlock->xBlockSize = ( uxEnd - uxAddress ) | heapBLOCK_FREE;
+
+	/* The sentinel only has the header fields allocated blocks have. */
+	pxSentinel = ( TLSFBlock_t * ) uxEnd;
+	pxSentinel->pxPrevPhysBlock = pxFirstFreeBlock;
+	pxSentinel->xBlockSize = heapPREV_FREE;
+
+	pxRegion->pucStart = ( uint8_t * ) uxAddress;
+	pxRegion->pucEnd = ( uint8_t * ) uxEnd;
+	pxRegion->xTotalBytes = uxEnd - uxAddress;
+	pxRegion->xFreeBytes = pxRegion->xTotalBytes;
+	pxRegion->xMinimumEverFreeBytes = pxRegion->xTotalBytes;
+
+	prvInsertFreeBlock( pxRegion, pxFirstFreeBlock );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xSize, UBaseType_t *puxFL, UBaseType_t *puxSL )
+{
+UBaseType_t uxFL;
+
+	if( xSize < heapSMALL_BLOCK_SIZE )
+	{
+		*puxFL = 0;
+		*puxSL = ( UBaseType_t ) ( xSize >> 2 );
+	}
+	else
+	{
+		uxFL = ( UBaseType_t ) heapFLS( xSize );
+		*puxSL = ( UBaseType_t ) ( ( xSize >> ( uxFL - heapSL_INDEX_LOG2 ) ) ^ heapSL_COUNT );
+		*puxFL = uxFL - ( heapFL_INDEX_SHIFT - 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( TLSFRegion_t *pxRegion, TLSFBlock_t *pxBlock )
+{
+UBaseType_t uxFL, uxSL;
+TLSFBlock_t *pxHead;
+
+	prvMappingInsert( pxBlock->xBlockSize & ~heapFLAG_MASK, &uxFL, &uxSL );
+
+	pxHead = pxRegion->pxFreeLists[ uxFL ][ uxSL ];
+	pxBlock->pxNextFreeBlock = pxHead;
+	pxBlock->pxPrevFreeBlock = NULL;
+
+	if( pxHead != NULL )
+	{
+		pxHead->pxPrevFreeBlock = pxBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxRegion->pxFreeLists[ uxFL ][ uxSL ] = pxBlock;
+	pxRegion->ulFLBitmap |= 1UL << uxFL;
+	pxRegion->ulSLBitmap[ uxFL ] |= 1UL << uxSL;
+	pxRegion->xNumberOfFreeBlocks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( TLSFRegion_t *pxRegion, TLSFBlock_t *pxBlock )
+{
+UBaseType_t uxFL, uxSL;
+
+	prvMappingInsert( pxBlock->xBlockSize & ~heapFLAG_MASK, &uxFL, &uxSL );
+
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock->pxPrevFreeBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlock->pxPrevFreeBlock != NULL )
+	{
+		pxBlock->pxPrevFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+	}
+	else
+	{
+		/* The block was the head of its list. */
+		pxRegion->pxFreeLists[ uxFL ][ uxSL ] = pxBlock->pxNextFreeBlock;
+
+		if( pxBlock->pxNextFreeBlock == NULL )
+		{
+			pxRegion->ulSLBitmap[ uxFL ] &= ~( 1UL << uxSL );
+
+			if( pxRegion->ulSLBitmap[ uxFL ] == 0 )
+			{
+				pxRegion->ulFLBitmap &= ~( 1UL << uxFL );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	pxRegion->xNumberOfFreeBlocks--;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvRegionMalloc( TLSFRegion_t *pxRegion, size_t xBlockSize )
+{
+TLSFBlock_t *pxBlock, *pxNewBlock;
+UBaseType_t uxFL, uxSL;
+uint32_t ulMap;
+size_t xRoundedSize, xRemaining;
+
+	if( ( pxRegion->pucStart == NULL ) || ( xBlockSize > pxRegion->xFreeBytes ) )
+	{
+		return NULL;
+	}
+
+	/* Round the size up to the next list boundary, so any block of the list
+	found is large enough. */
+	xRoundedSize = xBlockSize;
+	if( xBlockSize >= heapSMALL_BLOCK_SIZE )
+	{
+		xRoundedSize += ( ( size_t ) 1 << ( heapFLS( xBlockSize ) - heapSL_INDEX_LOG2 ) ) - 1;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xRoundedSize > heapMAX_BLOCK_SIZE )
+	{
+		return NULL;
+	}
+
+	prvMappingInsert( xRoundedSize, &uxFL, &uxSL );
+
+	/* First non empty list at or above (uxFL, uxSL). */
+	ulMap = pxRegion->ulSLBitmap[ uxFL ] & ( ~0UL << uxSL );
+	if( ulMap == 0 )
+	{
+		ulMap = ( uxFL + 1 < 32 ) ? ( pxRegion->ulFLBitmap & ( ~0UL << ( uxFL + 1 ) ) ) : 0;
+		if( ulMap == 0 )
+		{
+			return NULL;
+		}
+
+		uxFL = heapFFS( ulMap );
+		ulMap = pxRegion->ulSLBitmap[ uxFL ];
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	uxSL = heapFFS( ulMap );
+	pxBlock = pxRegion->pxFreeLists[ uxFL ][ uxSL ];
+	prvRemoveFreeBlock( pxRegion, pxBlock );
+
+	/* Split off the end of the block if it is large enough to be a block on
+	its own.  The new block stays free, so the flags of the block above are
+	still right. */
+	xRemaining = ( pxBlock->xBlockSize & ~heapFLAG_MASK ) - xBlockSize;
+	if( xRemaining >= xMinimumBlockSize )
+	{
+		pxNewBlock = ( TLSFBlock_t * ) ( ( ( uint8_t * ) pxBlock ) + xBlockSize );
+		pxNewBlock->pxPrevPhysBlock = pxBlock;
+		pxNewBlock->xBlockSize = xRemaining | heapBLOCK_FREE;
+		prvNextPhysBlock( pxNewBlock )->pxPrevPhysBlock = pxNewBlock;
+		prvInsertFreeBlock( pxRegion, pxNewBlock );
+
+		pxBlock->xBlockSize = xBlockSize | ( pxBlock->xBlockSize & heapPREV_FREE );
+	}
+	else
+	{
+		pxBlock->xBlockSize &= ~heapBLOCK_FREE;
+		prvNextPhysBlock( pxBlock )->xBlockSize &= ~heapPREV_FREE;
+	}
+
+	pxRegion->xFreeBytes -= pxBlock->xBlockSize & ~heapFLAG_MASK;
+	pxRegion->xNumberOfAllocations++;
+
+	if( pxRegion->xFreeBytes < pxRegion->xMinimumEverFreeBytes )
+	{
+		pxRegion->xMinimumEverFreeBytes = pxRegion->xFreeBytes;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeaderSize );
+}
+/*-----------------------------------------------------------*/
+
+static TLSFRegion_t *prvRegionOf( const void *pv )
+{
+UBaseType_t uxRegion;
+const uint8_t *puc = ( const uint8_t * ) pv;
+
+	for( uxRegion = 0; uxRegion < eHeapRegionCount; uxRegion++ )
+	{
+		if( ( puc > xRegions[ uxRegion ].pucStart ) && ( puc < xRegions[ uxRegion ].pucEnd ) )
+		{
+			return &xRegions[ uxRegion ];
+		}
+	}
+
+	return NULL;
+}
+
+#endif /* configUSE_TLSF_HEAP */
@@ -76,6 +76,10 @@ extern volatile TCB_t * volatile pxCurrentTCB;
 unsigned port_xSchedulerRunning = 0; // Duplicate of inaccessible xSchedulerRunning; needed at startup to avoid counting nesting
 unsigned port_interruptNesting = 0;  // Interrupt nesting level
 
+/* Upper half and last value of the 64-bit run time counter. */
+static uint32_t port_ccountHigh = 0;
+static uint32_t port_ccountLast = 0;
+
 /*-----------------------------------------------------------*/
 
 // User exception dispatcher when exiting
@@ -181,6 +185,28 @@ BaseType_t xPortStartScheduler( void )
 }
 /*-----------------------------------------------------------*/
 
+/*
+ * Run time counter: CCOUNT extended to 64 bits. Must be called at least once
+ * per CCOUNT wrap, which the tick handler ensures.
+ */
+uint64_t ullPortGetRunTimeCounterValue( void )
+{
+	uint32_t interruptMask = portSET_INTERRUPT_MASK_FROM_ISR();
+	uint32_t ccount = xthal_get_ccount();
+	uint64_t ret;
+
+	if( ccount < port_ccountLast )
+	{
+		port_ccountHigh++;
+	}
+	port_ccountLast = ccount;
+	ret = ( ( uint64_t ) port_ccountHigh << 32 ) | ccount;
+
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( interruptMask );
+	return ret;
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t xPortSysTickHandler( void )
 {
 	BaseType_t ret;
@@ -188,6 +214,11 @@ BaseType_t xPortSysTickHandler( void )
 
 	portbenchmarkIntLatency();
 
+	#if configGENERATE_RUN_TIME_STATS || configUSE_HR_TIMERS
+	/* Keep the run time counter from missing a CCOUNT wrap. */
+	(void) ullPortGetRunTimeCounterValue();
+	#endif
+
 	/* Interrupts upto configMAX_SYSCALL_INTERRUPT_PRIORITY must be
 	 * disabled before calling xTaskIncrementTick as it access the
 	 * kernel lists. */
@@ -23,24 +23,77 @@
  */
 
 /*
- * This utility helps benchmarking interrupt latency and context switches.
- * In order to enable it, set configBENCHMARK to 1 in FreeRTOSConfig.h.
- * You will also need to download the FreeRTOS_trace patch that contains
- * portbenchmark.c and the complete version of portbenchmark.h
+ * This utility benchmarks interrupt latency. In order to enable it, set
+ * configBENCHMARK to 1 in FreeRTOSConfig.h, portbenchmark.c then records two
+ * latencies in cycles for each interrupt source:
+ *
+ *  - entry:  from interrupt assertion to handler entry. The tick asserts when
+ *            CCOUNT reaches CCOMPARE, so its assertion cycle is exact. The
+ *            iDMA interrupts carry no time stamp and only record their entry
+ *            cycle for the resume latency.
+ *  - resume: from handler entry to the task woken by the interrupt running,
+ *            recorded when the task calls portbenchmarkIntWait() after its
+ *            wait returns. Measured from the latest entry of the source.
+ *
+ * Each latency keeps min/avg/max and a histogram for the percentiles.
  */
 
 #ifndef PORTBENCHMARK_H
 #define PORTBENCHMARK_H
 
+// Interrupt sources.
+#define portbenchmarkSRC_TICK           0
+#define portbenchmarkSRC_IDMA_DONE      1
+#define portbenchmarkSRC_IDMA_ERR       2
+#define portbenchmarkNUM_SOURCES        3
+
 #if configBENCHMARK
-    #error "You need to download the FreeRTOS_trace patch that overwrites this file"
+
+// Histogram bin width in cycles. The last bin counts all longer latencies.
+#ifndef portbenchmarkBIN_CYCLES
+#define portbenchmarkBIN_CYCLES         16
 #endif
+#define portbenchmarkNUM_BINS           64
+
+// Latency statistics in cycles, see xPortBenchmarkGetStats().
+typedef struct {
+	uint32_t count;
+	uint32_t min;
+	uint32_t avg;
+	uint32_t max;
+	uint32_t p50;
+	uint32_t p90;
+	uint32_t p99;
+} BenchmarkStats_t;
+
+void vPortBenchmarkTickEntry( void );
+void vPortBenchmarkIntEntry( UBaseType_t uxSource );
+void vPortBenchmarkIntWait( UBaseType_t uxSource );
+void vPortBenchmarkReset( void );
+void vPortBenchmarkPrint( void );
+
+// Copies the entry (xResume == 0) or resume latency statistics of a source.
+// Returns pdFALSE for an invalid source.
+BaseType_t xPortBenchmarkGetStats( UBaseType_t uxSource, BaseType_t xResume, BenchmarkStats_t * pxStats );
+
+#define portbenchmarkINTERRUPT_DISABLE()
+#define portbenchmarkINTERRUPT_RESTORE(newstate)
+#define portbenchmarkIntLatency()       vPortBenchmarkTickEntry()
+#define portbenchmarkIntEntry(src)      vPortBenchmarkIntEntry(src)
+#define portbenchmarkIntWait(src)       vPortBenchmarkIntWait(src)
+#define portbenchmarkReset()            vPortBenchmarkReset()
+#define portbenchmarkPrint()            vPortBenchmarkPrint()
+
+#else
 
 #define portbenchmarkINTERRUPT_DISABLE()
 #define portbenchmarkINTERRUPT_RESTORE(newstate)
 #define portbenchmarkIntLatency()
-#define portbenchmarkIntWait()
+#define portbenchmarkIntEntry(src)
+#define portbenchmarkIntWait(src)
 #define portbenchmarkReset()
 #define portbenchmarkPrint()
 
+#endif /* configBENCHMARK */
+
 #endif /* PORTBENCHMARK */
@@ -595,6 +595,112 @@ BaseType_t xHigherPriorityTaskWoken = pdFALSE;  // Initialised to pdFALSE.
  */
 #define xMessageBufferReceiveFromISR( xMessageBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferReceiveFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken )
 
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferSendReserve( MessageBufferHandle_t xMessageBuffer,
+                                  void **ppvTxData,
+                                  size_t xDataLengthBytes,
+                                  TickType_t xTicksToWait );
+
+size_t xMessageBufferSendReserveFromISR( MessageBufferHandle_t xMessageBuffer,
+                                         void **ppvTxData,
+                                         size_t xDataLengthBytes );
+
+size_t xMessageBufferSendCommit( MessageBufferHandle_t xMessageBuffer,
+                                 size_t xDataLengthBytes );
+
+size_t xMessageBufferSendCommitFromISR( MessageBufferHandle_t xMessageBuffer,
+                                        size_t xDataLengthBytes,
+                                        BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Sends a message without copying it.  xMessageBufferSendReserve() reserves
+ * contiguous space for a message of xDataLengthBytes bytes, blocking for up to
+ * xTicksToWait ticks for it to become free, and sets *ppvTxData to it.  The
+ * writer builds the message in place, then xMessageBufferSendCommit() sends it
+ * with the length actually written, which can be less than was reserved.
+ * Committing 0 bytes cancels the reservation.
+ *
+ * A message is never split at the end of the buffer's storage area.  If it
+ * would be, the rest of the storage area is left unused and the message is
+ * placed at its start, so up to a message's length more free space can be
+ * needed than for xMessageBufferSend().  A message of more than about half the
+ * storage area may not fit at all, depending on where the previous message
+ * ended.  xMessageBufferSendReserve() then returns 0 once the message buffer is
+ * empty instead of waiting for the time out.
+ *
+ * Only one reservation can be outstanding, and the writer must not call
+ * xMessageBufferSend() while it is.  The ...FromISR() versions never block and
+ * can be called from an interrupt service routine (ISR).
+ *
+ * @return The number of bytes reserved, either xDataLengthBytes or 0 with
+ * *ppvTxData set to NULL, or the number of bytes committed.
+ *
+ * Example use:
+<pre>
+void vAFunction( MessageBufferHandle_t xMessageBuffer )
+{
+Tile_t *pxTile;
+
+    // Reserve space for a tile, build it in place, then send it.
+    if( xMessageBufferSendReserve( xMessageBuffer, ( void ** ) &pxTile, sizeof( Tile_t ), portMAX_DELAY ) != 0 )
+    {
+        vFillTile( pxTile );
+        xMessageBufferSendCommit( xMessageBuffer, sizeof( Tile_t ) );
+    }
+}
+</pre>
+ * \defgroup xMessageBufferSendReserve xMessageBufferSendReserve
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendReserve( xMessageBuffer, ppvTxData, xDataLengthBytes, xTicksToWait ) xStreamBufferSendReserve( ( StreamBufferHandle_t ) xMessageBuffer, ppvTxData, xDataLengthBytes, xTicksToWait )
+#define xMessageBufferSendReserveFromISR( xMessageBuffer, ppvTxData, xDataLengthBytes ) xStreamBufferSendReserveFromISR( ( StreamBufferHandle_t ) xMessageBuffer, ppvTxData, xDataLengthBytes )
+#define xMessageBufferSendCommit( xMessageBuffer, xDataLengthBytes ) xStreamBufferSendCommit( ( StreamBufferHandle_t ) xMessageBuffer, xDataLengthBytes )
+#define xMessageBufferSendCommitFromISR( xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferSendCommitFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferReceiveAcquire( MessageBufferHandle_t xMessageBuffer,
+                                     void **ppvRxData,
+                                     TickType_t xTicksToWait );
+
+size_t xMessageBufferReceiveAcquireFromISR( MessageBufferHandle_t xMessageBuffer,
+                                            void **ppvRxData );
+
+void vMessageBufferReceiveRelease( MessageBufferHandle_t xMessageBuffer );
+
+void vMessageBufferReceiveReleaseFromISR( MessageBufferHandle_t xMessageBuffer,
+                                          BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Receives a message without copying it.  xMessageBufferReceiveAcquire()
+ * blocks for up to xTicksToWait ticks for a message, sets *ppvRxData to it and
+ * returns its length.  The message stays in the buffer, so the reader can use
+ * it in place, until vMessageBufferReceiveRelease() removes it.
+ *
+ * Only messages sent with xMessageBufferSendReserve() are guaranteed to be
+ * contiguous.  Messages sent with xMessageBufferSend() can be split at the end
+ * of the storage area.  Such a message is not acquired: its length is returned
+ * with *ppvRxData set to NULL, and it must be read with xMessageBufferReceive()
+ * into a buffer of that length.  The ...FromISR() versions never block and can
+ * be called from an interrupt service routine (ISR).
+ *
+ * @return The length of the next message, with *ppvRxData set to it if it was
+ * acquired or to NULL if it is split, or 0 with *ppvRxData set to NULL if the
+ * message buffer is empty.
+ *
+ * \defgroup xMessageBufferReceiveAcquire xMessageBufferReceiveAcquire
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceiveAcquire( xMessageBuffer, ppvRxData, xTicksToWait ) xStreamBufferReceiveAcquire( ( StreamBufferHandle_t ) xMessageBuffer, ppvRxData, xTicksToWait )
+#define xMessageBufferReceiveAcquireFromISR( xMessageBuffer, ppvRxData ) xStreamBufferReceiveAcquireFromISR( ( StreamBufferHandle_t ) xMessageBuffer, ppvRxData )
+#define vMessageBufferReceiveRelease( xMessageBuffer ) vStreamBufferReceiveRelease( ( StreamBufferHandle_t ) xMessageBuffer, ( size_t ) 0 )
+#define vMessageBufferReceiveReleaseFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) vStreamBufferReceiveReleaseFromISR( ( StreamBufferHandle_t ) xMessageBuffer, ( size_t ) 0, pxHigherPriorityTaskWoken )
+
 /**
  * message_buffer.h
  *
@@ -0,0 +1,158 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Fixed size object pools.
+ *
+ * A pool is an array of equally sized blocks with a free list threaded
+ * through the free blocks, so taking and returning a block are O(1) and
+ * never fragment the heap.  objpool.c preallocates one pool per kernel object
+ * type, sized by the configPOOL_ constants of FreeRTOSConfig.h and placed in
+ * configPOOL_SECTION (configPOOL_STACK_SECTION for task stacks):
+ *
+ *	- queues with up to configPOOL_QUEUE_STORAGE_SIZE bytes of storage,
+ *	- semaphores and mutexes,
+ *	- tasks in two stack classes, configPOOL_SMALL_STACK_DEPTH and
+ *	  configPOOL_LARGE_STACK_DEPTH words,
+ *	- message buffers of up to configPOOL_MESSAGE_BUFFER_SIZE bytes.
+ *
+ * The ...FromPool() functions create objects with the static creation
+ * functions on pool blocks.  Queues, semaphores and message buffers are
+ * returned with the matching ...DeleteFromPool() function.  Tasks are deleted
+ * with vTaskDelete() as usual, the kernel returns their block once it has
+ * finished with the TCB and stack.
+ *
+ * Requires configUSE_OBJECT_POOLS and configSUPPORT_STATIC_ALLOCATION set to 1.
+ */
+
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include objpool.h"
+#endif
+
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "message_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* Pool control structure.  The application may create its own pools, for
+example for tile messages, with vPoolInit(). */
+typedef struct xOBJECT_POOL
+{
+	void *pvFreeList;		/*<< First free block, each free block holds the next. */
+	uint8_t *pucStart;		/*<< First block. */
+	uint8_t *pucEnd;		/*<< End of the last block. */
+	size_t xBlockSize;
+	UBaseType_t uxBlocks;
+	UBaseType_t uxFreeBlocks;
+	UBaseType_t uxMinimumEverFreeBlocks;
+} ObjectPool_t;
+
+/*
+ * Sets up a pool of uxBlocks blocks of xBlockSize bytes in pvBuffer.
+ * xBlockSize is rounded up to portBYTE_ALIGNMENT and to at least a pointer,
+ * pvBuffer must be aligned and hold uxBlocks rounded blocks.
+ */
+void vPoolInit( ObjectPool_t *pxPool, void *pvBuffer, size_t xBlockSize, UBaseType_t uxBlocks ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes a block from the pool, NULL if the pool is empty.  Can be called from
+ * tasks and interrupts.
+ */
+void *pvPoolAlloc( ObjectPool_t *pxPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns a block taken with pvPoolAlloc().  Can be called from tasks and
+ * interrupts.
+ */
+void vPoolFree( ObjectPool_t *pxPool, void *pv ) PRIVILEGED_FUNCTION;
+
+/*
+ * pdTRUE if pv is a block of the pool.
+ */
+BaseType_t xPoolContains( const ObjectPool_t *pxPool, const void *pv ) PRIVILEGED_FUNCTION;
+
+/*
+ * Creates a queue of uxQueueLength items of uxItemSize bytes.  Fails if the
+ * items do not fit configPOOL_QUEUE_STORAGE_SIZE bytes or the pool is empty.
+ */
+QueueHandle_t xQueueCreateFromPool( UBaseType_t uxQueueLength, UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Deletes a queue created with xQueueCreateFromPool() and returns its block.
+ */
+void vQueueDeleteFromPool( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Semaphore and mutex equivalents of xSemaphoreCreateBinary(),
+ * xSemaphoreCreateCounting() and xSemaphoreCreateMutex().
+ */
+SemaphoreHandle_t xSemaphoreCreateBinaryFromPool( void ) PRIVILEGED_FUNCTION;
+SemaphoreHandle_t xSemaphoreCreateCountingFromPool( UBaseType_t uxMaxCount, UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
+SemaphoreHandle_t xSemaphoreCreateMutexFromPool( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Deletes a semaphore or mutex created from the pool and returns its block.
+ */
+void vSemaphoreDeleteFromPool( SemaphoreHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
+
+/*
+ * Equivalent of xTaskCreate().  The task gets a block of the smallest stack
+ * class holding usStackDepth words, the full class depth is used as stack.
+ * Returns errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY if no class has a free block.
+ */
+BaseType_t xTaskCreateFromPool( TaskFunction_t pxTaskCode,
+								const char * const pcName,
+								const configSTACK_DEPTH_TYPE usStackDepth,
+								void * const pvParameters,
+								UBaseType_t uxPriority,
+								TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the kernel when it has finished with the TCB of a deleted
+ * statically allocated task.  Returns the block if the task came from a pool.
+ */
+void vPoolReleaseTask( void *pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Equivalent of xMessageBufferCreate() for up to configPOOL_MESSAGE_BUFFER_SIZE
+ * bytes, and the matching delete.
+ */
+MessageBufferHandle_t xMessageBufferCreateFromPool( size_t xBufferSizeBytes ) PRIVILEGED_FUNCTION;
+void vMessageBufferDeleteFromPool( MessageBufferHandle_t xMessageBuffer ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+} /* extern "C" */
+#endif
+
+#endif /* OBJECT_POOL_H */
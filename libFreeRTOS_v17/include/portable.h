@@ -122,6 +122,59 @@ typedef struct HeapRegion
  */
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
+/* Used by heap_tlsf.c.  The regions follow the LSP memory map. */
+typedef enum
+{
+	eHeapRegionDRAM0 = 0,	/* Local data RAM 0. */
+	eHeapRegionDRAM1,		/* Local data RAM 1. */
+	eHeapRegionSRAM,		/* System RAM. */
+	eHeapRegionCount
+} eHeapRegion;
+
+/* Placement hints of pvPortMallocInRegion(), a mask of regions to try first.
+Other regions are tried next unless portHEAP_HINT_STRICT is set. */
+#define portHEAP_HINT_DRAM0		( 1UL << eHeapRegionDRAM0 )
+#define portHEAP_HINT_DRAM1		( 1UL << eHeapRegionDRAM1 )
+#define portHEAP_HINT_SRAM		( 1UL << eHeapRegionSRAM )
+#define portHEAP_HINT_LOCAL		( portHEAP_HINT_DRAM0 | portHEAP_HINT_DRAM1 )
+#define portHEAP_HINT_ANY		( portHEAP_HINT_LOCAL | portHEAP_HINT_SRAM )
+#define portHEAP_HINT_STRICT	( 0x80000000UL )
+
+/* Used by vPortGetHeapRegionStats(). */
+typedef struct xHEAP_REGION_STATS
+{
+	size_t xTotalBytes;				/* Size of the region. */
+	size_t xFreeBytes;				/* Free bytes, block headers included. */
+	size_t xMinimumEverFreeBytes;	/* Lowest xFreeBytes since boot. */
+	size_t xLargestFreeBlock;		/* Largest allocation that would succeed. */
+	size_t xNumberOfFreeBlocks;
+	size_t xNumberOfAllocations;	/* Successful allocations since boot. */
+	size_t xNumberOfFrees;			/* Frees since boot. */
+	UBaseType_t uxFragmentation;	/* Percentage of the free bytes outside the largest free block. */
+} HeapRegionStats_t;
+
+/*
+ * Allocates from the regions selected by ulHint, a portHEAP_HINT_ mask.  Used
+ * for buffers that must or should live in a given memory, for example to keep
+ * tile buffers in the local data RAMs.  pvPortMalloc() hints
+ * portHEAP_HINT_LOCAL up to configHEAP_LOCAL_MAX_SIZE bytes and
+ * portHEAP_HINT_SRAM above.
+ */
+void *pvPortMallocInRegion( size_t xWantedSize, uint32_t ulHint ) PRIVILEGED_FUNCTION;
+
+/*
+ * Gives the region eRegion the xSizeInBytes bytes at pvStart, for regions
+ * not sized in FreeRTOSConfig.h.  A region spans a single range, so this
+ * fails if the region already has memory.
+ */
+BaseType_t xPortAddHeapRegion( eHeapRegion eRegion, void *pvStart, size_t xSizeInBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Fragmentation statistics of one region.
+ */
+void vPortGetHeapRegionStats( eHeapRegion eRegion, HeapRegionStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
+
 
 /*
  * Map to the memory management routines required for the port.
@@ -52,8 +52,10 @@ correct privileged Vs unprivileged linkage and placement. */
 /* This entire source file will be skipped if the application is not configured
 to include software timer functionality.  This #if is closed at the very bottom
 of this file.  If you want to include software timer functionality then ensure
-configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
-#if ( configUSE_TIMERS == 1 )
+configUSE_TIMERS is set to 1 in FreeRTOSConfig.h.  The timing wheel
+implementation in timer_wheel.c is used instead when configUSE_TIMER_WHEEL is
+set to 1. */
+#if ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_WHEEL == 0 )
 
 /* Misc definitions. */
 #define tmrNO_DELAY		( TickType_t ) 0U
@@ -1081,7 +1083,7 @@ Timer_t * const pxTimer = xTimer;
 /* This entire source file will be skipped if the application is not configured
 to include software timer functionality.  If you want to include software timer
 functionality then ensure configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
-#endif /* configUSE_TIMERS == 1 */
+#endif /* ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_WHEEL == 0 ) */
 
 
 
@@ -337,11 +337,61 @@ typedef void (*idma_err_callback_fn)( const idma_error_details_t* error);
 /* log handler typedef */
 typedef void (*idma_log_h)( const char* xlog);
 
+/* Deferred log event, see idma_dlog_flush(). The events are kept in
+ * g_idma_dlog_ring[], IDMA_DLOG_ENTRIES entries indexed by sequence
+ * number modulo IDMA_DLOG_ENTRIES, so a host tool can decode a memory
+ * dump of the ring with the format strings of the application ELF. */
+#ifndef IDMA_DLOG_ENTRIES
+#define IDMA_DLOG_ENTRIES       256     /* Power of 2 */
+#endif
+#define IDMA_DLOG_MAX_ARGS      8       /* Further arguments are dropped */
+
+typedef struct idma_dlog_entry_struct {
+  uint32_t     seq;                        /* Sequence number + 1, 0 while written */
+  uint32_t     ccount;                     /* CCOUNT when the event was logged     */
+  const char*  fmt;                        /* Format string                        */
+  int16_t      ch;                         /* Channel                              */
+  int16_t      nargs;                      /* Arguments in args[]                  */
+  uint32_t     args[IDMA_DLOG_MAX_ARGS];
+} idma_dlog_entry_t;
+
 /* Typedef for external API use */
 typedef struct idma_buffer_struct {
   char buffer[4];
 } idma_buffer_t;
 
+/* Priority classes of task mode transfers */
+typedef enum {
+  IDMA_PRIO_HIGH = 0,     /* Latency critical, queued to HW right away        */
+  IDMA_PRIO_BULK,         /* Background, one task at a time on the HW queue   */
+  IDMA_PRIO_NUM_CLASSES
+} idma_prio_t;
+
+/* Latency of the completed tasks of a priority class, in CCOUNT cycles
+ * from submission until the task is retired by iDMAlib. */
+typedef struct idma_prio_stats_struct {
+  uint32_t  count;
+  uint32_t  min_cycles;
+  uint32_t  max_cycles;
+  uint64_t  total_cycles;
+} idma_prio_stats_t;
+
+/* Default chunk size of bulk copies, in bytes */
+#define IDMA_BULK_CHUNK_DEFAULT   4096U
+
+/* Bulk copy object, defined below */
+typedef struct idma_bulk_struct idma_bulk_t;
+
+/* One transfer of a descriptor list, see idma_copy_2d_desc_list() */
+typedef struct idma_2d_xfer_struct {
+  void      *dst;
+  void      *src;
+  uint32_t  row_sz;
+  uint32_t  nrows;
+  uint32_t  src_pitch;
+  uint32_t  dst_pitch;
+} idma_2d_xfer_t;
+
 /* allocate space for n descriptors of type idma_type_t. */
 #define IDMA_BUFFER_SIZE(n,type)  \
                         (  ((n)* (((type) == IDMA_1D_DESC) ? IDMA_1D_DESC_SIZE : (((type) == IDMA_2D_DESC) ? IDMA_2D_DESC_SIZE : IDMA_64_DESC_SIZE))) + \
@@ -500,6 +550,28 @@ idma_get_state(int32_t ch);
 void
 idma_log_handler(idma_log_h xlog);
 
+/**
+ * @name   Format deferred log messages.
+ * @brief  With IDMA_DEBUG_DEFERRED, XLOG only stores the format string,
+ *         the arguments and CCOUNT of each message in a lock-free ring.
+ *         This function formats the stored messages, oldest first, and
+ *         sends them to the log handler. Call it from a low-priority task.
+ *         Messages overwritten before they were formatted are counted.
+ *         NOTE: In debug library with IDMA_DEBUG_DEFERRED only !
+ * @param  max          Maximum number of messages to format.
+ * @retval Number of messages formatted.
+ */
+int32_t
+idma_dlog_flush(int32_t max);
+
+/**
+ * @name   Get the number of lost deferred log messages.
+ * @brief  NOTE: In debug library with IDMA_DEBUG_DEFERRED only !
+ * @retval Messages overwritten before they were formatted.
+ */
+uint32_t
+idma_dlog_lost(void);
+
 /**
  * @name   Sleep/block until current iDMA activity completes.
  * @brief  Wait in low-power mode until iDMA activity completes. Return immediately
@@ -728,6 +800,103 @@ idma_process_tasks(int32_t ch);
 IDMA_API idma_status_t
 idma_abort_tasks(int32_t ch);
 
+/************************************************/
+/****          Task Priority Classes         ****/
+/************************************************/
+
+/*
+ * All tasks of a channel share one HW FIFO. To bound the latency of
+ * IDMA_PRIO_HIGH tasks, IDMA_PRIO_BULK tasks are held in a software queue
+ * and released to the HW queue one at a time, when the previous bulk
+ * task is retired. A high priority task then waits for at most one bulk
+ * task. Large copies should use idma_copy_bulk_task(), which splits them
+ * into chunks so that this bulk task is short. Bulk traffic can also be
+ * kept off the channel entirely by scheduling it on another channel.
+ * Tasks scheduled with idma_schedule_task() or the copy_task functions
+ * are IDMA_PRIO_HIGH.
+ */
+
+/**
+ * @name   Schedule a task in a priority class.
+ * @brief  IDMA_PRIO_HIGH tasks are scheduled like idma_schedule_task().
+ *         IDMA_PRIO_BULK tasks are queued behind other bulk tasks and
+ *         reach the HW queue when the previous bulk task is retired.
+ *         NOTE: TASK MODE ONLY. Without interrupts, idma_process_tasks()
+ *         has to be called to release queued bulk tasks.
+ * @param  taskh      Pointer to iDMA task to be scheduled.
+ * @param  prio       Priority class.
+ * @retval IDMA_OK    Successful.
+ * @retval !IDMA_OK   Error type.
+ */
+idma_status_t
+idma_schedule_task_prio(idma_buffer_t *taskh, idma_prio_t prio);
+
+/**
+ * @name   Copy a large block in the bulk priority class.
+ * @brief  The copy is split into chunks of at most the channel's chunk
+ *         size. Each chunk is an IDMA_PRIO_BULK task, the next chunk is
+ *         queued when the previous one completes, so bulk copies on the
+ *         same channel are interleaved chunk by chunk.
+ * @param  ch          Selected iDMA HW channel.
+ *                     NOTE: Argument present only if LIBIDMA_USE_MULTICHANNEL_API defined.
+ * @param  bulk        Bulk copy object. Holds the chunk descriptor, so it
+ *                     must be in memory the iDMA can fetch descriptors from.
+ * @param  dst...      iDMA 1D transfer parameters
+ * @param  flags       Descriptor options (Control field) of every chunk.
+ *                     DESC_NOTIFY_W_INT is always added.
+ * @param  cb_func     Function to call when the last chunk completes.
+ * @param  cb_data     Callback data.
+ * @retval IDMA_OK     Successful.
+ * @retval !IDMA_OK    Error type
+ */
+IDMA_API idma_status_t
+idma_copy_bulk_task(int32_t ch,
+                    idma_bulk_t *bulk,
+                    void *dst,
+                    void *src,
+                    size_t size,
+                    uint32_t flags,
+                    void *cb_data,
+                    idma_callback_fn cb_func);
+
+/**
+ * @name   Get the bulk copy status.
+ * @param  bulk   Pointer to bulk copy object
+ * @retval <  0   Error (task_status_t)
+ * @retval >= 0   Number of bytes not yet copied.
+ */
+IDMA_API int32_t
+idma_bulk_status(idma_bulk_t *bulk);
+
+/**
+ * @name   Set the chunk size of bulk copies.
+ * @brief  Smaller chunks lower the latency of high priority tasks,
+ *         larger chunks lower the scheduling overhead.
+ * @param  ch          Selected iDMA HW channel.
+ *                     NOTE: Argument present only if LIBIDMA_USE_MULTICHANNEL_API defined.
+ * @param  size        Chunk size in bytes, 0 selects IDMA_BULK_CHUNK_DEFAULT.
+ */
+IDMA_API void
+idma_set_bulk_chunk(int32_t ch, uint32_t size);
+
+/**
+ * @name   Get the latency statistics of a priority class.
+ * @param  ch          Selected iDMA HW channel.
+ *                     NOTE: Argument present only if LIBIDMA_USE_MULTICHANNEL_API defined.
+ * @param  prio        Priority class.
+ * @param  stats       Copy of the statistics.
+ */
+IDMA_API void
+idma_get_prio_stats(int32_t ch, idma_prio_t prio, idma_prio_stats_t *stats);
+
+/**
+ * @name   Clear the latency statistics of all priority classes.
+ * @param  ch          Selected iDMA HW channel.
+ *                     NOTE: Argument present only if LIBIDMA_USE_MULTICHANNEL_API defined.
+ */
+IDMA_API void
+idma_reset_prio_stats(int32_t ch);
+
 /************************************************/
 /****         Fixed-Buffer Mode API          ****/
 /************************************************/
@@ -737,6 +906,8 @@ idma_abort_tasks(int32_t ch);
  *         mode which prevents using the buffer as a separate task.
  * @brief  Needs to be called after a buffer is created (e.g. using the
  *         IDMA_DEFINE_BUFFER) and before adding descriptors to it.
+ *         Can be called again on a buffer whose descriptors completed,
+ *         the channel then restarts at the first descriptor.
  * @param  ch         Selected iDMA HW channel.
  *                    NOTE: Argument present only if LIBIDMA_USE_MULTICHANNEL_API defined.
  * @param  buffer     Pointer to the memory used for iDMA buffer
@@ -845,6 +1016,32 @@ idma_copy_2d_desc(int32_t ch,
                   uint32_t src_pitch,
                   uint32_t dst_pitch);
 
+/**
+ * @name   Add and schedule a list of 2D descriptors.
+ * @brief  Descriptors are added in order and scheduled together, so the
+ *         whole list completes with the returned index.
+ *         Descriptors are written in the format of the buffer, 2D or
+ *         64B 2D.
+ *         DESC_NOTIFY_W_INT is set on the last descriptor only, the other
+ *         flags on all of them.
+ *         NOTE: INCOMPATIBLE with idma_add_desc/idma_add_2d_desc/idma_schedule_desc
+ * @param  ch           Selected iDMA HW channel.
+ *                      NOTE: Argument present only if LIBIDMA_USE_MULTICHANNEL_API defined.
+ * @param  xfers        Transfers, one descriptor each.
+ * @param  count        Number of transfers, up to the number of descriptors
+ *                      of the buffer. If 0, nothing is scheduled and the
+ *                      index of the last scheduled descriptor is returned.
+ * @param  flags        Descriptor options (Control field).
+ *                      See "Descriptor Control Flags".
+ * @retval <  0         Error code, from idma_status_t.
+ * @retval >= 0         Index of the last descriptor, see idma_schedule_desc()
+ */
+IDMA_API int32_t
+idma_copy_2d_desc_list(int32_t ch,
+                       const idma_2d_xfer_t *xfers,
+                       uint32_t count,
+                       uint32_t flags);
+
 /**
  * @name   Check if a descriptor is done, using unique desc ID.
  * @brief  Unique ID is made available when descriptor was scheduled.
@@ -960,6 +1157,8 @@ IDMA_API void idma_hw_schedule(uint32_t count);
 IDMA_API uint32_t idma_hw_num_outstanding(void);
 
 void idma_log_handler(idma_log_h xlog);
+int32_t idma_dlog_flush(int32_t max);
+uint32_t idma_dlog_lost(void);
 
 IDMA_API idma_status_t idma_init(uint32_t flags, idma_max_block_t block_sz, uint32_t pif_req, idma_ticks_cyc_t ticks_per_cyc, uint32_t timeout_ticks, idma_err_callback_fn  err_cb_func);
 IDMA_API idma_status_t idma_add_desc(idma_buffer_t *bufh, void *dst, void *src, size_t size,  uint32_t flags);
@@ -975,6 +1174,12 @@ IDMA_API idma_status_t idma_update_desc_dst(void *dst);
 IDMA_API idma_status_t idma_update_desc_src(void *src);
 IDMA_API idma_status_t idma_update_desc_size(uint32_t size);
 idma_status_t idma_schedule_task( idma_buffer_t *taskh);
+idma_status_t idma_schedule_task_prio(idma_buffer_t *taskh, idma_prio_t prio);
+IDMA_API idma_status_t idma_copy_bulk_task(idma_bulk_t *bulk, void *dst, void *src, size_t size, uint32_t flags, void *cb_data, idma_callback_fn cb_func);
+IDMA_API int32_t idma_bulk_status(idma_bulk_t *bulk);
+IDMA_API void idma_set_bulk_chunk(uint32_t size);
+IDMA_API void idma_get_prio_stats(idma_prio_t prio, idma_prio_stats_t *stats);
+IDMA_API void idma_reset_prio_stats(void);
 
 IDMA_API idma_state_t  idma_get_state(void);
 
@@ -985,6 +1190,7 @@ IDMA_API int32_t idma_schedule_desc(uint32_t count);
 IDMA_API int32_t idma_schedule_desc_fast(uint32_t count);
 IDMA_API int32_t idma_copy_desc(void *dst, void *src, size_t size, uint32_t flags);
 IDMA_API int32_t idma_copy_2d_desc(void *dst, void *src, size_t size, uint32_t flags, uint32_t nrows, uint32_t src_pitch, uint32_t dst_pitch);
+IDMA_API int32_t idma_copy_2d_desc_list(const idma_2d_xfer_t *xfers, uint32_t count, uint32_t flags);
 IDMA_API int32_t idma_desc_done(int32_t index);
 IDMA_API int32_t idma_buffer_status(void);
 IDMA_API int32_t idma_task_status(idma_buffer_t *taskh);
@@ -1476,7 +1682,15 @@ idma_copy_2d_task_wide_i(int32_t          ch,
 # ifdef IDMA_DEBUG
 #  define IDMA_ASSERT(expr)
 void idma_print(int32_t ch, const char* fmt, ...);
+#  ifdef IDMA_DEBUG_DEFERRED
+void idma_dlog(int32_t ch, int32_t nargs, const char* fmt, ...);
+/* Number of arguments after the format string, up to 12 */
+#   define IDMA_DLOG_NARGS(...)  IDMA_DLOG_NARGS_(__VA_ARGS__, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#   define IDMA_DLOG_NARGS_(fmt, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, n, ...)  n
+#   define XLOG(ch, ...)  do { idma_dlog((ch), IDMA_DLOG_NARGS(__VA_ARGS__), __VA_ARGS__);} while (0)  // parasoft-suppress MISRA2012-RULE-20_7 "used only in non-FuSa code"
+#  else
 #  define XLOG(ch, ...)  do { idma_print((ch), __VA_ARGS__);} while (0)              // parasoft-suppress MISRA2012-RULE-20_7 "used only in non-FuSa code"
+#  endif
 # else
 #  define IDMA_ASSERT(expr)
 #  define XLOG(ch, ...)  (void)(ch); do {} while (0)
@@ -1564,10 +1778,27 @@ struct idma_buf_struct {
   int16_t           sleeping;       // Nonzero when thread is sleeping (blocked)
   int16_t           pending;        // Nonzero when buffer is queued
   int32_t           pending_desc_cnt;
+  int32_t           prio;           // TASK: priority class, idma_prio_t
+  uint32_t          submit_cycles;  // TASK: CCOUNT at submission, for latency stats
 
   idma_desc_t       desc    __attribute__ ((aligned(16)));
 };
 
+/* Bulk copy object - fields NOT TO BE USED BY APPLICATION */
+
+struct idma_bulk_struct {
+  // Two chunk tasks, the next chunk is queued while the previous one is retired
+  idma_buffer_t     task[2][IDMA_BUFFER_SIZE(1, IDMA_1D_DESC)/sizeof(idma_buffer_t)] __attribute__ ((aligned(16)));
+  int32_t           cur;            // Index of the task of the current chunk
+  uint8_t *         dst;            // Next chunk destination
+  uint8_t *         src;            // Next chunk source
+  uint32_t          remaining;      // Bytes not yet copied
+  uint32_t          flags;
+  int32_t           status;         // Bytes not yet copied, or error (task_status_t)
+  idma_callback_fn  cb_func;        // Callback on completion of the whole copy
+  void *            cb_data;
+};
+
 /* Inline functions for iDMA register read/write */
 ALWAYS_INLINE uint32_t
 READ_IDMA_REG(int32_t ch, int32_t reg)
@@ -1941,6 +2172,10 @@ idma_status_t   idma_copy_2d_task_i(int32_t ch, idma_buffer_t *taskh, void *dst,
 idma_status_t   idma_init_loop_i (int32_t ch, idma_buffer_t* bufh, idma_type_t type, int32_t ndescs, void* cb_data, idma_callback_fn cb_func);
 idma_hw_error_t       idma_buffer_check_errors_i(int32_t ch);
 idma_error_details_t* idma_error_details_i(int32_t ch);
+idma_status_t   idma_copy_bulk_task_i(int32_t ch, idma_bulk_t *bulk, void *dst, void *src, size_t size, uint32_t flags, void *cb_data, idma_callback_fn cb_func);
+void            idma_set_bulk_chunk_i(int32_t ch, uint32_t size);
+void            idma_get_prio_stats_i(int32_t ch, idma_prio_t prio, idma_prio_stats_t *stats);
+void            idma_reset_prio_stats_i(int32_t ch);
 
 
 /************************************************/
@@ -2122,6 +2357,65 @@ idma_copy_2d_desc(IDMA_CHAN_FUNC_ARG void *dst, void *src,  size_t size, uint32_
   return ret;
 }
 
+IDMA_API int32_t
+idma_copy_2d_desc_list(IDMA_CHAN_FUNC_ARG const idma_2d_xfer_t *xfers, uint32_t count, uint32_t flags)
+{
+  idma_buf_t*  buf;
+  idma_desc_t* desc;
+  uint32_t     i;
+  DECLARE_PS();
+  int32_t      ret;
+
+  IDMA_DISABLE_INTS();
+
+  buf = idma_chan_buf_get(IDMA_CH_PTR);
+  if (buf == NULL) {
+    IDMA_ENABLE_INTS();
+    return (int32_t) IDMA_ERR_NO_BUF;
+  }
+
+  if (count > (uint32_t)buf->num_descs) {
+    IDMA_ENABLE_INTS();
+    return (int32_t) IDMA_ERR_BUF_OVFL;
+  }
+
+  if (count == 0U) {
+    ret = buf->cur_desc_i;
+    IDMA_ENABLE_INTS();
+    return ret;
+  }
+
+  /* Fill the descriptors from next_desc on, wrapping at the JUMP
+   * descriptor, then hand them to the HW in one go. */
+  desc = buf->next_desc;
+  for (i = 0; i < count; i++) {
+    uint32_t ctrl = ((i + 1U) < count) ? (flags & ~DESC_NOTIFY_W_INT) : flags;
+
+#if (IDMA_USE_64B_DESC > 0)
+    if (buf->type == (int32_t)IDMA_64B_DESC) {
+      set_desc64_ctrl(desc, ctrl, IDMA_64B_DESC_CODE | SET_CONTROL_SUBTYPE(IDMA_64B_2D_TYPE));
+      set_2d_desc64_fields(IDMA_CH_PTR, desc, (void *)&xfers[i].dst, (void *)&xfers[i].src, xfers[i].row_sz,
+                           xfers[i].nrows, xfers[i].src_pitch, xfers[i].dst_pitch);
+    }
+    else
+#endif
+    {
+      set_desc_ctrl(desc, ctrl, IDMA_2D_DESC_CODE);
+      set_2d_fields(IDMA_CH_PTR, desc, xfers[i].dst, xfers[i].src, xfers[i].row_sz,
+                    xfers[i].nrows, xfers[i].src_pitch, xfers[i].dst_pitch);
+    }
+
+    desc = &desc[buf->type];
+    if (desc >= buf->last_desc) {
+      desc = &buf->desc;
+    }
+  }
+
+  ret = schedule_desc(IDMA_CH_PTR, count);
+  IDMA_ENABLE_INTS();
+  return ret;
+}
+
 IDMA_API int32_t
 idma_schedule_desc(IDMA_CHAN_FUNC_ARG
                    uint32_t count)
@@ -2941,6 +3235,46 @@ idma_abort_tasks(IDMA_CHAN_FUNC_ARG_SINGLE)
   return idma_abort_tasks_i(IDMA_CH_PTR);
 }
 
+IDMA_API idma_status_t
+idma_copy_bulk_task(IDMA_CHAN_FUNC_ARG
+                    idma_bulk_t *bulk,
+                    void *dst,
+                    void *src,
+                    size_t size,
+                    uint32_t flags,
+                    void *cb_data,
+                    idma_callback_fn cb_func)
+{
+  return idma_copy_bulk_task_i(IDMA_CH_PTR, bulk, dst, src, size, flags, cb_data, cb_func);
+}
+
+IDMA_API int32_t
+idma_bulk_status(idma_bulk_t *bulk)
+{
+  return bulk->status;
+}
+
+IDMA_API void
+idma_set_bulk_chunk(IDMA_CHAN_FUNC_ARG
+                    uint32_t size)
+{
+  idma_set_bulk_chunk_i(IDMA_CH_PTR, size);
+}
+
+IDMA_API void
+idma_get_prio_stats(IDMA_CHAN_FUNC_ARG
+                    idma_prio_t prio,
+                    idma_prio_stats_t *stats)
+{
+  idma_get_prio_stats_i(IDMA_CH_PTR, prio, stats);
+}
+
+IDMA_API void
+idma_reset_prio_stats(IDMA_CHAN_FUNC_ARG_SINGLE)
+{
+  idma_reset_prio_stats_i(IDMA_CH_PTR);
+}
+
 
 IDMA_API int32_t
 idma_task_status(idma_buffer_t *taskh)
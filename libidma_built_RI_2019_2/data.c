@@ -31,10 +31,14 @@
 
 extern idma_cntrl_t   g_idma_cntrl[XCHAL_IDMA_NUM_CHANNELS];
 extern char           g_idmalogbuf[IDMA_LOG_SIZE];
+extern idma_prio_cntrl_t g_idma_prio[XCHAL_IDMA_NUM_CHANNELS];
+extern idma_submit_ring_t g_idma_submit[XCHAL_IDMA_NUM_CHANNELS];
 
 idma_cntrl_t g_idma_cntrl[XCHAL_IDMA_NUM_CHANNELS]    __attribute__ ((section(".dram0.data"))) __attribute__ ((weak));
 idma_buf_t* g_idma_buf_ptr[XCHAL_IDMA_NUM_CHANNELS]   __attribute__ ((section(".dram0.data"))) __attribute__ ((weak));
 char        g_idmalogbuf[IDMA_LOG_SIZE]         __attribute__ ((section(".dram0.data"))) __attribute__ ((weak));
+idma_prio_cntrl_t g_idma_prio[XCHAL_IDMA_NUM_CHANNELS] __attribute__ ((section(".dram0.data"))) __attribute__ ((weak));
+idma_submit_ring_t g_idma_submit[XCHAL_IDMA_NUM_CHANNELS] __attribute__ ((section(".dram0.data"))) __attribute__ ((weak));
 
 // Only works in C11 or later.
 #if defined (__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
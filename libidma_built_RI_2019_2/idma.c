@@ -34,12 +34,19 @@
 #define NO_CB   0
 
 extern idma_cntrl_t   g_idma_cntrl[XCHAL_IDMA_NUM_CHANNELS];
+extern idma_prio_cntrl_t g_idma_prio[XCHAL_IDMA_NUM_CHANNELS];
+extern idma_submit_ring_t g_idma_submit[XCHAL_IDMA_NUM_CHANNELS];
 
 #ifdef IDMA_DEBUG
 extern char           g_idmalogbuf[IDMA_LOG_SIZE];
 #endif
 
 idma_status_t queue_task(idma_buf_t * task);
+static idma_status_t queue_task_i(idma_buf_t * task);
+static void retire_task_i(int32_t ch, idma_buf_t * task);
+static void release_bulk_task_i(int32_t ch);
+static void abort_bulk_tasks_i(int32_t ch);
+static inline idma_status_t idma_init_task_ii(int32_t ch, idma_buffer_t *taskh, idma_type_t type, int32_t num_descs, idma_callback_fn cb_func, void *cb_data);
 
 
 WRAPPER_FUNC int32_t
@@ -224,6 +231,7 @@ idma_process_error_i(int32_t ch, idma_buf_t* task, uint32_t status)
 
   XLOG(ch, "Abort other tasks\n");
   abort_tasks((idma_buf_t*)task->next_task);
+  abort_bulk_tasks_i(ch);
 }
 
 /*
@@ -287,6 +295,7 @@ idma_task_processing_i(int32_t ch)
 
     #pragma no_reorder
     complete_desc_i(task);
+    retire_task_i(ch, task);
     g_idma_cntrl[ch].oldest_task = task->next_task;
 
     if((task->next_task == NULL) && (num_completed > 0U)) {
@@ -309,6 +318,9 @@ idma_task_processing_i(int32_t ch)
     IDMA_ENABLE_INTS();
     return IDMA_ERR_HW_ERROR;
   }
+
+  // Release the next bulk task once the task chain is consistent again
+  release_bulk_task_i(ch);
   IDMA_ENABLE_INTS();
   return IDMA_OK;
 }
@@ -457,27 +469,110 @@ add_jump(idma_buf_t * new_buf, idma_buf_t * old_buf)
   XLOG(new_buf->ch, "Add jump %p (%p) -> %p (%p)\n", old_buf, old_buf->last_desc, new_buf, new_buf->desc);
 }
 
-/*__attribute__((section(".idma.text"))) */
-idma_status_t
-queue_task(idma_buf_t *task)
+/*
+ * Task submission.
+ *
+ * Producers (threads and ISRs) put tasks on a bounded per-channel ring
+ * without masking interrupts. Slot (pos % IDMA_SUBMIT_RING_SIZE) holds
+ * position pos, its seq word tells the state of the position:
+ *
+ *   seq == pos          free, or claimed and not yet filled if pos < head
+ *   seq == pos + 1      filled, the task is published
+ *   seq == pos + SIZE   taken off the ring, free for the next lap
+ *
+ * A producer claims position head with a compare-and-swap of head from
+ * pos to pos + 1, which only succeeds if no other producer claimed it
+ * first. It then stores the task in the slot, issues MEMW and publishes
+ * the task by storing pos + 1 to seq. The MEMW orders the task pointer
+ * and the task fields written by the caller before the publishing store.
+ *
+ * There is a single consumer: tasks are taken off the ring and put on
+ * the HW queue with interrupts masked, one task per masked section. A
+ * channel must only be used from the core it belongs to, masking is what
+ * excludes the other producers. After publishing, a producer moves every
+ * published task to the HW queue before it returns.
+ *
+ * Ordering guarantees:
+ * - Tasks submitted from one context execute in submission order.
+ * - Tasks submitted from different contexts execute in the order they
+ *   were published. A producer preempted between claiming and filling
+ *   its slot is ordered after the preempting producers, which skip the
+ *   unfilled slot instead of waiting for it.
+ * - A task is on the HW queue when idma_schedule_task() returns.
+ * - If the ring is full because an unfilled slot is SIZE positions
+ *   behind head, the producer puts its task on the HW queue directly.
+ *
+ * Fixed-buffer mode is not affected, its descriptors are written in
+ * place in the ring buffer with interrupts masked.
+ */
+static int32_t
+push_submit_ring(int32_t ch, idma_buf_t *task)
+{
+  idma_submit_ring_t * ring = &g_idma_submit[ch];
+  uint32_t             pos;
+  uint32_t             slot;
+  int32_t              diff;
+
+  for (;;) {
+    pos  = ring->head;
+    slot = pos & (IDMA_SUBMIT_RING_SIZE - 1U);
+    diff = (int32_t)(ring->seq[slot] - pos);
+    if (diff < 0) {
+      // The slot still holds position pos - SIZE
+      return -1;
+    }
+    if ((diff == 0) && (IDMA_ATOMIC_CAS(&ring->head, pos, pos + 1U) == pos)) {
+      break;
+    }
+    // Another producer claimed pos first
+  }
+
+  ring->task[slot] = task;
+  XT_MEMW();
+  ring->seq[slot] = pos + 1U;
+  return 0;
+}
+
+/*
+ * Take the oldest published task off the ring, NULL if there is none.
+ * Called with interrupts disabled.
+ */
+static idma_buf_t *
+take_submit_ring_i(int32_t ch)
+{
+  idma_submit_ring_t * ring = &g_idma_submit[ch];
+  idma_buf_t *         task = NULL;
+  uint32_t             pos;
+  uint32_t             slot;
+
+  for (pos = ring->tail; pos != ring->head; pos++) {
+    slot = pos & (IDMA_SUBMIT_RING_SIZE - 1U);
+    if (ring->seq[slot] == (pos + 1U)) {
+      task = ring->task[slot];
+      ring->seq[slot] = pos + IDMA_SUBMIT_RING_SIZE;
+      break;
+    }
+  }
+
+  // Step over the positions taken so far
+  while ((ring->tail != ring->head) &&
+         (ring->seq[ring->tail & (IDMA_SUBMIT_RING_SIZE - 1U)] == (ring->tail + IDMA_SUBMIT_RING_SIZE))) {
+    ring->tail++;
+  }
+  return task;
+}
+
+/*
+ * Put a task on the HW queue. Called with interrupts disabled.
+ */
+static void
+publish_task_i(int32_t ch, idma_buf_t *task)
 {
 #ifdef IDMA_DEBUG
   uint32_t numdesc;
 #endif
   int32_t  busy;
-  int32_t  ch;
-  DECLARE_PS();
 
-  ch = task->ch;
-  if (g_idma_cntrl[ch].initialized == 0U) {
-    return IDMA_ERR_NOT_INIT;
-  }
-  if (g_idma_cntrl[ch].error.err_type != IDMA_NO_ERR) {
-    return IDMA_ERR_HW_ERROR;
-  }
-
-  IDMA_DISABLE_INTS();
-  task->status = task->num_descs;
   busy = idma_busy_i(ch);
   if ( ( (busy > 0) || (g_idma_cntrl[ch].num_outstanding > 0U))  && (g_idma_cntrl[ch].newest_task != NULL)) {
     idma_buf_t* old_task = g_idma_cntrl[ch].newest_task;
@@ -504,11 +599,313 @@ queue_task(idma_buf_t *task)
   idma_enable_i(ch);
   /* Queue the descriptor(s) */
   WRITE_IDMA_REG(ch, IDMA_REG_DESC_INC, (uint32_t)task->status);
-  IDMA_ENABLE_INTS();
+}
+
+/*
+ * Move the published tasks of the ring to the HW queue.
+ */
+static void
+drain_submit_ring(int32_t ch)
+{
+  idma_buf_t * task;
+  DECLARE_PS();
+
+  while (g_idma_submit[ch].tail != g_idma_submit[ch].head) {
+    IDMA_DISABLE_INTS();
+    task = take_submit_ring_i(ch);
+    if (task != NULL) {
+      publish_task_i(ch, task);
+    }
+    IDMA_ENABLE_INTS();
+
+    if (task == NULL) {
+      // Only unfilled slots left, their producers publish them
+      break;
+    }
+  }
+}
+
+/*__attribute__((section(".idma.text"))) */
+static idma_status_t
+queue_task_i(idma_buf_t *task)
+{
+  int32_t  ch;
+  DECLARE_PS();
+
+  ch = task->ch;
+  if (g_idma_cntrl[ch].initialized == 0U) {
+    return IDMA_ERR_NOT_INIT;
+  }
+  if (g_idma_cntrl[ch].error.err_type != IDMA_NO_ERR) {
+    return IDMA_ERR_HW_ERROR;
+  }
+
+  task->status = task->num_descs;
+  if (push_submit_ring(ch, task) != 0) {
+    drain_submit_ring(ch);
+    IDMA_DISABLE_INTS();
+    publish_task_i(ch, task);
+    IDMA_ENABLE_INTS();
+    return IDMA_OK;
+  }
+
+  drain_submit_ring(ch);
+  return IDMA_OK;
+}
+
+idma_status_t
+queue_task(idma_buf_t *task)
+{
+  task->prio          = (int32_t)IDMA_PRIO_HIGH;
+  task->submit_cycles = xthal_get_ccount();
+  return queue_task_i(task);
+}
+
+/******************** PRIORITY CLASSES **********************/
+
+/*
+ * Account the latency of a retired task and free the bulk slot
+ * if it was the active bulk task. Called with interrupts disabled.
+ */
+static void
+retire_task_i(int32_t ch, idma_buf_t *task)
+{
+  uint32_t            cycles = xthal_get_ccount() - task->submit_cycles;
+  idma_prio_stats_t * stats  = &g_idma_prio[ch].stats[task->prio];
+
+  if ((stats->count == 0U) || (cycles < stats->min_cycles)) {
+    stats->min_cycles = cycles;
+  }
+  if (cycles > stats->max_cycles) {
+    stats->max_cycles = cycles;
+  }
+  stats->total_cycles += cycles;
+  stats->count++;
+
+  if (task == g_idma_prio[ch].bulk_active) {
+    g_idma_prio[ch].bulk_active = NULL;
+  }
+}
+
+/*
+ * Move the oldest waiting bulk task to the HW queue if no bulk task
+ * is on it. A task that cannot be queued is aborted. Called with
+ * interrupts disabled.
+ */
+static void
+release_bulk_task_i(int32_t ch)
+{
+  idma_buf_t * task = g_idma_prio[ch].bulk_head;
+
+  if ((g_idma_prio[ch].bulk_active != NULL) || (task == NULL)) {
+    return;
+  }
+
+  g_idma_prio[ch].bulk_head = task->next_task;
+  if (g_idma_prio[ch].bulk_head == NULL) {
+    g_idma_prio[ch].bulk_tail = NULL;
+  }
 
+  XLOG(ch, "Release bulk task %p\n", task);
+  g_idma_prio[ch].bulk_active = task;
+  if (queue_task_i(task) != IDMA_OK) {
+    XLOG(ch, "Bulk task %p: aborted\n", task);
+    g_idma_prio[ch].bulk_active = NULL;
+    task->status = (int32_t)IDMA_TASK_ABORTED;
+    if (task->cb_func != NULL) {
+      (*task->cb_func)(task->cb_data);
+    }
+  }
+}
+
+/*
+ * Abort the bulk tasks that did not reach the HW queue.
+ */
+static void
+abort_bulk_tasks_i(int32_t ch)
+{
+  idma_buf_t * task = g_idma_prio[ch].bulk_head;
+
+  g_idma_prio[ch].bulk_head   = NULL;
+  g_idma_prio[ch].bulk_tail   = NULL;
+  g_idma_prio[ch].bulk_active = NULL;
+  abort_tasks(task);
+}
+
+idma_status_t
+idma_schedule_task_prio(idma_buffer_t *taskh, idma_prio_t prio)
+{
+  idma_buf_t *  task;
+  int32_t       ch;
+  DECLARE_PS();
+
+  task = convert_buffer_to_buf(taskh);
+  if (prio == IDMA_PRIO_HIGH) {
+    return queue_task(task);
+  }
+  if (prio != IDMA_PRIO_BULK) {
+    return IDMA_ERR_BAD_TASK;
+  }
+
+  ch = task->ch;
+  if (g_idma_cntrl[ch].initialized == 0U) {
+    return IDMA_ERR_NOT_INIT;
+  }
+  if (g_idma_cntrl[ch].error.err_type != IDMA_NO_ERR) {
+    return IDMA_ERR_HW_ERROR;
+  }
+
+  task->prio          = (int32_t)IDMA_PRIO_BULK;
+  task->submit_cycles = xthal_get_ccount();
+  task->status        = task->num_descs;
+  task->next_task     = NULL;
+
+  IDMA_DISABLE_INTS();
+  if (g_idma_prio[ch].bulk_tail != NULL) {
+    g_idma_prio[ch].bulk_tail->next_task = task;
+  }
+  else {
+    g_idma_prio[ch].bulk_head = task;
+  }
+  g_idma_prio[ch].bulk_tail = task;
+  XLOG(ch, "Queue bulk task %p w/ %d descs\n", task, task->num_descs);
+
+  release_bulk_task_i(ch);
+  IDMA_ENABLE_INTS();
   return IDMA_OK;
 }
 
+/*
+ * Queue the next chunk of a bulk copy.
+ */
+static idma_status_t
+queue_bulk_chunk(int32_t ch, idma_bulk_t *bulk)
+{
+  idma_buffer_t * taskh;
+  idma_buf_t *    task;
+  uint32_t        size = bulk->remaining;
+
+  if (size > g_idma_prio[ch].chunk_size) {
+    size = g_idma_prio[ch].chunk_size;
+  }
+
+  // Alternate the chunk tasks, the previous one may still be in the
+  // middle of retirement. Tasks were initialized with the first chunk,
+  // only rewind the descriptor.
+  bulk->cur ^= 1;
+  taskh = bulk->task[bulk->cur];
+  task  = convert_buffer_to_buf(taskh);
+  task->next_add_desc = &task->desc;
+  (void) idma_add_desc(taskh, bulk->dst, bulk->src, size, bulk->flags);
+
+  bulk->status     = (int32_t)bulk->remaining;
+  bulk->dst       += size;
+  bulk->src       += size;
+  bulk->remaining -= size;
+  return idma_schedule_task_prio(taskh, IDMA_PRIO_BULK);
+}
+
+/*
+ * Chunk completion callback, queues the next chunk.
+ */
+static void
+bulk_chunk_done(void *arg)
+{
+  idma_bulk_t * bulk = (idma_bulk_t *)arg;
+  idma_buf_t *  task = convert_buffer_to_buf(bulk->task[bulk->cur]);
+
+  if (task->status > (int32_t)IDMA_TASK_DONE) {
+    return;
+  }
+
+  if (task->status < (int32_t)IDMA_TASK_DONE) {
+    bulk->status = task->status;
+  }
+  else if (bulk->remaining == 0U) {
+    bulk->status = (int32_t)IDMA_TASK_DONE;
+  }
+  else if (queue_bulk_chunk(task->ch, bulk) == IDMA_OK) {
+    return;
+  }
+  else {
+    bulk->status = (int32_t)IDMA_TASK_ABORTED;
+  }
+
+  bulk->remaining = 0;
+  if (bulk->cb_func != NULL) {
+    (*bulk->cb_func)(bulk->cb_data);
+  }
+}
+
+idma_status_t
+idma_copy_bulk_task_i(int32_t ch,
+                      idma_bulk_t *bulk,
+                      void *dst,
+                      void *src,
+                      size_t size,
+                      uint32_t flags,
+                      void *cb_data,
+                      idma_callback_fn cb_func)
+{
+  idma_status_t ret;
+
+  if (bulk == NULL) {
+    return IDMA_ERR_BAD_TASK;
+  }
+  if (size == 0U) {
+    return IDMA_ERR_TASK_EMPTY;
+  }
+
+  ret = idma_init_task_ii(ch, bulk->task[0], IDMA_1D_DESC, 1, bulk_chunk_done, bulk);
+  if (ret == IDMA_OK) {
+    ret = idma_init_task_ii(ch, bulk->task[1], IDMA_1D_DESC, 1, bulk_chunk_done, bulk);
+  }
+  if (ret != IDMA_OK) {
+    return ret;
+  }
+
+  bulk->dst       = (uint8_t *)dst;
+  bulk->src       = (uint8_t *)src;
+  bulk->remaining = (uint32_t)size;
+  bulk->flags     = flags | DESC_NOTIFY_W_INT;
+  bulk->cb_func   = cb_func;
+  bulk->cb_data   = cb_data;
+  bulk->cur       = 1;
+  return queue_bulk_chunk(ch, bulk);
+}
+
+void
+idma_set_bulk_chunk_i(int32_t ch, uint32_t size)
+{
+  g_idma_prio[ch].chunk_size = (size == 0U) ? IDMA_BULK_CHUNK_DEFAULT : size;
+}
+
+void
+idma_get_prio_stats_i(int32_t ch, idma_prio_t prio, idma_prio_stats_t *stats)
+{
+  DECLARE_PS();
+
+  IDMA_DISABLE_INTS();
+  *stats = g_idma_prio[ch].stats[prio];
+  IDMA_ENABLE_INTS();
+}
+
+void
+idma_reset_prio_stats_i(int32_t ch)
+{
+  int32_t i;
+  DECLARE_PS();
+
+  IDMA_DISABLE_INTS();
+  for (i = 0; i < (int32_t)IDMA_PRIO_NUM_CLASSES; i++) {
+    g_idma_prio[ch].stats[i].count        = 0;
+    g_idma_prio[ch].stats[i].min_cycles   = 0;
+    g_idma_prio[ch].stats[i].max_cycles   = 0;
+    g_idma_prio[ch].stats[i].total_cycles = 0;
+  }
+  IDMA_ENABLE_INTS();
+}
+
 
 /********** API ***************/
 
@@ -534,6 +931,7 @@ idma_init_i(int32_t              ch,
             idma_err_callback_fn err_cb_func)
 {
   DECLARE_PS();
+  uint32_t i;
   uint32_t haltable  = 0U;
   uint32_t maxpifreq = pif_req;
   idma_max_block_t bsz = block_sz;
@@ -584,6 +982,20 @@ idma_init_i(int32_t              ch,
   g_idma_cntrl[ch].oldest_task     = NULL;
   g_idma_cntrl[ch].newest_task     = NULL;
 
+  g_idma_submit[ch].head           = 0;
+  g_idma_submit[ch].tail           = 0;
+  for (i = 0U; i < IDMA_SUBMIT_RING_SIZE; i++) {
+    g_idma_submit[ch].seq[i]       = i;
+    g_idma_submit[ch].task[i]      = NULL;
+  }
+
+  g_idma_prio[ch].bulk_head        = NULL;
+  g_idma_prio[ch].bulk_tail        = NULL;
+  g_idma_prio[ch].bulk_active      = NULL;
+  if (g_idma_prio[ch].chunk_size == 0U) {
+    g_idma_prio[ch].chunk_size     = IDMA_BULK_CHUNK_DEFAULT;
+  }
+
   g_idma_cntrl[ch].err_cb_func     = err_cb_func;
   g_idma_cntrl[ch].error.err_type  = 0;
   g_idma_cntrl[ch].error.currDesc  = 0;
@@ -1054,6 +1466,7 @@ idma_abort_tasks_i(int32_t ch)
   idma_reset_i(ch);
 
   abort_tasks(task);
+  abort_bulk_tasks_i(ch);
   return IDMA_OK;
 }
 
@@ -1076,6 +1489,9 @@ idma_init_loop_i (int32_t          ch,
   uint32_t *    last_desc_ptr;
   uint32_t      last_desc_val;
   int32_t       ret = 0;
+#ifndef IDMA_USE_XTOS
+  DECLARE_PS();
+#endif
 
   if ((ch >= XCHAL_IDMA_NUM_CHANNELS) || (bufh == NULL)) {
     return IDMA_ERR_BAD_INIT;
@@ -1092,10 +1508,21 @@ idma_init_loop_i (int32_t          ch,
 
   // For XTOS mode, disable the channel and bind the buffer to it.
   // For OS mode, we cannot disable the channel because it might be
-  // active. Set the thread's active buffer pointer.
+  // active. Set the thread's active buffer pointer. A completed buffer
+  // stays bound to the channel, so if this buffer is bound and the
+  // channel is idle, restart the channel at the first descriptor.
+  // Else the next schedule would continue where the HW stopped.
 #ifdef IDMA_USE_XTOS
   idma_disable_ii(ch);
   idma_set_start_address_i(ch, desc);
+#else
+  IDMA_DISABLE_INTS();
+  if ((g_idma_buf_ptr[ch] == buf) && (hw_num_outstanding(ch) == 0U)) {
+    idma_disable_ii(ch);
+    idma_set_start_address_i(ch, desc);
+    XLOG(ch, "Restart bound buf %p at %p\n", buf, desc);
+  }
+  IDMA_ENABLE_INTS();
 #endif
   idma_chan_buf_set(ch, buf);
 
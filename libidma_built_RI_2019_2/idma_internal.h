@@ -67,10 +67,37 @@ typedef struct idma_cntrl_struct {
   idma_error_details_t  error;
 } idma_cntrl_t;
 
+typedef struct idma_prio_cntrl_struct {
+  idma_buf_t*       bulk_head;      // Bulk tasks waiting for the HW queue
+  idma_buf_t*       bulk_tail;
+  idma_buf_t*       bulk_active;    // Bulk task on the HW queue, NULL if none
+  uint32_t          chunk_size;     // Chunk size of bulk copies
+  idma_prio_stats_t stats[IDMA_PRIO_NUM_CLASSES];
+} idma_prio_cntrl_t;
+
+/* Slots of the per-channel submission ring, must be a power of 2 */
+#ifndef IDMA_SUBMIT_RING_SIZE
+#define IDMA_SUBMIT_RING_SIZE   8U
+#endif
+
+typedef struct idma_submit_ring_struct {
+  volatile uint32_t     head;                           // Next position to claim
+  uint32_t              tail;                           // Oldest position not yet taken
+  volatile uint32_t     seq[IDMA_SUBMIT_RING_SIZE];     // Slot state, see queue_task_i()
+  idma_buf_t * volatile task[IDMA_SUBMIT_RING_SIZE];
+} idma_submit_ring_t;
+
 #ifdef __cplusplus
 }
 #endif
 
+/* Compare-and-swap of a 32-bit word, returns the previous value. Uses S32C1I
+ * or L32EX/S32EX where the core has them, else the HAL masks interrupts
+ * around the update.
+ */
+#define IDMA_ATOMIC_CAS(addr, cmp, set) \
+        ((uint32_t) xthal_compare_and_set((int32_t *) (addr), (int32_t) (cmp), (int32_t) (set)))
+
 /* Settings reg */
 #define IDMA_MAX_BLOCK_SIZE_SHIFT	2
 #define IDMA_MAX_BLOCK_SIZE_MASK	3U
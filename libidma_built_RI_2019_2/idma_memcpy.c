@@ -0,0 +1,538 @@
+/*
+ * Copyright (c) 2019 by Cadence Design Systems. ALL RIGHTS RESERVED.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#define IDMA_BUILD
+
+#include <stdint.h>
+#include <string.h>
+
+#include "idma_internal.h"
+#include "idma_memcpy.h"
+
+#if defined(XCHAL_HAVE_VISION) && XCHAL_HAVE_VISION
+#include <xtensa/tie/xt_ivpn.h>
+#endif
+
+// Rows per 2D descriptor are limited by the descriptor field
+#define IDMA_MEMCPY_MAX_ROWS    0xFFFFU
+
+// Chunks of a split 1D copy start on this boundary
+#define IDMA_MEMCPY_SPLIT_ALIGN 64U
+
+// Timed runs per size during calibration, the fastest one counts
+#define IDMA_CALIB_RUNS         3
+
+static idma_memcpy_model_t g_memcpy_model = {
+  IDMA_MEMCPY_CPU_MAX_DEFAULT,
+  IDMA_MEMCPY_SPLIT_MIN_DEFAULT,
+  1U << IDMA_CHANNEL_0
+};
+
+// Rotates single descriptor copies over the channels of the model
+static uint32_t g_memcpy_next_ch;
+
+// Descriptors of the calibration copies
+static idma_memcpy_t g_calib_handle IDMA_DRAM;
+
+static int32_t
+count_channels(uint32_t ch_mask)
+{
+  int32_t ch;
+  int32_t count = 0;
+
+  for (ch = 0; ch < XCHAL_IDMA_NUM_CHANNELS; ch++) {
+    if ((ch_mask & (1U << (uint32_t)ch)) != 0U) {
+      count++;
+    }
+  }
+  return count;
+}
+
+// Returns the channel of the n-th set bit of the mask
+static int32_t
+nth_channel(uint32_t ch_mask, int32_t n)
+{
+  int32_t ch;
+  int32_t count = n;
+
+  for (ch = 0; ch < XCHAL_IDMA_NUM_CHANNELS; ch++) {
+    if ((ch_mask & (1U << (uint32_t)ch)) != 0U) {
+      if (count == 0) {
+        break;
+      }
+      count--;
+    }
+  }
+  return ch;
+}
+
+static int32_t
+next_channel(uint32_t ch_mask)
+{
+  uint32_t n = g_memcpy_next_ch++;
+
+  return nth_channel(ch_mask, (int32_t)(n % (uint32_t)count_channels(ch_mask)));
+}
+
+static void
+begin_request(idma_memcpy_t *handle)
+{
+  handle->num_tasks = 0;
+  handle->status    = IDMA_OK;
+}
+
+// Local data RAM is not cached and needs no cache maintenance
+static int32_t
+is_dataram(const uint8_t *ptr)
+{
+  uintptr_t addr = (uintptr_t)ptr;
+
+  return ((((addr - (uintptr_t)IDMA_DATARAM0_ADDR) < (uintptr_t)IDMA_DATARAM0_SIZE) ||
+           ((addr - (uintptr_t)IDMA_DATARAM1_ADDR) < (uintptr_t)IDMA_DATARAM1_SIZE)) ? 1 : 0);
+}
+
+// Writes back cached lines written by the core, so that the iDMA reads
+// them: the source of a DMA copy, the destination of a core copy.
+static void
+writeback_region(const uint8_t *ptr, uint32_t size)
+{
+#if XCHAL_DCACHE_SIZE > 0
+  if ((size > 0U) && (is_dataram(ptr) == 0)) {
+    xthal_dcache_region_writeback((void *)ptr, size);
+  }
+#else
+  (void) ptr;
+  (void) size;
+#endif
+}
+
+// Writes back and invalidates the destination lines of a DMA copy before
+// it is started, so that no dirty line is evicted over the data written
+// by the iDMA and the core reads that data from memory.
+static void
+invalidate_dst(uint8_t *ptr, uint32_t size)
+{
+#if XCHAL_DCACHE_SIZE > 0
+  if ((size > 0U) && (is_dataram(ptr) == 0)) {
+    xthal_dcache_region_writeback_inv(ptr, size);
+  }
+#else
+  (void) ptr;
+  (void) size;
+#endif
+}
+
+// Core copy, with unaligned Vision vector loads and stores if the core
+// has them
+static void
+cpu_copy(uint8_t *dst, const uint8_t *src, uint32_t size)
+{
+#if defined(XCHAL_HAVE_VISION) && XCHAL_HAVE_VISION
+  xb_vec2Nx8U * psrc = (xb_vec2Nx8U *)src;
+  xb_vec2Nx8U * pdst = (xb_vec2Nx8U *)dst;
+  xb_vec2Nx8U   vec;
+  valign        va_src;
+  valign        va_dst = IVP_ZALIGN();
+  int32_t       n;
+
+  va_src = IVP_LA2NX8U_PP(psrc);
+  for (n = (int32_t)size; n > 0; n -= (2 * IVP_SIMD_WIDTH)) {
+    IVP_LAV2NX8U_XP(vec, va_src, psrc, n);
+    IVP_SAV2NX8U_XP(vec, va_dst, pdst, n);
+  }
+  IVP_SAPOS2NX8U_FP(va_dst, pdst);
+#else
+  (void) memcpy(dst, src, size);
+#endif
+}
+
+// Core memset, with Vision vector stores if the core has them
+static void
+cpu_set(uint8_t *dst, int32_t value, uint32_t size)
+{
+#if defined(XCHAL_HAVE_VISION) && XCHAL_HAVE_VISION
+  xb_vec2Nx8U * pdst = (xb_vec2Nx8U *)dst;
+  xb_vec2Nx8U   vec  = (uint8_t)value;
+  valign        va_dst = IVP_ZALIGN();
+  int32_t       n;
+
+  for (n = (int32_t)size; n > 0; n -= (2 * IVP_SIMD_WIDTH)) {
+    IVP_SAV2NX8U_XP(vec, va_dst, pdst, n);
+  }
+  IVP_SAPOS2NX8U_FP(va_dst, pdst);
+#else
+  (void) memset(dst, value, size);
+#endif
+}
+
+static idma_status_t
+add_task_1d(idma_memcpy_t *handle, int32_t ch, uint8_t *dst, const uint8_t *src, uint32_t size)
+{
+  idma_status_t ret;
+
+  ret = idma_copy_task_i(ch, handle->task[handle->num_tasks], dst, (void *)src, size,
+                         DESC_NOTIFY_W_INT, NULL, NULL);
+  if (ret == IDMA_OK) {
+    handle->num_tasks++;
+  }
+  else {
+    handle->status = ret;
+  }
+  return ret;
+}
+
+static idma_status_t
+add_task_2d(idma_memcpy_t *handle, int32_t ch, uint8_t *dst, const uint8_t *src, uint32_t row_sz,
+            uint32_t nrows, uint32_t src_pitch, uint32_t dst_pitch)
+{
+  idma_status_t ret;
+
+  if (nrows > IDMA_MEMCPY_MAX_ROWS) {
+    handle->status = IDMA_ERR_BAD_DESC;
+    return IDMA_ERR_BAD_DESC;
+  }
+
+  ret = idma_copy_2d_task_i(ch, handle->task[handle->num_tasks], dst, (void *)src, row_sz,
+                            DESC_NOTIFY_W_INT, nrows, src_pitch, dst_pitch, NULL, NULL);
+  if (ret == IDMA_OK) {
+    handle->num_tasks++;
+  }
+  else {
+    handle->status = ret;
+  }
+  return ret;
+}
+
+// 1D copy on one channel, or one chunk per channel of ch_mask if split
+static idma_status_t
+copy_1d_dma(idma_memcpy_t *handle, uint32_t ch_mask, int32_t split, uint8_t *dst, const uint8_t *src, uint32_t size)
+{
+  idma_status_t ret;
+  int32_t       i;
+  int32_t       nch;
+  uint32_t      chunk;
+  uint32_t      part;
+  uint32_t      remaining = size;
+
+  begin_request(handle);
+  writeback_region(src, size);
+  invalidate_dst(dst, size);
+  if (split == 0) {
+    return add_task_1d(handle, next_channel(ch_mask), dst, src, size);
+  }
+
+  nch   = count_channels(ch_mask);
+  chunk = ((size / (uint32_t)nch) + IDMA_MEMCPY_SPLIT_ALIGN - 1U) & ~(IDMA_MEMCPY_SPLIT_ALIGN - 1U);
+  for (i = 0; (i < nch) && (remaining > 0U); i++) {
+    part = (remaining < chunk) ? remaining : chunk;
+    ret  = add_task_1d(handle, nth_channel(ch_mask, i), dst, src, part);
+    if (ret != IDMA_OK) {
+      return ret;
+    }
+    dst       += part;
+    src       += part;
+    remaining -= part;
+  }
+  return IDMA_OK;
+}
+
+// 2D copy on one channel, or split by rows across the channels of ch_mask
+static idma_status_t
+copy_2d_dma(idma_memcpy_t *handle, uint32_t ch_mask, int32_t split, uint8_t *dst, const uint8_t *src,
+            uint32_t row_sz, uint32_t nrows, uint32_t src_pitch, uint32_t dst_pitch)
+{
+  idma_status_t ret;
+  int32_t       i;
+  int32_t       nch;
+  uint32_t      rows_per_ch;
+  uint32_t      rows;
+  uint32_t      remaining = nrows;
+
+  begin_request(handle);
+  if (nrows > 0U) {
+    writeback_region(src, ((nrows - 1U) * src_pitch) + row_sz);
+    invalidate_dst(dst, ((nrows - 1U) * dst_pitch) + row_sz);
+  }
+  if (split == 0) {
+    return add_task_2d(handle, next_channel(ch_mask), dst, src, row_sz, nrows, src_pitch, dst_pitch);
+  }
+
+  nch         = count_channels(ch_mask);
+  rows_per_ch = (nrows + (uint32_t)nch - 1U) / (uint32_t)nch;
+  for (i = 0; (i < nch) && (remaining > 0U); i++) {
+    rows = (remaining < rows_per_ch) ? remaining : rows_per_ch;
+    ret  = add_task_2d(handle, nth_channel(ch_mask, i), dst, src, row_sz, rows, src_pitch, dst_pitch);
+    if (ret != IDMA_OK) {
+      return ret;
+    }
+    dst       += rows * dst_pitch;
+    src       += rows * src_pitch;
+    remaining -= rows;
+  }
+  return IDMA_OK;
+}
+
+idma_status_t
+idma_memcpy_set_model(const idma_memcpy_model_t *model)
+{
+  if ((model->ch_mask == 0U) || ((model->ch_mask >> XCHAL_IDMA_NUM_CHANNELS) != 0U)) {
+    return IDMA_ERR_BAD_CHAN;
+  }
+  g_memcpy_model = *model;
+  return IDMA_OK;
+}
+
+void
+idma_memcpy_get_model(idma_memcpy_model_t *model)
+{
+  *model = g_memcpy_model;
+}
+
+idma_status_t
+idma_memcpy_async(idma_memcpy_t *handle, void *dst, const void *src, size_t size)
+{
+  idma_memcpy_model_t model = g_memcpy_model;
+
+  if (size <= model.cpu_max) {
+    begin_request(handle);
+    cpu_copy((uint8_t *)dst, (const uint8_t *)src, (uint32_t)size);
+    writeback_region((const uint8_t *)dst, (uint32_t)size);
+    return IDMA_OK;
+  }
+
+  return copy_1d_dma(handle, model.ch_mask, (size >= model.split_min) ? 1 : 0,
+                     (uint8_t *)dst, (const uint8_t *)src, (uint32_t)size);
+}
+
+idma_status_t
+idma_memcpy_2d_async(idma_memcpy_t *handle, void *dst, const void *src, size_t row_sz,
+                     uint32_t nrows, uint32_t src_pitch, uint32_t dst_pitch)
+{
+  idma_memcpy_model_t model = g_memcpy_model;
+  uint8_t *           pdst  = (uint8_t *)dst;
+  const uint8_t *     psrc  = (const uint8_t *)src;
+  uint32_t            size;
+  uint32_t            row;
+
+  // The total size picks the strategy and must fit in 32 bits
+  if (((uint64_t)row_sz * nrows) > UINT32_MAX) {
+    begin_request(handle);
+    handle->status = IDMA_ERR_BAD_DESC;
+    return IDMA_ERR_BAD_DESC;
+  }
+  size = (uint32_t)row_sz * nrows;
+
+  if (size <= model.cpu_max) {
+    begin_request(handle);
+    for (row = 0; row < nrows; row++) {
+      cpu_copy(pdst, psrc, (uint32_t)row_sz);
+      writeback_region(pdst, (uint32_t)row_sz);
+      pdst += dst_pitch;
+      psrc += src_pitch;
+    }
+    return IDMA_OK;
+  }
+
+  return copy_2d_dma(handle, model.ch_mask, (size >= model.split_min) ? 1 : 0,
+                     pdst, psrc, (uint32_t)row_sz, nrows, src_pitch, dst_pitch);
+}
+
+idma_status_t
+idma_memset_async(idma_memcpy_t *handle, void *dst, int32_t value, size_t size)
+{
+  idma_memcpy_model_t model = g_memcpy_model;
+  uint8_t *           pdst  = (uint8_t *)dst;
+  uint32_t            nblocks;
+  uint32_t            tail;
+
+  if ((size <= model.cpu_max) || (size < (2U * IDMA_MEMSET_BLOCK))) {
+    begin_request(handle);
+    cpu_set(pdst, value, (uint32_t)size);
+    writeback_region(pdst, (uint32_t)size);
+    return IDMA_OK;
+  }
+
+  // Set the first block and the partial block at the end on the core,
+  // the iDMA copies the first block over the full blocks in between.
+  nblocks = ((uint32_t)size / IDMA_MEMSET_BLOCK) - 1U;
+  tail    = (uint32_t)size % IDMA_MEMSET_BLOCK;
+  cpu_set(pdst, value, IDMA_MEMSET_BLOCK);
+  if (tail > 0U) {
+    cpu_set(&pdst[size - tail], value, tail);
+    writeback_region(&pdst[size - tail], tail);
+  }
+
+  return copy_2d_dma(handle, model.ch_mask, (size >= model.split_min) ? 1 : 0,
+                     &pdst[IDMA_MEMSET_BLOCK], pdst, IDMA_MEMSET_BLOCK, nblocks, 0U, IDMA_MEMSET_BLOCK);
+}
+
+// Returns the descriptors outstanding over all tasks of the request,
+// the status of a failed task is stored in *error.
+static int32_t
+tasks_pending(idma_memcpy_t *handle, int32_t *error)
+{
+  int32_t i;
+  int32_t status;
+  int32_t pending = 0;
+
+  for (i = 0; i < handle->num_tasks; i++) {
+    status = idma_task_status(handle->task[i]);
+    if (status < 0) {
+      *error = status;
+    }
+    else {
+      pending += status;
+    }
+  }
+  return pending;
+}
+
+int32_t
+idma_memcpy_status(idma_memcpy_t *handle)
+{
+  int32_t error   = 0;
+  int32_t pending;
+
+  if (handle->status != IDMA_OK) {
+    return handle->status;
+  }
+
+  pending = tasks_pending(handle, &error);
+  return (error < 0) ? error : pending;
+}
+
+idma_status_t
+idma_memcpy_wait(idma_memcpy_t *handle)
+{
+  int32_t error = 0;
+  int32_t i;
+
+  // A failed task or a split request that failed part way may leave
+  // other chunks in flight, wait for them before the handle is reused.
+  while (tasks_pending(handle, &error) > 0) {
+    for (i = 0; i < handle->num_tasks; i++) {
+      (void) idma_process_tasks_i(convert_buffer_to_buf(handle->task[i])->ch);
+    }
+  }
+
+  if (handle->status != IDMA_OK) {
+    return (idma_status_t)handle->status;
+  }
+  return (error < 0) ? IDMA_ERR_TASK_IN_ERROR : IDMA_OK;
+}
+
+/******************** CALIBRATION **********************/
+
+static uint32_t
+time_cpu_copy(uint8_t *dst, const uint8_t *src, uint32_t size)
+{
+  uint32_t best = UINT32_MAX;
+  uint32_t start;
+  uint32_t cycles;
+  int32_t  run;
+
+  for (run = 0; run < IDMA_CALIB_RUNS; run++) {
+    start = xthal_get_ccount();
+    cpu_copy(dst, src, size);
+    cycles = xthal_get_ccount() - start;
+    best = (cycles < best) ? cycles : best;
+  }
+  return best;
+}
+
+// Returns the cycles from request to completion, 0 on error
+static uint32_t
+time_dma_copy(uint32_t ch_mask, int32_t split, uint8_t *dst, const uint8_t *src, uint32_t size)
+{
+  uint32_t best = UINT32_MAX;
+  uint32_t start;
+  uint32_t cycles;
+  int32_t  run;
+
+  for (run = 0; run < IDMA_CALIB_RUNS; run++) {
+    start = xthal_get_ccount();
+    if ((copy_1d_dma(&g_calib_handle, ch_mask, split, dst, src, size) != IDMA_OK) ||
+        (idma_memcpy_wait(&g_calib_handle) != IDMA_OK)) {
+      return 0;
+    }
+    cycles = xthal_get_ccount() - start;
+    best = (cycles < best) ? cycles : best;
+  }
+  return best;
+}
+
+idma_status_t
+idma_memcpy_calibrate(void *dst, void *src, size_t size, uint32_t ch_mask, idma_memcpy_model_t *model)
+{
+  idma_memcpy_model_t result;
+  uint8_t *           pdst = (uint8_t *)dst;
+  const uint8_t *     psrc = (const uint8_t *)src;
+  uint32_t            single_mask;
+  uint32_t            cpu;
+  uint32_t            single;
+  uint32_t            split;
+  uint32_t            sz;
+
+  if (size < 1024U) {
+    return IDMA_ERR_BAD_DESC;
+  }
+  if ((ch_mask == 0U) || ((ch_mask >> XCHAL_IDMA_NUM_CHANNELS) != 0U)) {
+    return IDMA_ERR_BAD_CHAN;
+  }
+
+  result.cpu_max   = 0;
+  result.split_min = UINT32_MAX;
+  result.ch_mask   = ch_mask;
+  single_mask      = 1U << (uint32_t)nth_channel(ch_mask, 0);
+
+  // Core copies up to the first size the iDMA is faster for
+  for (sz = 16U; sz <= (uint32_t)size; sz <<= 1) {
+    cpu    = time_cpu_copy(pdst, psrc, sz);
+    single = time_dma_copy(single_mask, 0, pdst, psrc, sz);
+    if (single == 0U) {
+      return IDMA_ERR_HW_ERROR;
+    }
+    if (cpu > single) {
+      break;
+    }
+    result.cpu_max = sz;
+  }
+
+  // Split from the first size where all channels beat one
+  if (count_channels(ch_mask) > 1) {
+    for (sz = (result.cpu_max < 512U) ? 1024U : (result.cpu_max << 1); sz <= (uint32_t)size; sz <<= 1) {
+      single = time_dma_copy(single_mask, 0, pdst, psrc, sz);
+      split  = time_dma_copy(ch_mask, 1, pdst, psrc, sz);
+      if ((single == 0U) || (split == 0U)) {
+        return IDMA_ERR_HW_ERROR;
+      }
+      if (split < single) {
+        result.split_min = sz;
+        break;
+      }
+    }
+  }
+
+  if (model != NULL) {
+    *model = result;
+  }
+  return idma_memcpy_set_model(&result);
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2019 by Cadence Design Systems. ALL RIGHTS RESERVED.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef IDMA_MEMCPY_H__
+#define IDMA_MEMCPY_H__
+
+// Asynchronous memcpy/memset on top of the task mode API.
+//
+// Each request picks one of three strategies from a cost model:
+// - size <= cpu_max:   copied by the core before the call returns,
+//                      with Vision vector loads/stores if available,
+// - size <  split_min: one descriptor on one channel,
+// - otherwise:         split into one chunk per channel of ch_mask
+//                      (2D transfers are split by rows).
+// Requests return a handle that can be polled or waited for.
+// idma_memcpy_calibrate() measures the crossover points on the
+// actual source/destination memories.
+//
+// Channels in ch_mask must be initialized with idma_init() and used
+// in task mode only.
+//
+// Cached buffers need no cache maintenance by the caller. The source of
+// a DMA copy is written back and its destination written back and
+// invalidated before the copy starts. The destination of a core copy is
+// written back, so that later iDMA transfers read the new data.
+
+#include "idma.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define IDMA_MEMCPY_CPU_MAX_DEFAULT     256U
+#define IDMA_MEMCPY_SPLIT_MIN_DEFAULT   65536U
+
+// Bytes set by the core at the start of a DMA memset, the rest is
+// replicated from them by the iDMA.
+#define IDMA_MEMSET_BLOCK               256U
+
+typedef struct idma_memcpy_model_struct {
+  uint32_t  cpu_max;      /* Largest size copied by the core            */
+  uint32_t  split_min;    /* Smallest size split across channels        */
+  uint32_t  ch_mask;      /* Channels available for copies, bit per ch  */
+} idma_memcpy_model_t;
+
+/* Handle of an asynchronous copy - fields NOT TO BE USED BY APPLICATION.
+ * Holds the descriptors, so it must be in memory the iDMA can fetch
+ * descriptors from. */
+typedef struct idma_memcpy_struct {
+  idma_buffer_t  task[XCHAL_IDMA_NUM_CHANNELS][IDMA_BUFFER_SIZE(1, IDMA_2D_DESC)/sizeof(idma_buffer_t)] __attribute__ ((aligned(16)));
+  int32_t        num_tasks;   /* Tasks scheduled, 0 if copied by the core */
+  int32_t        status;      /* Error of the request, IDMA_OK if none    */
+} idma_memcpy_t;
+
+/**
+ * @name   Set the cost model.
+ * @param  model      New cost model. ch_mask must not be 0.
+ * @retval IDMA_OK    Successful.
+ * @retval !IDMA_OK   Error type.
+ */
+idma_status_t
+idma_memcpy_set_model(const idma_memcpy_model_t *model);
+
+/**
+ * @name   Get the cost model in use.
+ * @param  model      Copy of the cost model.
+ */
+void
+idma_memcpy_get_model(idma_memcpy_model_t *model);
+
+/**
+ * @name   Start a 1D copy.
+ * @param  handle     Copy handle, reusable once the copy completed.
+ * @param  dst...     Copy parameters as for memcpy().
+ * @retval IDMA_OK    Successful.
+ * @retval !IDMA_OK   Error type.
+ */
+idma_status_t
+idma_memcpy_async(idma_memcpy_t *handle, void *dst, const void *src, size_t size);
+
+/**
+ * @name   Start a 2D copy.
+ * @param  handle     Copy handle, reusable once the copy completed.
+ * @param  dst...     nrows rows of row_sz bytes, rows are src_pitch and
+ *                    dst_pitch bytes apart.
+ * @retval IDMA_OK    Successful.
+ * @retval !IDMA_OK   Error type.
+ */
+idma_status_t
+idma_memcpy_2d_async(idma_memcpy_t *handle, void *dst, const void *src, size_t row_sz,
+                     uint32_t nrows, uint32_t src_pitch, uint32_t dst_pitch);
+
+/**
+ * @name   Start a memset.
+ * @brief  The first IDMA_MEMSET_BLOCK bytes are set by the core, the
+ *         iDMA replicates them with a 2D descriptor of source pitch 0.
+ * @param  handle     Copy handle, reusable once the copy completed.
+ * @param  dst...     Parameters as for memset().
+ * @retval IDMA_OK    Successful.
+ * @retval !IDMA_OK   Error type.
+ */
+idma_status_t
+idma_memset_async(idma_memcpy_t *handle, void *dst, int32_t value, size_t size);
+
+/**
+ * @name   Get the status of a copy.
+ * @retval <  0   Error (task_status_t)
+ * @retval >= 0   Number of outstanding descriptors.
+ */
+int32_t
+idma_memcpy_status(idma_memcpy_t *handle);
+
+/**
+ * @name   Wait for a copy to complete.
+ * @brief  Polls the channels of the copy, so it works with and
+ *         without iDMA interrupts. If the copy failed, returns once
+ *         the parts of it already scheduled are done.
+ * @retval IDMA_OK    Copy completed.
+ * @retval !IDMA_OK   Error type.
+ */
+idma_status_t
+idma_memcpy_wait(idma_memcpy_t *handle);
+
+/**
+ * @name   Measure the crossover points of the cost model.
+ * @brief  Times core and iDMA copies of power of two sizes between the
+ *         given buffers and installs the resulting model. The buffers
+ *         should be in the memories the application copies between.
+ * @param  dst        Destination buffer.
+ * @param  src        Source buffer.
+ * @param  size       Size of both buffers, at least 1 KB.
+ * @param  ch_mask    Channels to use, bit per channel.
+ * @param  model      Resulting cost model, may be NULL.
+ * @retval IDMA_OK    Successful.
+ * @retval !IDMA_OK   Error type.
+ */
+idma_status_t
+idma_memcpy_calibrate(void *dst, void *src, size_t size, uint32_t ch_mask, idma_memcpy_model_t *model);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IDMA_MEMCPY_H__ */
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2019 by Cadence Design Systems. ALL RIGHTS RESERVED.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#define IDMA_BUILD
+
+#include <stdint.h>
+#include <string.h>
+
+#include "idma_internal.h"
+#include "idma_monitor.h"
+
+// Low bits of the control word, or 0 for a JUMP to the address it holds
+#define IDMA_DESC_CODE_MASK     UINT32_C(0x7)
+
+typedef struct idma_monitor_chan_struct {
+  idma_monitor_stats_t  stats;
+  uint32_t              last_desc;    /* IDMA_REG_CURR_DESC at the previous sample */
+  uint32_t              last_ccount;  /* Cycle count at the previous sample        */
+} idma_monitor_chan_t;
+
+static idma_monitor_chan_t g_monitor[XCHAL_IDMA_NUM_CHANNELS];
+static volatile uint32_t   g_monitor_mask;
+
+static uint32_t
+update_avg(uint32_t avg, uint32_t value)
+{
+  return avg - (avg >> IDMA_MONITOR_AVG_SHIFT) + (value >> IDMA_MONITOR_AVG_SHIFT);
+}
+
+static uint32_t
+hist_bin(uint32_t depth)
+{
+  uint32_t bin = 0;
+
+  while ((depth != 0U) && (bin < (IDMA_MONITOR_HIST_BINS - 1))) {
+    depth >>= 1;
+    bin++;
+  }
+  return bin;
+}
+
+// Sums the bytes of the descriptors from 'from' up to, not including,
+// 'to'. Returns the number of descriptors, or -1 if 'to' is not reached
+// within IDMA_MONITOR_MAX_WALK descriptors or a descriptor is unknown.
+static int32_t
+walk_descs(uint32_t from, uint32_t to, uint64_t *bytes)
+{
+  const idma_2d_desc_t *  desc;
+  const idma_desc64_t *   desc64;
+  uint32_t  addr  = from;
+  uint64_t  sum   = 0;
+  int32_t   count = 0;
+  int32_t   steps = 0;
+
+  while (addr != to) {
+    // JUMPs count as steps too, so that a JUMP loop ends the walk
+    if (steps++ >= (2 * IDMA_MONITOR_MAX_WALK)) {
+      return -1;
+    }
+    desc = (const idma_2d_desc_t *) cvt_uint32_to_voidp(addr);
+    switch (desc->control & IDMA_DESC_CODE_MASK) {
+    case IDMA_JMP_DESC_CODE:
+      addr = desc->control;
+      continue;
+    case IDMA_1D_DESC_CODE:
+      sum  += desc->size;
+      addr += sizeof(idma_desc_t);
+      break;
+    case IDMA_2D_DESC_CODE:
+      sum  += (uint64_t) desc->size * desc->nrows;
+      addr += sizeof(idma_2d_desc_t);
+      break;
+    case IDMA_64B_DESC_CODE:
+      desc64 = (const idma_desc64_t *) cvt_uint32_to_voidp(addr);
+      switch ((desc64->control >> IDMA_64B_SUBTYPE_SHIFT) & IDMA_64B_SUBTYPE_MASK) {
+      case IDMA_64B_1D_TYPE:
+        sum += (uint32_t) desc64->size;
+        break;
+      case IDMA_64B_3D_TYPE:
+        sum += (uint64_t)(uint32_t) desc64->size * (uint32_t) desc64->nrows * (uint32_t) desc64->ntiles;
+        break;
+      default:
+        sum += (uint64_t)(uint32_t) desc64->size * (uint32_t) desc64->nrows;
+        break;
+      }
+      addr += sizeof(idma_desc64_t);
+      break;
+    default:
+      return -1;
+    }
+    if (++count > IDMA_MONITOR_MAX_WALK) {
+      return -1;
+    }
+  }
+
+  *bytes = sum;
+  return count;
+}
+
+static void
+sample_channel(int32_t ch, uint32_t now)
+{
+  idma_monitor_chan_t *   mon   = &g_monitor[ch];
+  idma_monitor_stats_t *  stats = &mon->stats;
+  uint32_t  outstanding;
+  uint32_t  state;
+  uint32_t  curr;
+  uint32_t  cycles;
+  uint32_t  busy;
+  uint64_t  bytes = 0;
+  int32_t   descs;
+
+  outstanding = READ_IDMA_REG(ch, IDMA_REG_NUM_DESC);
+  state       = READ_IDMA_REG(ch, IDMA_REG_STATUS) & IDMA_STATE_MASK;
+  curr        = READ_IDMA_REG(ch, IDMA_REG_CURR_DESC);
+  // Only an active channel is busy. A halted or failed channel keeps its
+  // outstanding count but does not move data.
+  busy        = ((state == IDMA_STATE_BUSY) || (state == IDMA_STATE_STANDBY)) ? 1U : 0U;
+
+  cycles = now - mon->last_ccount;
+  mon->last_ccount = now;
+
+  descs = walk_descs(mon->last_desc, curr, &bytes);
+  mon->last_desc = curr;
+  if (descs < 0) {
+    stats->lost++;
+    descs = 0;
+    bytes = 0;
+  }
+
+  stats->samples++;
+  stats->cycles += cycles;
+  if (busy != 0U) {
+    stats->busy_samples++;
+    stats->busy_cycles += cycles;
+  }
+  stats->bytes += bytes;
+  stats->descs += (uint32_t) descs;
+  if (outstanding > stats->max_outstanding) {
+    stats->max_outstanding = outstanding;
+  }
+  stats->hist[hist_bin(outstanding)]++;
+
+  stats->avg_outstanding = update_avg(stats->avg_outstanding, outstanding << 8);
+  stats->avg_busy        = update_avg(stats->avg_busy, busy << 8);
+  stats->avg_bytes       = update_avg(stats->avg_bytes, (bytes > UINT32_MAX) ? UINT32_MAX : (uint32_t) bytes);
+
+  XLOG(ch, "Monitor: %d outstanding, state %d, %d descs (%d bytes) in %d cycles\n",
+       outstanding, state, descs, (uint32_t) bytes, cycles);
+}
+
+static void
+clear_channel(int32_t ch)
+{
+  (void) memset(&g_monitor[ch].stats, 0, sizeof(g_monitor[ch].stats));
+  g_monitor[ch].last_desc   = READ_IDMA_REG(ch, IDMA_REG_CURR_DESC);
+  g_monitor[ch].last_ccount = xthal_get_ccount();
+}
+
+idma_status_t
+idma_monitor_start(uint32_t ch_mask)
+{
+  int32_t ch;
+  DECLARE_PS();
+
+  if ((ch_mask == 0U) || ((ch_mask >> XCHAL_IDMA_NUM_CHANNELS) != 0U)) {
+    return IDMA_ERR_BAD_CHAN;
+  }
+
+  IDMA_DISABLE_INTS();
+  for (ch = 0; ch < XCHAL_IDMA_NUM_CHANNELS; ch++) {
+    if ((ch_mask & (1U << (uint32_t)ch)) != 0U) {
+      clear_channel(ch);
+    }
+  }
+  g_monitor_mask = ch_mask;
+  IDMA_ENABLE_INTS();
+  return IDMA_OK;
+}
+
+void
+idma_monitor_stop(void)
+{
+  g_monitor_mask = 0;
+}
+
+void
+idma_monitor_sample(void)
+{
+  uint32_t  mask;
+  uint32_t  now;
+  int32_t   ch;
+  DECLARE_PS();
+
+  IDMA_DISABLE_INTS();
+  mask = g_monitor_mask;
+  now  = xthal_get_ccount();
+  for (ch = 0; ch < XCHAL_IDMA_NUM_CHANNELS; ch++) {
+    if ((mask & (1U << (uint32_t)ch)) != 0U) {
+      sample_channel(ch, now);
+    }
+  }
+  IDMA_ENABLE_INTS();
+}
+
+idma_status_t
+idma_monitor_get(int32_t ch, idma_monitor_stats_t *stats)
+{
+  DECLARE_PS();
+
+  if ((ch < 0) || (ch >= XCHAL_IDMA_NUM_CHANNELS)) {
+    return IDMA_ERR_BAD_CHAN;
+  }
+  if (stats == NULL) {
+    return IDMA_ERR_BAD_DESC;
+  }
+
+  IDMA_DISABLE_INTS();
+  *stats = g_monitor[ch].stats;
+  IDMA_ENABLE_INTS();
+  return IDMA_OK;
+}
+
+idma_status_t
+idma_monitor_reset(int32_t ch)
+{
+  DECLARE_PS();
+
+  if ((ch < 0) || (ch >= XCHAL_IDMA_NUM_CHANNELS)) {
+    return IDMA_ERR_BAD_CHAN;
+  }
+
+  IDMA_DISABLE_INTS();
+  clear_channel(ch);
+  IDMA_ENABLE_INTS();
+  return IDMA_OK;
+}
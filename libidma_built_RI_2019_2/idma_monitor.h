@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2019 by Cadence Design Systems. ALL RIGHTS RESERVED.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef IDMA_MONITOR_H__
+#define IDMA_MONITOR_H__
+
+// Utilization monitor of the iDMA channels.
+//
+// idma_monitor_sample() reads the hardware state of the monitored
+// channels: outstanding descriptors, busy/idle state and the current
+// descriptor pointer. The descriptors the channel moved past since the
+// previous sample are walked to count the bytes they copy. Call it
+// periodically, e.g. from vApplicationTickHook() or a timer interrupt.
+//
+// From these samples the monitor keeps totals, a histogram of queue
+// depths and moving averages of queue depth, busy ratio and bytes per
+// sample. A channel that is busy in most samples with a deep queue
+// means a DMA-bound pipeline, a mostly idle one a compute-bound one.
+
+#include "idma.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Queue depth histogram: bin 0 counts samples without outstanding
+// descriptors, bin k samples with 2^(k-1) to 2^k - 1 descriptors.
+// The last bin also counts all deeper queues.
+#define IDMA_MONITOR_HIST_BINS          8
+
+// Moving averages weight a new sample by 1/2^IDMA_MONITOR_AVG_SHIFT
+#define IDMA_MONITOR_AVG_SHIFT          4
+
+// Descriptors walked per channel and sample. If the channel moved past
+// more, the bytes of the sample are not counted.
+#define IDMA_MONITOR_MAX_WALK           64
+
+typedef struct idma_monitor_stats_struct {
+  uint32_t  samples;          /* Samples taken                                   */
+  uint32_t  busy_samples;     /* Samples that found the channel busy             */
+  uint64_t  cycles;           /* Cycles covered by the samples                   */
+  uint64_t  busy_cycles;      /* Cycles of sample periods ending busy            */
+  uint64_t  bytes;            /* Bytes of the descriptors the channel moved past */
+  uint32_t  descs;            /* Descriptors the channel moved past              */
+  uint32_t  lost;             /* Samples whose bytes could not be counted        */
+  uint32_t  max_outstanding;  /* Deepest queue seen                              */
+  uint32_t  avg_outstanding;  /* Moving average of the queue depth, Q8           */
+  uint32_t  avg_busy;         /* Moving average of the busy ratio, Q8 (256=100%) */
+  uint32_t  avg_bytes;        /* Moving average of bytes per sample              */
+  uint32_t  hist[IDMA_MONITOR_HIST_BINS];  /* Samples per queue depth            */
+} idma_monitor_stats_t;
+
+/**
+ * @name   Start monitoring channels.
+ * @brief  Clears the statistics of the channels. Channels must be
+ *         initialized before.
+ * @param  ch_mask    Channels to monitor, bit per channel.
+ * @retval IDMA_OK    Successful.
+ * @retval !IDMA_OK   Error type.
+ */
+idma_status_t
+idma_monitor_start(uint32_t ch_mask);
+
+/**
+ * @name   Stop monitoring all channels.
+ * @brief  The statistics are kept until the next start.
+ */
+void
+idma_monitor_stop(void);
+
+/**
+ * @name   Sample the monitored channels.
+ * @brief  Can be called from interrupt handlers.
+ */
+void
+idma_monitor_sample(void);
+
+/**
+ * @name   Get the statistics of a channel.
+ * @param  ch         Selected iDMA HW channel.
+ * @param  stats      Copy of the statistics.
+ * @retval IDMA_OK    Successful.
+ * @retval !IDMA_OK   Error type.
+ */
+idma_status_t
+idma_monitor_get(int32_t ch, idma_monitor_stats_t *stats);
+
+/**
+ * @name   Clear the statistics of a channel.
+ * @param  ch         Selected iDMA HW channel.
+ * @retval IDMA_OK    Successful.
+ * @retval !IDMA_OK   Error type.
+ */
+idma_status_t
+idma_monitor_reset(int32_t ch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IDMA_MONITOR_H__ */
@@ -26,6 +26,7 @@
 
 #ifdef _FREERTOS_
   #include "FreeRTOS.h"
+  #include "task.h"
   #include "semphr.h"
   //#include "xtensa_rtos.h"
 
@@ -59,6 +60,9 @@ static ALIGNDCACHE idma_buf_t * buf_list[XCHAL_IDMA_NUM_CHANNELS];
 
 #ifdef _FREERTOS_
   QueueHandle_t IDMA_SEMA;
+
+  // Interrupt nesting level, maintained by the port.
+  extern unsigned port_interruptNesting;
 #endif
 
 
@@ -75,7 +79,9 @@ idma_task_done_intr_handler_freertos(void * arg)
 {
   int32_t ch = cvt_voidp_to_int32(arg);
   int ret;
-  BaseType_t pxHigherPriorityTaskWoken;
+  BaseType_t pxHigherPriorityTaskWoken = pdFALSE;
+
+  portbenchmarkIntEntry(portbenchmarkSRC_IDMA_DONE);
 
   XLOG(ch, "task_done intr\n");
   // Return value not useful here.
@@ -88,6 +94,9 @@ idma_task_done_intr_handler_freertos(void * arg)
 	  K_ASSERT(0, "idma_task_done_intr_handler_freertos\n");
   if(ret != pdTRUE)
 	  K_ASSERT(0, "idma_task_done_intr_handler_freertos");
+
+  // Switch to the waiting task on interrupt exit, not on the next tick.
+  portYIELD_FROM_ISR(pxHigherPriorityTaskWoken);
 }
 
 void
@@ -95,6 +104,8 @@ idma_task_err_intr_handler_freertos(void * arg)
 {
   int32_t ch = cvt_voidp_to_int32(arg);
 
+  portbenchmarkIntEntry(portbenchmarkSRC_IDMA_ERR);
+
   XLOG(ch, "task_err intr\n");
   // Return value not useful here.
   (void) idma_task_processing_i(ch);
@@ -230,7 +241,18 @@ idma_thread_block(void * thread) // parasoft-suppress MISRA2012-RULE-8_13_a-4 "C
    // (void) thread;    // Unused
 
 #ifdef _FREERTOS_
-    K_ASSERT(0, "should not call here");
+    // Called by idma_sleep() with interrupts disabled. Block on the task
+    // notification so the kernel can run other tasks, or sleep in the idle
+    // task with the tick suppressed, until the done interrupt wakes us up.
+    // A notification given before we got here is not lost.
+    (void) thread;
+#if (configGENERATE_RUN_TIME_STATS == 1)
+    vTaskSetWaitReason(eWaitDMA);
+#endif
+    (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#if (configGENERATE_RUN_TIME_STATS == 1)
+    vTaskSetWaitReason(eWaitNone);
+#endif
 #else
 
 
@@ -252,7 +274,18 @@ idma_thread_unblock(void * thread) // parasoft-suppress MISRA2012-RULE-8_13_a-4
    // (void) thread;    // Unused
 
 #ifdef _FREERTOS_
-    K_ASSERT(0, "should not call here");
+    // thread is the handle of the task blocked in idma_sleep().
+    if (thread != NULL) {
+        if (port_interruptNesting != 0U) {
+            BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+            vTaskNotifyGiveFromISR((TaskHandle_t) thread, &xHigherPriorityTaskWoken);
+            portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+        }
+        else {
+            (void) xTaskNotifyGive((TaskHandle_t) thread);
+        }
+    }
 #else
 
 #endif
@@ -29,6 +29,32 @@
 extern idma_cntrl_t   g_idma_cntrl[XCHAL_IDMA_NUM_CHANNELS];
 extern char           g_idmalogbuf[IDMA_LOG_SIZE];
 
+/* Arguments of a message, from a va_list or from a deferred log event */
+typedef struct {
+  va_list          ap;
+  const uint32_t * argv;    /* NULL if the arguments are in ap */
+  int32_t          argc;    /* Arguments left in argv          */
+} xt_args_t;
+
+static uint32_t
+xt_next_arg(xt_args_t *args)
+{
+  uint32_t val = 0;
+
+  if (args->argv == NULL) {
+    val = va_arg(args->ap, uint32_t);
+  }
+  else if (args->argc > 0) {
+    val = *args->argv;
+    args->argv++;
+    args->argc--;
+  }
+  else {
+    /* More conversions than stored arguments */
+  }
+  return val;
+}
+
 static void
 xt_output(char **outargp, char *inarg, int32_t count, int32_t *lim)
 {
@@ -45,7 +71,7 @@ xt_output(char **outargp, char *inarg, int32_t count, int32_t *lim)
  * Base formatting routine, used internally.
  */
 static int32_t
-xt_vprint(void * outarg, const char * fmth, va_list ap, int32_t size)
+xt_vprint(void * outarg, const char * fmth, xt_args_t *args, int32_t size)
 {
     const char* fmt = fmth;
     int32_t    total = 0;
@@ -76,7 +102,7 @@ xt_vprint(void * outarg, const char * fmth, va_list ap, int32_t size)
 		  break;
 
                 case 's':
-                    s = va_arg(ap, char*);
+                    s = (char *) cvt_uint32_to_voidp(xt_next_arg(args));
                     if (s == (char)0) {
                      s = (char*)"(null)";
                     }
@@ -86,7 +112,7 @@ xt_vprint(void * outarg, const char * fmth, va_list ap, int32_t size)
                     break;
 
                 case 'd':
-                    n = va_arg(ap, int32_t);
+                    n = xt_next_arg(args);
                     if ((int32_t)n < 0) {
                         sign = '-';
                         n = -(int32_t)n;
@@ -105,7 +131,7 @@ xt_vprint(void * outarg, const char * fmth, va_list ap, int32_t size)
                     goto do_decimal;
 
                 case 'u':
-                    n = va_arg(ap, int32_t);
+                    n = xt_next_arg(args);
 do_decimal:
                     {
                         /*  (avoids division or multiplication)  */
@@ -148,7 +174,7 @@ do_decimal:
                     width = (int32_t)sizeof(void *) * 2;
 
                 case 'x':
-                    n = va_arg(ap, uint32_t);
+                    n = xt_next_arg(args);
                     s = &buf[8];
                     do {
                         --s;
@@ -199,7 +225,7 @@ void
 idma_print(int ch, const char* fmt,...)
 {
   int32_t n = 0;
-  va_list ap;
+  xt_args_t args;
 
   if(!g_idma_cntrl[IDMA_CHANNEL_0].xlogh) {
     return;
@@ -211,14 +237,129 @@ idma_print(int ch, const char* fmt,...)
   g_idmalogbuf[4] = ' ';
   g_idmalogbuf[2] = (char) (ch + 0x30);
 
-  va_start(ap, fmt);
-  n = xt_vprint(g_idmalogbuf + 5, fmt, ap, IDMA_LOG_SIZE);
-  va_end(ap);
+  args.argv = NULL;
+  args.argc = 0;
+  va_start(args.ap, fmt);
+  n = xt_vprint(g_idmalogbuf + 5, fmt, &args, IDMA_LOG_SIZE);
+  va_end(args.ap);
   g_idmalogbuf[n+5] = (char)0;
 
   g_idma_cntrl[IDMA_CHANNEL_0].xlogh(g_idmalogbuf);
 }
 
+#ifdef IDMA_DEBUG_DEFERRED
+
+/*
+ * Deferred logging. Writers claim a sequence number with a CAS on the
+ * head, fill the entry of that number and publish it by writing its seq
+ * field last. The ring is overwritten when full, the reader detects
+ * overwritten entries by their seq field.
+ */
+idma_dlog_entry_t   g_idma_dlog_ring[IDMA_DLOG_ENTRIES];
+volatile uint32_t   g_idma_dlog_head;
+static uint32_t     g_idma_dlog_tail;
+static uint32_t     g_idma_dlog_lost;
+
+void
+idma_dlog(int32_t ch, int32_t nargs, const char* fmt, ...)
+{
+  idma_dlog_entry_t * entry;
+  uint32_t  seq;
+  int32_t   n;
+  int32_t   i;
+  va_list   ap;
+
+  do {
+    seq = g_idma_dlog_head;
+  }
+  while (IDMA_ATOMIC_CAS(&g_idma_dlog_head, seq, seq + 1U) != seq);
+
+  n     = (nargs < IDMA_DLOG_MAX_ARGS) ? nargs : IDMA_DLOG_MAX_ARGS;
+  entry = &g_idma_dlog_ring[seq & (IDMA_DLOG_ENTRIES - 1U)];
+  entry->seq    = 0;
+  entry->ccount = xthal_get_ccount();
+  entry->fmt    = fmt;
+  entry->ch     = (int16_t) ch;
+  entry->nargs  = (int16_t) n;
+
+  va_start(ap, fmt);
+  for (i = 0; i < n; i++) {
+    entry->args[i] = va_arg(ap, uint32_t);
+  }
+  va_end(ap);
+
+  XT_MEMW();
+  entry->seq = seq + 1U;
+}
+
+int32_t
+idma_dlog_flush(int32_t max)
+{
+  idma_dlog_entry_t   event;
+  idma_dlog_entry_t * entry;
+  xt_args_t args;
+  uint32_t  prefix[2];
+  uint32_t  head;
+  int32_t   done = 0;
+  int32_t   n;
+
+  if(!g_idma_cntrl[IDMA_CHANNEL_0].xlogh) {
+    return 0;
+  }
+
+  while (done < max) {
+    head = g_idma_dlog_head;
+    if (head == g_idma_dlog_tail) {
+      break;
+    }
+    if ((head - g_idma_dlog_tail) > IDMA_DLOG_ENTRIES) {
+      g_idma_dlog_lost += (head - g_idma_dlog_tail) - IDMA_DLOG_ENTRIES;
+      g_idma_dlog_tail  = head - IDMA_DLOG_ENTRIES;
+    }
+
+    entry = &g_idma_dlog_ring[g_idma_dlog_tail & (IDMA_DLOG_ENTRIES - 1U)];
+    event = *entry;
+    XT_MEMW();
+    if ((event.seq == 0U) || ((int32_t) (event.seq - (g_idma_dlog_tail + 1U)) < 0)) {
+      /* Still being written. A claimed entry keeps the seq of the
+       * previous lap until its writer clears it. */
+      break;
+    }
+    if ((event.seq != (g_idma_dlog_tail + 1U)) || (entry->seq != event.seq)) {
+      /* Overwritten by a newer event */
+      g_idma_dlog_lost++;
+      g_idma_dlog_tail++;
+      continue;
+    }
+    g_idma_dlog_tail++;
+
+    prefix[0] = (uint32_t) event.ch;
+    prefix[1] = event.ccount;
+    args.argv = prefix;
+    args.argc = 2;
+    n = xt_vprint(g_idmalogbuf, "ch%d @%u: ", &args, IDMA_LOG_SIZE - 1);
+    n = (n < (IDMA_LOG_SIZE - 1)) ? n : (IDMA_LOG_SIZE - 1);
+
+    args.argv = event.args;
+    args.argc = event.nargs;
+    n += xt_vprint(g_idmalogbuf + n, event.fmt, &args, IDMA_LOG_SIZE - 1 - n);
+    n = (n < (IDMA_LOG_SIZE - 1)) ? n : (IDMA_LOG_SIZE - 1);
+    g_idmalogbuf[n] = (char)0;
+
+    g_idma_cntrl[IDMA_CHANNEL_0].xlogh(g_idmalogbuf);
+    done++;
+  }
+  return done;
+}
+
+uint32_t
+idma_dlog_lost(void)
+{
+  return g_idma_dlog_lost;
+}
+
+#endif
+
 #else
 
 // Need something here to avoid compiler warnings about empty translation unit.
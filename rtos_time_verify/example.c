@@ -32,6 +32,7 @@
 #include "FreeRTOS.h"
 #include "semphr.h"
 #include "event_groups.h"
+#include "channel.h"
 
 #include <testcommon.h>
 
@@ -64,11 +65,25 @@
 #define TASK_TERM_COUNT         (1<<2)
 #define TASK_TERM_IDMA        (1<<3)
 
+#if configUSE_CHANNELS
+// Count channel size, a power of two.
+#define CHANNEL_SIZE            16
+#define COUNT_SEND(p, t)        xChannelSend( &Channel, (p), (t) )
+#define COUNT_RECEIVE(p, t)     xChannelReceive( &Channel, (p), (t) )
+#else
 // Message queue size.
 #define QUEUE_SIZE              10
+#define COUNT_SEND(p, t)        xQueueSend( Queue, (p), (t) )
+#define COUNT_RECEIVE(p, t)     xQueueReceive( Queue, (p), (t) )
+#endif
 
 EventGroupHandle_t TaskTermFlags;
+#if configUSE_CHANNELS
+Channel_t          Channel;
+uint32_t           ChannelStorage[CHANNEL_SIZE];
+#else
 QueueHandle_t      Queue;
+#endif
 TaskHandle_t       Count_Task_TCB;
 TaskHandle_t       Report_Task_TCB;
 TaskHandle_t       IDMA_Task_TCB;
@@ -103,8 +118,8 @@ void Display_Task( void * pdata )
 
 
 //-----------------------------------------------------------------------------
-// Count Task. Counts at regular intervals and sends the count via queue to
-// the Report Task.
+// Count Task. Counts at regular intervals and sends the count via channel (or
+// queue) to the Report Task.
 //-----------------------------------------------------------------------------
 void Count_Task( void * pdata )
 {
@@ -112,12 +127,12 @@ void Count_Task( void * pdata )
 
     PRINTF( "[Count_Task] Started.\n" );
 
-    // Count at regular intervals and place counter in queue.
+    // Count at regular intervals and place counter in channel (or queue).
     PRINTF( "[Count_Task] Counting.\n" );
 
     while ( 1 )
     {
-        xQueueSend( Queue, (void *) &count, 2 );
+        COUNT_SEND( (void *) &count, 2 );
         ++count;
         vTaskDelay( 1 );
 #ifdef XT_SIMULATOR
@@ -131,7 +146,7 @@ void Count_Task( void * pdata )
 
     // Send a last message to terminate the Report Task.
     count = 0xFFFFFFFF;
-    xQueueSend( Queue, (void *) &count, portMAX_DELAY );
+    COUNT_SEND( (void *) &count, portMAX_DELAY );
 
     PRINTF( "\n[Count_Task] Terminating.\n" );
 
@@ -144,9 +159,9 @@ void Count_Task( void * pdata )
 
 
 //-----------------------------------------------------------------------------
-// The Report Task waits for messages coming through the queue from the Count
-// Task and reports progress. It terminates when it receives a magic value for
-// the message.
+// The Report Task waits for messages coming through the channel (or queue)
+// from the Count Task and reports progress. It terminates when it receives a
+// magic value for the message.
 //-----------------------------------------------------------------------------
 void Report_Task( void * pdata )
 {
@@ -157,7 +172,7 @@ void Report_Task( void * pdata )
 
     while ( 1 )
     {
-        err = xQueueReceive( Queue, &count, 2 );
+        err = COUNT_RECEIVE( &count, 2 );
         if ( err == pdFAIL )
         {
             // Error
@@ -193,6 +208,11 @@ void Report_Task( void * pdata )
 void idma_main( void * pdata );
 void appframework( void * pdata );
 void verify_1d_2d( void *pdata);
+void test_time( void );
+void test_switch( void );
+void test_latency( void );
+void test_hrtimer( void );
+void test_channel( void );
 //-----------------------------------------------------------------------------
 // The Init Task creates the other tasks and waits for them to finish.
 //-----------------------------------------------------------------------------
@@ -205,6 +225,10 @@ void Init_Task( void * pdata )
 
     //process_eason();
     test_time();
+    test_switch();
+    test_latency();
+    test_hrtimer();
+    test_channel();
 
 
     // Create event flag group for task termination.
@@ -216,6 +240,11 @@ void Init_Task( void * pdata )
         goto done;
     }
 
+#if configUSE_CHANNELS
+    // Set up channel for sequence of counts.
+    PRINTF( "[Init_Task] Creating channel for sequence of counts.\n" );
+    vChannelInit( &Channel, ChannelStorage, CHANNEL_SIZE, sizeof(uint32_t) );
+#else
     // Create queue for sequence of counts.
     PRINTF( "[Init_Task] Creating queue for sequence of counts.\n" );
     Queue = xQueueCreate( QUEUE_SIZE, sizeof(uint32_t) );
@@ -225,6 +254,7 @@ void Init_Task( void * pdata )
         err = 101;
         goto done;
     }
+#endif
 
     // Create reporting task.
     PRINTF( "[Init_Task] Creating reporting task Report_Task.\n" );
@@ -286,16 +316,29 @@ void Init_Task( void * pdata )
     xEventGroupWaitBits( TaskTermFlags, TASK_TERM_REPORT | TASK_TERM_COUNT /*| TASK_TERM_IDMA*/, 0, pdTRUE, portMAX_DELAY );
 
 done:
-{
-	char pcWriteBuffer[200];
-    //vTaskGetRunTimeStats(pcWriteBuffer);
+#if (XT_USE_THREAD_SAFE_CLIB > 0) && (configGENERATE_RUN_TIME_STATS == 1) && (configUSE_STATS_FORMATTING_FUNCTIONS > 0)
+    {
+        // About 80 bytes per task. All times are in CCOUNT cycles.
+        static char pcWriteBuffer[1024];
+
+        printf( "[Init_Task] Run time stats:\nTask\t\tRun\t\tShare\n" );
+        vTaskGetRunTimeStats( pcWriteBuffer );
+        printf( "%s", pcWriteBuffer );
+
+        printf( "[Init_Task] Wait time stats:\nTask\t\tRun\tQueue\tiDMA\tOther\n" );
+        vTaskGetWaitTimeStats( pcWriteBuffer );
+        printf( "%s", pcWriteBuffer );
+        fflush( stdout );
+    }
+#endif
 
-}
     // Clean up and shut down.
     exit_code = ( err != pdPASS );
     PRINTF( "[Init_Task] Cleaning up resources and terminating.\n" );
 
+#if !configUSE_CHANNELS
     vQueueDelete( Queue );
+#endif
     vEventGroupDelete( TaskTermFlags );
 
 #ifdef XT_SIMULATOR
@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <stdint.h>
+
+#include <xtensa/hal.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "channel.h"
+
+// Queue against channel microbenchmark. Reports cycles per uint32_t item for
+// a send and receive by the same task, where nobody ever blocks, and for a
+// higher priority consumer that blocks on every item, so each item also
+// wakes it and switches to it and back.
+
+#define CHANNEL_ITERATIONS      1000
+#define CHANNEL_LENGTH          8
+#define CHANNEL_TASK_STK_SIZE   (XT_STACK_MIN_SIZE + 0x400)
+
+#if configUSE_CHANNELS
+
+static QueueHandle_t chan_queue;
+static Channel_t     chan_channel;
+static uint32_t      chan_storage[CHANNEL_LENGTH];
+
+static void chan_queue_consumer( void * pdata )
+{
+    uint32_t item;
+    int      i;
+
+    for ( i = 0; i < CHANNEL_ITERATIONS; i++ ) {
+        xQueueReceive( chan_queue, &item, portMAX_DELAY );
+    }
+
+    vTaskDelete( NULL );
+}
+
+static void chan_channel_consumer( void * pdata )
+{
+    uint32_t item;
+    int      i;
+
+    for ( i = 0; i < CHANNEL_ITERATIONS; i++ ) {
+        xChannelReceive( &chan_channel, &item, portMAX_DELAY );
+    }
+
+    vTaskDelete( NULL );
+}
+
+#endif /* configUSE_CHANNELS */
+
+void test_channel( void )
+{
+#if configUSE_CHANNELS
+    UBaseType_t prio = uxTaskPriorityGet( NULL );
+    uint32_t    start, queue_cycles, channel_cycles, queue_wake, channel_wake;
+    uint32_t    item = 0;
+    int         i;
+
+    printf("start test_channel\n");
+
+    chan_queue = xQueueCreate( CHANNEL_LENGTH, sizeof(uint32_t) );
+    vChannelInit( &chan_channel, chan_storage, CHANNEL_LENGTH, sizeof(uint32_t) );
+    if ( chan_queue == NULL ) {
+        printf("test_channel: FAILED to create queue\n");
+        return;
+    }
+
+    // Nobody blocks: send and receive one item at a time.
+    start = xthal_get_ccount();
+    for ( i = 0; i < CHANNEL_ITERATIONS; i++ ) {
+        xQueueSend( chan_queue, &item, 0 );
+        xQueueReceive( chan_queue, &item, 0 );
+    }
+    queue_cycles = xthal_get_ccount() - start;
+
+    start = xthal_get_ccount();
+    for ( i = 0; i < CHANNEL_ITERATIONS; i++ ) {
+        xChannelSend( &chan_channel, &item, 0 );
+        xChannelReceive( &chan_channel, &item, 0 );
+    }
+    channel_cycles = xthal_get_ccount() - start;
+
+    // Blocked consumer: it runs above the caller, so each send wakes it and
+    // it blocks again on the next receive.
+    if ( xTaskCreate( chan_queue_consumer, "QCons", CHANNEL_TASK_STK_SIZE, NULL, prio + 1, NULL ) != pdPASS ) {
+        printf("test_channel: FAILED to create queue consumer\n");
+        return;
+    }
+    start = xthal_get_ccount();
+    for ( i = 0; i < CHANNEL_ITERATIONS; i++ ) {
+        xQueueSend( chan_queue, &item, portMAX_DELAY );
+    }
+    queue_wake = xthal_get_ccount() - start;
+
+    if ( xTaskCreate( chan_channel_consumer, "CCons", CHANNEL_TASK_STK_SIZE, NULL, prio + 1, NULL ) != pdPASS ) {
+        printf("test_channel: FAILED to create channel consumer\n");
+        return;
+    }
+    start = xthal_get_ccount();
+    for ( i = 0; i < CHANNEL_ITERATIONS; i++ ) {
+        xChannelSend( &chan_channel, &item, portMAX_DELAY );
+    }
+    channel_wake = xthal_get_ccount() - start;
+
+    printf("test_channel: no wait   queue %u cycles/item, channel %u cycles/item\n",
+           (unsigned) (queue_cycles / CHANNEL_ITERATIONS),
+           (unsigned) (channel_cycles / CHANNEL_ITERATIONS));
+    printf("test_channel: wake      queue %u cycles/item, channel %u cycles/item\n",
+           (unsigned) (queue_wake / CHANNEL_ITERATIONS),
+           (unsigned) (channel_wake / CHANNEL_ITERATIONS));
+
+    // Let the idle task free the deleted tasks.
+    vTaskDelay( 2 );
+
+    vQueueDelete( chan_queue );
+#else
+    printf("test_channel: set configUSE_CHANNELS to 1 in FreeRTOSConfig.h\n");
+#endif
+}
@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// High resolution timer check. Reports in cycles how late the callbacks of
+// a one-shot and of a periodic timer run after their deadlines, and how late
+// a task wakes from vTaskDelayUntilCycles(), all well below one tick.
+
+#define HRTIMER_SAMPLES     200
+#define HRTIMER_PERIOD      (XT_CLOCK_FREQ / 2000)      // 500 us
+
+#if configUSE_HR_TIMERS
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+} hrtimer_stats;
+
+static HRTimer_t     hrtimer_one;
+static HRTimer_t     hrtimer_per;
+static hrtimer_stats hrtimer_one_stats;
+static hrtimer_stats hrtimer_per_stats;
+static uint64_t      hrtimer_per_next;
+static TaskHandle_t  hrtimer_waiter;
+
+static void hrtimer_record( hrtimer_stats * s, uint64_t deadline )
+{
+    uint32_t late = (uint32_t) ( portHRTIMER_NOW() - deadline );
+
+    if ( s->count == 0 || late < s->min ) {
+        s->min = late;
+    }
+    if ( late > s->max ) {
+        s->max = late;
+    }
+    s->count++;
+    s->sum += late;
+}
+
+static void hrtimer_print( const char * name, const hrtimer_stats * s )
+{
+    printf("test_hrtimer: %-10s %4u samples, late min %u avg %u max %u cycles\n",
+           name, (unsigned) s->count, (unsigned) s->min,
+           (unsigned) ( s->count ? s->sum / s->count : 0 ), (unsigned) s->max);
+}
+
+// pvArg points to the deadline the one-shot timer was started with.
+static void hrtimer_one_cb( HRTimer_t * timer, void * arg )
+{
+    BaseType_t woken = pdFALSE;
+
+    hrtimer_record( &hrtimer_one_stats, *(uint64_t *) arg );
+    vTaskNotifyGiveFromISR( hrtimer_waiter, &woken );
+    portYIELD_FROM_ISR( woken );
+}
+
+static void hrtimer_per_cb( HRTimer_t * timer, void * arg )
+{
+    BaseType_t woken = pdFALSE;
+
+    hrtimer_record( &hrtimer_per_stats, hrtimer_per_next );
+    hrtimer_per_next += HRTIMER_PERIOD;
+
+    if ( hrtimer_per_stats.count == HRTIMER_SAMPLES ) {
+        xPortHRTimerStop( timer );
+        vTaskNotifyGiveFromISR( hrtimer_waiter, &woken );
+        portYIELD_FROM_ISR( woken );
+    }
+}
+
+#endif /* configUSE_HR_TIMERS */
+
+void test_hrtimer( void )
+{
+#if configUSE_HR_TIMERS
+    hrtimer_stats delay_stats = { 0 };
+    uint64_t      deadline;
+    uint64_t      wake;
+    int           i;
+
+    printf("start test_hrtimer (period %u cycles)\n", (unsigned) HRTIMER_PERIOD);
+
+    hrtimer_waiter = xTaskGetCurrentTaskHandle();
+
+    // One-shot: restarted from the task for each sample, at odd offsets so
+    // the deadlines do not line up with the tick.
+    vPortHRTimerInit( &hrtimer_one, hrtimer_one_cb, &deadline );
+    for ( i = 0; i < HRTIMER_SAMPLES; i++ ) {
+        deadline = portHRTIMER_NOW() + HRTIMER_PERIOD + i * 97;
+        xPortHRTimerStart( &hrtimer_one, deadline, 0 );
+        ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+
+    // Periodic: the callback checks each expiry against the phase of the
+    // first one and stops the timer after the last sample.
+    vPortHRTimerInit( &hrtimer_per, hrtimer_per_cb, NULL );
+    hrtimer_per_next = portHRTIMER_NOW() + HRTIMER_PERIOD;
+    xPortHRTimerStart( &hrtimer_per, hrtimer_per_next, HRTIMER_PERIOD );
+    ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+    // Task wake up, measured from the target cycle to the task running.
+    wake = portHRTIMER_NOW();
+    for ( i = 0; i < HRTIMER_SAMPLES; i++ ) {
+        vTaskDelayUntilCycles( &wake, HRTIMER_PERIOD );
+        hrtimer_record( &delay_stats, wake );
+    }
+
+    hrtimer_print( "one-shot", &hrtimer_one_stats );
+    hrtimer_print( "periodic", &hrtimer_per_stats );
+    hrtimer_print( "delay", &delay_stats );
+#else
+    printf("test_hrtimer: set configUSE_HR_TIMERS to 1 in FreeRTOSConfig.h\n");
+#endif
+}
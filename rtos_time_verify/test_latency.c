@@ -0,0 +1,31 @@
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Interrupt latency report. Waits for a number of ticks so the tick has
+// entry and resume latencies, then prints all sources recorded so far.
+
+#define LATENCY_TICKS   200
+
+void test_latency( void )
+{
+#if configBENCHMARK
+    int i;
+
+    printf("start test_latency\n");
+
+    portbenchmarkReset();
+
+    for ( i = 0; i < LATENCY_TICKS; i++ ) {
+        vTaskDelay( 1 );
+        portbenchmarkIntWait( portbenchmarkSRC_TICK );
+    }
+
+    portbenchmarkPrint();
+#else
+    printf("test_latency: set configBENCHMARK to 1 in FreeRTOSConfig.h\n");
+#endif
+}
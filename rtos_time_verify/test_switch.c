@@ -0,0 +1,102 @@
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <xtensa/hal.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+// Context switch microbenchmark. Reports cycles per switch for two tasks
+// yielding to each other and for a semaphore ping-pong between two tasks.
+// Build once with configUSE_PORT_OPTIMISED_TASK_SELECTION set to 0 and once
+// with 1 to compare the generic and the NSAU task selection.
+
+#define SWITCH_ITERATIONS       1000
+#define SWITCH_TASK_STK_SIZE    (XT_STACK_MIN_SIZE + 0x400)
+
+static SemaphoreHandle_t switch_ping;
+static SemaphoreHandle_t switch_pong;
+static SemaphoreHandle_t switch_done;
+
+// Two of these run at the same priority, so each taskYIELD() is a switch.
+static void switch_yield_task( void * pdata )
+{
+    int i;
+
+    for ( i = 0; i < SWITCH_ITERATIONS; i++ ) {
+        taskYIELD();
+    }
+
+    xSemaphoreGive( switch_done );
+    vTaskDelete( NULL );
+}
+
+// Runs above the caller, giving switch_ping switches to it and taking the
+// next one switches back.
+static void switch_pong_task( void * pdata )
+{
+    int i;
+
+    for ( i = 0; i < SWITCH_ITERATIONS; i++ ) {
+        xSemaphoreTake( switch_ping, portMAX_DELAY );
+        xSemaphoreGive( switch_pong );
+    }
+
+    vTaskDelete( NULL );
+}
+
+void test_switch( void )
+{
+    UBaseType_t prio = uxTaskPriorityGet( NULL );
+    uint32_t    start, yield_cycles, sem_cycles;
+    int         i;
+
+    printf("start test_switch (%s task selection)\n",
+           configUSE_PORT_OPTIMISED_TASK_SELECTION ? "NSAU" : "generic");
+
+    switch_ping = xSemaphoreCreateBinary();
+    switch_pong = xSemaphoreCreateBinary();
+    switch_done = xSemaphoreCreateCounting( 2, 0 );
+    if ( switch_ping == NULL || switch_pong == NULL || switch_done == NULL ) {
+        printf("test_switch: FAILED to create semaphores\n");
+        return;
+    }
+
+    // Yield: the two tasks run below the caller once it blocks.
+    if ( xTaskCreate( switch_yield_task, "Yield_A", SWITCH_TASK_STK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL ) != pdPASS ||
+         xTaskCreate( switch_yield_task, "Yield_B", SWITCH_TASK_STK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL ) != pdPASS ) {
+        printf("test_switch: FAILED to create yield tasks\n");
+        return;
+    }
+
+    start = xthal_get_ccount();
+    xSemaphoreTake( switch_done, portMAX_DELAY );
+    xSemaphoreTake( switch_done, portMAX_DELAY );
+    yield_cycles = xthal_get_ccount() - start;
+
+    // Semaphore ping-pong: two switches per iteration.
+    if ( xTaskCreate( switch_pong_task, "Pong", SWITCH_TASK_STK_SIZE, NULL, prio + 1, NULL ) != pdPASS ) {
+        printf("test_switch: FAILED to create pong task\n");
+        return;
+    }
+
+    start = xthal_get_ccount();
+    for ( i = 0; i < SWITCH_ITERATIONS; i++ ) {
+        xSemaphoreGive( switch_ping );
+        xSemaphoreTake( switch_pong, portMAX_DELAY );
+    }
+    sem_cycles = xthal_get_ccount() - start;
+
+    printf("test_switch: yield %u cycles/switch, semaphore %u cycles/switch\n",
+           (unsigned) (yield_cycles / (2 * SWITCH_ITERATIONS)),
+           (unsigned) (sem_cycles / (2 * SWITCH_ITERATIONS)));
+
+    // Let the idle task free the deleted tasks.
+    vTaskDelay( 2 );
+
+    vSemaphoreDelete( switch_ping );
+    vSemaphoreDelete( switch_pong );
+    vSemaphoreDelete( switch_done );
+}